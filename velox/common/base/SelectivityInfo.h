@@ -47,6 +47,18 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  // Halves the history so that recent measurements outweigh old ones. The
+  // rows a filter sees depend on the filters that run before it, so that the
+  // measurements of correlated filters change when the filter order changes.
+  // The number of dropped rows is rounded up, so that a filter that dropped
+  // rows still has a finite time to drop a row.
+  void decay() {
+    const auto numDropped = numIn_ - numOut_;
+    numOut_ /= 2;
+    numIn_ = numOut_ + (numDropped + 1) / 2;
+    timeClocks_ /= 2;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -23,7 +23,9 @@
 #include <stdexcept>
 
 #include <fcntl.h>
+#include <folly/portability/SysMman.h>
 #include <folly/portability/SysUio.h>
+#include <folly/portability/Unistd.h>
 
 namespace facebook::velox {
 
@@ -94,7 +96,8 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
+LocalReadFile::LocalReadFile(std::string_view path, bool useMmap)
+    : path_(path) {
   fd_ = open(path_.c_str(), O_RDONLY);
   VELOX_CHECK_GE(
       fd_,
@@ -112,11 +115,24 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+  if (useMmap && size_ > 0) {
+    void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    VELOX_CHECK(
+        mapping != MAP_FAILED,
+        "mmap failure in LocalReadFile constructor, {} {}.",
+        path,
+        folly::errnoStr(errno));
+    mapping_ = static_cast<char*>(mapping);
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
 
 LocalReadFile::~LocalReadFile() {
+  if (mapping_ != nullptr && munmap(mapping_, size_) < 0) {
+    LOG(WARNING) << "munmap failure in LocalReadFile destructor: "
+                 << folly::errnoStr(errno);
+  }
   const int ret = close(fd_);
   if (ret < 0) {
     LOG(WARNING) << "close failure in LocalReadFile destructor: " << ret << ", "
@@ -126,6 +142,10 @@ LocalReadFile::~LocalReadFile() {
 
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
+  if (mapping_ != nullptr) {
+    memcpy(pos, mappedView(offset, length).data(), length);
+    return;
+  }
   bytesRead_ += length;
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
@@ -142,9 +162,80 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
   return {static_cast<char*>(buf), length};
 }
 
+std::string_view LocalReadFile::mappedView(uint64_t offset, uint64_t length)
+    const {
+  VELOX_CHECK_NOT_NULL(mapping_, "{} is not mapped", getName());
+  VELOX_CHECK_LE(
+      offset + length,
+      size_,
+      "Read past end of mapped file {}, {} vs {}",
+      getName(),
+      offset + length,
+      size_);
+  bytesRead_ += length;
+  return {mapping_ + offset, length};
+}
+
+void LocalReadFile::advise(uint64_t offset, uint64_t length, AccessHint hint)
+    const {
+  if (length == 0) {
+    return;
+  }
+  if (mapping_ != nullptr) {
+    // madvise() needs a page aligned start.
+    static const uint64_t kPageSize = sysconf(_SC_PAGESIZE);
+    const auto start = offset / kPageSize * kPageSize;
+    const auto end = std::min<uint64_t>(offset + length, size_);
+    if (start >= end) {
+      return;
+    }
+    int advice = MADV_NORMAL;
+    switch (hint) {
+      case AccessHint::kSequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+      case AccessHint::kRandom:
+        advice = MADV_RANDOM;
+        break;
+      case AccessHint::kWillNeed:
+        advice = MADV_WILLNEED;
+        break;
+      default:
+        break;
+    }
+    // The hint is best effort.
+    if (madvise(mapping_ + start, end - start, advice) < 0) {
+      VLOG(1) << "madvise failed on " << getName() << ": "
+              << folly::errnoStr(errno);
+    }
+    return;
+  }
+#ifdef __linux__
+  int advice = POSIX_FADV_NORMAL;
+  switch (hint) {
+    case AccessHint::kSequential:
+      advice = POSIX_FADV_SEQUENTIAL;
+      break;
+    case AccessHint::kRandom:
+      advice = POSIX_FADV_RANDOM;
+      break;
+    case AccessHint::kWillNeed:
+      advice = POSIX_FADV_WILLNEED;
+      break;
+    default:
+      break;
+  }
+  posix_fadvise(fd_, offset, length, advice);
+#endif
+}
+
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (mapping_ != nullptr) {
+    // Copies from the mapping and skips the gaps without touching them.
+    return ReadFile::preadv(offset, buffers);
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
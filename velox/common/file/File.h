@@ -101,6 +101,42 @@ class ReadFile {
     return false;
   }
 
+  // Returns true if mappedView() is supported.
+  virtual bool hasMappedView() const {
+    return false;
+  }
+
+  // Returns the data at [offset, offset + length) without copying, e.g. a
+  // view into a memory mapping of the file. The view stays valid for the
+  // lifetime of *this. Only supported if hasMappedView() is true.
+  //
+  // This method should be thread safe.
+  virtual std::string_view mappedView(uint64_t /*offset*/, uint64_t /*length*/)
+      const {
+    VELOX_UNSUPPORTED("{} does not support mapped views", getName());
+  }
+
+  // Expected access to a range of the file.
+  enum class AccessHint {
+    // No special treatment.
+    kNormal,
+    // Read front to back. The implementation may read ahead aggressively.
+    kSequential,
+    // Read in no particular order. The implementation should not read ahead.
+    kRandom,
+    // Read soon. The implementation may start loading the range.
+    kWillNeed,
+  };
+
+  // Advises the implementation of the expected access to [offset, offset +
+  // length). The default implementation ignores the hint.
+  //
+  // This method should be thread safe.
+  virtual void advise(
+      uint64_t /*offset*/,
+      uint64_t /*length*/,
+      AccessHint /*hint*/) const {}
+
   // Whether preads should be coalesced where possible. E.g. remote disk would
   // set to true, in-memory to false.
   virtual bool shouldCoalesce() const = 0;
@@ -223,9 +259,15 @@ class InMemoryWriteFile final : public WriteFile {
 // internal arenaing), as local disk writes are expected to be cheap. Local
 // files match against any filepath starting with '/'.
 
+//
+// If 'useMmap' is true, the file is mapped into memory. Reads copy from the
+// mapping without a system call and mappedView() returns views into the
+// mapping, which lets readers consume uncompressed data in place. Truncating
+// a mapped file while it is being read raises SIGBUS, so this is meant for
+// immutable files on local storage.
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  explicit LocalReadFile(std::string_view path, bool useMmap = false);
 
   explicit LocalReadFile(int32_t fd);
 
@@ -242,6 +284,14 @@ class LocalReadFile final : public ReadFile {
 
   uint64_t memoryUsage() const final;
 
+  bool hasMappedView() const final {
+    return mapping_ != nullptr;
+  }
+
+  std::string_view mappedView(uint64_t offset, uint64_t length) const final;
+
+  void advise(uint64_t offset, uint64_t length, AccessHint hint) const final;
+
   bool shouldCoalesce() const final {
     return false;
   }
@@ -264,6 +314,8 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  // Mapping of the whole file if opened with 'useMmap'.
+  char* mapping_{nullptr};
 };
 
 class LocalWriteFile final : public WriteFile {
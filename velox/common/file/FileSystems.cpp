@@ -86,8 +86,10 @@ class LocalFileSystem : public FileSystem {
 
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
-      const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+      const FileOptions& options) override {
+    auto it = options.values.find(FileOptions::kLocalFileMmap);
+    const bool useMmap = it != options.values.end() && it->second == "true";
+    return std::make_unique<LocalReadFile>(extractPath(path), useMmap);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
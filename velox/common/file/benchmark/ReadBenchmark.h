@@ -46,7 +46,7 @@ DECLARE_int32(measurement_size);
 
 namespace facebook::velox {
 
-enum class Mode { Pread = 0, Preadv = 1, Multiple = 2 };
+enum class Mode { Pread = 0, Preadv = 1, Multiple = 2, PreadvAsync = 3 };
 
 // Struct to read data into. If we read contiguous and then copy to
 // non-contiguous buffers, we read to 'buffer' and copy to
@@ -142,6 +142,13 @@ class ReadBenchmark {
     clearCache();
     std::vector<folly::Promise<bool>> promises;
     std::vector<folly::SemiFuture<bool>> futures;
+    // Destination of each outstanding preadvAsync(). Kept live until all the
+    // reads complete.
+    std::vector<std::string> asyncBuffers;
+    std::vector<folly::SemiFuture<uint64_t>> asyncFutures;
+    if (mode == Mode::PreadvAsync) {
+      asyncBuffers.reserve(repeats);
+    }
     uint64_t usec = 0;
     std::string label;
     {
@@ -227,6 +234,22 @@ class ReadBenchmark {
 
             break;
           }
+          case Mode::PreadvAsync: {
+            // Issues all the reads before waiting for any of them. The
+            // concurrency comes from the ReadFile, not from 'executor_'.
+            label = "1 preadvAsync";
+            auto& buffer = asyncBuffers.emplace_back(size * count, 0);
+            std::vector<folly::Range<char*>> ranges;
+            for (auto i = 0; i < count; ++i) {
+              ranges.push_back(
+                  folly::Range<char*>(buffer.data() + i * size, size));
+              if (gap && i < count - 1) {
+                ranges.push_back(folly::Range<char*>(nullptr, gap));
+              }
+            }
+            asyncFutures.push_back(readFile_->preadvAsync(offset, ranges));
+            break;
+          }
           case Mode::Multiple: {
             label = "multiple pread";
             if (parallel) {
@@ -264,6 +287,9 @@ class ReadBenchmark {
           std::move(futures[i]).via(&exec).wait();
         }
       }
+      for (auto& future : asyncFutures) {
+        std::move(future).get();
+      }
     }
     std::cout << fmt::format(
                      "{} MB/s {} {}",
@@ -289,6 +315,9 @@ class ReadBenchmark {
     randomReads(size, gap, count, repeats, Mode::Pread, true);
     randomReads(size, gap, count, repeats, Mode::Preadv, true);
     randomReads(size, gap, count, repeats, Mode::Multiple, true);
+    if (readFile_->hasPreadvAsync()) {
+      randomReads(size, gap, count, repeats, Mode::PreadvAsync, false);
+    }
   }
 
   void run();
@@ -126,6 +126,53 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+TEST(LocalFile, mmap) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  LocalReadFile readFile(filename, true);
+  ASSERT_TRUE(readFile.hasMappedView());
+  readData(&readFile);
+
+  auto view = readFile.mappedView(0, 10);
+  ASSERT_EQ(view, "aaaaabbbbb");
+  // Views of the same range point to the same memory.
+  ASSERT_EQ(view.data(), readFile.mappedView(0, 10).data());
+  ASSERT_EQ(readFile.mappedView(10 + kOneMB, 5), "ddddd");
+  EXPECT_THROW(readFile.mappedView(kOneMB, 16), VeloxRuntimeError);
+
+  // Hints do not change the data.
+  readFile.advise(3, kOneMB, ReadFile::AccessHint::kSequential);
+  readFile.advise(0, 15 + kOneMB, ReadFile::AccessHint::kWillNeed);
+  readFile.advise(0, 15 + kOneMB, ReadFile::AccessHint::kRandom);
+  readData(&readFile);
+
+  LocalReadFile unmapped(filename);
+  ASSERT_FALSE(unmapped.hasMappedView());
+  unmapped.advise(0, 15 + kOneMB, ReadFile::AccessHint::kSequential);
+  readData(&unmapped);
+
+  filesystems::registerLocalFileSystem();
+  filesystems::FileOptions options;
+  options.values[filesystems::FileOptions::kLocalFileMmap] = "true";
+  auto viaRegistry = filesystems::getFileSystem(filename, nullptr)
+                         ->openFileForRead(filename, options);
+  ASSERT_TRUE(viaRegistry->hasMappedView());
+  readData(viaRegistry.get());
+}
+
+TEST(LocalFile, mmapEmptyFile) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  LocalReadFile readFile(filename, true);
+  ASSERT_EQ(0, readFile.size());
+  ASSERT_FALSE(readFile.hasMappedView());
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
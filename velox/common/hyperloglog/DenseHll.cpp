@@ -133,8 +133,13 @@ void DenseHll::initialize(int8_t indexBitLength) {
   indexBitLength_ = indexBitLength;
 
   auto numBuckets = 1 << indexBitLength;
+  baseline_ = 0;
   baselineCount_ = numBuckets;
-  deltas_.resize(numBuckets * kBitsPerBucket / 8);
+  // Clears the buckets of an instance that is initialized again for reuse.
+  deltas_.assign(numBuckets * kBitsPerBucket / 8, 0);
+  overflows_ = 0;
+  overflowBuckets_.clear();
+  overflowValues_.clear();
 }
 
 void DenseHll::insertHash(uint64_t hash) {
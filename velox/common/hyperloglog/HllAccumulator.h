@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/hyperloglog/SparseHll.h"
+#include "velox/common/memory/HashStringAllocator.h"
+
+namespace facebook::velox::common::hll {
+
+/// HyperLogLog that starts with the sparse layout and switches to the dense
+/// layout once the sparse layout uses more memory than the dense one would.
+class HllAccumulator {
+ public:
+  explicit HllAccumulator(HashStringAllocator* allocator)
+      : sparseHll_{allocator}, denseHll_{allocator} {}
+
+  void setIndexBitLength(int8_t indexBitLength) {
+    indexBitLength_ = indexBitLength;
+    sparseHll_.setSoftMemoryLimit(
+        DenseHll::estimateInMemorySize(indexBitLength_));
+  }
+
+  int8_t indexBitLength() const {
+    return indexBitLength_;
+  }
+
+  void append(uint64_t hash) {
+    if (isSparse_) {
+      if (sparseHll_.insertHash(hash)) {
+        toDense();
+      }
+    } else {
+      denseHll_.insertHash(hash);
+    }
+  }
+
+  /// Removes all the values. Keeps the index bit length and the memory of the
+  /// dense layout, if any, so that the accumulator can be reused.
+  void clear() {
+    isSparse_ = true;
+    sparseHll_.clear();
+  }
+
+  int64_t cardinality() const {
+    return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
+  }
+
+  /// Merges a HyperLogLog in Presto SparseV2 or DenseV2 format into this one.
+  void mergeWith(StringView serialized, HashStringAllocator* allocator) {
+    auto input = serialized.data();
+    if (SparseHll::canDeserialize(input)) {
+      if (isSparse_) {
+        sparseHll_.mergeWith(input);
+        if (indexBitLength_ < 0) {
+          setIndexBitLength(DenseHll::deserializeIndexBitLength(input));
+        }
+        if (sparseHll_.overLimit()) {
+          toDense();
+        }
+      } else {
+        SparseHll other{input, allocator};
+        other.toDense(denseHll_);
+      }
+    } else if (DenseHll::canDeserialize(input)) {
+      if (isSparse_) {
+        if (indexBitLength_ < 0) {
+          setIndexBitLength(DenseHll::deserializeIndexBitLength(input));
+        }
+        toDense();
+      }
+      denseHll_.mergeWith(input);
+    } else {
+      VELOX_USER_FAIL("Unexpected type of HLL");
+    }
+  }
+
+  /// Merges 'other' into this one. Both must have the same index bit length.
+  void mergeWith(const HllAccumulator& other) {
+    VELOX_CHECK_EQ(
+        indexBitLength_,
+        other.indexBitLength_,
+        "Cannot merge HLLs with different number of buckets");
+    if (other.isSparse_) {
+      if (isSparse_) {
+        sparseHll_.mergeWith(other.sparseHll_);
+        if (sparseHll_.overLimit()) {
+          toDense();
+        }
+      } else {
+        other.sparseHll_.toDense(denseHll_);
+      }
+    } else {
+      if (isSparse_) {
+        toDense();
+      }
+      denseHll_.mergeWith(other.denseHll_);
+    }
+  }
+
+  int32_t serializedSize() {
+    return isSparse_ ? sparseHll_.serializedSize() : denseHll_.serializedSize();
+  }
+
+  void serialize(char* outputBuffer) {
+    return isSparse_ ? sparseHll_.serialize(indexBitLength_, outputBuffer)
+                     : denseHll_.serialize(outputBuffer);
+  }
+
+ private:
+  void toDense() {
+    isSparse_ = false;
+    denseHll_.initialize(indexBitLength_);
+    sparseHll_.toDense(denseHll_);
+    sparseHll_.reset();
+  }
+
+  bool isSparse_{true};
+  int8_t indexBitLength_{-1};
+  SparseHll sparseHll_;
+  DenseHll denseHll_;
+};
+
+} // namespace facebook::velox::common::hll
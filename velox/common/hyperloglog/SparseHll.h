@@ -68,6 +68,11 @@ class SparseHll {
   /// Returns current memory usage.
   int32_t inMemorySize() const;
 
+  // Clear accumulated state and keep the memory for reuse.
+  void clear() {
+    entries_.clear();
+  }
+
   // Clear accumulated state and release memory. Used to free up memory after
   // converting to dense layout.
   void reset() {
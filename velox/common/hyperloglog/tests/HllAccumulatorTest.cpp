@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/hyperloglog/HllAccumulator.h"
+
+#include <gtest/gtest.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/hyperloglog/HllUtils.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::common::hll;
+
+namespace {
+
+uint64_t hashOne(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+class HllAccumulatorTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<HllAccumulator> makeAccumulator(
+      int64_t begin,
+      int64_t end,
+      int8_t indexBitLength = kIndexBitLength) {
+    auto accumulator = std::make_unique<HllAccumulator>(&allocator_);
+    accumulator->setIndexBitLength(indexBitLength);
+    for (auto value = begin; value < end; ++value) {
+      accumulator->append(hashOne(value));
+    }
+    return accumulator;
+  }
+
+  std::string serialize(HllAccumulator& accumulator) {
+    std::string serialized(accumulator.serializedSize(), '\0');
+    accumulator.serialize(serialized.data());
+    return serialized;
+  }
+
+  static constexpr int8_t kIndexBitLength = 11;
+
+  std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  HashStringAllocator allocator_{pool_.get()};
+};
+
+TEST_F(HllAccumulatorTest, mergeWith) {
+  // 100 values stay sparse, 10'000 values make the accumulator dense.
+  for (const int64_t leftSize : {0, 100, 10'000}) {
+    for (const int64_t rightSize : {0, 100, 10'000}) {
+      SCOPED_TRACE(fmt::format("{} + {}", leftSize, rightSize));
+      // The values overlap by half of the smaller side.
+      const auto rightBegin = leftSize - std::min(leftSize, rightSize) / 2;
+      const auto rightEnd = rightBegin + rightSize;
+      auto expected = makeAccumulator(0, std::max(leftSize, rightEnd));
+
+      auto left = makeAccumulator(0, leftSize);
+      auto right = makeAccumulator(rightBegin, rightEnd);
+      left->mergeWith(*right);
+      EXPECT_EQ(left->cardinality(), expected->cardinality());
+
+      auto serializedLeft = makeAccumulator(0, leftSize);
+      serializedLeft->mergeWith(StringView(serialize(*right)), &allocator_);
+      EXPECT_EQ(serializedLeft->cardinality(), expected->cardinality());
+    }
+  }
+}
+
+TEST_F(HllAccumulatorTest, mergeWithDifferentIndexBitLength) {
+  auto left = makeAccumulator(0, 100);
+  auto right = makeAccumulator(0, 100, kIndexBitLength + 1);
+  VELOX_ASSERT_THROW(
+      left->mergeWith(*right),
+      "Cannot merge HLLs with different number of buckets");
+}
+
+TEST_F(HllAccumulatorTest, clear) {
+  // A dense accumulator that is cleared and refilled with other values must
+  // not keep any bucket of the earlier values.
+  for (const int64_t size : {100, 10'000}) {
+    SCOPED_TRACE(fmt::format("{} values", size));
+    auto accumulator = makeAccumulator(0, 10'000);
+    accumulator->clear();
+    EXPECT_EQ(accumulator->cardinality(), 0);
+    EXPECT_EQ(accumulator->indexBitLength(), kIndexBitLength);
+    for (int64_t value = 20'000; value < 20'000 + size; ++value) {
+      accumulator->append(hashOne(value));
+    }
+    auto expected = makeAccumulator(20'000, 20'000 + size);
+    EXPECT_EQ(accumulator->cardinality(), expected->cardinality());
+    EXPECT_EQ(serialize(*accumulator), serialize(*expected));
+  }
+}
+
+} // namespace
@@ -146,6 +146,21 @@ class DataSink {
     return 0;
   }
 
+  /// Returns true if the sink can free memory by writing out the data that
+  /// its file writers buffer.
+  virtual bool canReclaim() const {
+    return false;
+  }
+
+  /// Invoked by the memory arbitrator to free memory by writing out the data
+  /// buffered by the file writers, e.g. by ending their current stripe or row
+  /// group early. Stops when about 'targetBytes' are freed or, if
+  /// 'targetBytes' is zero, when all the writers are flushed. Returns the
+  /// number of flushed writers. Not called while the sink is in use.
+  virtual uint64_t reclaim(uint64_t /*targetBytes*/) {
+    return 0;
+  }
+
   /// Called once after all data has been added via possibly multiple calls to
   /// appendData(). The function returns the metadata of written data in string
   /// form on success. If 'success' is false, this function aborts any pending
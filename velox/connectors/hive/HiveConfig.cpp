@@ -66,6 +66,11 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* config) {
   return config->get<uint32_t>(kMaxPartitionsPerWriters, 100);
 }
 
+// static
+uint32_t HiveConfig::maxSortedPartitionsPerWriters(const Config* config) {
+  return config->get<uint32_t>(kMaxSortedPartitionsPerWriters, 0);
+}
+
 // static
 bool HiveConfig::immutablePartitions(const Config* config) {
   return config->get<bool>(kImmutablePartitions, false);
@@ -125,6 +130,36 @@ std::string HiveConfig::s3IAMRoleSessionName(const Config* config) {
   return config->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+// static
+int32_t HiveConfig::s3ReadThreads(const Config* config) {
+  return config->get<int32_t>(kS3ReadThreads, 0);
+}
+
+// static
+uint64_t HiveConfig::s3ReadPartSize(const Config* config) {
+  return config->get<uint64_t>(kS3ReadPartSize, 8 << 20);
+}
+
+// static
+double HiveConfig::s3HedgeReadPercentile(const Config* config) {
+  return config->get<double>(kS3HedgeReadPercentile, 0);
+}
+
+// static
+int32_t HiveConfig::hdfsReadThreads(const Config* config) {
+  return config->get<int32_t>(kHdfsReadThreads, 0);
+}
+
+// static
+bool HiveConfig::isHdfsShortCircuitReadEnabled(const Config* config) {
+  return config->get<bool>(kHdfsShortCircuitReadEnabled, false);
+}
+
+// static
+std::string HiveConfig::hdfsDomainSocketPath(const Config* config) {
+  return config->get<std::string>(kHdfsDomainSocketPath, std::string(""));
+}
+
 // static
 std::string HiveConfig::gcsEndpoint(const Config* config) {
   return config->get<std::string>(kGCSEndpoint, std::string(""));
@@ -160,9 +195,29 @@ int32_t HiveConfig::maxCoalescedDistanceBytes(const Config* config) {
   return config->get<int32_t>(kMaxCoalescedDistanceBytes, 512 << 10);
 }
 
+// static.
+bool HiveConfig::isAdaptiveIoEnabled(const Config* config) {
+  return config->get<bool>(kAdaptiveIoEnabled, false);
+}
+
+// static.
+bool HiveConfig::isLocalFileMmapEnabled(const Config* config) {
+  return config->get<bool>(kLocalFileMmapEnabled, false);
+}
+
 // static.
 int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+int32_t HiveConfig::decodingThreads(const Config* config) {
+  return config->get<int32_t>(kDecodingThreads, 0);
+}
+
+// static.
+int32_t HiveConfig::splitDecodingParallelism(const Config* config) {
+  return config->get<int32_t>(kSplitDecodingParallelism, 1);
+}
+
 } // namespace facebook::velox::connector::hive
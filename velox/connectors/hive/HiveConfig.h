@@ -44,6 +44,15 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWriters =
       "max_partitions_per_writers";
 
+  /// Maximum number of distinct (bucketed) partitions per a single table
+  /// writer instance if the rows of the partitions beyond
+  /// 'max_partitions_per_writers' are sorted by partition and written one
+  /// partition at a time on close. 0 disables sorting the rows of such
+  /// partitions, so that writing more partitions than
+  /// 'max_partitions_per_writers' fails.
+  static constexpr const char* kMaxSortedPartitionsPerWriters =
+      "max_sorted_partitions_per_writers";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -81,6 +90,33 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Number of threads issuing concurrent range GETs for reads of one file
+  /// system. 0 reads each request with a single synchronous GET.
+  static constexpr const char* kS3ReadThreads = "hive.s3.read-threads";
+
+  /// Maximum size of a single range GET when reads are parallel. Larger reads
+  /// are split into concurrent parts.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// Percentile of recent part latencies after which a duplicate GET is
+  /// issued for a part that has not completed. 0 disables hedged reads.
+  static constexpr const char* kS3HedgeReadPercentile =
+      "hive.s3.hedge-read-percentile";
+
+  /// Number of threads per HDFS file system that serve asynchronous reads.
+  /// 0 disables asynchronous reads.
+  static constexpr const char* kHdfsReadThreads = "hive.hdfs.read-threads";
+
+  /// Read blocks stored on the local DataNode directly from the local disk
+  /// instead of streaming them through the DataNode.
+  static constexpr const char* kHdfsShortCircuitReadEnabled =
+      "hive.hdfs.short-circuit-read-enabled";
+
+  /// Path of the UNIX domain socket shared with the local DataNode. Required
+  /// for short-circuit reads.
+  static constexpr const char* kHdfsDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
   // The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -104,14 +140,35 @@ class HiveConfig {
   static constexpr const char* kMaxCoalescedDistanceBytes =
       "max-coalesced-distance-bytes";
 
+  /// Adapt coalesce distance, load quantum and read-ahead depth to the
+  /// latency and bandwidth measured on reads.
+  static constexpr const char* kAdaptiveIoEnabled = "adaptive-io-enabled";
+
+  /// Memory map local files for reading. Uncompressed streams are then read
+  /// in place without copying.
+  static constexpr const char* kLocalFileMmapEnabled =
+      "local-file-mmap-enabled";
+
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Number of threads of the connector for decoding the stripes or row
+  /// groups of a split in parallel. 0 decodes on the driver threads only.
+  static constexpr const char* kDecodingThreads = "decoding-threads";
+
+  /// Maximum number of stripes or row groups of a split that are decoded at
+  /// the same time on the decoding threads. Takes effect only if there are
+  /// decoding threads.
+  static constexpr const char* kSplitDecodingParallelism =
+      "split-decoding-parallelism";
+
   static InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* config);
 
   static uint32_t maxPartitionsPerWriters(const Config* config);
 
+  static uint32_t maxSortedPartitionsPerWriters(const Config* config);
+
   static bool immutablePartitions(const Config* config);
 
   static bool s3UseVirtualAddressing(const Config* config);
@@ -132,6 +189,18 @@ class HiveConfig {
 
   static std::string s3IAMRoleSessionName(const Config* config);
 
+  static int32_t s3ReadThreads(const Config* config);
+
+  static uint64_t s3ReadPartSize(const Config* config);
+
+  static double s3HedgeReadPercentile(const Config* config);
+
+  static int32_t hdfsReadThreads(const Config* config);
+
+  static bool isHdfsShortCircuitReadEnabled(const Config* config);
+
+  static std::string hdfsDomainSocketPath(const Config* config);
+
   static std::string gcsEndpoint(const Config* config);
 
   static std::string gcsScheme(const Config* config);
@@ -146,7 +215,15 @@ class HiveConfig {
 
   static int32_t maxCoalescedDistanceBytes(const Config* config);
 
+  static bool isAdaptiveIoEnabled(const Config* config);
+
+  static bool isLocalFileMmapEnabled(const Config* config);
+
   static int32_t numCacheFileHandles(const Config* config);
+
+  static int32_t decodingThreads(const Config* config);
+
+  static int32_t splitDecodingParallelism(const Config* config);
 };
 
 } // namespace facebook::velox::connector::hive
@@ -41,6 +41,7 @@
 #include "velox/expression/FieldReference.h"
 
 #include <boost/lexical_cast.hpp>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <memory>
 
 using namespace facebook::velox::exec;
@@ -63,6 +64,13 @@ HiveConnector::HiveConnector(
               numCachedFileHandles(properties.get())),
           std::make_unique<FileHandleGenerator>(properties)),
       executor_(executor) {
+  if (properties) {
+    if (auto numThreads = HiveConfig::decodingThreads(properties.get())) {
+      decodingExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+          numThreads,
+          std::make_shared<folly::NamedThreadFactory>("HiveDecoding"));
+    }
+  }
   LOG(INFO) << "Hive connector " << connectorId() << " created with maximum of "
             << numCachedFileHandles(properties.get())
             << " cached file handles.";
@@ -80,6 +88,12 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       HiveConfig::maxCoalescedBytes(connectorQueryCtx->config()));
   options.setMaxCoalesceDistance(
       HiveConfig::maxCoalescedDistanceBytes(connectorQueryCtx->config()));
+  if (HiveConfig::isAdaptiveIoEnabled(connectorQueryCtx->config())) {
+    // Shared by the files read by this data source. These are usually on the
+    // same storage.
+    options.setIoTuner(std::make_shared<dwio::common::IoTuner>(
+        options.loadQuantum(), options.maxCoalesceDistance()));
+  }
   options.setFileColumnNamesReadAsLowerCase(
       HiveConfig::isFileColumnNamesReadAsLowerCase(
           connectorQueryCtx->config()));
@@ -95,7 +109,9 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       connectorQueryCtx->cache(),
       connectorQueryCtx->scanId(),
       executor_,
-      options);
+      options,
+      decodingExecutor_,
+      HiveConfig::splitDecodingParallelism(connectorQueryCtx->config()));
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/core/PlanNode.h"
@@ -72,6 +74,9 @@ class HiveConnector : public Connector {
  protected:
   FileHandleFactory fileHandleFactory_;
   folly::Executor* FOLLY_NULLABLE executor_;
+  // Decodes the stripes or row groups of a split in parallel. nullptr if
+  // HiveConfig::kDecodingThreads is 0.
+  std::shared_ptr<folly::CPUThreadPoolExecutor> decodingExecutor_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
@@ -33,6 +33,9 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   std::unordered_map<std::string, std::string> customSplitInfo;
   std::shared_ptr<std::string> extraFileInfo;
   std::unordered_map<std::string, std::string> serdeParameters;
+  /// Modification time of the file. If set, the parsed file footer is shared
+  /// with other splits of the same file through the FileMetadataCache.
+  std::optional<int64_t> fileModificationTime;
 
   HiveConnectorSplit(
       const std::string& connectorId,
@@ -45,7 +48,8 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
       std::optional<int32_t> _tableBucketNumber = std::nullopt,
       const std::unordered_map<std::string, std::string>& _customSplitInfo = {},
       const std::shared_ptr<std::string>& _extraFileInfo = {},
-      const std::unordered_map<std::string, std::string>& _serdeParameters = {})
+      const std::unordered_map<std::string, std::string>& _serdeParameters = {},
+      std::optional<int64_t> _fileModificationTime = std::nullopt)
       : ConnectorSplit(connectorId),
         filePath(_filePath),
         fileFormat(_fileFormat),
@@ -55,7 +59,8 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
         tableBucketNumber(_tableBucketNumber),
         customSplitInfo(_customSplitInfo),
         extraFileInfo(_extraFileInfo),
-        serdeParameters(_serdeParameters) {}
+        serdeParameters(_serdeParameters),
+        fileModificationTime(_fileModificationTime) {}
 
   std::string toString() const override {
     if (tableBucketNumber.has_value()) {
@@ -270,6 +270,59 @@ std::string HiveBucketProperty::toString() const {
   return out.str();
 }
 
+HiveClusteringProperty::HiveClusteringProperty(
+    Kind kind,
+    const std::vector<std::shared_ptr<const HiveSortingColumn>>& clusteredBy)
+    : kind_(kind), clusteredBy_(clusteredBy) {
+  VELOX_USER_CHECK(
+      !clusteredBy_.empty(), "Hive clustering columns must be set");
+}
+
+std::string HiveClusteringProperty::kindString(Kind kind) {
+  switch (kind) {
+    case Kind::kSorted:
+      return "SORTED";
+    case Kind::kZOrder:
+      return "Z_ORDER";
+    default:
+      return fmt::format("UNKNOWN {}", static_cast<int>(kind));
+  }
+}
+
+folly::dynamic HiveClusteringProperty::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "HiveClusteringProperty";
+  obj["kind"] = static_cast<int64_t>(kind_);
+  obj["clusteredBy"] = ISerializable::serialize(clusteredBy_);
+  return obj;
+}
+
+std::shared_ptr<HiveClusteringProperty> HiveClusteringProperty::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  const Kind kind = static_cast<Kind>(obj["kind"].asInt());
+  const auto clusteredBy =
+      ISerializable::deserialize<std::vector<HiveSortingColumn>>(
+          obj["clusteredBy"], context);
+  return std::make_shared<HiveClusteringProperty>(kind, clusteredBy);
+}
+
+void HiveClusteringProperty::registerSerDe() {
+  auto& registry = DeserializationWithContextRegistryForSharedPtr();
+  registry.Register(
+      "HiveClusteringProperty", HiveClusteringProperty::deserialize);
+}
+
+std::string HiveClusteringProperty::toString() const {
+  std::stringstream out;
+  out << "HiveClusteringProperty[<" << kind_ << ">";
+  for (const auto& column : clusteredBy_) {
+    out << " " << column->toString();
+  }
+  out << "]";
+  return out.str();
+}
+
 HiveDataSink::HiveDataSink(
     RowTypePtr inputType,
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
@@ -283,14 +336,17 @@ HiveDataSink::HiveDataSink(
       connectorProperties_(connectorProperties),
       maxOpenWriters_(
           HiveConfig::maxPartitionsPerWriters(connectorQueryCtx_->config())),
+      maxSortedPartitions_(HiveConfig::maxSortedPartitionsPerWriters(
+          connectorQueryCtx_->config())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
-          !partitionChannels_.empty() ? std::make_unique<PartitionIdGenerator>(
-                                            inputType_,
-                                            partitionChannels_,
-                                            maxOpenWriters_,
-                                            connectorQueryCtx_->memoryPool())
-                                      : nullptr),
+          !partitionChannels_.empty()
+              ? std::make_unique<PartitionIdGenerator>(
+                    inputType_,
+                    partitionChannels_,
+                    std::max(maxOpenWriters_, maxSortedPartitions_),
+                    connectorQueryCtx_->memoryPool())
+              : nullptr),
       bucketCount_(
           insertTableHandle_->bucketProperty() == nullptr
               ? 0
@@ -315,23 +371,76 @@ HiveDataSink::HiveDataSink(
       "Unsupported commit strategy: {}",
       commitStrategyToString(commitStrategy_));
 
-  if (!isBucketed()) {
+  if (isBucketed()) {
+    setSortColumns(insertTableHandle_->bucketProperty()->sortedBy());
+  }
+
+  const auto* clusteringProperty = insertTableHandle_->clusteringProperty();
+  if (clusteringProperty == nullptr) {
     return;
   }
-  const auto& sortedProperty = insertTableHandle_->bucketProperty()->sortedBy();
-  if (!sortedProperty.empty()) {
-    sortColumnIndices_.reserve(sortedProperty.size());
-    sortCompareFlags_.reserve(sortedProperty.size());
-    for (int i = 0; i < sortedProperty.size(); ++i) {
-      sortColumnIndices_.push_back(
-          inputType_->getChildIdx(sortedProperty.at(i)->sortColumn()));
-      sortCompareFlags_.push_back(
-          {sortedProperty.at(i)->sortOrder().isNullsFirst(),
-           sortedProperty.at(i)->sortOrder().isAscending(),
-           false,
-           CompareFlags::NullHandlingMode::NoStop});
-    }
+  VELOX_USER_CHECK(
+      sortColumnIndices_.empty(),
+      "A sorted bucket table can't be clustered: {}",
+      clusteringProperty->toString());
+  switch (clusteringProperty->kind()) {
+    case HiveClusteringProperty::Kind::kSorted:
+      setSortColumns(clusteringProperty->clusteredBy());
+      break;
+    case HiveClusteringProperty::Kind::kZOrder:
+      setZOrderColumns(clusteringProperty->clusteredBy());
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void HiveDataSink::setSortColumns(
+    const std::vector<std::shared_ptr<const HiveSortingColumn>>&
+        sortingColumns) {
+  sortColumnIndices_.reserve(sortingColumns.size());
+  sortCompareFlags_.reserve(sortingColumns.size());
+  for (const auto& column : sortingColumns) {
+    sortColumnIndices_.push_back(
+        inputType_->getChildIdx(column->sortColumn()));
+    sortCompareFlags_.push_back(
+        {column->sortOrder().isNullsFirst(),
+         column->sortOrder().isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::NoStop});
+  }
+}
+
+void HiveDataSink::setZOrderColumns(
+    const std::vector<std::shared_ptr<const HiveSortingColumn>>&
+        clusteredBy) {
+  std::vector<column_index_t> keyChannels;
+  std::vector<core::SortOrder> sortOrders;
+  for (const auto& column : clusteredBy) {
+    keyChannels.push_back(inputType_->getChildIdx(column->sortColumn()));
+    sortOrders.push_back(column->sortOrder());
   }
+  zOrderKeyGenerator_ = std::make_unique<ZOrderKeyGenerator>(
+      inputType_,
+      std::move(keyChannels),
+      std::move(sortOrders),
+      connectorQueryCtx_->memoryPool());
+  auto names = inputType_->names();
+  auto types = inputType_->children();
+  names.push_back("$z_order");
+  types.push_back(VARBINARY());
+  zOrderType_ = ROW(std::move(names), std::move(types));
+}
+
+RowVectorPtr HiveDataSink::appendZOrderKeys(const RowVectorPtr& input) {
+  auto children = input->children();
+  children.push_back(zOrderKeyGenerator_->run(input));
+  return std::make_shared<RowVector>(
+      connectorQueryCtx_->memoryPool(),
+      zOrderType_,
+      nullptr,
+      input->size(),
+      std::move(children));
 }
 
 void HiveDataSink::appendData(RowVectorPtr input) {
@@ -377,6 +486,54 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     writers_[index]->write(writerInput);
     writerInfo_[index]->numWrittenRows += partitionSize;
   }
+
+  if (numOverflowRows_ != 0) {
+    appendOverflowData(input);
+  }
+}
+
+bool HiveDataSink::isOverflowWriter(const HiveWriterId& id) const {
+  return isOverflowEnabled() && writers_.size() >= maxOpenWriters_ &&
+      writerIndexMap_.find(id) == writerIndexMap_.end();
+}
+
+std::unique_ptr<exec::SortBuffer> HiveDataSink::createOverflowBuffer() {
+  auto names = inputType_->names();
+  auto types = inputType_->children();
+  std::vector<column_index_t> sortColumnIndices;
+  std::vector<CompareFlags> sortCompareFlags;
+  sortColumnIndices.push_back(names.size());
+  names.push_back("$partition_id");
+  types.push_back(INTEGER());
+  if (isBucketed()) {
+    sortColumnIndices.push_back(names.size());
+    names.push_back("$bucket_id");
+    types.push_back(INTEGER());
+  }
+  if (zOrderKeyGenerator_ != nullptr) {
+    sortColumnIndices.push_back(names.size());
+    names.push_back("$z_order");
+    types.push_back(VARBINARY());
+  }
+  sortCompareFlags.resize(sortColumnIndices.size());
+  sortColumnIndices.insert(
+      sortColumnIndices.end(),
+      sortColumnIndices_.begin(),
+      sortColumnIndices_.end());
+  sortCompareFlags.insert(
+      sortCompareFlags.end(),
+      sortCompareFlags_.begin(),
+      sortCompareFlags_.end());
+  overflowType_ = ROW(std::move(names), std::move(types));
+  return std::make_unique<exec::SortBuffer>(
+      overflowType_,
+      sortColumnIndices,
+      sortCompareFlags,
+      1000, // todo batch size
+      connectorQueryCtx_->memoryPool(),
+      &nonReclaimableSection_,
+      &numSpillRuns_,
+      spillConfig_);
 }
 
 void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
@@ -397,6 +554,30 @@ int64_t HiveDataSink::getCompletedBytes() const {
   return completedBytes;
 }
 
+bool HiveDataSink::canReclaim() const {
+  return !isSorted();
+}
+
+uint64_t HiveDataSink::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+  if (closedOrAborted()) {
+    return 0;
+  }
+  auto* pool = connectorQueryCtx_->connectorMemoryPool();
+  const auto reservedBytes = pool->reservedBytes();
+  uint64_t numFlushedWriters{0};
+  for (const auto& writer : writers_) {
+    writer->flush();
+    ++numFlushedWriters;
+    if (targetBytes != 0 &&
+        reservedBytes - pool->reservedBytes() >=
+            static_cast<int64_t>(targetBytes)) {
+      break;
+    }
+  }
+  return numFlushedWriters;
+}
+
 std::vector<std::string> HiveDataSink::close(bool success) {
   closeInternal(!success);
   if (!success) {
@@ -454,6 +635,9 @@ void HiveDataSink::closeInternal(bool abort) {
     for (const auto& writer : writers_) {
       writer->close();
     }
+    if (overflowBuffer_ != nullptr) {
+      writeOverflowData();
+    }
   } else {
     aborted_ = true;
     for (const auto& writer : writers_) {
@@ -462,6 +646,62 @@ void HiveDataSink::closeInternal(bool abort) {
   }
 }
 
+void HiveDataSink::writeOverflowData() {
+  overflowBuffer_->noMoreInput();
+  const auto numColumns = inputType_->size();
+  std::optional<uint32_t> index;
+  HiveWriterId id;
+  while (auto sorted = overflowBuffer_->getOutput()) {
+    std::vector<VectorPtr> columns(
+        sorted->children().begin(), sorted->children().begin() + numColumns);
+    auto data = std::make_shared<RowVector>(
+        sorted->pool(), inputType_, nullptr, sorted->size(), columns);
+    vector_size_t start = 0;
+    while (start < sorted->size()) {
+      const auto startId = overflowWriterId(*sorted, start);
+      vector_size_t end = start + 1;
+      while (end < sorted->size() &&
+             overflowWriterId(*sorted, end) == startId) {
+        ++end;
+      }
+      if (!index.has_value() || !(startId == id)) {
+        if (index.has_value()) {
+          writers_[index.value()]->close();
+        }
+        id = startId;
+        index = appendWriter(id, /*overflow=*/true);
+      }
+      const vector_size_t size = end - start;
+      writers_[index.value()]->write(
+          size == data->size()
+              ? data
+              : std::static_pointer_cast<RowVector>(data->slice(start, size)));
+      writerInfo_[index.value()]->numWrittenRows += size;
+      start = end;
+    }
+  }
+  if (index.has_value()) {
+    writers_[index.value()]->close();
+  }
+  overflowBuffer_.reset();
+}
+
+HiveWriterId HiveDataSink::overflowWriterId(
+    const RowVector& sorted,
+    vector_size_t row) const {
+  const auto numColumns = inputType_->size();
+  const uint32_t partitionId =
+      sorted.childAt(numColumns)->asFlatVector<int32_t>()->valueAt(row);
+  if (!isBucketed()) {
+    return HiveWriterId{partitionId};
+  }
+  return HiveWriterId{
+      partitionId,
+      static_cast<uint32_t>(
+          sorted.childAt(numColumns + 1)->asFlatVector<int32_t>()->valueAt(
+              row))};
+}
+
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
   if (it != writerIndexMap_.end()) {
@@ -470,10 +710,12 @@ uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   return appendWriter(id);
 }
 
-uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
+uint32_t HiveDataSink::appendWriter(const HiveWriterId& id, bool overflow) {
   // Check max open writers.
-  VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  if (!overflow) {
+    VELOX_USER_CHECK_LE(
+        writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  }
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
   VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
 
@@ -506,7 +748,9 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
            .metricLogger = dwio::common::MetricsLog::voidLog(),
            .stats = ioStats_.back().get()}),
       options);
-  writer = maybeCreateBucketSortWriter(std::move(writer));
+  if (!overflow) {
+    writer = maybeCreateSortWriter(std::move(writer));
+  }
   writers_.emplace_back(std::move(writer));
   // Extends the buffer used for partition rows calculations.
   partitionSizes_.emplace_back(0);
@@ -518,11 +762,29 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
 }
 
 std::unique_ptr<facebook::velox::dwio::common::Writer>
-HiveDataSink::maybeCreateBucketSortWriter(
+HiveDataSink::maybeCreateSortWriter(
     std::unique_ptr<facebook::velox::dwio::common::Writer> writer) {
-  if (sortColumnIndices_.empty()) {
+  if (!isSorted()) {
     return writer;
   }
+  if (zOrderKeyGenerator_ != nullptr) {
+    // Sorts by the Z-order key after the input columns.
+    const column_index_t zOrderChannel = inputType_->size();
+    auto sortBuffer = std::make_unique<exec::SortBuffer>(
+        zOrderType_,
+        std::vector<column_index_t>{zOrderChannel},
+        std::vector<CompareFlags>{CompareFlags{}},
+        1000, // todo batch size
+        connectorQueryCtx_->memoryPool(),
+        &nonReclaimableSection_,
+        &numSpillRuns_,
+        spillConfig_);
+    return std::make_unique<dwio::common::SortingWriter>(
+        std::move(writer),
+        std::move(sortBuffer),
+        inputType_,
+        [this](const RowVectorPtr& input) { return appendZOrderKeys(input); });
+  }
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
       inputType_,
       sortColumnIndices_,
@@ -542,6 +804,7 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
     VELOX_CHECK_EQ(bucketIds_.size(), partitionIds_.size());
   }
   std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
+  numOverflowRows_ = 0;
 
   const auto numRows = partitionIds_.size();
   for (auto row = 0; row < numRows; ++row) {
@@ -549,6 +812,15 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
     const uint32_t partitionId = static_cast<uint32_t>(partitionIds_[row]);
     const auto id = isBucketed() ? HiveWriterId{partitionId, bucketIds_[row]}
                                  : HiveWriterId{partitionId};
+    if (FOLLY_UNLIKELY(isOverflowWriter(id))) {
+      if (overflowRows_ == nullptr ||
+          overflowRows_->capacity() < numRows * sizeof(vector_size_t)) {
+        overflowRows_ =
+            allocateIndices(numRows, connectorQueryCtx_->memoryPool());
+      }
+      overflowRows_->asMutable<vector_size_t>()[numOverflowRows_++] = row;
+      continue;
+    }
     const uint32_t index = ensureWriter(id);
     VELOX_DCHECK_LT(index, partitionSizes_.size());
     VELOX_DCHECK_EQ(partitionSizes_.size(), partitionRows_.size());
@@ -570,6 +842,44 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
       partitionRows_[i]->setSize(partitionSizes_[i] * sizeof(vector_size_t));
     }
   }
+  if (numOverflowRows_ != 0) {
+    overflowRows_->setSize(numOverflowRows_ * sizeof(vector_size_t));
+  }
+}
+
+void HiveDataSink::appendOverflowData(const RowVectorPtr& input) {
+  VELOX_CHECK(isOverflowEnabled());
+  if (overflowBuffer_ == nullptr) {
+    overflowBuffer_ = createOverflowBuffer();
+  }
+  auto* pool = connectorQueryCtx_->memoryPool();
+  const auto* rows = overflowRows_->as<vector_size_t>();
+  auto overflowInput = exec::wrap(numOverflowRows_, overflowRows_, input);
+  auto children = overflowInput->children();
+
+  auto partitionIds = BaseVector::create<FlatVector<int32_t>>(
+      INTEGER(), numOverflowRows_, pool);
+  for (vector_size_t i = 0; i < numOverflowRows_; ++i) {
+    partitionIds->set(i, static_cast<int32_t>(partitionIds_[rows[i]]));
+  }
+  children.push_back(std::move(partitionIds));
+  if (isBucketed()) {
+    auto bucketIds = BaseVector::create<FlatVector<int32_t>>(
+        INTEGER(), numOverflowRows_, pool);
+    for (vector_size_t i = 0; i < numOverflowRows_; ++i) {
+      bucketIds->set(i, bucketIds_[rows[i]]);
+    }
+    children.push_back(std::move(bucketIds));
+  }
+  if (zOrderKeyGenerator_ != nullptr) {
+    children.push_back(zOrderKeyGenerator_->run(overflowInput));
+  }
+  overflowBuffer_->addInput(std::make_shared<RowVector>(
+      pool,
+      overflowType_,
+      nullptr,
+      numOverflowRows_,
+      std::move(children)));
 }
 
 HiveWriterParameters HiveDataSink::getWriterParameters(
@@ -673,6 +983,9 @@ folly::dynamic HiveInsertTableHandle::serialize() const {
 
   obj["inputColumns"] = arr;
   obj["locationHandle"] = locationHandle_->serialize();
+  if (clusteringProperty_ != nullptr) {
+    obj["clusteringProperty"] = clusteringProperty_->serialize();
+  }
   return obj;
 }
 
@@ -682,7 +995,18 @@ HiveInsertTableHandlePtr HiveInsertTableHandle::create(
       obj["inputColumns"]);
   auto locationHandle =
       ISerializable::deserialize<LocationHandle>(obj["locationHandle"]);
-  return std::make_shared<HiveInsertTableHandle>(inputColumns, locationHandle);
+  std::shared_ptr<const HiveClusteringProperty> clusteringProperty;
+  if (obj.count("clusteringProperty")) {
+    clusteringProperty = ISerializable::deserialize<HiveClusteringProperty>(
+        obj["clusteringProperty"]);
+  }
+  return std::make_shared<HiveInsertTableHandle>(
+      inputColumns,
+      locationHandle,
+      dwio::common::FileFormat::DWRF,
+      nullptr,
+      std::nullopt,
+      clusteringProperty);
 }
 
 void HiveInsertTableHandle::registerSerDe() {
@@ -696,7 +1020,11 @@ std::string HiveInsertTableHandle::toString() const {
   for (const auto& i : inputColumns_) {
     out << " " << i->toString();
   }
-  out << " ], locationHandle: " << locationHandle_->toString() << "]";
+  out << " ], locationHandle: " << locationHandle_->toString();
+  if (clusteringProperty_ != nullptr) {
+    out << ", clusteringProperty: " << clusteringProperty_->toString();
+  }
+  out << "]";
   return out.str();
 }
 
@@ -18,9 +18,11 @@
 #include "velox/common/compression/Compression.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/PartitionIdGenerator.h"
+#include "velox/connectors/hive/ZOrderKeyGenerator.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::dwrf {
 class Writer;
@@ -181,6 +183,54 @@ FOLLY_ALWAYS_INLINE std::ostream& operator<<(
   return os;
 }
 
+/// Specifies how to order the rows of each file written. kSorted sorts the
+/// rows by the clustering columns in order. kZOrder sorts the rows by the
+/// Z-order key of the clustering columns, which interleaves their bits so
+/// that the min/max statistics of the stripes and row groups of a file are
+/// selective on each of the columns, not only on the first.
+class HiveClusteringProperty : public ISerializable {
+ public:
+  enum class Kind { kSorted, kZOrder };
+
+  HiveClusteringProperty(
+      Kind kind,
+      const std::vector<std::shared_ptr<const HiveSortingColumn>>&
+          clusteredBy);
+
+  Kind kind() const {
+    return kind_;
+  }
+
+  static std::string kindString(Kind kind);
+
+  /// Returns the clustering columns.
+  const std::vector<std::shared_ptr<const HiveSortingColumn>>& clusteredBy()
+      const {
+    return clusteredBy_;
+  }
+
+  folly::dynamic serialize() const override;
+
+  static std::shared_ptr<HiveClusteringProperty> deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+  static void registerSerDe();
+
+  std::string toString() const;
+
+ private:
+  const Kind kind_;
+  const std::vector<std::shared_ptr<const HiveSortingColumn>> clusteredBy_;
+};
+
+FOLLY_ALWAYS_INLINE std::ostream& operator<<(
+    std::ostream& os,
+    HiveClusteringProperty::Kind kind) {
+  os << HiveClusteringProperty::kindString(kind);
+  return os;
+}
+
 class HiveInsertTableHandle;
 using HiveInsertTableHandlePtr = std::shared_ptr<HiveInsertTableHandle>;
 
@@ -195,12 +245,15 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
       dwio::common::FileFormat tableStorageFormat =
           dwio::common::FileFormat::DWRF,
       std::shared_ptr<HiveBucketProperty> bucketProperty = nullptr,
-      std::optional<common::CompressionKind> compressionKind = {})
+      std::optional<common::CompressionKind> compressionKind = {},
+      std::shared_ptr<const HiveClusteringProperty> clusteringProperty =
+          nullptr)
       : inputColumns_(std::move(inputColumns)),
         locationHandle_(std::move(locationHandle)),
         tableStorageFormat_(tableStorageFormat),
         bucketProperty_(std::move(bucketProperty)),
-        compressionKind_(compressionKind) {
+        compressionKind_(compressionKind),
+        clusteringProperty_(std::move(clusteringProperty)) {
     if (compressionKind.has_value()) {
       VELOX_CHECK(
           compressionKind.value() != common::CompressionKind_MAX,
@@ -237,6 +290,12 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
 
   const HiveBucketProperty* bucketProperty() const;
 
+  /// Returns how to order the rows of each file written, or null if the rows
+  /// are written in input order.
+  const HiveClusteringProperty* clusteringProperty() const {
+    return clusteringProperty_.get();
+  }
+
   bool isInsertTable() const;
 
   folly::dynamic serialize() const override;
@@ -253,6 +312,7 @@ class HiveInsertTableHandle : public ConnectorInsertTableHandle {
   const dwio::common::FileFormat tableStorageFormat_;
   const std::shared_ptr<HiveBucketProperty> bucketProperty_;
   const std::optional<common::CompressionKind> compressionKind_;
+  const std::shared_ptr<const HiveClusteringProperty> clusteringProperty_;
 };
 
 /// Parameters for Hive writers.
@@ -402,6 +462,12 @@ class HiveDataSink : public DataSink {
 
   int64_t getCompletedBytes() const override;
 
+  /// Returns false if the written data is sorted, in which case the writers
+  /// buffer all the data until close.
+  bool canReclaim() const override;
+
+  uint64_t reclaim(uint64_t targetBytes) override;
+
   std::vector<std::string> close(bool success) override;
 
  private:
@@ -415,6 +481,12 @@ class HiveDataSink : public DataSink {
     return bucketCount_ != 0;
   }
 
+  // Returns true if the rows for the writers beyond 'maxOpenWriters_' are
+  // sorted in 'overflowBuffer_' and written on close.
+  FOLLY_ALWAYS_INLINE bool isOverflowEnabled() const {
+    return maxSortedPartitions_ != 0;
+  }
+
   FOLLY_ALWAYS_INLINE bool isCommitRequired() const {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
@@ -433,11 +505,56 @@ class HiveDataSink : public DataSink {
   uint32_t ensureWriter(const HiveWriterId& id);
 
   // Appends a new writer for the given 'id'. The function returns the index of
-  // the newly created writer in 'writers_'.
-  uint32_t appendWriter(const HiveWriterId& id);
-
-  std::unique_ptr<facebook::velox::dwio::common::Writer>
-  maybeCreateBucketSortWriter(
+  // the newly created writer in 'writers_'. An 'overflow' writer writes rows
+  // already sorted by 'overflowBuffer_' and is not subject to the open writer
+  // limit.
+  uint32_t appendWriter(const HiveWriterId& id, bool overflow = false);
+
+  // Returns true if the rows for 'id' go to 'overflowBuffer_' because there
+  // is no writer for 'id' and no more writers can be opened.
+  bool isOverflowWriter(const HiveWriterId& id) const;
+
+  // Creates the buffer that sorts the rows of the overflow writers by
+  // partition and bucket id.
+  std::unique_ptr<exec::SortBuffer> createOverflowBuffer();
+
+  // Adds the rows of 'input' in 'overflowRows_' to 'overflowBuffer_'.
+  void appendOverflowData(const RowVectorPtr& input);
+
+  // Writes the rows in 'overflowBuffer_' with one writer at a time. Each
+  // writer is closed before the next one is created.
+  void writeOverflowData();
+
+  // Returns the id of the writer for 'row' of the sorted output of
+  // 'overflowBuffer_'.
+  HiveWriterId overflowWriterId(const RowVector& sorted, vector_size_t row)
+      const;
+
+  // Sets 'sortColumnIndices_' and 'sortCompareFlags_' to sort by
+  // 'sortingColumns'.
+  void setSortColumns(
+      const std::vector<std::shared_ptr<const HiveSortingColumn>>&
+          sortingColumns);
+
+  // Sets up 'zOrderKeyGenerator_' to sort by the Z-order key of
+  // 'clusteredBy'.
+  void setZOrderColumns(
+      const std::vector<std::shared_ptr<const HiveSortingColumn>>&
+          clusteredBy);
+
+  // Returns true if the rows of each file are sorted, either by the bucket
+  // sort columns, the clustering columns or the Z-order key.
+  bool isSorted() const {
+    return !sortColumnIndices_.empty() || zOrderKeyGenerator_ != nullptr;
+  }
+
+  // Returns 'input' with the Z-order key of its rows appended as the last
+  // column.
+  RowVectorPtr appendZOrderKeys(const RowVectorPtr& input);
+
+  // Wraps 'writer' in a writer that sorts all its rows before writing them
+  // if the rows of each file are sorted.
+  std::unique_ptr<facebook::velox::dwio::common::Writer> maybeCreateSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
 
   HiveWriterParameters getWriterParameters(
@@ -477,6 +594,9 @@ class HiveDataSink : public DataSink {
   const CommitStrategy commitStrategy_;
   const std::shared_ptr<const Config> connectorProperties_;
   const uint32_t maxOpenWriters_;
+  // The maximum number of distinct (bucketed) partitions if the rows beyond
+  // 'maxOpenWriters_' go to 'overflowBuffer_'. 0 if disabled.
+  const uint32_t maxSortedPartitions_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   const int32_t bucketCount_{0};
@@ -487,6 +607,12 @@ class HiveDataSink : public DataSink {
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
 
+  // Generates the keys of the Z-order clustering columns. Null if not
+  // clustered by Z-order.
+  std::unique_ptr<ZOrderKeyGenerator> zOrderKeyGenerator_;
+  // The input type followed by the Z-order key column.
+  RowTypePtr zOrderType_;
+
   bool closed_{false};
   bool aborted_{false};
 
@@ -514,6 +640,17 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  // Sorts the rows of the writers that are not opened because of the open
+  // writer limit. The rows have the input columns followed by the partition
+  // id and the bucket id if bucketed, and the Z-order key if clustered by
+  // Z-order. They are sorted by these ids and then by the sort columns of the
+  // table or the Z-order key. Created on the first such row.
+  std::unique_ptr<exec::SortBuffer> overflowBuffer_;
+  RowTypePtr overflowType_;
+  // The input rows added to 'overflowBuffer_' for the current input.
+  BufferPtr overflowRows_;
+  vector_size_t numOverflowRows_{0};
 };
 
 } // namespace facebook::velox::connector::hive
@@ -20,7 +20,9 @@
 #include <unordered_map>
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/expression/FieldReference.h"
@@ -390,6 +392,66 @@ const std::string& getColumnName(const common::Subfield& subfield) {
   return field->name();
 }
 
+// Returns the minimum or maximum in 'stats' as a value of 'type'. Returns
+// std::nullopt if 'stats' has no exact minimum or maximum for 'type'. Only
+// integer statistics are used. String statistics may be truncated and
+// floating point statistics may leave out NaNs. Short decimals are stored as
+// integers but their statistics may be of the unscaled or the scaled values
+// depending on the writer.
+std::optional<variant> integerMinMax(
+    const dwio::common::ColumnStatistics& stats,
+    HiveStatsAggregate::Kind aggregate,
+    const TypePtr& type) {
+  if (type->isDecimal()) {
+    return std::nullopt;
+  }
+  auto* integerStats =
+      dynamic_cast<const dwio::common::IntegerColumnStatistics*>(&stats);
+  if (!integerStats) {
+    return std::nullopt;
+  }
+  auto value = aggregate == HiveStatsAggregate::Kind::kMin
+      ? integerStats->getMinimum()
+      : integerStats->getMaximum();
+  if (!value.has_value()) {
+    return std::nullopt;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      return variant(static_cast<int8_t>(value.value()));
+    case TypeKind::SMALLINT:
+      return variant(static_cast<int16_t>(value.value()));
+    case TypeKind::INTEGER:
+      return variant(static_cast<int32_t>(value.value()));
+    case TypeKind::BIGINT:
+      return variant(value.value());
+    default:
+      return std::nullopt;
+  }
+}
+
+// Sets row 0 of 'result' to the minimum or maximum of itself and the
+// non-null values in the first 'numRows' rows of 'values'.
+void updateMinMax(
+    HiveStatsAggregate::Kind aggregate,
+    const BaseVector& values,
+    vector_size_t numRows,
+    BaseVector& result) {
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (values.isNullAt(row)) {
+      continue;
+    }
+    if (!result.isNullAt(0)) {
+      const auto comparison = values.compare(&result, row, 0);
+      if (aggregate == HiveStatsAggregate::Kind::kMin ? comparison >= 0
+                                                      : comparison <= 0) {
+        continue;
+      }
+    }
+    result.copy(&values, 0, row, 1);
+  }
+}
+
 } // namespace
 
 core::TypedExprPtr HiveDataSource::extractFiltersFromRemainingFilter(
@@ -453,7 +515,9 @@ HiveDataSource::HiveDataSource(
     cache::AsyncDataCache* cache,
     const std::string& scanId,
     folly::Executor* executor,
-    const dwio::common::ReaderOptions& options)
+    const dwio::common::ReaderOptions& options,
+    std::shared_ptr<folly::Executor> decodingExecutor,
+    int32_t decodingParallelism)
     : fileHandleFactory_(fileHandleFactory),
       readerOpts_(options),
       pool_(&options.getMemoryPool()),
@@ -462,6 +526,16 @@ HiveDataSource::HiveDataSource(
       cache_(cache),
       scanId_(scanId),
       executor_(executor) {
+  auto hiveTableHandle =
+      std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
+  VELOX_CHECK(
+      hiveTableHandle != nullptr,
+      "TableHandle must be an instance of HiveTableHandle");
+  if (!hiveTableHandle->statsAggregates().empty()) {
+    setUpStatsAggregates(*hiveTableHandle);
+    return;
+  }
+
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
     auto handle = std::dynamic_pointer_cast<HiveColumnHandle>(columnHandle);
@@ -497,11 +571,6 @@ HiveDataSource::HiveDataSource(
     }
   }
 
-  auto hiveTableHandle =
-      std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
-  VELOX_CHECK(
-      hiveTableHandle != nullptr,
-      "TableHandle must be an instance of HiveTableHandle");
   if (readerOpts_.isFileColumnNamesReadAsLowerCase()) {
     checkColumnNameLowerCase(outputType_);
     checkColumnNameLowerCase(hiveTableHandle->subfieldFilters());
@@ -600,10 +669,192 @@ HiveDataSource::HiveDataSource(
   if (skipRowsIt != hiveTableHandle->tableParameters().end()) {
     rowReaderOpts_.setSkipRows(folly::to<uint64_t>(skipRowsIt->second));
   }
+  if (decodingExecutor && decodingParallelism > 1) {
+    rowReaderOpts_.setDecodingExecutor(std::move(decodingExecutor));
+    rowReaderOpts_.setDecodingParallelism(decodingParallelism);
+  }
+
+  ioStats_ = std::make_shared<dwio::common::IoStatistics>();
+}
 
+void HiveDataSource::setUpStatsAggregates(const HiveTableHandle& tableHandle) {
+  VELOX_USER_CHECK(
+      tableHandle.subfieldFilters().empty() && !tableHandle.remainingFilter(),
+      "Aggregates from statistics do not support filters: {}",
+      tableHandle.toString());
+  const auto& dataColumns = tableHandle.dataColumns();
+  VELOX_USER_CHECK_NOT_NULL(
+      dataColumns,
+      "Aggregates from statistics need the data columns: {}",
+      tableHandle.toString());
+  statsAggregates_ = tableHandle.statsAggregates();
+  VELOX_USER_CHECK_EQ(
+      statsAggregates_.size(),
+      outputType_->size(),
+      "Aggregates from statistics must match the output columns");
+  std::vector<std::string> readerRowNames;
+  std::vector<TypePtr> readerRowTypes;
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    const auto& aggregate = statsAggregates_[i];
+    TypePtr columnType;
+    column_index_t channel = 0;
+    if (aggregate.column.empty()) {
+      VELOX_USER_CHECK(
+          aggregate.kind == HiveStatsAggregate::Kind::kCount,
+          "Only count can be computed over all columns: {}",
+          aggregate.toString());
+    } else {
+      columnType = dataColumns->findChild(aggregate.column);
+      auto it = std::find(
+          readerRowNames.begin(), readerRowNames.end(), aggregate.column);
+      channel = it - readerRowNames.begin();
+      if (it == readerRowNames.end()) {
+        readerRowNames.push_back(aggregate.column);
+        readerRowTypes.push_back(columnType);
+      }
+    }
+    VELOX_USER_CHECK(
+        outputType_->childAt(i)->equivalent(*aggregate.resultType(columnType)),
+        "Unexpected output type {} for {}",
+        outputType_->childAt(i)->toString(),
+        aggregate.toString());
+    statsAggregateChannels_.push_back(channel);
+  }
+  readerOutputType_ = ROW(std::move(readerRowNames), std::move(readerRowTypes));
+  scanSpec_ = makeScanSpec(
+      readerOutputType_, {}, SubfieldFilters{}, dataColumns, pool_);
+  readerOpts_.setFileSchema(dataColumns);
+  rowReaderOpts_.setScanSpec(scanSpec_);
   ioStats_ = std::make_shared<dwio::common::IoStatistics>();
 }
 
+RowVectorPtr HiveDataSource::aggregateFromStatistics(uint64_t size) {
+  auto result = BaseVector::create<RowVector>(outputType_, 1, pool_);
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    if (statsAggregates_[i].kind == HiveStatsAggregate::Kind::kCount) {
+      result->childAt(i)->asFlatVector<int64_t>()->set(0, 0);
+    } else {
+      result->childAt(i)->setNull(0, true);
+    }
+  }
+  auto rowGroups = reader_->rowGroupStatistics(split_->start, split_->length);
+  if (!rowGroups.has_value()) {
+    // The format has no statistics per stripe or row group.
+    aggregateRows(split_->start, split_->length, size, *result);
+    ++numStatsAggregateReadRowGroups_;
+    return result;
+  }
+  for (const auto& rowGroup : rowGroups.value()) {
+    if (addStatistics(rowGroup, *result)) {
+      completedRows_ += rowGroup.numRows;
+      ++numStatsAggregatedRowGroups_;
+    } else {
+      aggregateRows(rowGroup.offset, rowGroup.length, size, *result);
+      ++numStatsAggregateReadRowGroups_;
+    }
+  }
+  return result;
+}
+
+bool HiveDataSource::addStatistics(
+    const dwio::common::RowGroupStatistics& rowGroup,
+    RowVector& result) {
+  const auto& fileType = reader_->rowType();
+  // The results for the row group are set only if all the aggregates have
+  // one. A min or max over nulls only has no result.
+  std::vector<std::optional<variant>> values(statsAggregates_.size());
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    const auto& aggregate = statsAggregates_[i];
+    const bool isCount = aggregate.kind == HiveStatsAggregate::Kind::kCount;
+    if (aggregate.column.empty()) {
+      values[i] = variant(static_cast<int64_t>(rowGroup.numRows));
+      continue;
+    }
+    auto fileIndex = fileType->getChildIdxIfExists(aggregate.column);
+    if (!fileIndex.has_value()) {
+      // The column is missing from the file and is all null.
+      if (isCount) {
+        values[i] = variant(static_cast<int64_t>(0));
+      }
+      continue;
+    }
+    const auto* stats = fileIndex.value() < rowGroup.columns.size()
+        ? rowGroup.columns[fileIndex.value()].get()
+        : nullptr;
+    if (!stats) {
+      return false;
+    }
+    const auto numValues = stats->getNumberOfValues();
+    if (isCount) {
+      if (!numValues.has_value()) {
+        return false;
+      }
+      values[i] = variant(static_cast<int64_t>(numValues.value()));
+      continue;
+    }
+    if (numValues.has_value() && numValues.value() == 0) {
+      continue;
+    }
+    values[i] =
+        integerMinMax(*stats, aggregate.kind, outputType_->childAt(i));
+    if (!values[i].has_value()) {
+      return false;
+    }
+  }
+  for (auto i = 0; i < statsAggregates_.size(); ++i) {
+    if (!values[i].has_value()) {
+      continue;
+    }
+    auto& child = result.childAt(i);
+    if (statsAggregates_[i].kind == HiveStatsAggregate::Kind::kCount) {
+      auto* counts = child->asFlatVector<int64_t>();
+      counts->set(0, counts->valueAt(0) + values[i]->value<int64_t>());
+    } else {
+      auto value = BaseVector::createConstant(
+          child->type(), values[i].value(), 1, pool_);
+      updateMinMax(statsAggregates_[i].kind, *value, 1, *child);
+    }
+  }
+  return true;
+}
+
+void HiveDataSource::aggregateRows(
+    uint64_t offset,
+    uint64_t length,
+    uint64_t size,
+    RowVector& result) {
+  auto options = rowReaderOpts_;
+  options.range(offset, length);
+  auto rowReader = createRowReader(options);
+  VectorPtr rows = BaseVector::create(readerOutputType_, 0, pool_);
+  while (auto numRows = rowReader->next(size, rows)) {
+    completedRows_ += numRows;
+    auto* rowVector = rows->as<RowVector>();
+    for (auto i = 0; i < statsAggregates_.size(); ++i) {
+      const auto& aggregate = statsAggregates_[i];
+      if (aggregate.column.empty()) {
+        auto* counts = result.childAt(i)->asFlatVector<int64_t>();
+        counts->set(0, counts->valueAt(0) + numRows);
+        continue;
+      }
+      const auto& values =
+          rowVector->childAt(statsAggregateChannels_[i])->loadedVector();
+      if (aggregate.kind == HiveStatsAggregate::Kind::kCount) {
+        int64_t numValues = 0;
+        for (vector_size_t row = 0; row < rowVector->size(); ++row) {
+          numValues += !values->isNullAt(row);
+        }
+        auto* counts = result.childAt(i)->asFlatVector<int64_t>();
+        counts->set(0, counts->valueAt(0) + numValues);
+      } else {
+        updateMinMax(
+            aggregate.kind, *values, rowVector->size(), *result.childAt(i));
+      }
+    }
+  }
+  rowReader->updateRuntimeStats(runtimeStats_);
+}
+
 inline uint8_t parseDelimiter(const std::string& delim) {
   for (char const& ch : delim) {
     if (!std::isdigit(ch)) {
@@ -676,6 +927,15 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     readerOpts_.setFileFormat(split_->fileFormat);
   }
 
+  auto* metadataCache = dwio::common::FileMetadataCache::getInstance();
+  if (metadataCache != nullptr && split_->fileModificationTime.has_value()) {
+    readerOpts_.setFileMetadataCache(metadataCache);
+    readerOpts_.setFileMetadataKey(dwio::common::FileMetadataKey{
+        fileHandle_->uuid.id(), split_->fileModificationTime.value()});
+  } else {
+    readerOpts_.setFileMetadataKey(std::nullopt);
+  }
+
   reader_ = dwio::common::getReaderFactory(readerOpts_.getFileFormat())
                 ->createReader(std::move(input), readerOpts_);
 
@@ -747,7 +1007,26 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   // NOTE: we firstly reset the finished 'rowReader_' of previous split before
   // setting up for the next one to avoid doubling the peak memory usage.
   rowReader_.reset();
+  if (!statsAggregates_.empty()) {
+    // next() reads only the stripes or row groups without usable statistics.
+    return;
+  }
   rowReader_ = createRowReader(rowReaderOpts_);
+
+  // Without filters the split is read front to back and read-ahead pays off.
+  // With filters, rows and whole row groups are skipped and the default
+  // read-ahead is kept.
+  if (!scanSpec_->hasFilter()) {
+    const auto& file = fileHandle_->file;
+    const auto end = std::min<uint64_t>(
+        file->size(), split_->start + std::min(split_->length, file->size()));
+    if (split_->start < end) {
+      file->advise(
+          split_->start,
+          end - split_->start,
+          ReadFile::AccessHint::kSequential);
+    }
+  }
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
@@ -759,6 +1038,13 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (!statsAggregates_.empty()) {
+    auto result = aggregateFromStatistics(size);
+    // The split is done after its single row of aggregates.
+    emptySplit_ = true;
+    return result;
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
@@ -839,7 +1125,29 @@ void HiveDataSource::addDynamicFilter(
 }
 
 std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
-  auto res = runtimeStats_.toMap();
+  // The reorders of the ScanSpec copies of parallel readers are in
+  // 'runtimeStats_'.
+  auto stats = runtimeStats_;
+  stats.numFilterReorders += scanSpec_->numFilterReorders();
+  auto res = stats.toMap();
+  if (remainingFilterExprSet_) {
+    res.insert(
+        {{"remainingFilterInputRows",
+          RuntimeCounter(remainingFilterInputRows_)},
+         {"remainingFilterDroppedRows",
+          RuntimeCounter(remainingFilterDroppedRows_)},
+         {"remainingFilterWallNanos",
+          RuntimeCounter(
+              remainingFilterMicros_ * 1'000,
+              RuntimeCounter::Unit::kNanos)}});
+  }
+  if (!statsAggregates_.empty()) {
+    res.insert(
+        {{"statsAggregatedRowGroups",
+          RuntimeCounter(numStatsAggregatedRowGroups_)},
+         {"statsAggregateReadRowGroups",
+          RuntimeCounter(numStatsAggregateReadRowGroups_)}});
+  }
   res.insert(
       {{"numPrefetch", RuntimeCounter(ioStats_->prefetch().count())},
        {"prefetchBytes",
@@ -867,6 +1175,20 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  if (auto numTunings = ioStats_->tunedLoadQuantum().count()) {
+    res.insert(
+        {{"tunedCoalesceDistance",
+          RuntimeCounter(
+              ioStats_->tunedCoalesceDistance().sum() / numTunings,
+              RuntimeCounter::Unit::kBytes)},
+         {"tunedLoadQuantum",
+          RuntimeCounter(
+              ioStats_->tunedLoadQuantum().sum() / numTunings,
+              RuntimeCounter::Unit::kBytes)},
+         {"tunedMaxOutstandingLoads",
+          RuntimeCounter(
+              ioStats_->tunedMaxOutstandingLoads().sum() / numTunings)}});
+  }
   return res;
 }
 
@@ -997,12 +1319,16 @@ HiveDataSource::createBufferedInput(
 }
 
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
+  MicrosecondTimer timer(&remainingFilterMicros_);
   filterRows_.resize(output_->size());
 
   expressionEvaluator_->evaluate(
       remainingFilterExprSet_.get(), filterRows_, *rowVector, filterResult_);
-  return exec::processFilterResults(
+  const auto numPassed = exec::processFilterResults(
       filterResult_, filterRows_, filterEvalCtx_, pool_);
+  remainingFilterInputRows_ += output_->size();
+  remainingFilterDroppedRows_ += output_->size() - numPassed;
+  return numPassed;
 }
 
 void HiveDataSource::setConstantValue(
@@ -40,7 +40,9 @@ class HiveDataSource : public DataSource {
       cache::AsyncDataCache* cache,
       const std::string& scanId,
       folly::Executor* executor,
-      const dwio::common::ReaderOptions& options);
+      const dwio::common::ReaderOptions& options,
+      std::shared_ptr<folly::Executor> decodingExecutor = nullptr,
+      int32_t decodingParallelism = 1);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -147,6 +149,30 @@ class HiveDataSource : public DataSource {
   void parseSerdeParameters(
       const std::unordered_map<std::string, std::string>& serdeParameters);
 
+  // Sets up the scan to return the aggregates of 'tableHandle' instead of
+  // the rows.
+  void setUpStatsAggregates(const HiveTableHandle& tableHandle);
+
+  // Returns the row of 'statsAggregates_' for the current split. Uses the
+  // statistics of the stripes or row groups where these are exact and reads
+  // the others 'size' rows at a time.
+  RowVectorPtr aggregateFromStatistics(uint64_t size);
+
+  // Adds the statistics of 'rowGroup' to the aggregates in row 0 of
+  // 'result'. Returns false and leaves 'result' unchanged if some aggregate
+  // cannot be computed from the statistics.
+  bool addStatistics(
+      const dwio::common::RowGroupStatistics& rowGroup,
+      RowVector& result);
+
+  // Reads the rows in the range of 'offset' and 'length' of the split and
+  // adds them to the aggregates in row 0 of 'result'.
+  void aggregateRows(
+      uint64_t offset,
+      uint64_t length,
+      uint64_t size,
+      RowVector& result);
+
   const RowTypePtr outputType_;
   // Column handles for the partition key columns keyed on partition key column
   // name.
@@ -166,6 +192,21 @@ class HiveDataSource : public DataSource {
   core::ExpressionEvaluator* expressionEvaluator_;
   uint64_t completedRows_ = 0;
 
+  // Rows passed to and dropped by the remaining filter and the time spent in
+  // it. Reported next to the stats of the pushed down filters.
+  uint64_t remainingFilterInputRows_{0};
+  uint64_t remainingFilterDroppedRows_{0};
+  uint64_t remainingFilterMicros_{0};
+
+  // The aggregates returned instead of the rows, empty for a regular scan.
+  std::vector<HiveStatsAggregate> statsAggregates_;
+  // Channel of the column of each of 'statsAggregates_' in
+  // 'readerOutputType_'. Unused for count(*).
+  std::vector<column_index_t> statsAggregateChannels_;
+  // Stripes or row groups aggregated from statistics and by reading rows.
+  uint64_t numStatsAggregatedRowGroups_{0};
+  uint64_t numStatsAggregateReadRowGroups_{0};
+
   // Reusable memory for remaining filter evaluation.
   VectorPtr filterResult_;
   SelectivityVector filterRows_;
@@ -28,6 +28,15 @@ columnTypeNames() {
   };
 }
 
+std::unordered_map<HiveStatsAggregate::Kind, std::string>
+statsAggregateKindNames() {
+  return {
+      {HiveStatsAggregate::Kind::kCount, "count"},
+      {HiveStatsAggregate::Kind::kMin, "min"},
+      {HiveStatsAggregate::Kind::kMax, "max"},
+  };
+}
+
 template <typename K, typename V>
 std::unordered_map<V, K> invertMap(const std::unordered_map<K, V>& mapping) {
   std::unordered_map<V, K> inverted;
@@ -102,6 +111,36 @@ void HiveColumnHandle::registerSerDe() {
   registry.Register("HiveColumnHandle", HiveColumnHandle::create);
 }
 
+// static
+std::string HiveStatsAggregate::kindName(Kind kind) {
+  static const auto names = statsAggregateKindNames();
+  return names.at(kind);
+}
+
+// static
+HiveStatsAggregate::Kind HiveStatsAggregate::kindFromName(
+    const std::string& name) {
+  static const auto kinds = invertMap(statsAggregateKindNames());
+  return kinds.at(name);
+}
+
+std::string HiveStatsAggregate::toString() const {
+  return fmt::format(
+      "{}({})", kindName(kind), column.empty() ? "*" : column.c_str());
+}
+
+folly::dynamic HiveStatsAggregate::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["kind"] = kindName(kind);
+  obj["column"] = column;
+  return obj;
+}
+
+// static
+HiveStatsAggregate HiveStatsAggregate::create(const folly::dynamic& obj) {
+  return {kindFromName(obj["kind"].asString()), obj["column"].asString()};
+}
+
 HiveTableHandle::HiveTableHandle(
     std::string connectorId,
     const std::string& tableName,
@@ -109,14 +148,16 @@ HiveTableHandle::HiveTableHandle(
     SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
     const RowTypePtr& dataColumns,
-    const std::unordered_map<std::string, std::string>& tableParameters)
+    const std::unordered_map<std::string, std::string>& tableParameters,
+    std::vector<HiveStatsAggregate> statsAggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
       dataColumns_(dataColumns),
-      tableParameters_(tableParameters) {}
+      tableParameters_(tableParameters),
+      statsAggregates_(std::move(statsAggregates)) {}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -144,6 +185,13 @@ std::string HiveTableHandle::toString() const {
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
+  if (!statsAggregates_.empty()) {
+    out << ", stats aggregates: [";
+    for (auto i = 0; i < statsAggregates_.size(); ++i) {
+      out << (i > 0 ? ", " : "") << statsAggregates_[i].toString();
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -167,6 +215,13 @@ folly::dynamic HiveTableHandle::serialize() const {
   if (dataColumns_) {
     obj["dataColumns"] = dataColumns_->serialize();
   }
+  if (!statsAggregates_.empty()) {
+    folly::dynamic statsAggregates = folly::dynamic::array;
+    for (const auto& aggregate : statsAggregates_) {
+      statsAggregates.push_back(aggregate.serialize());
+    }
+    obj["statsAggregates"] = statsAggregates;
+  }
 
   return obj;
 }
@@ -199,13 +254,22 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     dataColumns = ISerializable::deserialize<RowType>(it->second, context);
   }
 
+  std::vector<HiveStatsAggregate> statsAggregates;
+  if (auto it = obj.find("statsAggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      statsAggregates.push_back(HiveStatsAggregate::create(aggregate));
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
       filterPushdownEnabled,
       std::move(subfieldFilters),
       remainingFilter,
-      dataColumns);
+      dataColumns,
+      std::unordered_map<std::string, std::string>{},
+      std::move(statsAggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -112,8 +112,38 @@ class HiveColumnHandle : public ColumnHandle {
   const std::vector<common::Subfield> requiredSubfields_;
 };
 
+/// An aggregate over the rows of a split that the scan computes from the
+/// statistics of the file where these are exact. The scan returns one row
+/// per split with the intermediate result of each aggregate. An
+/// intermediate or final aggregation combines these.
+struct HiveStatsAggregate {
+  enum class Kind { kCount, kMin, kMax };
+
+  Kind kind;
+
+  /// The aggregated column of the table. Empty for count(*).
+  std::string column;
+
+  /// Type of the intermediate result given the type of 'column'.
+  TypePtr resultType(const TypePtr& columnType) const {
+    return kind == Kind::kCount ? BIGINT() : columnType;
+  }
+
+  std::string toString() const;
+
+  folly::dynamic serialize() const;
+
+  static HiveStatsAggregate create(const folly::dynamic& obj);
+
+  static std::string kindName(Kind kind);
+
+  static Kind kindFromName(const std::string& name);
+};
+
 class HiveTableHandle : public ConnectorTableHandle {
  public:
+  /// If 'statsAggregates' is not empty, the scan returns the results of
+  /// these instead of the rows. This requires 'dataColumns' and no filters.
   HiveTableHandle(
       std::string connectorId,
       const std::string& tableName,
@@ -121,7 +151,8 @@ class HiveTableHandle : public ConnectorTableHandle {
       SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
       const RowTypePtr& dataColumns = nullptr,
-      const std::unordered_map<std::string, std::string>& tableParameters = {});
+      const std::unordered_map<std::string, std::string>& tableParameters = {},
+      std::vector<HiveStatsAggregate> statsAggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -148,6 +179,10 @@ class HiveTableHandle : public ConnectorTableHandle {
     return tableParameters_;
   }
 
+  const std::vector<HiveStatsAggregate>& statsAggregates() const {
+    return statsAggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -165,6 +200,7 @@ class HiveTableHandle : public ConnectorTableHandle {
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
   const std::unordered_map<std::string, std::string> tableParameters_;
+  const std::vector<HiveStatsAggregate> statsAggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
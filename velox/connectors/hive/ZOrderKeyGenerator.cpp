@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/ZOrderKeyGenerator.h"
+
+#include <algorithm>
+
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::connector::hive {
+
+namespace {
+
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+// Number of top bits of the 64 bits of a value that hold its rank.
+constexpr int32_t kRankBits = 16;
+
+// Maximum number of boundaries per key column.
+constexpr size_t kMaxBoundaries = 1024;
+
+// Maximum offset of a value from the boundary below it in the bits below
+// the rank.
+constexpr uint64_t kMaxOffset = (1ULL << (64 - kRankBits)) - 1;
+
+// Maps a signed integer of 'kBits' bits to the high bits of a uint64_t that
+// compares like the integer.
+template <int kBits>
+uint64_t normalizeInteger(int64_t value) {
+  return (static_cast<uint64_t>(value) << (64 - kBits)) ^ kSignBit;
+}
+
+// Maps the bits of a floating point value to bits that compare like the
+// value. Negative values have their bits inverted, positive values have
+// their sign bit set.
+uint64_t normalizeFloatingPoint(uint64_t bits) {
+  return (bits & kSignBit) ? ~bits : bits | kSignBit;
+}
+
+uint64_t normalizeString(StringView value) {
+  uint64_t bits = 0;
+  const auto size = std::min<size_t>(value.size(), sizeof(uint64_t));
+  for (size_t i = 0; i < size; ++i) {
+    bits |= static_cast<uint64_t>(static_cast<uint8_t>(value.data()[i]))
+        << (56 - 8 * i);
+  }
+  return bits;
+}
+
+template <typename T, typename F>
+void normalizeValues(
+    const DecodedVector& decoded,
+    vector_size_t numRows,
+    int32_t stride,
+    uint64_t* bits,
+    F normalize) {
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    if (!decoded.isNullAt(row)) {
+      bits[row * stride] = normalize(decoded.valueAt<T>(row));
+    }
+  }
+}
+} // namespace
+
+ZOrderKeyGenerator::ZOrderKeyGenerator(
+    const RowTypePtr& inputType,
+    std::vector<column_index_t> keyChannels,
+    std::vector<core::SortOrder> sortOrders,
+    memory::MemoryPool* pool)
+    : keyChannels_(std::move(keyChannels)),
+      sortOrders_(std::move(sortOrders)),
+      pool_(pool) {
+  VELOX_USER_CHECK(!keyChannels_.empty(), "Z-order requires key columns");
+  VELOX_CHECK_EQ(keyChannels_.size(), sortOrders_.size());
+  for (auto channel : keyChannels_) {
+    const auto& type = inputType->childAt(channel);
+    switch (type->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+      case TypeKind::TIMESTAMP:
+        break;
+      default:
+        VELOX_USER_FAIL(
+            "Unsupported Z-order column type: {} {}",
+            inputType->nameOf(channel),
+            type->toString());
+    }
+    keyTypes_.push_back(type);
+  }
+}
+
+VectorPtr ZOrderKeyGenerator::run(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  const auto numKeys = keyChannels_.size();
+  bits_.resize(numRows * numKeys);
+  for (size_t i = 0; i < numKeys; ++i) {
+    decoded_.decode(*input->childAt(keyChannels_[i]));
+    normalize(decoded_, keyTypes_[i], sortOrders_[i], numRows, &bits_[i]);
+  }
+  if (boundaries_.empty() && numRows > 0) {
+    setBoundaries(numRows);
+  }
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    for (size_t i = 0; i < numKeys; ++i) {
+      bits_[row * numKeys + i] = rank(i, bits_[row * numKeys + i]);
+    }
+  }
+
+  auto result =
+      BaseVector::create<FlatVector<StringView>>(VARBINARY(), numRows, pool_);
+  auto buffer = AlignedBuffer::allocate<char>(numRows * keySize(), pool_);
+  auto* rawBuffer = buffer->asMutable<char>();
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    auto* key = rawBuffer + row * keySize();
+    interleave(&bits_[row * numKeys], key);
+    result->setNoCopy(row, StringView(key, keySize()));
+  }
+  result->addStringBuffer(std::move(buffer));
+  return result;
+}
+
+void ZOrderKeyGenerator::normalize(
+    const DecodedVector& decoded,
+    const TypePtr& type,
+    const core::SortOrder& sortOrder,
+    vector_size_t numRows,
+    uint64_t* bits) const {
+  const int32_t stride = keyChannels_.size();
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      normalizeValues<bool>(decoded, numRows, stride, bits, [](bool value) {
+        return value ? kSignBit : 0;
+      });
+      break;
+    case TypeKind::TINYINT:
+      normalizeValues<int8_t>(
+          decoded, numRows, stride, bits, normalizeInteger<8>);
+      break;
+    case TypeKind::SMALLINT:
+      normalizeValues<int16_t>(
+          decoded, numRows, stride, bits, normalizeInteger<16>);
+      break;
+    case TypeKind::INTEGER:
+      normalizeValues<int32_t>(
+          decoded, numRows, stride, bits, normalizeInteger<32>);
+      break;
+    case TypeKind::BIGINT:
+      normalizeValues<int64_t>(
+          decoded, numRows, stride, bits, normalizeInteger<64>);
+      break;
+    case TypeKind::REAL:
+      normalizeValues<float>(decoded, numRows, stride, bits, [](float value) {
+        uint32_t valueBits;
+        std::memcpy(&valueBits, &value, sizeof(valueBits));
+        return normalizeFloatingPoint(static_cast<uint64_t>(valueBits) << 32);
+      });
+      break;
+    case TypeKind::DOUBLE:
+      normalizeValues<double>(
+          decoded, numRows, stride, bits, [](double value) {
+            uint64_t valueBits;
+            std::memcpy(&valueBits, &value, sizeof(valueBits));
+            return normalizeFloatingPoint(valueBits);
+          });
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      normalizeValues<StringView>(
+          decoded, numRows, stride, bits, normalizeString);
+      break;
+    case TypeKind::TIMESTAMP:
+      normalizeValues<Timestamp>(
+          decoded, numRows, stride, bits, [](Timestamp value) {
+            return normalizeInteger<64>(value.getSeconds());
+          });
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+
+  const uint64_t nullBits = sortOrder.isNullsFirst() ? 0 : ~0ULL;
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    auto& value = bits[row * stride];
+    if (decoded.isNullAt(row)) {
+      value = nullBits;
+    } else if (!sortOrder.isAscending()) {
+      value = ~value;
+    }
+  }
+}
+
+void ZOrderKeyGenerator::setBoundaries(vector_size_t numRows) {
+  const auto numKeys = keyChannels_.size();
+  boundaries_.resize(numKeys);
+  std::vector<uint64_t> values(numRows);
+  for (size_t i = 0; i < numKeys; ++i) {
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      values[row] = bits_[row * numKeys + i];
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    const auto numBoundaries = std::min(values.size(), kMaxBoundaries);
+    auto& boundaries = boundaries_[i];
+    boundaries.reserve(numBoundaries);
+    for (size_t j = 0; j < numBoundaries; ++j) {
+      boundaries.push_back(values[j * values.size() / numBoundaries]);
+    }
+  }
+}
+
+uint64_t ZOrderKeyGenerator::rank(size_t keyIndex, uint64_t value) const {
+  const auto& boundaries = boundaries_[keyIndex];
+  // The rank is between 0 for values below the lowest boundary and the
+  // number of boundaries for values at or above the highest one.
+  const uint64_t valueRank =
+      std::upper_bound(boundaries.begin(), boundaries.end(), value) -
+      boundaries.begin();
+  const uint64_t scaledRank =
+      valueRank * ((1ULL << kRankBits) - 1) / boundaries.size();
+  // Values of the same rank are ordered by their offset from the boundary
+  // below them.
+  const uint64_t lowerBoundary =
+      valueRank == 0 ? 0 : boundaries[valueRank - 1];
+  const uint64_t offset = std::min(value - lowerBoundary, kMaxOffset);
+  return (scaledRank << (64 - kRankBits)) | offset;
+}
+
+void ZOrderKeyGenerator::interleave(const uint64_t* bits, char* key) const {
+  const auto numKeys = keyChannels_.size();
+  uint8_t byte = 0;
+  int32_t numBits = 0;
+  for (int32_t bit = 63; bit >= 0; --bit) {
+    for (size_t i = 0; i < numKeys; ++i) {
+      byte = (byte << 1) | ((bits[i] >> bit) & 1);
+      if (++numBits == 8) {
+        *key++ = static_cast<char>(byte);
+        byte = 0;
+        numBits = 0;
+      }
+    }
+  }
+}
+
+} // namespace facebook::velox::connector::hive
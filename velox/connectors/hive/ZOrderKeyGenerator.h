@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Generates Z-order keys, which interleave the bits of several columns, so
+/// that sorting rows by key clusters them on all the columns at once. Each
+/// value is mapped to 64 bits that compare in the sort order of its column:
+/// integers, dates, booleans and floating point values over the full range
+/// of their type, timestamps by seconds and strings by their first 8 bytes.
+/// Nulls map to the lowest or highest 64 bits.
+///
+/// The columns usually use a small part of this range, e.g. a BIGINT column
+/// of small numbers and an INTEGER column differ in different bits. So that
+/// no column dominates the key, the top 16 bits of each column hold the rank
+/// of the value among up to 1024 boundaries taken from the distinct values
+/// of the first non-empty input, scaled to the full 16 bits. The lower 48
+/// bits hold the offset of the value from the boundary below it, so that
+/// values of the same rank keep their order.
+/// The boundaries do not change afterwards, so that the keys of later inputs
+/// compare with the earlier ones. The key is the VARBINARY made of the most
+/// significant bit of each column, then the next bit of each column and so
+/// on.
+class ZOrderKeyGenerator {
+ public:
+  /// @param inputType RowType of the input.
+  /// @param keyChannels Channels of the Z-order columns in the input.
+  /// @param sortOrders Sort order of each Z-order column.
+  /// @param pool Memory pool for the keys.
+  ZOrderKeyGenerator(
+      const RowTypePtr& inputType,
+      std::vector<column_index_t> keyChannels,
+      std::vector<core::SortOrder> sortOrders,
+      memory::MemoryPool* pool);
+
+  /// Returns the keys of the rows of 'input' as a flat VARBINARY vector.
+  VectorPtr run(const RowVectorPtr& input);
+
+  /// Returns the size in bytes of a key.
+  int32_t keySize() const {
+    return keyChannels_.size() * sizeof(uint64_t);
+  }
+
+ private:
+  // Stores the 64 bits of each row of 'decoded' at 'bits' with a stride of
+  // the number of key columns.
+  void normalize(
+      const DecodedVector& decoded,
+      const TypePtr& type,
+      const core::SortOrder& sortOrder,
+      vector_size_t numRows,
+      uint64_t* bits) const;
+
+  // Sets 'boundaries_' from the 64 bit values of the first 'numRows' rows
+  // in 'bits_'.
+  void setBoundaries(vector_size_t numRows);
+
+  // Returns the 64 bit value 'value' of key column 'keyIndex' with its rank
+  // among 'boundaries_' in the top bits.
+  uint64_t rank(size_t keyIndex, uint64_t value) const;
+
+  // Writes the key made of the 64 bit values 'bits' of each key column to
+  // 'key'.
+  void interleave(const uint64_t* bits, char* key) const;
+
+  const std::vector<column_index_t> keyChannels_;
+  const std::vector<core::SortOrder> sortOrders_;
+  std::vector<TypePtr> keyTypes_;
+  memory::MemoryPool* const pool_;
+
+  DecodedVector decoded_;
+  // The 64 bit values of the rows being processed, one per key column per
+  // row.
+  std::vector<uint64_t> bits_;
+  // Sorted distinct 64 bit values of each key column. Empty until the first
+  // non-empty input.
+  std::vector<std::vector<uint64_t>> boundaries_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsWriteFile.h"
 #include "velox/core/Config.h"
@@ -23,22 +26,46 @@
 namespace facebook::velox::filesystems {
 std::string_view HdfsFileSystem::kScheme("hdfs://");
 
+using namespace connector::hive;
+
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    if (config != nullptr &&
+        HiveConfig::isHdfsShortCircuitReadEnabled(config)) {
+      const auto socketPath = HiveConfig::hdfsDomainSocketPath(config);
+      VELOX_CHECK(
+          !socketPath.empty(),
+          "{} is required for HDFS short-circuit reads",
+          HiveConfig::kHdfsDomainSocketPath);
+      // The client reads a block from the local disk when the block has a
+      // replica on this host and falls back to the DataNode otherwise.
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", socketPath.c_str());
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
         "Unable to connect to HDFS: {}, got error: {}.",
         endpoint.identity(),
         hdfsGetLastError())
+
+    const auto readThreads =
+        config != nullptr ? HiveConfig::hdfsReadThreads(config) : 0;
+    if (readThreads > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          readThreads,
+          std::make_shared<folly::NamedThreadFactory>("HdfsRead"));
+    }
   }
 
   ~Impl() {
+    // Waits for the in-flight reads before the client is disconnected.
+    readExecutor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -51,8 +78,15 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
  private:
   hdfsFS hdfsClient_;
+  // Serves HdfsReadFile::preadvAsync(). nullptr if asynchronous reads are
+  // disabled.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -76,7 +110,8 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(), path, impl_->readExecutor());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
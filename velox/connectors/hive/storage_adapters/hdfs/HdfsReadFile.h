@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
 #include "velox/common/file/File.h"
 
@@ -56,11 +57,17 @@ struct HdfsFile {
 };
 
 /**
- * Implementation of hdfs read file.
+ * Implementation of hdfs read file. Each thread reads through its own handle
+ * so that concurrent reads do not serialize on a shared file position. If
+ * 'executor' is set, preadvAsync() runs the reads on it. The executor must
+ * outlive the file.
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* executor = nullptr);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -68,6 +75,16 @@ class HdfsReadFile final : public ReadFile {
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  // Reads on the executor. The file and 'buffers' must stay live until the
+  // returned future completes.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -89,6 +106,7 @@ class HdfsReadFile final : public ReadFile {
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
+  folly::Executor* const executor_;
   folly::ThreadLocal<HdfsFile> file_;
 };
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/storage_adapters/hdfs/benchmark/HdfsReadBenchmark.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/storage_adapters/hdfs/RegisterHdfsFileSystem.h"
+#include "velox/core/Config.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+
+#include <fstream>
+
+DEFINE_bool(
+    use_minicluster,
+    false,
+    "Start a local HDFS mini cluster and generate the file at --path in it, "
+    "e.g. --path=/read_benchmark_file. Requires the hadoop executable on the "
+    "PATH");
+DEFINE_int32(
+    minicluster_file_mb,
+    512,
+    "Size of the file generated for --use_minicluster");
+DEFINE_int32(
+    hdfs_read_threads,
+    0,
+    "Value of hive.hdfs.read-threads. If non-0, also measures preadvAsync");
+DEFINE_bool(
+    hdfs_short_circuit_read,
+    false,
+    "Value of hive.hdfs.short-circuit-read-enabled");
+DEFINE_string(
+    hdfs_domain_socket_path,
+    "",
+    "Value of hive.hdfs.domain-socket-path");
+
+namespace facebook::velox {
+
+HdfsReadBenchmark::~HdfsReadBenchmark() {
+  // Closes the file before the cluster goes away.
+  readFile_.reset();
+  if (miniCluster_) {
+    miniCluster_->stop();
+  }
+}
+
+std::string HdfsReadBenchmark::setupMiniCluster() {
+  miniCluster_ = std::make_shared<filesystems::test::HdfsMiniCluster>();
+  miniCluster_->start();
+  auto tempFile = exec::test::TempFilePath::create();
+  {
+    std::ofstream out(tempFile->path, std::ios::binary);
+    std::string chunk(1 << 20, 0);
+    for (auto i = 0; i < FLAGS_minicluster_file_mb; ++i) {
+      for (auto& c : chunk) {
+        c = folly::Random::rand32(rng_);
+      }
+      out.write(chunk.data(), chunk.size());
+    }
+  }
+  miniCluster_->addFile(tempFile->path, FLAGS_path);
+  return filesystems::test::filesystemUrl + FLAGS_path;
+}
+
+void HdfsReadBenchmark::initialize() {
+  executor_ = std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_threads);
+  if (FLAGS_seed) {
+    rng_.seed(FLAGS_seed);
+  }
+  if (FLAGS_use_minicluster) {
+    FLAGS_path = setupMiniCluster();
+  }
+
+  filesystems::registerHdfsFileSystem();
+  std::unordered_map<std::string, std::string> properties = {
+      {connector::hive::HiveConfig::kHdfsReadThreads,
+       std::to_string(FLAGS_hdfs_read_threads)},
+      {connector::hive::HiveConfig::kHdfsShortCircuitReadEnabled,
+       FLAGS_hdfs_short_circuit_read ? "true" : "false"},
+      {connector::hive::HiveConfig::kHdfsDomainSocketPath,
+       FLAGS_hdfs_domain_socket_path}};
+  auto config = std::make_shared<const core::MemConfig>(std::move(properties));
+  auto hdfs = filesystems::getFileSystem(FLAGS_path, config);
+  readFile_ = hdfs->openFileForRead(FLAGS_path);
+
+  fileSize_ = readFile_->size();
+  if (FLAGS_file_size_gb) {
+    fileSize_ = std::min<uint64_t>(FLAGS_file_size_gb << 30, fileSize_);
+  }
+
+  if (fileSize_ <= FLAGS_measurement_size) {
+    LOG(ERROR) << "File size " << fileSize_
+               << " is <= then --measurement_size " << FLAGS_measurement_size;
+    exit(1);
+  }
+}
+
+} // namespace facebook::velox
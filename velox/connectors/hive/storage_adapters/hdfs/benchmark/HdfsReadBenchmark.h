@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/file/benchmark/ReadBenchmark.h"
+#include "velox/connectors/hive/storage_adapters/hdfs/tests/HdfsMiniCluster.h"
+
+DECLARE_bool(use_minicluster);
+DECLARE_int32(minicluster_file_mb);
+DECLARE_int32(hdfs_read_threads);
+DECLARE_bool(hdfs_short_circuit_read);
+DECLARE_string(hdfs_domain_socket_path);
+
+namespace facebook::velox {
+
+class HdfsReadBenchmark : public ReadBenchmark {
+ public:
+  ~HdfsReadBenchmark() override;
+
+  // Initializes a HdfsReadFile for --path. With --use_minicluster, first
+  // starts a local mini cluster and generates a file of
+  // --minicluster_file_mb at --path in it.
+  void initialize() override;
+
+ private:
+  // Writes a file of random data and copies it to --path in the mini
+  // cluster. Returns the full hdfs path of the copy.
+  std::string setupMiniCluster();
+
+  std::shared_ptr<filesystems::test::HdfsMiniCluster> miniCluster_;
+};
+
+} // namespace facebook::velox
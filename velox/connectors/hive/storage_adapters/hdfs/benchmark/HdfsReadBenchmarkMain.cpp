@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/storage_adapters/hdfs/benchmark/HdfsReadBenchmark.h"
+
+using namespace facebook::velox;
+
+// This benchmark measures the throughput of the HDFS FileSystem for various
+// ReadFile APIs, including preadvAsync() when --hdfs_read_threads is set.
+// Run with --use_minicluster to read from a local mini cluster, e.g.
+// --use_minicluster --path=/read_benchmark_file --hdfs_read_threads=8
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, false);
+  HdfsReadBenchmark bm;
+  bm.initialize();
+  bm.run();
+}
@@ -15,6 +15,7 @@
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
 #include <boost/format.hpp>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gmock/gmock-matchers.h>
 #include <hdfs/hdfs.h>
 #include <atomic>
@@ -22,6 +23,7 @@
 #include "HdfsMiniCluster.h"
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsReadFile.h"
 #include "velox/connectors/hive/storage_adapters/hdfs/RegisterHdfsFileSystem.h"
 #include "velox/core/QueryConfig.h"
@@ -56,13 +58,34 @@ class HdfsFileSystemTest : public testing::Test {
     }
   }
 
+  void TearDown() override {
+    for (auto hdfs : connections_) {
+      hdfsDisconnect(hdfs);
+    }
+    connections_.clear();
+  }
+
   static void TearDownTestSuite() {
     miniCluster->stop();
   }
   static std::atomic<bool> startThreads;
   static std::shared_ptr<filesystems::test::HdfsMiniCluster> miniCluster;
 
+ protected:
+  // Connects to the mini cluster. The connection is released in TearDown().
+  hdfsFS connect() {
+    struct hdfsBuilder* builder = hdfsNewBuilder();
+    hdfsBuilderSetNameNode(builder, localhost.c_str());
+    hdfsBuilderSetNameNodePort(builder, 7878);
+    auto hdfs = hdfsBuilderConnect(builder);
+    VELOX_CHECK_NOT_NULL(hdfs);
+    connections_.push_back(hdfs);
+    return hdfs;
+  }
+
  private:
+  std::vector<hdfsFS> connections_;
+
   static std::shared_ptr<::exec::test::TempFilePath> createFile() {
     auto tempFile = ::exec::test::TempFilePath::create();
     tempFile->append("aaaaa");
@@ -177,6 +200,66 @@ TEST_F(HdfsFileSystemTest, read) {
   readData(&readFile);
 }
 
+TEST_F(HdfsFileSystemTest, preadvAsync) {
+  auto hdfs = connect();
+  HdfsReadFile syncFile(hdfs, destinationPath);
+  ASSERT_FALSE(syncFile.hasPreadvAsync());
+
+  folly::CPUThreadPoolExecutor executor(4);
+  HdfsReadFile readFile(hdfs, destinationPath, &executor);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+
+  // Issues several reads before waiting for any of them.
+  std::vector<std::string> buffers(8, std::string(10, 0));
+  std::vector<folly::SemiFuture<uint64_t>> futures;
+  for (auto i = 0; i < buffers.size(); ++i) {
+    // 5 bytes of 'a', a 5 byte gap, then 5 bytes of 'c'.
+    std::vector<folly::Range<char*>> ranges = {
+        folly::Range<char*>(buffers[i].data(), 5),
+        folly::Range<char*>(nullptr, 5),
+        folly::Range<char*>(buffers[i].data() + 5, 5)};
+    futures.push_back(readFile.preadvAsync(0, ranges));
+  }
+  for (auto i = 0; i < buffers.size(); ++i) {
+    ASSERT_EQ(std::move(futures[i]).get(), 15);
+    ASSERT_EQ(buffers[i], "aaaaaccccc");
+  }
+}
+
+TEST_F(HdfsFileSystemTest, preadvAsyncViaFileSystem) {
+  auto config = configurationValues;
+  config[connector::hive::HiveConfig::kHdfsReadThreads] = "4";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  // Not cached by the file system registry so that the read threads apply.
+  filesystems::HdfsFileSystem hdfsFileSystem(
+      memConfig,
+      filesystems::HdfsFileSystem::getServiceEndpoint(
+          fullDestinationPath, memConfig.get()));
+  auto readFile = hdfsFileSystem.openFileForRead(fullDestinationPath);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  std::string buffer(10, 0);
+  ASSERT_EQ(
+      readFile
+          ->preadvAsync(
+              kOneMB + 5, {folly::Range<char*>(buffer.data(), buffer.size())})
+          .get(),
+      10);
+  ASSERT_EQ(buffer, "cccccddddd");
+}
+
+TEST_F(HdfsFileSystemTest, shortCircuitReadRequiresSocketPath) {
+  auto config = configurationValues;
+  config[connector::hive::HiveConfig::kHdfsShortCircuitReadEnabled] = "true";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  VELOX_ASSERT_THROW(
+      std::make_shared<filesystems::HdfsFileSystem>(
+          memConfig,
+          filesystems::HdfsFileSystem::getServiceEndpoint(
+              fullDestinationPath, memConfig.get())),
+      "hive.hdfs.domain-socket-path is required for HDFS short-circuit reads");
+}
+
 TEST_F(HdfsFileSystemTest, viaFileSystem) {
   auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
   auto hdfsFileSystem =
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/storage_adapters/s3fs/ParallelRangeReader.h"
+
+#include <folly/futures/Future.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::filesystems {
+
+int32_t LatencyTracker::bucketIndex(uint64_t bytes) {
+  int32_t index = 0;
+  for (auto limit = kMinBucketBytes; bytes >= limit && index < kNumBuckets - 1;
+       limit *= 4) {
+    ++index;
+  }
+  return index;
+}
+
+void LatencyTracker::record(uint64_t micros, uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& bucket = buckets_[bucketIndex(bytes)];
+  if (bucket.samples.size() < kCapacity) {
+    bucket.samples.push_back({micros, bytes});
+  } else {
+    bucket.samples[bucket.numSamples % kCapacity] = {micros, bytes};
+  }
+  ++bucket.numSamples;
+  ++numSamples_;
+}
+
+std::optional<uint64_t> LatencyTracker::percentile(
+    double percentile,
+    int32_t minSamples,
+    uint64_t bytes) const {
+  std::vector<Sample> samples;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto& bucket = buckets_[bucketIndex(bytes)];
+    if (bucket.samples.size() < std::max<size_t>(minSamples, 1)) {
+      return std::nullopt;
+    }
+    samples = bucket.samples;
+  }
+  const double scaledBytes = std::max(bytes, kMinBucketBytes);
+  std::vector<uint64_t> latencies;
+  latencies.reserve(samples.size());
+  for (const auto& sample : samples) {
+    latencies.push_back(
+        sample.micros * scaledBytes / std::max(sample.bytes, kMinBucketBytes));
+  }
+  const auto index = std::min<size_t>(
+      latencies.size() - 1, latencies.size() * percentile / 100);
+  std::nth_element(
+      latencies.begin(), latencies.begin() + index, latencies.end());
+  return latencies[index];
+}
+
+namespace {
+// A range of the file that is copied to the caller's memory.
+struct Segment {
+  uint64_t offset;
+  char* data;
+  uint64_t size;
+};
+
+// A range of the file read with one request, possibly twice if hedged.
+struct Part {
+  uint64_t offset;
+  uint64_t length;
+  std::vector<Segment> segments;
+
+  // Serializes writes to the caller's memory. Once 'done' is set, no
+  // attempt writes to the caller's memory.
+  std::mutex mutex;
+
+  // Set under 'mutex' by the first attempt to succeed or by the last attempt
+  // to fail.
+  std::atomic<bool> done{false};
+
+  // Number of attempts that have not failed.
+  std::atomic<int32_t> numPending{0};
+
+  folly::Promise<folly::Unit> promise;
+};
+
+// Splits the data ranges of 'buffers' starting at 'offset' into parts of at
+// most 'partSize' bytes. Gaps at the start and end of a part are not read.
+std::vector<std::shared_ptr<Part>> makeParts(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t partSize) {
+  std::vector<Segment> segments;
+  uint64_t end = offset;
+  for (const auto& range : buffers) {
+    if (range.data() && range.size() > 0) {
+      segments.push_back({end, range.data(), range.size()});
+    }
+    end += range.size();
+  }
+
+  std::vector<std::shared_ptr<Part>> parts;
+  size_t first = 0;
+  for (auto partStart = offset; partStart < end && first < segments.size();
+       partStart += partSize) {
+    const auto partEnd = std::min(end, partStart + partSize);
+    std::shared_ptr<Part> part;
+    for (auto i = first; i < segments.size(); ++i) {
+      const auto& segment = segments[i];
+      if (segment.offset >= partEnd) {
+        break;
+      }
+      const auto start = std::max(segment.offset, partStart);
+      const auto stop = std::min(segment.offset + segment.size, partEnd);
+      if (start >= stop) {
+        continue;
+      }
+      if (!part) {
+        part = std::make_shared<Part>();
+        part->offset = start;
+      }
+      part->segments.push_back(
+          {start, segment.data + (start - segment.offset), stop - start});
+      part->length = stop - part->offset;
+    }
+    if (part) {
+      parts.push_back(std::move(part));
+    }
+    while (first < segments.size() &&
+           segments[first].offset + segments[first].size <= partEnd) {
+      ++first;
+    }
+  }
+  return parts;
+}
+} // namespace
+
+ParallelRangeReader::ParallelRangeReader(
+    ReadRange readRange,
+    folly::Executor* executor,
+    ParallelReadOptions options,
+    std::shared_ptr<LatencyTracker> latencies)
+    : state_(std::make_shared<State>()) {
+  VELOX_CHECK_NOT_NULL(executor);
+  VELOX_CHECK_GT(options.partSize, 0);
+  state_->readRange = std::make_shared<const ReadRange>(std::move(readRange));
+  state_->executor = executor;
+  state_->options = options;
+  state_->latencies =
+      latencies ? std::move(latencies) : std::make_shared<LatencyTracker>();
+}
+
+namespace {
+// Copies 'size' bytes of 'data' at 'position' from the start of 'part' to the
+// segments of 'part'. Bytes in the gaps between segments are dropped.
+void copyToSegments(
+    Part& part,
+    uint64_t position,
+    const char* data,
+    uint64_t size) {
+  const auto begin = part.offset + position;
+  const auto end = begin + size;
+  for (const auto& segment : part.segments) {
+    const auto start = std::max(begin, segment.offset);
+    const auto stop = std::min(end, segment.offset + segment.size);
+    if (start < stop) {
+      std::memcpy(
+          segment.data + (start - segment.offset),
+          data + (start - begin),
+          stop - start);
+    }
+  }
+}
+
+// Writes the first attempt to read 'part' straight to the caller's memory.
+// Drops the bytes that arrive after a hedged attempt completed the part.
+class DirectSink : public RangeSink {
+ public:
+  explicit DirectSink(Part& part) : part_(part) {}
+
+  void write(uint64_t offset, const char* data, uint64_t size) override {
+    VELOX_CHECK_LE(offset + size, part_.length, "Write past end of part");
+    std::lock_guard<std::mutex> l(part_.mutex);
+    if (!part_.done) {
+      copyToSegments(part_, offset, data, size);
+    }
+  }
+
+ private:
+  Part& part_;
+};
+
+// Collects a hedged attempt in its own memory, since the first attempt may
+// still be writing to the caller's memory.
+class BufferSink : public RangeSink {
+ public:
+  explicit BufferSink(uint64_t size) : data_(new char[size]), size_(size) {}
+
+  void write(uint64_t offset, const char* data, uint64_t size) override {
+    VELOX_CHECK_LE(offset + size, size_, "Write past end of part");
+    std::memcpy(data_.get() + offset, data, size);
+  }
+
+  const char* data() const {
+    return data_.get();
+  }
+
+ private:
+  std::unique_ptr<char[]> data_;
+  const uint64_t size_;
+};
+
+// Completes 'part' unless another attempt did. 'hedgedData' is the data read
+// by a hedged attempt or nullptr if the attempt wrote to the caller's memory.
+void completePart(Part& part, const char* hedgedData) {
+  {
+    std::lock_guard<std::mutex> l(part.mutex);
+    if (part.done) {
+      return;
+    }
+    if (hedgedData) {
+      copyToSegments(part, 0, hedgedData, part.length);
+    }
+    part.done = true;
+  }
+  part.promise.setValue();
+}
+
+void startRead(
+    const std::shared_ptr<const ParallelRangeReader::ReadRange>& readRange,
+    const folly::Executor::KeepAlive<>& executor,
+    const std::shared_ptr<LatencyTracker>& latencies,
+    const std::shared_ptr<Part>& part,
+    bool hedged) {
+  ++part->numPending;
+  executor->add([readRange,
+                 latencies,
+                 part,
+                 hedged,
+                 keepAlive = executor.copy()]() {
+    try {
+      auto read = [&](auto& sink) {
+        uint64_t usec = 0;
+        {
+          MicrosecondTimer timer(&usec);
+          (*readRange)(part->offset, part->length, sink);
+        }
+        latencies->record(usec, part->length);
+      };
+      if (hedged) {
+        BufferSink sink(part->length);
+        read(sink);
+        completePart(*part, sink.data());
+      } else {
+        DirectSink sink(*part);
+        read(sink);
+        completePart(*part, nullptr);
+      }
+    } catch (const std::exception&) {
+      if (--part->numPending > 0) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> l(part->mutex);
+        if (part->done) {
+          return;
+        }
+        part->done = true;
+      }
+      part->promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+    }
+  });
+}
+} // namespace
+
+folly::SemiFuture<uint64_t> ParallelRangeReader::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  auto parts = makeParts(offset, buffers, state_->options.partSize);
+  if (parts.empty()) {
+    return folly::makeSemiFuture<uint64_t>(length);
+  }
+
+  // Keeps the executor alive for the attempts and pending hedges, which may
+  // outlive 'this'.
+  auto executor = folly::getKeepAliveToken(state_->executor);
+  const bool hedge = state_->options.hedgePercentile > 0;
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(parts.size());
+  for (auto& part : parts) {
+    futures.push_back(part->promise.getSemiFuture());
+    ++state_->numPartReads;
+    startRead(state_->readRange, executor, state_->latencies, part, false);
+    if (!hedge) {
+      continue;
+    }
+    const auto hedgeMicros = state_->latencies->percentile(
+        state_->options.hedgePercentile,
+        state_->options.minHedgeSamples,
+        part->length);
+    if (!hedgeMicros.has_value()) {
+      continue;
+    }
+    folly::futures::sleep(std::chrono::microseconds(hedgeMicros.value()))
+        .via(executor.copy())
+        .thenValue([state = state_, executor = executor.copy(), part](
+                       auto&& /*unused*/) {
+          if (part->done) {
+            return;
+          }
+          ++state->numHedgedReads;
+          startRead(state->readRange, executor, state->latencies, part, true);
+        });
+  }
+  // Waits for all parts even if one fails, so that no first attempt writes
+  // to the caller's memory after the returned future is complete.
+  return folly::collectAll(std::move(futures))
+      .deferValue([length](std::vector<folly::Try<folly::Unit>>&& results) {
+        for (auto& result : results) {
+          result.throwUnlessValue();
+        }
+        return length;
+      });
+}
+
+} // namespace facebook::velox::filesystems
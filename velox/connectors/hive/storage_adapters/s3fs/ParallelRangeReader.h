@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Parallel and hedged reading of byte ranges from object storage. Object
+// stores serve a single GET at a fraction of the available bandwidth and have
+// a long latency tail. Splitting a read into concurrent range GETs raises
+// throughput and issuing a duplicate GET for a straggler cuts the tail.
+
+#pragma once
+
+#include <folly/Executor.h>
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace facebook::velox::filesystems {
+
+/// Keeps the latencies of the most recent reads for computing percentiles.
+/// Latencies are kept per size class, so that the delay before hedging a
+/// read depends on reads of a similar size. Thread-safe.
+class LatencyTracker {
+ public:
+  /// Number of latencies kept per size class.
+  static constexpr int32_t kCapacity = 1024;
+
+  /// Reads of up to this many bytes take about the same time. Size classes
+  /// start at this size and grow by a factor of 4.
+  static constexpr uint64_t kMinBucketBytes = 64 << 10;
+
+  static constexpr int32_t kNumBuckets = 8;
+
+  /// Records that a read of 'bytes' took 'micros'.
+  void record(uint64_t micros, uint64_t bytes);
+
+  /// Returns the 'percentile' (0-100) of the expected latency of a read of
+  /// 'bytes' or std::nullopt if fewer than 'minSamples' latencies are
+  /// recorded for reads of that size class. Each recorded latency is scaled
+  /// by the ratio of 'bytes' to its read size, treating reads smaller than
+  /// kMinBucketBytes as kMinBucketBytes.
+  std::optional<uint64_t>
+  percentile(double percentile, int32_t minSamples, uint64_t bytes) const;
+
+  /// Total number of recorded latencies over all size classes.
+  int64_t numSamples() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numSamples_;
+  }
+
+ private:
+  struct Sample {
+    uint64_t micros;
+    uint64_t bytes;
+  };
+
+  struct Bucket {
+    // Ring buffer of up to kCapacity samples.
+    std::vector<Sample> samples;
+    // Number of samples recorded in 'this'. The next one goes to
+    // 'samples[numSamples % kCapacity]'.
+    int64_t numSamples{0};
+  };
+
+  static int32_t bucketIndex(uint64_t bytes);
+
+  mutable std::mutex mutex_;
+  std::array<Bucket, kNumBuckets> buckets_;
+  int64_t numSamples_{0};
+};
+
+/// Destination of one attempt to read a range.
+class RangeSink {
+ public:
+  virtual ~RangeSink() = default;
+
+  /// Writes 'size' bytes at 'offset' from the start of the range. A retried
+  /// request may write the same bytes again.
+  virtual void write(uint64_t offset, const char* data, uint64_t size) = 0;
+};
+
+struct ParallelReadOptions {
+  /// Maximum size of a single range read. Larger reads are split.
+  uint64_t partSize{8 << 20};
+
+  /// Percentile of the recent latencies of reads of a similar size, scaled to
+  /// the part's length, after which a part is read again in parallel with the
+  /// first attempt. 0 disables hedging.
+  double hedgePercentile{0};
+
+  /// Number of latencies to observe in a size class before parts of that
+  /// size are hedged.
+  int32_t minHedgeSamples{32};
+};
+
+/// Implements ReadFile::preadvAsync() on top of a synchronous range read.
+/// The file range covered by the buffers is split into parts of at most
+/// 'partSize' bytes. Parts that consist only of skipped bytes are not read.
+/// Parts are read concurrently on 'executor'. The first attempt to read a part
+/// writes directly into the destination. A hedged attempt reads into its own
+/// buffer, which is copied to the destination if the hedged attempt finishes
+/// first. The first attempt then stops writing to the destination.
+class ParallelRangeReader {
+ public:
+  /// Reads 'length' bytes at 'offset' and writes them to 'sink'. Throws on
+  /// error. Must be thread-safe and must not depend on the lifetime of the
+  /// ReadFile since a losing attempt may still be running after the read
+  /// completed.
+  using ReadRange =
+      std::function<void(uint64_t offset, uint64_t length, RangeSink& sink)>;
+
+  /// 'executor' must outlive 'this'. In-flight attempts and pending hedges
+  /// hold keep-alive tokens of 'executor', so that an executor that joins on
+  /// destruction waits for them.
+  ParallelRangeReader(
+      ReadRange readRange,
+      folly::Executor* executor,
+      ParallelReadOptions options,
+      std::shared_ptr<LatencyTracker> latencies);
+
+  /// Same contract as ReadFile::preadvAsync(). The memory referenced by
+  /// 'buffers' must stay valid until the returned future is complete. The
+  /// future completes after all parts, also if one of them fails.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const;
+
+  /// Number of parts that were read a second time because the first attempt
+  /// exceeded the hedge latency.
+  int64_t numHedgedReads() const {
+    return state_->numHedgedReads;
+  }
+
+  /// Number of parts read, not counting hedged attempts.
+  int64_t numPartReads() const {
+    return state_->numPartReads;
+  }
+
+ private:
+  // Shared with the in-flight attempts, which may outlive 'this'.
+  struct State {
+    std::shared_ptr<const ReadRange> readRange;
+    // Not owned. See the constructor.
+    folly::Executor* executor;
+    ParallelReadOptions options;
+    std::shared_ptr<LatencyTracker> latencies;
+    std::atomic<int64_t> numHedgedReads{0};
+    std::atomic<int64_t> numPartReads{0};
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+} // namespace facebook::velox::filesystems
@@ -17,12 +17,15 @@
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/HiveConfig.h"
+#include "velox/connectors/hive/storage_adapters/s3fs/ParallelRangeReader.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -69,12 +72,102 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// An output stream that passes the bytes of a response to a RangeSink as they
+// arrive. Like StringViewStream, takes at most 'length' bytes.
+class RangeSinkStream : std::streambuf, public std::iostream {
+ public:
+  RangeSinkStream(filesystems::RangeSink& sink, uint64_t length)
+      : std::iostream(this), sink_(sink), length_(length) {}
+
+ protected:
+  std::streamsize xsputn(const char* data, std::streamsize size) override {
+    const auto accepted =
+        std::min<std::streamsize>(size, length_ - position_);
+    sink_.write(position_, data, accepted);
+    position_ += accepted;
+    return accepted;
+  }
+
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    const char value = traits_type::to_char_type(c);
+    return xsputn(&value, 1) == 1 ? c : traits_type::eof();
+  }
+
+ private:
+  filesystems::RangeSink& sink_;
+  const uint64_t length_;
+  uint64_t position_{0};
+};
+
+// Reads 'length' bytes at 'offset' of 'bucket'/'key' into the streams made by
+// 'streamFactory'.
+void getObjectRange(
+    Aws::S3::S3Client* client,
+    const std::string& bucket,
+    const std::string& key,
+    uint64_t offset,
+    uint64_t length,
+    const Aws::IOStreamFactory& streamFactory) {
+  Aws::S3::Model::GetObjectRequest request;
+  request.SetBucket(awsString(bucket));
+  request.SetKey(awsString(key));
+  std::stringstream ss;
+  ss << "bytes=" << offset << "-" << offset + length - 1;
+  request.SetRange(awsString(ss.str()));
+  request.SetResponseStreamFactory(streamFactory);
+  auto outcome = client->GetObject(request);
+  VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket, key);
+}
+
+// Reads 'length' bytes at 'offset' of 'bucket'/'key' into 'position', which
+// has space for at least 'length' bytes.
+void getObjectRange(
+    Aws::S3::S3Client* client,
+    const std::string& bucket,
+    const std::string& key,
+    uint64_t offset,
+    uint64_t length,
+    char* position) {
+  getObjectRange(
+      client,
+      bucket,
+      key,
+      offset,
+      length,
+      AwsWriteableStreamFactory(position, length));
+}
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
+  // If 'executor' is set, preadv() and preadvAsync() read in parallel range
+  // GETs of at most 'readOptions.partSize' bytes on 'executor'.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      const filesystems::ParallelReadOptions& readOptions = {},
+      std::shared_ptr<filesystems::LatencyTracker> latencies = nullptr)
       : client_(client) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
+    if (executor) {
+      parallelReader_ = std::make_unique<filesystems::ParallelRangeReader>(
+          [client, bucket = bucket_, key = key_](
+              uint64_t offset,
+              uint64_t length,
+              filesystems::RangeSink& sink) {
+            getObjectRange(
+                client, bucket, key, offset, length, [&sink, length]() {
+                  return Aws::New<RangeSinkStream>("", sink, length);
+                });
+          },
+          executor,
+          readOptions,
+          std::move(latencies));
+    }
   }
 
   // Gets the length of the file.
@@ -112,6 +205,9 @@ class S3ReadFile final : public ReadFile {
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const override {
+    if (parallelReader_) {
+      return parallelReader_->preadvAsync(offset, buffers).get();
+    }
     // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. AWS S3 GetObject does not support
@@ -135,6 +231,19 @@ class S3ReadFile final : public ReadFile {
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (!parallelReader_) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    return parallelReader_->preadvAsync(offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return parallelReader_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -161,25 +270,15 @@ class S3ReadFile final : public ReadFile {
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
-
-    request.SetBucket(awsString(bucket_));
-    request.SetKey(awsString(key_));
-    std::stringstream ss;
-    ss << "bytes=" << offset << "-" << offset + length - 1;
-    request.SetRange(awsString(ss.str()));
-    request.SetResponseStreamFactory(
-        AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
-    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    getObjectRange(client_, bucket_, key_, offset, length, position);
   }
 
   Aws::S3::S3Client* client_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
+  // Set if reads are split into parallel range GETs.
+  std::unique_ptr<filesystems::ParallelRangeReader> parallelReader_;
 };
 
 Aws::Utils::Logging::LogLevel inferS3LogLevel(std::string level) {
@@ -524,10 +623,24 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         HiveConfig::s3UseVirtualAddressing(config_));
+
+    const auto readThreads = HiveConfig::s3ReadThreads(config_);
+    if (readThreads > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          readThreads,
+          std::make_shared<folly::NamedThreadFactory>("S3Read"));
+      readOptions_.partSize = HiveConfig::s3ReadPartSize(config_);
+      readOptions_.hedgePercentile = HiveConfig::s3HedgeReadPercentile(config_);
+      readLatencies_ = std::make_shared<LatencyTracker>();
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    // Waits for the in-flight reads, including losing attempts and pending
+    // hedges, which hold keep-alive tokens of the executor, before the client
+    // goes away.
+    readExecutor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -606,9 +719,26 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Executor for parallel range GETs or nullptr if reads are synchronous.
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
+  const ParallelReadOptions& readOptions() const {
+    return readOptions_;
+  }
+
+  const std::shared_ptr<LatencyTracker>& readLatencies() const {
+    return readLatencies_;
+  }
+
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  ParallelReadOptions readOptions_;
+  // Latencies of range GETs of all files of 'this'. Used for hedging.
+  std::shared_ptr<LatencyTracker> readLatencies_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -624,7 +754,12 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      impl_->readExecutor(),
+      impl_->readOptions(),
+      impl_->readLatencies());
   s3file->initialize();
   return s3file;
 }
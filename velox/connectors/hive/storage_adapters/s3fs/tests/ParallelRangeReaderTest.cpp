@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/storage_adapters/s3fs/ParallelRangeReader.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/time/Timer.h"
+
+#include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::velox;
+using namespace facebook::velox::filesystems;
+
+namespace {
+
+// Stand-in for an object store. Serves ranges of 'data_' and counts requests.
+// Requests for ranges that start at 'slowOffset_' stall on their first
+// attempt.
+class FakeObjectStore {
+ public:
+  explicit FakeObjectStore(size_t size) : data_(size, 0) {
+    for (auto i = 0; i < size; ++i) {
+      data_[i] = 'a' + i % 26;
+    }
+  }
+
+  ParallelRangeReader::ReadRange reader() {
+    return [this](uint64_t offset, uint64_t length, RangeSink& sink) {
+      VELOX_CHECK_LE(offset + length, data_.size());
+      ++numRequests_;
+      if (offset == failOffset_) {
+        VELOX_FAIL("Injected failure at {}", offset);
+      }
+      if (offset == slowOffset_ && !slowServed_.exchange(true)) {
+        /* sleep override */
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      }
+      ranges_.withWLock([&](auto& ranges) {
+        ranges.emplace_back(offset, length);
+      });
+      sink.write(0, data_.data() + offset, length);
+    };
+  }
+
+  const std::string& data() const {
+    return data_;
+  }
+
+  int32_t numRequests() const {
+    return numRequests_;
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> ranges() const {
+    auto ranges = ranges_.copy();
+    std::sort(ranges.begin(), ranges.end());
+    return ranges;
+  }
+
+  void setSlowOffset(uint64_t offset) {
+    slowOffset_ = offset;
+  }
+
+  void setFailOffset(uint64_t offset) {
+    failOffset_ = offset;
+  }
+
+ private:
+  std::string data_;
+  std::atomic<int32_t> numRequests_{0};
+  folly::Synchronized<std::vector<std::pair<uint64_t, uint64_t>>> ranges_;
+  uint64_t slowOffset_{std::numeric_limits<uint64_t>::max()};
+  std::atomic<bool> slowServed_{false};
+  uint64_t failOffset_{std::numeric_limits<uint64_t>::max()};
+};
+
+class ParallelRangeReaderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(8);
+  }
+
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+};
+
+TEST_F(ParallelRangeReaderTest, splitsIntoParts) {
+  FakeObjectStore store(1000);
+  ParallelReadOptions options;
+  options.partSize = 100;
+  ParallelRangeReader reader(
+      store.reader(), executor_.get(), options, nullptr);
+
+  // 10 bytes, 300 byte gap, 250 bytes, 20 byte gap, 20 bytes.
+  std::string first(10, 0);
+  std::string second(250, 0);
+  std::string third(20, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(first.data(), first.size()),
+      folly::Range<char*>(nullptr, 300),
+      folly::Range<char*>(second.data(), second.size()),
+      folly::Range<char*>(nullptr, 20),
+      folly::Range<char*>(third.data(), third.size())};
+  EXPECT_EQ(600, reader.preadvAsync(5, buffers).get());
+  EXPECT_EQ(store.data().substr(5, 10), first);
+  EXPECT_EQ(store.data().substr(315, 250), second);
+  EXPECT_EQ(store.data().substr(585, 20), third);
+
+  // The parts at 105 and 205 are all gap and are not read. The gap at 565 is
+  // read since it is inside a part.
+  std::vector<std::pair<uint64_t, uint64_t>> expected = {
+      {5, 10}, {315, 90}, {405, 100}, {505, 100}};
+  EXPECT_EQ(expected, store.ranges());
+  EXPECT_EQ(4, reader.numPartReads());
+  EXPECT_EQ(0, reader.numHedgedReads());
+}
+
+TEST_F(ParallelRangeReaderTest, gapsOnly) {
+  FakeObjectStore store(100);
+  ParallelRangeReader reader(store.reader(), executor_.get(), {}, nullptr);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(nullptr, 50)};
+  EXPECT_EQ(50, reader.preadvAsync(0, buffers).get());
+  EXPECT_EQ(0, store.numRequests());
+}
+
+TEST_F(ParallelRangeReaderTest, hedgesSlowPart) {
+  FakeObjectStore store(10'000);
+  ParallelReadOptions options;
+  options.partSize = 1000;
+  options.hedgePercentile = 90;
+  options.minHedgeSamples = 5;
+  auto latencies = std::make_shared<LatencyTracker>();
+  ParallelRangeReader reader(
+      store.reader(), executor_.get(), options, latencies);
+
+  std::string data(10'000, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  // Warm up the latency percentile.
+  EXPECT_EQ(10'000, reader.preadvAsync(0, buffers).get());
+  EXPECT_EQ(0, reader.numHedgedReads());
+  EXPECT_EQ(10, latencies->numSamples());
+
+  std::fill(data.begin(), data.end(), 0);
+  store.setSlowOffset(3000);
+  uint64_t usec = 0;
+  {
+    MicrosecondTimer timer(&usec);
+    EXPECT_EQ(10'000, reader.preadvAsync(0, buffers).get());
+  }
+  EXPECT_EQ(store.data(), data);
+  EXPECT_GE(reader.numHedgedReads(), 1);
+  // The hedged attempt completes before the stalled one.
+  EXPECT_LT(usec, 400'000);
+  // Waits for the stalled attempt, which references 'store'. The stalled
+  // attempt reads in place but does not write to 'data' after the read
+  // completed.
+  std::fill(data.begin(), data.end(), 0);
+  executor_->join();
+  EXPECT_EQ(std::string(10'000, 0), data);
+}
+
+TEST_F(ParallelRangeReaderTest, hedgeDelayScalesWithSize) {
+  FakeObjectStore store(10'000);
+  ParallelReadOptions options;
+  options.hedgePercentile = 50;
+  options.minHedgeSamples = 5;
+  auto latencies = std::make_shared<LatencyTracker>();
+  // Large reads are slow. They do not make small reads wait for a hedge.
+  for (auto i = 0; i < 5; ++i) {
+    latencies->record(10'000'000, 64 << 20);
+  }
+  for (auto i = 0; i < 5; ++i) {
+    latencies->record(1'000, 1000);
+  }
+  ParallelRangeReader reader(
+      store.reader(), executor_.get(), options, latencies);
+
+  std::string data(10'000, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  store.setSlowOffset(0);
+  uint64_t usec = 0;
+  {
+    MicrosecondTimer timer(&usec);
+    EXPECT_EQ(10'000, reader.preadvAsync(0, buffers).get());
+  }
+  EXPECT_EQ(store.data(), data);
+  EXPECT_EQ(1, reader.numHedgedReads());
+  EXPECT_LT(usec, 400'000);
+  executor_->join();
+}
+
+TEST_F(ParallelRangeReaderTest, pendingHedgeKeepsExecutor) {
+  FakeObjectStore store(1000);
+  ParallelReadOptions options;
+  options.hedgePercentile = 50;
+  options.minHedgeSamples = 1;
+  auto latencies = std::make_shared<LatencyTracker>();
+  latencies->record(500'000, 1000);
+  ParallelRangeReader reader(
+      store.reader(), executor_.get(), options, latencies);
+
+  std::string data(1000, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  EXPECT_EQ(1000, reader.preadvAsync(0, buffers).get());
+  EXPECT_EQ(store.data(), data);
+  // The hedge timer of the completed read is still pending. Destroying the
+  // executor waits for it.
+  executor_.reset();
+}
+
+TEST_F(ParallelRangeReaderTest, error) {
+  FakeObjectStore store(1000);
+  ParallelReadOptions options;
+  options.partSize = 100;
+  ParallelRangeReader reader(
+      store.reader(), executor_.get(), options, nullptr);
+  store.setFailOffset(300);
+  std::string data(1000, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  VELOX_ASSERT_THROW(
+      reader.preadvAsync(0, buffers).get(), "Injected failure at 300");
+  // All parts were attempted before the future failed.
+  EXPECT_EQ(10, store.numRequests());
+  // Waits for anything still referencing 'store'.
+  executor_->join();
+}
+
+TEST(LatencyTrackerTest, percentile) {
+  LatencyTracker tracker;
+  EXPECT_FALSE(tracker.percentile(50, 1, 1000).has_value());
+  for (auto i = 1; i <= 100; ++i) {
+    tracker.record(i, 1000);
+  }
+  EXPECT_FALSE(tracker.percentile(50, 101, 1000).has_value());
+  EXPECT_EQ(51, tracker.percentile(50, 10, 1000).value());
+  EXPECT_EQ(91, tracker.percentile(90, 10, 1000).value());
+  EXPECT_EQ(100, tracker.percentile(100, 10, 1000).value());
+  // Reads below kMinBucketBytes are not scaled.
+  EXPECT_EQ(51, tracker.percentile(50, 10, 10).value());
+
+  // Older latencies are replaced once the capacity is reached.
+  for (auto i = 0; i < LatencyTracker::kCapacity; ++i) {
+    tracker.record(1000, 1000);
+  }
+  EXPECT_EQ(1000, tracker.percentile(1, 10, 1000).value());
+  EXPECT_EQ(100 + LatencyTracker::kCapacity, tracker.numSamples());
+}
+
+TEST(LatencyTrackerTest, sizeClasses) {
+  LatencyTracker tracker;
+  for (auto i = 0; i < 10; ++i) {
+    tracker.record(100, 1000);
+    tracker.record(10'000, 1 << 20);
+  }
+  EXPECT_EQ(100, tracker.percentile(50, 10, 1000).value());
+  EXPECT_EQ(10'000, tracker.percentile(50, 10, 1 << 20).value());
+  // Scaled by the length within a size class.
+  EXPECT_EQ(20'000, tracker.percentile(50, 10, 2 << 20).value());
+  // No samples for reads of this size.
+  EXPECT_FALSE(tracker.percentile(50, 1, 64 << 20).has_value());
+}
+
+} // namespace
@@ -60,6 +60,37 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "paralleldata";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Parts of 64KB split the 1MB run of 'c' into many concurrent GETs.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-threads", "4"},
+       {"hive.s3.read-part-size", "65536"},
+       {"hive.s3.hedge-read-percentile", "90"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  readData(readFile.get());
+
+  std::string head(10, 0);
+  std::string middle(kOneMB, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(middle.data(), middle.size())};
+  auto future = readFile->preadvAsync(0, buffers);
+  ASSERT_EQ(10 + kOneMB, std::move(future).get());
+  ASSERT_EQ(head, "aaaaabbbbb");
+  ASSERT_EQ(middle, std::string(kOneMB, 'c'));
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
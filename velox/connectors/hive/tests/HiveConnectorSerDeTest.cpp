@@ -34,6 +34,8 @@ class HiveConnectorSerDeTest : public exec::test::HiveConnectorTestBase {
     HiveColumnHandle::registerSerDe();
     LocationHandle::registerSerDe();
     HiveInsertTableHandle::registerSerDe();
+    HiveSortingColumn::registerSerDe();
+    HiveClusteringProperty::registerSerDe();
   }
 
   template <typename T>
@@ -86,6 +88,28 @@ TEST_F(HiveConnectorSerDeTest, hiveTableHandle) {
   testSerde(*tableHandle);
 }
 
+TEST_F(HiveConnectorSerDeTest, hiveTableHandleWithStatsAggregates) {
+  auto tableHandle = std::make_shared<HiveTableHandle>(
+      kHiveConnectorId,
+      "hive_table",
+      true,
+      SubfieldFilters{},
+      nullptr,
+      ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}),
+      std::unordered_map<std::string, std::string>{},
+      std::vector<HiveStatsAggregate>{
+          {HiveStatsAggregate::Kind::kCount, ""},
+          {HiveStatsAggregate::Kind::kMin, "c0"},
+          {HiveStatsAggregate::Kind::kMax, "c1"}});
+  auto clone =
+      ISerializable::deserialize<HiveTableHandle>(tableHandle->serialize());
+  ASSERT_EQ(clone->toString(), tableHandle->toString());
+  ASSERT_EQ(3, clone->statsAggregates().size());
+  ASSERT_EQ(
+      HiveStatsAggregate::Kind::kMax, clone->statsAggregates()[2].kind);
+  ASSERT_EQ("c1", clone->statsAggregates()[2].column);
+}
+
 TEST_F(HiveConnectorSerDeTest, hiveColumnHandle) {
   auto columnType = ROW(
       {{"c0c0", BIGINT()},
@@ -129,4 +153,17 @@ TEST_F(HiveConnectorSerDeTest, hiveInsertTableHandle) {
       exec::test::HiveConnectorTestBase::makeHiveInsertTableHandle(
           tableColumnNames, tableColumnTypes, {"loc"}, locationHandle);
   testSerde(*hiveInsertTableHandle);
+
+  auto clusteredHandle = std::make_shared<HiveInsertTableHandle>(
+      hiveInsertTableHandle->inputColumns(),
+      locationHandle,
+      dwio::common::FileFormat::DWRF,
+      nullptr,
+      std::nullopt,
+      std::make_shared<HiveClusteringProperty>(
+          HiveClusteringProperty::Kind::kZOrder,
+          std::vector<std::shared_ptr<const HiveSortingColumn>>{
+              std::make_shared<HiveSortingColumn>(
+                  "id", core::SortOrder{true, true})}));
+  testSerde(*clusteredHandle);
 }
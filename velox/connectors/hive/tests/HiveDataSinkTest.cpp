@@ -18,10 +18,14 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
@@ -40,6 +44,7 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
     Type::registerSerDe();
     HiveSortingColumn::registerSerDe();
     HiveBucketProperty::registerSerDe();
+    HiveClusteringProperty::registerSerDe();
 
     rowType_ =
         ROW({"c0", "c1", "c2", "c3", "c4", "c5"},
@@ -416,6 +421,291 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->path);
 }
 
+TEST_F(HiveDataSinkTest, reclaim) {
+  const int numBatches = 10;
+  const auto outputDirectory = TempDirectoryPath::create();
+  auto dataSink = createDataSink(rowType_, outputDirectory->path);
+  ASSERT_TRUE(dataSink->canReclaim());
+  // No writer is created before the first input.
+  ASSERT_EQ(dataSink->reclaim(0), 0);
+
+  VectorFuzzer::Options options;
+  options.vectorSize = 2'000;
+  VectorFuzzer fuzzer(options, pool());
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(fuzzer.fuzzRow(rowType_));
+    dataSink->appendData(vectors.back());
+    if (i % 3 == 2) {
+      // The flush frees the buffered stripe of the file writer.
+      const auto reservedBytes = connectorPool_->reservedBytes();
+      ASSERT_EQ(dataSink->reclaim(0), 1);
+      ASSERT_LT(connectorPool_->reservedBytes(), reservedBytes);
+    }
+  }
+  const auto results = dataSink->close(true);
+  ASSERT_EQ(results.size(), 1);
+  ASSERT_EQ(dataSink->reclaim(0), 0);
+
+  createDuckDbTable(vectors);
+  verifyWrittenData(outputDirectory->path);
+}
+
+TEST_F(HiveDataSinkTest, sortedOverflowPartitions) {
+  const int numBatches = 3;
+  const int numPartitions = 10;
+  const auto rowType =
+      ROW({"c0", "c1", "p0"}, {BIGINT(), VARCHAR(), INTEGER()});
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+         makeFlatVector<StringView>(
+             100,
+             [&](auto row) {
+               return StringView::makeInline(std::to_string(i * row));
+             }),
+         makeFlatVector<int32_t>(
+             100, [&](auto row) { return row % numPartitions; })}));
+  }
+
+  for (const bool sorted : {false, true}) {
+    SCOPED_TRACE(fmt::format("sorted: {}", sorted));
+    const auto outputDirectory = TempDirectoryPath::create();
+    const auto config = std::make_shared<core::MemConfig>(
+        std::unordered_map<std::string, std::string>{
+            {HiveConfig::kMaxPartitionsPerWriters, "2"},
+            {HiveConfig::kMaxSortedPartitionsPerWriters,
+             sorted ? "100" : "0"}});
+    const auto connectorQueryCtx = std::make_unique<ConnectorQueryCtx>(
+        opPool_.get(),
+        connectorPool_.get(),
+        nullptr,
+        config.get(),
+        nullptr,
+        nullptr,
+        nullptr,
+        "query.HiveDataSinkTest",
+        "task.HiveDataSinkTest",
+        "planNodeId.HiveDataSinkTest",
+        0);
+    auto dataSink = std::make_shared<HiveDataSink>(
+        rowType,
+        makeHiveInsertTableHandle(
+            rowType->names(),
+            rowType->children(),
+            {"p0"},
+            makeLocationHandle(outputDirectory->path)),
+        connectorQueryCtx.get(),
+        CommitStrategy::kNoCommit,
+        connectorConfig_);
+    if (!sorted) {
+      VELOX_ASSERT_THROW(
+          dataSink->appendData(vectors[0]),
+          "Exceeded limit of 2 distinct partitions.");
+      dataSink->close(false);
+      continue;
+    }
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto results = dataSink->close(true);
+    ASSERT_EQ(results.size(), numPartitions);
+    for (const auto& result : results) {
+      ASSERT_EQ(folly::parseJson(result)["rowCount"].asInt(), 30);
+    }
+
+    const auto filePaths = listFiles(outputDirectory->path);
+    ASSERT_EQ(filePaths.size(), numPartitions);
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    for (const auto& filePath : filePaths) {
+      splits.push_back(makeHiveConnectorSplit(filePath));
+    }
+    createDuckDbTable(vectors);
+    HiveConnectorTestBase::assertQuery(
+        PlanBuilder().tableScan(rowType).planNode(),
+        splits,
+        "SELECT * FROM tmp");
+  }
+}
+
+TEST_F(HiveDataSinkTest, hiveClusteringProperty) {
+  const std::vector<std::shared_ptr<const HiveSortingColumn>> clusteredBy = {
+      std::make_shared<HiveSortingColumn>("c0", core::SortOrder{true, true}),
+      std::make_shared<HiveSortingColumn>("c1", core::SortOrder{false, false})};
+  VELOX_ASSERT_THROW(
+      HiveClusteringProperty(HiveClusteringProperty::Kind::kZOrder, {}),
+      "Hive clustering columns must be set");
+  for (const auto kind :
+       {HiveClusteringProperty::Kind::kSorted,
+        HiveClusteringProperty::Kind::kZOrder}) {
+    SCOPED_TRACE(HiveClusteringProperty::kindString(kind));
+    const HiveClusteringProperty property(kind, clusteredBy);
+    ASSERT_EQ(property.kind(), kind);
+    ASSERT_EQ(property.clusteredBy(), clusteredBy);
+    const auto obj = property.serialize();
+    const auto deserializedProperty =
+        HiveClusteringProperty::deserialize(obj, pool());
+    ASSERT_EQ(obj, deserializedProperty->serialize());
+  }
+}
+
+TEST_F(HiveDataSinkTest, clustering) {
+  const int numBatches = 10;
+  const auto rowType =
+      ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()});
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(
+             100, [&](auto row) { return (i * 100 + row) * 7919 % 1000; }),
+         makeFlatVector<int32_t>(
+             100,
+             [&](auto row) { return (i * 100 + row) * 104729 % 1000 - 500; },
+             nullEvery(11)),
+         makeFlatVector<StringView>(100, [&](auto row) {
+           return StringView::makeInline(std::to_string(i * row));
+         })}));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::shared_ptr<const HiveSortingColumn>> clusteredBy = {
+      std::make_shared<HiveSortingColumn>("c0", core::SortOrder{true, true}),
+      std::make_shared<HiveSortingColumn>("c1", core::SortOrder{false, false})};
+  for (const auto kind :
+       {HiveClusteringProperty::Kind::kSorted,
+        HiveClusteringProperty::Kind::kZOrder}) {
+    SCOPED_TRACE(HiveClusteringProperty::kindString(kind));
+    const auto outputDirectory = TempDirectoryPath::create();
+    const auto handle = makeHiveInsertTableHandle(
+        rowType->names(),
+        rowType->children(),
+        {},
+        makeLocationHandle(outputDirectory->path));
+    auto dataSink = std::make_shared<HiveDataSink>(
+        rowType,
+        std::make_shared<HiveInsertTableHandle>(
+            handle->inputColumns(),
+            handle->locationHandle(),
+            dwio::common::FileFormat::DWRF,
+            nullptr,
+            std::nullopt,
+            std::make_shared<HiveClusteringProperty>(kind, clusteredBy)),
+        connectorQueryCtx_.get(),
+        CommitStrategy::kNoCommit,
+        connectorConfig_);
+    ASSERT_FALSE(dataSink->canReclaim());
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    ASSERT_EQ(dataSink->close(true).size(), 1);
+
+    const auto filePaths = listFiles(outputDirectory->path);
+    ASSERT_EQ(filePaths.size(), 1);
+    const auto plan = PlanBuilder().tableScan(rowType).planNode();
+    HiveConnectorTestBase::assertQuery(
+        plan, {makeHiveConnectorSplit(filePaths[0])}, "SELECT * FROM tmp");
+    const auto result = AssertQueryBuilder(plan)
+                            .split(makeHiveConnectorSplit(filePaths[0]))
+                            .copyResults(pool());
+    ASSERT_EQ(result->size(), numBatches * 100);
+
+    if (kind == HiveClusteringProperty::Kind::kSorted) {
+      const auto* c0 = result->childAt(0)->asFlatVector<int64_t>();
+      for (vector_size_t row = 1; row < result->size(); ++row) {
+        ASSERT_LE(c0->valueAt(row - 1), c0->valueAt(row));
+      }
+      continue;
+    }
+    ZOrderKeyGenerator keyGenerator(
+        rowType,
+        {0, 1},
+        {core::SortOrder{true, true}, core::SortOrder{false, false}},
+        pool());
+    // The ranks of the keys come from the first input, as in the sink.
+    keyGenerator.run(vectors[0]);
+    const auto keys = keyGenerator.run(result)->asFlatVector<StringView>();
+    for (vector_size_t row = 1; row < result->size(); ++row) {
+      ASSERT_LE(keys->valueAt(row - 1), keys->valueAt(row));
+    }
+  }
+}
+
+TEST_F(HiveDataSinkTest, zOrderSelectivity) {
+  // Writes a grid of 1000 x 100 points in 10 row groups of 10'000 rows and
+  // checks that the min/max statistics of the row groups skip most of them
+  // for a filter on either column. The columns use different integer types
+  // and magnitudes. The points are shuffled so that each batch samples the
+  // whole grid.
+  const int numBatches = 10;
+  const int batchSize = 10'000;
+  const int numRows = numBatches * batchSize;
+  const auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    const auto point = [&](auto row) {
+      return (int64_t{i} * batchSize + row) * 7919 % numRows;
+    };
+    vectors.push_back(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(
+             batchSize, [&](auto row) { return point(row) / 100 * 1'000; }),
+         makeFlatVector<int32_t>(
+             batchSize, [&](auto row) { return point(row) % 100; })}));
+  }
+  createDuckDbTable(vectors);
+
+  const auto outputDirectory = TempDirectoryPath::create();
+  const auto handle = makeHiveInsertTableHandle(
+      rowType->names(),
+      rowType->children(),
+      {},
+      makeLocationHandle(outputDirectory->path));
+  auto dataSink = std::make_shared<HiveDataSink>(
+      rowType,
+      std::make_shared<HiveInsertTableHandle>(
+          handle->inputColumns(),
+          handle->locationHandle(),
+          dwio::common::FileFormat::DWRF,
+          nullptr,
+          std::nullopt,
+          std::make_shared<HiveClusteringProperty>(
+              HiveClusteringProperty::Kind::kZOrder,
+              std::vector<std::shared_ptr<const HiveSortingColumn>>{
+                  std::make_shared<HiveSortingColumn>(
+                      "c0", core::SortOrder{true, true}),
+                  std::make_shared<HiveSortingColumn>(
+                      "c1", core::SortOrder{true, true})})),
+      connectorQueryCtx_.get(),
+      CommitStrategy::kNoCommit,
+      connectorConfig_);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_EQ(dataSink->close(true).size(), 1);
+  const auto filePaths = listFiles(outputDirectory->path);
+  ASSERT_EQ(filePaths.size(), 1);
+
+  for (const auto& filter : {"c0 < 100000", "c1 < 10"}) {
+    SCOPED_TRACE(filter);
+    core::PlanNodeId scanNodeId;
+    const auto plan = PlanBuilder()
+                          .tableScan(rowType, {filter})
+                          .capturePlanNodeId(scanNodeId)
+                          .planNode();
+    const auto task = HiveConnectorTestBase::assertQuery(
+        plan,
+        {makeHiveConnectorSplit(filePaths[0])},
+        fmt::format("SELECT * FROM tmp WHERE {}", filter));
+    const auto skippedStrides = exec::toPlanStats(task->taskStats())
+                                    .at(scanNodeId)
+                                    .customStats.at("skippedStrides");
+    EXPECT_GE(skippedStrides.sum, 5);
+  }
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/ZOrderKeyGenerator.h"
+
+#include <numeric>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include "gtest/gtest.h"
+
+namespace facebook::velox::connector::hive {
+
+class ZOrderKeyGeneratorTest : public ::testing::Test,
+                               public test::VectorTestBase {
+ protected:
+  const core::SortOrder kAscending{true, true};
+  const core::SortOrder kDescending{false, false};
+
+  std::vector<std::string> keys(
+      ZOrderKeyGenerator& generator,
+      const RowVectorPtr& input) {
+    auto result = generator.run(input)->asFlatVector<StringView>();
+    std::vector<std::string> keys;
+    for (vector_size_t row = 0; row < result->size(); ++row) {
+      EXPECT_EQ(result->valueAt(row).size(), generator.keySize());
+      keys.push_back(result->valueAt(row).str());
+    }
+    return keys;
+  }
+
+  // Verifies that the keys of a single column sort like its values. A null
+  // may have the same key as the lowest or highest value.
+  void testSingleColumn(const VectorPtr& values, bool ascending) {
+    const auto input = makeRowVector({values});
+    ZOrderKeyGenerator generator(
+        asRowType(input->type()),
+        {0},
+        {ascending ? kAscending : kDescending},
+        pool());
+    const auto result = keys(generator, input);
+    CompareFlags flags{ascending, ascending};
+    for (vector_size_t i = 0; i < values->size(); ++i) {
+      for (vector_size_t j = 0; j < values->size(); ++j) {
+        const auto expected =
+            values->compare(values.get(), i, j, flags).value();
+        const auto actual = result[i].compare(result[j]);
+        if (values->isNullAt(i) || values->isNullAt(j)) {
+          EXPECT_FALSE(expected < 0 && actual > 0) << i << " " << j;
+          EXPECT_FALSE(expected > 0 && actual < 0) << i << " " << j;
+        } else {
+          EXPECT_EQ(expected < 0, actual < 0) << i << " " << j;
+          EXPECT_EQ(expected > 0, actual > 0) << i << " " << j;
+        }
+      }
+    }
+  }
+
+  // Verifies that sorting the points of a 'size' x 'size' grid of the
+  // distinct values of 'x' and 'y' by key keeps the points of each quadrant
+  // together. Row 'row' is the point (row / size, row % size).
+  void expectQuadrants(const VectorPtr& x, const VectorPtr& y, int32_t size) {
+    const auto input = makeRowVector({x, y});
+    ZOrderKeyGenerator generator(
+        asRowType(input->type()), {0, 1}, {kAscending, kAscending}, pool());
+    const auto result = keys(generator, input);
+    std::vector<vector_size_t> rows(result.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+      return result[left] < result[right];
+    });
+    const auto quadrant = [&](vector_size_t row) {
+      return (row / size >= size / 2) * 2 + (row % size >= size / 2);
+    };
+    for (size_t i = 0; i < rows.size(); ++i) {
+      EXPECT_EQ(quadrant(rows[i]), static_cast<int32_t>(i) / (size * size / 4))
+          << i;
+    }
+  }
+};
+
+TEST_F(ZOrderKeyGeneratorTest, singleColumn) {
+  for (const bool ascending : {true, false}) {
+    SCOPED_TRACE(fmt::format("ascending: {}", ascending));
+    testSingleColumn(
+        makeNullableFlatVector<bool>({true, std::nullopt, false}), ascending);
+    testSingleColumn(
+        makeNullableFlatVector<int8_t>({-128, 127, std::nullopt, 0, -1, 1}),
+        ascending);
+    testSingleColumn(
+        makeNullableFlatVector<int32_t>(
+            {std::numeric_limits<int32_t>::min(),
+             std::numeric_limits<int32_t>::max(),
+             std::nullopt,
+             0,
+             -1,
+             1}),
+        ascending);
+    testSingleColumn(
+        makeNullableFlatVector<int64_t>(
+            {std::numeric_limits<int64_t>::min(),
+             std::numeric_limits<int64_t>::max(),
+             std::nullopt,
+             0,
+             -1,
+             1}),
+        ascending);
+    testSingleColumn(
+        makeNullableFlatVector<double>(
+            {-std::numeric_limits<double>::infinity(),
+             -1.5,
+             -0.25,
+             std::nullopt,
+             0.25,
+             1.5,
+             std::numeric_limits<double>::max()}),
+        ascending);
+    testSingleColumn(
+        makeNullableFlatVector<float>({-2.5, std::nullopt, 0.5, 1e10}),
+        ascending);
+    testSingleColumn(
+        makeNullableFlatVector<StringView>(
+            {"", "a", "ab", std::nullopt, "abcdefg", "b", "\xff"}),
+        ascending);
+    testSingleColumn(
+        makeNullableFlatVector<Timestamp>(
+            {Timestamp(-100, 0),
+             std::nullopt,
+             Timestamp(0, 0),
+             Timestamp(5, 0)}),
+        ascending);
+  }
+}
+
+TEST_F(ZOrderKeyGeneratorTest, interleave) {
+  // The key of two columns takes the most significant bit of the first
+  // column, then of the second column and so on.
+  const auto input = makeRowVector({
+      makeFlatVector<int64_t>({std::numeric_limits<int64_t>::min(), 0}),
+      makeFlatVector<int64_t>({std::numeric_limits<int64_t>::max(), -1}),
+  });
+  ZOrderKeyGenerator generator(
+      asRowType(input->type()), {0, 1}, {kAscending, kAscending}, pool());
+  ASSERT_EQ(generator.keySize(), 16);
+  const auto result = keys(generator, input);
+  // Each column has 2 boundaries and each value is a boundary, so that the
+  // values map to their rank of 1 or 2 scaled to 0x7fff or 0xffff followed
+  // by 48 zero bits. Row 0 maps to 0x7fff... and 0xffff..., row 1 to
+  // 0xffff... and 0x7fff....
+  EXPECT_EQ(
+      result[0],
+      std::string("\x7f") + std::string(3, '\xff') + std::string(12, '\0'));
+  EXPECT_EQ(
+      result[1],
+      std::string("\xbf") + std::string(3, '\xff') + std::string(12, '\0'));
+}
+
+TEST_F(ZOrderKeyGeneratorTest, clustering) {
+  const int32_t size = 16;
+  expectQuadrants(
+      makeFlatVector<int32_t>(size * size, [](auto row) { return row / size; }),
+      makeFlatVector<int32_t>(size * size, [](auto row) { return row % size; }),
+      size);
+}
+
+TEST_F(ZOrderKeyGeneratorTest, differentDomains) {
+  // The columns are clustered alike even if their values differ in
+  // different bits.
+  const int32_t size = 16;
+  expectQuadrants(
+      makeFlatVector<int64_t>(
+          size * size, [](auto row) { return row / size * 1'000'000; }),
+      makeFlatVector<int8_t>(size * size, [](auto row) { return row % size; }),
+      size);
+  expectQuadrants(
+      makeFlatVector<StringView>(
+          size * size,
+          [](auto row) {
+            return StringView::makeInline(fmt::format("a{:02}", row / size));
+          }),
+      makeFlatVector<double>(
+          size * size, [](auto row) { return (row % size) * 0.001; }),
+      size);
+}
+
+TEST_F(ZOrderKeyGeneratorTest, laterInputs) {
+  // The ranks come from the first input, so that the keys of later inputs
+  // compare with the earlier keys.
+  const auto makeInput = [&](std::vector<int64_t> values) {
+    return makeRowVector({makeFlatVector<int64_t>(values)});
+  };
+  ZOrderKeyGenerator generator(
+      ROW({"c0"}, {BIGINT()}), {0}, {kAscending}, pool());
+  const auto first = keys(generator, makeInput({0, 10, 20}));
+  const auto later = keys(generator, makeInput({-5, 5, 10, 15, 25}));
+  EXPECT_LT(later[0], first[0]);
+  EXPECT_LT(first[0], later[1]);
+  EXPECT_LT(later[1], first[1]);
+  EXPECT_EQ(later[2], first[1]);
+  EXPECT_LT(first[1], later[3]);
+  EXPECT_LT(later[3], first[2]);
+  EXPECT_LT(first[2], later[4]);
+}
+
+TEST_F(ZOrderKeyGeneratorTest, unsupportedType) {
+  VELOX_ASSERT_THROW(
+      ZOrderKeyGenerator(
+          ROW({"c0"}, {ARRAY(BIGINT())}), {0}, {kAscending}, pool()),
+      "Unsupported Z-order column type: c0 ARRAY<BIGINT>");
+}
+
+} // namespace facebook::velox::connector::hive
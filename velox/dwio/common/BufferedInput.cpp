@@ -31,6 +31,16 @@ void BufferedInput::load(const LogType logType) {
     return;
   }
 
+  if (mapped_) {
+    // The streams read the mapping directly. Starts paging in the data.
+    for (const auto& region : regions_) {
+      getReadFile()->advise(
+          region.offset, region.length, ReadFile::AccessHint::kWillNeed);
+    }
+    regions_.clear();
+    return;
+  }
+
   offsets_.clear();
   buffers_.clear();
   allocPool_->clear();
@@ -76,6 +86,12 @@ std::unique_ptr<SeekableInputStream> BufferedInput::enqueue(
         static_cast<const char*>(nullptr), 0);
   }
 
+  if (mapped_) {
+    // Remembered for advising the file in load().
+    regions_.push_back(region);
+    return mappedStream(region.offset, region.length);
+  }
+
   // if the region is already in buffer - such as metadata
   auto ret = readBuffer(region.offset, region.length);
   if (ret) {
@@ -185,6 +201,16 @@ bool BufferedInput::tryMerge(Region& first, const Region& second) {
   return false;
 }
 
+std::unique_ptr<SeekableInputStream> BufferedInput::mappedStream(
+    uint64_t offset,
+    uint64_t length) const {
+  auto data = getReadFile()->mappedView(offset, length);
+  if (auto* stats = input_->getStats()) {
+    stats->incRawBytesRead(length);
+  }
+  return std::make_unique<SeekableArrayInputStream>(data.data(), data.size());
+}
+
 std::unique_ptr<SeekableInputStream> BufferedInput::readBuffer(
     uint64_t offset,
     uint64_t length) const {
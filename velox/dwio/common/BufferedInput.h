@@ -43,6 +43,7 @@ class BufferedInput {
         pool_{pool},
         maxMergeDistance_{maxMergeDistance},
         wsVRLoad_{wsVRLoad},
+        mapped_{input_->getReadFile()->hasMappedView()},
         allocPool_{std::make_unique<memory::AllocationPool>(&pool)} {}
 
   BufferedInput(
@@ -54,6 +55,7 @@ class BufferedInput {
         pool_(pool),
         maxMergeDistance_{maxMergeDistance},
         wsVRLoad_{wsVRLoad},
+        mapped_{input_->getReadFile()->hasMappedView()},
         allocPool_{std::make_unique<memory::AllocationPool>(&pool)} {}
 
   BufferedInput(BufferedInput&&) = default;
@@ -81,11 +83,17 @@ class BufferedInput {
   virtual void load(const LogType);
 
   virtual bool isBuffered(uint64_t offset, uint64_t length) const {
-    return !!readBuffer(offset, length);
+    return mapped_ || !!readBuffer(offset, length);
   }
 
+  // If the file supports mapped views, enqueue(), read() and loadCompleteFile()
+  // return streams over the file's memory and load() only advises the file of
+  // the upcoming reads. Uncompressed streams are then decoded in place.
   virtual std::unique_ptr<SeekableInputStream>
   read(uint64_t offset, uint64_t length, LogType logType) const {
+    if (mapped_) {
+      return mappedStream(offset, length);
+    }
     std::unique_ptr<SeekableInputStream> ret = readBuffer(offset, length);
     if (!ret) {
       VLOG(1) << "Unplanned read. Offset: " << offset << ", Length: " << length;
@@ -152,6 +160,8 @@ class BufferedInput {
  private:
   uint64_t maxMergeDistance_;
   std::optional<bool> wsVRLoad_;
+  // True if the file supports ReadFile::mappedView().
+  const bool mapped_;
   std::unique_ptr<memory::AllocationPool> allocPool_;
 
   // Regions enqueued for reading
@@ -171,6 +181,11 @@ class BufferedInput {
   std::unique_ptr<SeekableInputStream> readBuffer(
       uint64_t offset,
       uint64_t length) const;
+
+  // Returns a stream over the mapped memory of the file.
+  std::unique_ptr<SeekableInputStream> mappedStream(
+      uint64_t offset,
+      uint64_t length) const;
   std::tuple<const char*, uint64_t> readInternal(
       uint64_t offset,
       uint64_t length,
@@ -206,6 +206,9 @@ void CacheInputStream::loadSync(Region region) {
         MicrosecondTimer timer(&usec);
         input_->read(ranges, region.offset, LogType::FILE);
       }
+      if (auto* tuner = bufferedInput_->ioTuner()) {
+        tuner->recordRead(region.length, usec);
+      }
       ioStats_->read().increment(region.length);
       ioStats_->queryThreadIoLatency().increment(usec);
       entry->setExclusiveToShared();
@@ -15,8 +15,14 @@
  */
 
 #include "velox/dwio/common/CachedBufferedInput.h"
+
+#include <deque>
+
+#include <folly/futures/Future.h>
+
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -64,7 +70,7 @@ std::unique_ptr<SeekableInputStream> CachedBufferedInput::enqueue(
       tracker_,
       id,
       groupId_,
-      options_.loadQuantum());
+      ioParameters_.loadQuantum);
   requests_.back().stream = stream.get();
   return stream;
 }
@@ -82,7 +88,7 @@ bool CachedBufferedInput::shouldPreload(int32_t numPages) {
   }
   for (auto& request : requests_) {
     numPages += bits::roundUp(
-                    std::min<int32_t>(request.size, options_.loadQuantum()),
+                    std::min<int32_t>(request.size, ioParameters_.loadQuantum),
                     memory::AllocationTraits::kPageSize) /
         memory::AllocationTraits::kPageSize;
   }
@@ -184,7 +190,7 @@ void CachedBufferedInput::load(const LogType) {
       if (prefetchAnyway || adjustedReadPct(trackingData) >= readPct) {
         request.processed = true;
         auto parts = makeRequestParts(
-            request, trackingData, options_.loadQuantum(), extraRequests);
+            request, trackingData, ioParameters_.loadQuantum, extraRequests);
         for (auto part : parts) {
           if (cache_->exists(part->key)) {
             continue;
@@ -209,6 +215,38 @@ void CachedBufferedInput::load(const LogType) {
     makeLoads(std::move(storageLoad), isPrefetchPct(readPct));
     makeLoads(std::move(ssdLoad), isPrefetchPct(readPct));
   }
+  updateIoParameters();
+}
+
+void CachedBufferedInput::updateIoParameters() {
+  auto* tuner = ioTuner();
+  IoParameters parameters;
+  if (tuner) {
+    parameters = tuner->parameters();
+  } else {
+    parameters = {
+        options_.maxCoalesceDistance(),
+        options_.loadQuantum(),
+        std::numeric_limits<int32_t>::max()};
+  }
+  // The stats get one entry per change of the tuned values.
+  const bool changed = !hasIoParameters_ || parameters != ioParameters_;
+  ioParameters_ = parameters;
+  hasIoParameters_ = true;
+  if (!changed) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> l(readAhead_->mutex);
+    readAhead_->maxOutstanding = ioParameters_.maxOutstandingLoads;
+  }
+  if (tuner && ioStats_) {
+    ioStats_->tunedCoalesceDistance().increment(
+        ioParameters_.coalesceDistance);
+    ioStats_->tunedLoadQuantum().increment(ioParameters_.loadQuantum);
+    ioStats_->tunedMaxOutstandingLoads().increment(
+        ioParameters_.maxOutstandingLoads);
+  }
 }
 
 void CachedBufferedInput::makeLoads(
@@ -218,7 +256,7 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   bool isSsd = !requests[0]->ssdPin.empty();
-  int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  int32_t maxDistance = isSsd ? 20000 : ioParameters_.coalesceDistance;
   std::sort(
       requests.begin(),
       requests.end(),
@@ -231,7 +269,7 @@ void CachedBufferedInput::makeLoads(
       });
   // Combine adjacent short reads.
 
-  int32_t numNewLoads = 0;
+  const auto firstNewLoad = allCoalescedLoads_.size();
   int64_t coalescedBytes = 0;
   coalesceIo<CacheRequest*, CacheRequest*>(
       requests,
@@ -263,32 +301,72 @@ void CachedBufferedInput::makeLoads(
           int32_t /*end*/,
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
-        ++numNewLoads;
         readRegion(ranges, prefetch);
       });
   if (prefetch && executor_) {
-    std::vector<int32_t> doneIndices;
-    for (auto i = 0; i < allCoalescedLoads_.size(); ++i) {
-      auto& load = allCoalescedLoads_[i];
-      if (load->state() == CoalescedLoad::State::kPlanned) {
-        prefetchSize_ += load->size();
-        executor_->add([pendingLoad = load]() {
-          process::TraceContext trace("Read Ahead");
-          pendingLoad->loadOrFuture(nullptr);
-        });
-      } else {
-        doneIndices.push_back(i);
+    // The new loads wait in 'readAhead_' until fewer than the read-ahead depth
+    // are queued or loading. A finishing load starts the next one.
+    std::vector<std::shared_ptr<CoalescedLoad>> toSchedule;
+    {
+      std::lock_guard<std::mutex> l(readAhead_->mutex);
+      for (auto i = firstNewLoad; i < allCoalescedLoads_.size(); ++i) {
+        prefetchSize_ += allCoalescedLoads_[i]->size();
+        readAhead_->pending.push_back(allCoalescedLoads_[i]);
       }
+      readAhead_->nextLoadsLocked(toSchedule);
+    }
+    for (auto& load : toSchedule) {
+      scheduleReadAhead(readAhead_, std::move(load), executor_);
     }
     // Remove the loads that were complete. There can be done loads if the same
     // CachedBufferedInput has multiple cycles of enqueues and loads.
-    for (int32_t i = doneIndices.size() - 1; i >= 0; --i) {
-      assert(!doneIndices.empty()); // lint
-      allCoalescedLoads_.erase(allCoalescedLoads_.begin() + doneIndices[i]);
+    allCoalescedLoads_.erase(
+        std::remove_if(
+            allCoalescedLoads_.begin(),
+            allCoalescedLoads_.end(),
+            [](const auto& load) {
+              return load->state() != CoalescedLoad::State::kPlanned;
+            }),
+        allCoalescedLoads_.end());
+  }
+}
+
+void CachedBufferedInput::ReadAheadQueue::nextLoadsLocked(
+    std::vector<std::shared_ptr<CoalescedLoad>>& loads) {
+  while (numOutstanding < maxOutstanding && !pending.empty()) {
+    auto load = std::move(pending.front());
+    pending.pop_front();
+    // A stream may have loaded it in the meantime or the input may have
+    // cancelled it.
+    if (load->state() == CoalescedLoad::State::kPlanned) {
+      ++numOutstanding;
+      loads.push_back(std::move(load));
     }
   }
 }
 
+// static
+void CachedBufferedInput::scheduleReadAhead(
+    std::shared_ptr<ReadAheadQueue> queue,
+    std::shared_ptr<CoalescedLoad> load,
+    folly::Executor* executor) {
+  executor->add([queue = std::move(queue),
+                 pendingLoad = std::move(load),
+                 executor]() {
+    process::TraceContext trace("Read Ahead");
+    pendingLoad->loadOrFuture(nullptr);
+    std::vector<std::shared_ptr<CoalescedLoad>> next;
+    {
+      std::lock_guard<std::mutex> l(queue->mutex);
+      --queue->numOutstanding;
+      queue->nextLoadsLocked(next);
+    }
+    for (auto& nextLoad : next) {
+      scheduleReadAhead(queue, std::move(nextLoad), executor);
+    }
+  });
+}
+
 namespace {
 // Base class for CoalescedLoads for different storage types.
 class DwioCoalescedLoadBase : public cache::CoalescedLoad {
@@ -381,10 +459,12 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      std::shared_ptr<IoTuner> ioTuner)
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        ioTuner_(std::move(ioTuner)) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<CachePin> pins;
@@ -401,6 +481,10 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
+    if (input_->hasReadAsync()) {
+      updateStats(readPinsAsync(pins), isPrefetch, false);
+      return pins;
+    }
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -411,14 +495,75 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          if (!ioTuner_) {
+            input_->read(buffers, offset, LogType::FILE);
+            return;
+          }
+          uint64_t usec = 0;
+          {
+            MicrosecondTimer timer(&usec);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          uint64_t bytes = 0;
+          for (const auto& buffer : buffers) {
+            bytes += buffer.size();
+          }
+          ioTuner_->recordRead(bytes, usec);
         });
     updateStats(stats, isPrefetch, false);
     return pins;
   }
 
+  // Issues the reads of 'pins' with readAsync() so that they run in parallel
+  // and waits for all of them. The tuner sees the whole load as one read.
+  CoalesceIoStats readPinsAsync(const std::vector<CachePin>& pins) {
+    // The ranges of each read stay live until the reads are done. A deque
+    // does not move its elements on push_back().
+    std::deque<std::vector<folly::Range<char*>>> ranges;
+    std::vector<folly::SemiFuture<uint64_t>> futures;
+    uint64_t bytes = 0;
+    uint64_t usec = 0;
+    CoalesceIoStats stats;
+    {
+      MicrosecondTimer timer(&usec);
+      stats = cache::readPins(
+          pins,
+          maxCoalesceDistance_,
+          1000,
+          [&](int32_t i) { return pins[i].entry()->offset(); },
+          [&](const std::vector<CachePin>& /*pins*/,
+              int32_t /*begin*/,
+              int32_t /*end*/,
+              uint64_t offset,
+              const std::vector<folly::Range<char*>>& buffers) {
+            for (const auto& buffer : buffers) {
+              bytes += buffer.size();
+            }
+            ranges.push_back(buffers);
+            futures.push_back(
+                input_->readAsync(ranges.back(), offset, LogType::FILE));
+          });
+      // Rethrows the first error after all the reads are done.
+      uint64_t readBytes = 0;
+      for (auto& result : folly::collectAll(std::move(futures)).get()) {
+        readBytes += result.value();
+      }
+      VELOX_CHECK_EQ(
+          readBytes,
+          bytes,
+          "Should read exactly as requested. File name: {}",
+          input_->getName());
+    }
+    if (ioTuner_) {
+      ioTuner_->recordRead(bytes, usec);
+    }
+    return stats;
+  }
+
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  // Receives the size and latency of each IO. nullptr if not adaptive.
+  const std::shared_ptr<IoTuner> ioTuner_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -472,7 +617,8 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        ioParameters_.coalesceDistance,
+        options_.ioTuner());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
@@ -513,7 +659,7 @@ std::unique_ptr<SeekableInputStream> CachedBufferedInput::read(
       nullptr,
       TrackingId(),
       0,
-      options_.loadQuantum());
+      ioParameters_.loadQuantum);
 }
 
 bool CachedBufferedInput::prefetch(Region region) {
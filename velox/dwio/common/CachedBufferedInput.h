@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <deque>
+#include <limits>
+#include <mutex>
+
 #include <folly/Executor.h>
 
 #include "velox/common/caching/FileGroupStats.h"
@@ -25,6 +29,7 @@
 #include "velox/dwio/common/CacheInputStream.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/IoStatistics.h"
+#include "velox/dwio/common/IoTuner.h"
 #include "velox/dwio/common/Options.h"
 
 DECLARE_int32(cache_load_quantum);
@@ -77,7 +82,9 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions) {
+    updateIoParameters();
+  }
 
   CachedBufferedInput(
       std::shared_ptr<ReadFileInputStream> input,
@@ -96,12 +103,16 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(readerOptions) {
+    updateIoParameters();
+  }
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
       load->cancel();
     }
+    std::lock_guard<std::mutex> l(readAhead_->mutex);
+    readAhead_->pending.clear();
   }
 
   std::unique_ptr<SeekableInputStream> enqueue(
@@ -163,7 +174,47 @@ class CachedBufferedInput : public BufferedInput {
     return prefetchSize_;
   }
 
+  /// Returns the tuner that receives the latency and size of reads from
+  /// 'input_' or nullptr if IO sizes are not adaptive.
+  IoTuner* FOLLY_NULLABLE ioTuner() const {
+    return options_.ioTuner().get();
+  }
+
+  /// Returns the IO parameters in effect for the current enqueue/load cycle.
+  const IoParameters& ioParameters() const {
+    return ioParameters_;
+  }
+
  private:
+  // Read-ahead loads of this input. Shared with the executor tasks so that a
+  // finishing load can start the next one without referencing the input.
+  struct ReadAheadQueue {
+    // Moves the loads that can start now from 'pending' to 'loads'. Must be
+    // called under 'mutex'.
+    void nextLoadsLocked(
+        std::vector<std::shared_ptr<cache::CoalescedLoad>>& loads);
+
+    std::mutex mutex;
+    // Loads waiting for 'numOutstanding' to drop below 'maxOutstanding'.
+    std::deque<std::shared_ptr<cache::CoalescedLoad>> pending;
+    // Loads queued on or loading in the executor.
+    int32_t numOutstanding{0};
+    int32_t maxOutstanding{std::numeric_limits<int32_t>::max()};
+  };
+
+  // Runs 'load' on 'executor' and then schedules the next pending loads of
+  // 'queue'.
+  static void scheduleReadAhead(
+      std::shared_ptr<ReadAheadQueue> queue,
+      std::shared_ptr<cache::CoalescedLoad> load,
+      folly::Executor* FOLLY_NONNULL executor);
+
+  // Sets 'ioParameters_' for the next cycle of enqueue() and load() from
+  // 'ioTuner()' and records the choice in 'ioStats_'. The parameters stay
+  // fixed between the two so that streams and their loads agree on the
+  // load quantum.
+  void updateIoParameters();
+
   // Sorts requests and makes CoalescedLoads for nearby requests. If 'prefetch'
   // is true, starts background loading.
   void makeLoads(std::vector<CacheRequest*> requests, bool prefetch);
@@ -194,9 +245,19 @@ class CachedBufferedInput : public BufferedInput {
   // Distinct coalesced loads in 'coalescedLoads_'.
   std::vector<std::shared_ptr<cache::CoalescedLoad>> allCoalescedLoads_;
 
+  // Read-ahead loads that wait for the read-ahead depth.
+  const std::shared_ptr<ReadAheadQueue> readAhead_{
+      std::make_shared<ReadAheadQueue>()};
+
   const uint64_t fileSize_;
   int64_t prefetchSize_{0};
   ReaderOptions options_;
+
+  // Coalesce distance, load quantum and read-ahead depth. These are the
+  // values in 'options_' unless adapted by 'options_.ioTuner()'.
+  IoParameters ioParameters_;
+  // False until the first updateIoParameters().
+  bool hasIoParameters_{false};
 };
 
 } // namespace facebook::velox::dwio::common
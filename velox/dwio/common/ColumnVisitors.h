@@ -512,6 +512,24 @@ void ExtractToReader<TReader>::addNull(vector_size_t /*rowIndex*/) {
 
 enum FilterResult { kUnknown = 0x40, kSuccess = 0x80, kFailure = 0 };
 
+// Applies 'filter' to each of the 'numValues' strings in 'values' and sets
+// the corresponding entries of 'filterCache' to kSuccess or kFailure. This
+// is done once when a dictionary is loaded so that the visitors find all
+// entries decided. Returns the number of entries that pass.
+inline int32_t fillStringFilterCache(
+    const velox::common::Filter& filter,
+    const StringView* values,
+    int32_t numValues,
+    uint8_t* filterCache) {
+  int32_t numPassed = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    const bool passed = filter.testBytes(values[i].data(), values[i].size());
+    filterCache[i] = passed ? FilterResult::kSuccess : FilterResult::kFailure;
+    numPassed += passed;
+  }
+  return numPassed;
+}
+
 namespace detail {
 
 template <typename T, typename A>
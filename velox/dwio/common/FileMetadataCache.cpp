@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+// Unused reservation above which the reservation is shrunk after evictions.
+// MemoryPool::maybeReserve() grows in 8MB steps.
+constexpr int64_t kMaxUnusedReservation = 16 << 20;
+} // namespace
+
+FileMetadataCache::FileMetadataCache(
+    uint64_t capacity,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : capacity_(capacity), pool_(std::move(pool)) {
+  VELOX_CHECK(
+      pool_ == nullptr || pool_->isLeaf(),
+      "FileMetadataCache needs a leaf memory pool");
+}
+
+FileMetadataCache::~FileMetadataCache() {
+  clear();
+}
+
+std::shared_ptr<const CachedFileMetadata> FileMetadataCache::findEntry(
+    const FileMetadataKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++stats_.numMisses;
+    return nullptr;
+  }
+  ++stats_.numHits;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::insert(
+    const FileMetadataKey& key,
+    std::shared_ptr<const CachedFileMetadata> metadata) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  const auto size = metadata->size();
+  if (size > capacity_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) > 0) {
+    return;
+  }
+  while (!lru_.empty() && bytes_ + size > capacity_) {
+    evictLocked();
+  }
+  while (!reserveLocked(size)) {
+    if (lru_.empty()) {
+      return;
+    }
+    evictLocked();
+    shrinkReservationLocked();
+  }
+  lru_.push_front({key, std::move(metadata), size});
+  entries_[key] = lru_.begin();
+  bytes_ += size;
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  lru_.clear();
+  entries_.clear();
+  bytes_ = 0;
+  if (pool_ != nullptr) {
+    pool_->release();
+  }
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  return stats;
+}
+
+void FileMetadataCache::evictLocked() {
+  auto& entry = lru_.back();
+  bytes_ -= entry.size;
+  entries_.erase(entry.key);
+  lru_.pop_back();
+  ++stats_.numEvictions;
+}
+
+bool FileMetadataCache::reserveLocked(uint64_t increment) {
+  if (pool_ == nullptr) {
+    return true;
+  }
+  const int64_t needed = bytes_ + increment;
+  const auto reserved = pool_->reservedBytes();
+  if (needed <= reserved) {
+    return true;
+  }
+  return pool_->maybeReserve(needed - reserved);
+}
+
+void FileMetadataCache::shrinkReservationLocked() {
+  if (pool_ == nullptr ||
+      pool_->reservedBytes() - static_cast<int64_t>(bytes_) <
+          kMaxUnusedReservation) {
+    return;
+  }
+  pool_->release();
+  // Re-reserving less than was just released only fails if another pool took
+  // the memory in between. Drops the entries in that case since they are no
+  // longer accounted for.
+  while (bytes_ > 0 && !pool_->maybeReserve(bytes_)) {
+    evictLocked();
+  }
+}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+FileMetadataCache** FileMetadataCache::getInstancePtr() {
+  static FileMetadataCache* cache_{nullptr};
+  return &cache_;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Parsed metadata of a file, e.g. the PostScript and footer of a DWRF file
+/// or the FileMetaData of a Parquet file. Immutable once cached so that it can
+/// be shared by concurrent readers of the file.
+class CachedFileMetadata {
+ public:
+  virtual ~CachedFileMetadata() = default;
+
+  /// Returns the approximate memory footprint in bytes.
+  virtual uint64_t size() const = 0;
+};
+
+/// Identifies a version of a file. 'fileId' is the id of the file path in
+/// fileIds(). 'modificationTime' distinguishes a file that was replaced under
+/// the same path.
+struct FileMetadataKey {
+  uint64_t fileId;
+  int64_t modificationTime;
+
+  bool operator==(const FileMetadataKey& other) const {
+    return fileId == other.fileId && modificationTime == other.modificationTime;
+  }
+};
+
+struct FileMetadataKeyHasher {
+  size_t operator()(const FileMetadataKey& key) const {
+    return folly::hash::hash_combine(key.fileId, key.modificationTime);
+  }
+};
+
+/// Process-wide LRU cache of parsed file metadata. Opening a reader on a file
+/// whose metadata is cached skips reading and parsing the footer. The total
+/// size of the entries is bounded by 'capacity' and is reserved in 'pool' so
+/// that the memory shows up in the memory accounting of the process. Entries
+/// are evicted when the capacity is exceeded or when the reservation cannot be
+/// increased. Thread-safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    int64_t numHits{0};
+    int64_t numMisses{0};
+    int64_t numEvictions{0};
+    int64_t numEntries{0};
+    int64_t bytes{0};
+  };
+
+  /// 'pool' is a leaf pool owned by the cache. If nullptr, sizes are only
+  /// checked against 'capacity'.
+  FileMetadataCache(
+      uint64_t capacity,
+      std::shared_ptr<memory::MemoryPool> pool = nullptr);
+
+  ~FileMetadataCache();
+
+  /// Returns the metadata for 'key' or nullptr if not cached or if the cached
+  /// entry is not a 'T'.
+  template <typename T>
+  std::shared_ptr<const T> find(const FileMetadataKey& key) {
+    return std::dynamic_pointer_cast<const T>(findEntry(key));
+  }
+
+  /// Adds 'metadata' for 'key'. Keeps the existing entry if another reader
+  /// added one first. 'metadata' is not cached if it does not fit.
+  void insert(
+      const FileMetadataKey& key,
+      std::shared_ptr<const CachedFileMetadata> metadata);
+
+  /// Removes all entries.
+  void clear();
+
+  Stats stats() const;
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+  /// Returns the process-wide cache or nullptr if none is installed.
+  static FileMetadataCache* getInstance();
+
+  /// Installs the process-wide cache. The caller keeps ownership.
+  static void setInstance(FileMetadataCache* cache);
+
+ private:
+  struct Entry {
+    FileMetadataKey key;
+    std::shared_ptr<const CachedFileMetadata> metadata;
+    uint64_t size;
+  };
+
+  std::shared_ptr<const CachedFileMetadata> findEntry(
+      const FileMetadataKey& key);
+
+  // Removes the least recently used entry. Must be called under 'mutex_'.
+  void evictLocked();
+
+  // Grows the reservation in 'pool_' to cover 'bytes_' plus 'increment'.
+  // Returns false if the reservation could not be increased. Must be called
+  // under 'mutex_'.
+  bool reserveLocked(uint64_t increment);
+
+  // Shrinks the reservation in 'pool_' if it is much larger than 'bytes_'.
+  // Must be called under 'mutex_'.
+  void shrinkReservationLocked();
+
+  static FileMetadataCache** getInstancePtr();
+
+  const uint64_t capacity_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<
+      FileMetadataKey,
+      std::list<Entry>::iterator,
+      FileMetadataKeyHasher>
+      entries_;
+  uint64_t bytes_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -105,6 +105,9 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  tunedCoalesceDistance_.merge(other.tunedCoalesceDistance_);
+  tunedLoadQuantum_.merge(other.tunedLoadQuantum_);
+  tunedMaxOutstandingLoads_.merge(other.tunedMaxOutstandingLoads_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
@@ -99,6 +99,18 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& tunedCoalesceDistance() {
+    return tunedCoalesceDistance_;
+  }
+
+  IoCounter& tunedLoadQuantum() {
+    return tunedLoadQuantum_;
+  }
+
+  IoCounter& tunedMaxOutstandingLoads() {
+    return tunedMaxOutstandingLoads_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -139,6 +151,12 @@ class IoStatistics {
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // IO parameters chosen by IoTuner, one increment per tuning decision. The
+  // average is sum() / count().
+  IoCounter tunedCoalesceDistance_;
+  IoCounter tunedLoadQuantum_;
+  IoCounter tunedMaxOutstandingLoads_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/IoTuner.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+// Rounds 'size' up to a power of 2 so that loads of different tuning cycles
+// stay aligned with each other in the cache.
+int64_t nextPowerOf2(int64_t size) {
+  int64_t result = 1;
+  while (result < size) {
+    result <<= 1;
+  }
+  return result;
+}
+} // namespace
+
+void IoTuner::recordRead(uint64_t bytes, uint64_t micros) {
+  if (bytes == 0) {
+    return;
+  }
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+  weight_ = weight_ * kDecay + 1;
+  sumX_ = sumX_ * kDecay + x;
+  sumY_ = sumY_ * kDecay + y;
+  sumXx_ = sumXx_ * kDecay + x * x;
+  sumXy_ = sumXy_ * kDecay + x * y;
+}
+
+bool IoTuner::fitLocked(double& latency, double& bytesPerMicro) const {
+  if (numReads_ < kMinSamples) {
+    return false;
+  }
+  const double denominator = weight_ * sumXx_ - sumX_ * sumX_;
+  // Require the sizes to differ by some percent of their mean, otherwise
+  // the slope is dominated by noise.
+  if (denominator <= 0.0001 * sumX_ * sumX_) {
+    return false;
+  }
+  const double microsPerByte =
+      (weight_ * sumXy_ - sumX_ * sumY_) / denominator;
+  if (microsPerByte <= 0) {
+    return false;
+  }
+  latency = std::max<double>(0, (sumY_ - microsPerByte * sumX_) / weight_);
+  bytesPerMicro = 1 / microsPerByte;
+  return true;
+}
+
+double IoTuner::latencyMicros() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  double latency;
+  double bytesPerMicro;
+  return fitLocked(latency, bytesPerMicro) ? latency : 0;
+}
+
+double IoTuner::bytesPerMicro() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  double latency;
+  double bytesPerMicro;
+  return fitLocked(latency, bytesPerMicro) ? bytesPerMicro : 0;
+}
+
+IoParameters IoTuner::parameters() const {
+  double latency;
+  double bytesPerMicro;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!fitLocked(latency, bytesPerMicro)) {
+      return {coalesceDistance_, loadQuantum_, kMaxOutstandingLoads};
+    }
+  }
+  // Bytes that could have been transferred during the latency of one request.
+  // Reading a gap smaller than this is cheaper than issuing another request.
+  const double breakEven = latency * bytesPerMicro;
+
+  IoParameters result;
+  result.coalesceDistance = std::clamp<int64_t>(
+      breakEven, kMinCoalesceDistance, kMaxCoalesceDistance);
+
+  // A load of 4x the break even size spends at most 20% of its time waiting
+  // for the first byte.
+  const int32_t minQuantum = std::min(kMinLoadQuantum, loadQuantum_);
+  result.loadQuantum = std::clamp<int64_t>(
+      nextPowerOf2(static_cast<int64_t>(4 * breakEven)),
+      minQuantum,
+      loadQuantum_);
+
+  // Keep one more load in flight for each millisecond of latency so that high
+  // latency storage is read with enough parallelism to hide the wait.
+  result.maxOutstandingLoads = std::clamp<int32_t>(
+      1 + std::ceil(latency / 1000), 2, kMaxOutstandingLoads);
+  return result;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace facebook::velox::dwio::common {
+
+/// IO sizes chosen by IoTuner for the next batch of loads.
+struct IoParameters {
+  /// Maximum gap in bytes between two ranges that are read in one IO.
+  int32_t coalesceDistance;
+
+  /// Maximum size of a single cache entry load.
+  int32_t loadQuantum;
+
+  /// Maximum number of CoalescedLoads concurrently scheduled for read-ahead.
+  int32_t maxOutstandingLoads;
+
+  bool operator==(const IoParameters& other) const {
+    return coalesceDistance == other.coalesceDistance &&
+        loadQuantum == other.loadQuantum &&
+        maxOutstandingLoads == other.maxOutstandingLoads;
+  }
+
+  bool operator!=(const IoParameters& other) const {
+    return !(*this == other);
+  }
+};
+
+/// Adapts the IO sizes of CachedBufferedInput to the latency and bandwidth
+/// observed on a ReadFile. Completed reads are reported with recordRead(). The
+/// tuner fits 'time = latency + bytes / bandwidth' by least squares over an
+/// exponentially decaying window of recent reads and derives the coalesce gap,
+/// load quantum and read-ahead depth from the product of latency and
+/// bandwidth, i.e. the number of bytes that could have been transferred while
+/// waiting for one request to start. High latency storage like S3 gets large
+/// coalesced reads and deep read-ahead, low latency local storage gets small
+/// gaps so that bandwidth is not spent on unused bytes. Until enough reads
+/// have been seen, the configured sizes are returned unchanged with the
+/// maximum read-ahead depth. Thread-safe.
+class IoTuner {
+ public:
+  /// Minimum number of reads before the fitted model is used.
+  static constexpr int32_t kMinSamples = 8;
+
+  /// Weight of the previous samples when adding a new one.
+  static constexpr double kDecay = 0.95;
+
+  static constexpr int32_t kMinCoalesceDistance = 16 << 10; // 16K
+  static constexpr int32_t kMaxCoalesceDistance = 8 << 20; // 8MB
+  static constexpr int32_t kMinLoadQuantum = 1 << 20; // 1MB
+  static constexpr int32_t kMaxOutstandingLoads = 32;
+
+  /// 'loadQuantum' and 'coalesceDistance' are the configured values. The tuned
+  /// load quantum never exceeds 'loadQuantum' since it bounds the memory of a
+  /// single read.
+  IoTuner(int32_t loadQuantum, int32_t coalesceDistance)
+      : loadQuantum_(loadQuantum), coalesceDistance_(coalesceDistance) {}
+
+  /// Records a read of 'bytes' that took 'micros' microseconds end to end.
+  void recordRead(uint64_t bytes, uint64_t micros);
+
+  /// Returns the parameters for the next loads.
+  IoParameters parameters() const;
+
+  /// Returns the estimated latency of a request in microseconds. Returns 0 if
+  /// not enough reads have been recorded.
+  double latencyMicros() const;
+
+  /// Returns the estimated transfer rate in bytes per microsecond, which is
+  /// the same as MB/s. Returns 0 if not enough reads have been recorded.
+  double bytesPerMicro() const;
+
+  int32_t numReads() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numReads_;
+  }
+
+ private:
+  // Fits the model from the accumulated sums. Returns false if the samples do
+  // not determine both latency and bandwidth, e.g. all reads had the same
+  // size. Must be called under 'mutex_'.
+  bool fitLocked(double& latency, double& bytesPerMicro) const;
+
+  const int32_t loadQuantum_;
+  const int32_t coalesceDistance_;
+
+  mutable std::mutex mutex_;
+
+  int32_t numReads_{0};
+
+  // Decayed sums for weighted least squares of micros (y) over bytes (x).
+  double weight_{0};
+  double sumX_{0};
+  double sumY_{0};
+  double sumXx_{0};
+  double sumXy_{0};
+};
+
+} // namespace facebook::velox::dwio::common
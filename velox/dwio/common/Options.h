@@ -17,6 +17,7 @@
 #pragma once
 
 #include <limits>
+#include <optional>
 #include <unordered_set>
 
 #include <folly/Executor.h>
@@ -24,9 +25,11 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/ErrorTolerance.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/common/FlushPolicy.h"
 #include "velox/dwio/common/InputStream.h"
+#include "velox/dwio/common/IoTuner.h"
 #include "velox/dwio/common/ScanSpec.h"
 #include "velox/dwio/common/encryption/Encryption.h"
 
@@ -107,6 +110,8 @@ class RowReaderOptions {
   bool preloadStripe;
   bool projectSelectedType;
   bool returnFlatVector_ = false;
+  // See setMaxDictionaryToBatchRatio().
+  uint32_t maxDictionaryToBatchRatio_ = 16;
   ErrorTolerance errorTolerance_;
   std::shared_ptr<ColumnSelector> selector_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_ = nullptr;
@@ -119,6 +124,15 @@ class RowReaderOptions {
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
   std::shared_ptr<folly::Executor> ioExecutor_;
+  // Number of stripes or row groups of the range that are decoded at the
+  // same time on 'decodingExecutor_'. 1 decodes on the calling thread.
+  int32_t decodingParallelism_ = 1;
+  // Max number of decoded batches buffered ahead of the consumer when
+  // decoding in parallel. 0 means two per stripe or row group in flight.
+  int32_t maxBufferedBatches_ = 0;
+  // If false, batches decoded in parallel are returned as they are ready
+  // instead of in file order.
+  bool preserveOrder_ = true;
   bool appendRowNumberColumn_ = false;
   // Function to populate metrics related to feature projection stats
   // in Koski. This gets fired in FlatMapColumnReader.
@@ -237,6 +251,31 @@ class RowReaderOptions {
     returnFlatVector_ = value;
   }
 
+  /// Dictionaries with at most this many entries are always returned as
+  /// DictionaryVectors, whatever the size of the batch.
+  static constexpr uint32_t kMinFlattenedDictionarySize = 4096;
+
+  /// Dictionary encoded strings are returned as DictionaryVectors over the
+  /// file dictionary unless the dictionary is larger than 'ratio' times the
+  /// rows of the batch. Hashing or filtering such a batch would touch every
+  /// dictionary entry for a few rows. 0 always keeps the dictionary.
+  void setMaxDictionaryToBatchRatio(uint32_t ratio) {
+    maxDictionaryToBatchRatio_ = ratio;
+  }
+
+  uint32_t maxDictionaryToBatchRatio() const {
+    return maxDictionaryToBatchRatio_;
+  }
+
+  /// True if a batch of 'numRows' rows over a dictionary of
+  /// 'dictionarySize' entries is returned flat.
+  bool shouldFlattenDictionary(uint64_t dictionarySize, uint64_t numRows)
+      const {
+    return maxDictionaryToBatchRatio_ > 0 &&
+        dictionarySize > kMinFlattenedDictionarySize &&
+        dictionarySize > maxDictionaryToBatchRatio_ * numRows;
+  }
+
   /**
    * Request that the selected type be projected.
    */
@@ -308,6 +347,43 @@ class RowReaderOptions {
     ioExecutor_ = executor;
   }
 
+  /// Decodes up to 'parallelism' stripes or row groups of the range at the
+  /// same time on the decoding executor. Has no effect without a decoding
+  /// executor. Batches are returned in file order if 'preserveOrder' is
+  /// true. At most 'maxBufferedBatches' decoded batches are held ahead of
+  /// the consumer, 0 meaning two for each stripe or row group in flight.
+  void setDecodingParallelism(
+      int32_t parallelism,
+      bool preserveOrder = true,
+      int32_t maxBufferedBatches = 0) {
+    VELOX_CHECK_GT(parallelism, 0);
+    VELOX_CHECK_GE(maxBufferedBatches, 0);
+    decodingParallelism_ = parallelism;
+    preserveOrder_ = preserveOrder;
+    maxBufferedBatches_ = maxBufferedBatches;
+  }
+
+  int32_t decodingParallelism() const {
+    return decodingParallelism_;
+  }
+
+  bool preserveOrder() const {
+    return preserveOrder_;
+  }
+
+  int32_t maxBufferedBatches() const {
+    return maxBufferedBatches_ > 0 ? maxBufferedBatches_
+                                   : 2 * decodingParallelism_;
+  }
+
+  /// True if the stripes or row groups of the range should be decoded in
+  /// parallel. This is not supported together with row numbers or skipping
+  /// rows, which depend on the order of reading.
+  bool useParallelDecoding() const {
+    return decodingExecutor_ && decodingParallelism_ > 1 &&
+        !appendRowNumberColumn_ && skipRows_ == 0;
+  }
+
   /*
    * Set to true, if you want to add a new column to the results containing the
    * row numbers.  These row numbers are relative to the beginning of file (0 as
@@ -399,6 +475,10 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  std::shared_ptr<IoTuner> ioTuner_;
+  FileMetadataCache* fileMetadataCache_{nullptr};
+  std::optional<FileMetadataKey> fileMetadataKey_;
+  std::optional<int32_t> prefetchRowGroups_;
   SerDeOptions serDeOptions;
   std::shared_ptr<encryption::DecrypterFactory> decrypterFactory_;
   uint64_t directorySizeGuess{kDefaultDirectorySizeGuess};
@@ -439,8 +519,13 @@ class ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    loadQuantum_ = other.loadQuantum_;
     maxCoalesceDistance_ = other.maxCoalesceDistance_;
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
+    ioTuner_ = other.ioTuner_;
+    fileMetadataCache_ = other.fileMetadataCache_;
+    fileMetadataKey_ = other.fileMetadataKey_;
+    prefetchRowGroups_ = other.prefetchRowGroups_;
     return *this;
   }
 
@@ -521,6 +606,46 @@ class ReaderOptions {
     maxCoalesceBytes_ = bytes;
     return *this;
   }
+  /**
+   * Enable adaptive coalescing, load quantum and read-ahead depth. The load
+   * quantum and coalesce distance above become the starting values and
+   * 'tuner' receives the measured reads. A tuner may be shared by readers of
+   * files on the same storage. nullptr disables tuning.
+   */
+  ReaderOptions& setIoTuner(std::shared_ptr<IoTuner> tuner) {
+    ioTuner_ = std::move(tuner);
+    return *this;
+  }
+
+  /**
+   * Set the cache of parsed file metadata. The metadata of the file is looked
+   * up and added only if a key is set with setFileMetadataKey(). The cache
+   * must outlive the readers. nullptr disables caching.
+   */
+  ReaderOptions& setFileMetadataCache(FileMetadataCache* cache) {
+    fileMetadataCache_ = cache;
+    return *this;
+  }
+
+  /**
+   * Set the identity of the file being read for looking up its metadata in
+   * the FileMetadataCache. Must be reset when the options are reused for a
+   * file that has no key.
+   */
+  ReaderOptions& setFileMetadataKey(std::optional<FileMetadataKey> key) {
+    fileMetadataKey_ = key;
+    return *this;
+  }
+
+  /**
+   * Set the number of row groups after the one being read that are loaded
+   * ahead of use. Formats without row groups ignore this. If not set, the
+   * format uses its own default.
+   */
+  ReaderOptions& setPrefetchRowGroups(int32_t numRowGroups) {
+    prefetchRowGroups_ = numRowGroups;
+    return *this;
+  }
 
   /**
    * Modify the serialization-deserialization options.
@@ -605,6 +730,22 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  const std::shared_ptr<IoTuner>& ioTuner() const {
+    return ioTuner_;
+  }
+
+  FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_;
+  }
+
+  const std::optional<FileMetadataKey>& fileMetadataKey() const {
+    return fileMetadataKey_;
+  }
+
+  const std::optional<int32_t>& prefetchRowGroups() const {
+    return prefetchRowGroups_;
+  }
+
   SerDeOptions& getSerDeOptions() {
     return serDeOptions;
   }
@@ -65,6 +65,10 @@ class BufferedOutputStream : public google::protobuf::io::ZeroCopyOutputStream {
   /// expected increment so buffer allocation is more efficient
   virtual bool Next(void** data, int32_t* size, uint64_t increment);
 
+  /// Writes out the buffered data and returns the number of bytes added to
+  /// the output. A stream may defer writing its data, see
+  /// PagedOutputStream::flush(). Use size() after the deferred work is done
+  /// for the final size.
   virtual uint64_t flush();
 
   virtual std::string getName() const {
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ParallelRowReader.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+// Returns true if the value of 'decoded' at 'row' passes 'filter'. 'kind' is
+// the kind of the type of the values.
+bool testValue(
+    const velox::common::Filter& filter,
+    const DecodedVector& decoded,
+    vector_size_t row,
+    TypeKind kind) {
+  if (decoded.isNullAt(row)) {
+    return filter.testNull();
+  }
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      return filter.testBool(decoded.valueAt<bool>(row));
+    case TypeKind::TINYINT:
+      return filter.testInt64(decoded.valueAt<int8_t>(row));
+    case TypeKind::SMALLINT:
+      return filter.testInt64(decoded.valueAt<int16_t>(row));
+    case TypeKind::INTEGER:
+      return filter.testInt64(decoded.valueAt<int32_t>(row));
+    case TypeKind::BIGINT:
+      return filter.testInt64(decoded.valueAt<int64_t>(row));
+    case TypeKind::HUGEINT:
+      return filter.testInt128(decoded.valueAt<int128_t>(row));
+    case TypeKind::REAL:
+      return filter.testFloat(decoded.valueAt<float>(row));
+    case TypeKind::DOUBLE:
+      return filter.testDouble(decoded.valueAt<double>(row));
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto value = decoded.valueAt<StringView>(row);
+      return filter.testBytes(value.data(), value.size());
+    }
+    case TypeKind::TIMESTAMP:
+      return filter.testTimestamp(decoded.valueAt<Timestamp>(row));
+    default:
+      // A filter on a complex type column can only be IS NULL or IS NOT
+      // NULL.
+      return filter.testNonNull();
+  }
+}
+
+} // namespace
+
+ParallelRowReader::ParallelRowReader(
+    std::vector<uint64_t> unitOffsets,
+    const RowReaderOptions& options,
+    RowReaderFactory factory)
+    : options_(options),
+      factory_(std::move(factory)),
+      parallelism_(options.decodingParallelism()),
+      preserveOrder_(options.preserveOrder()),
+      maxBatchesPerUnit_(std::max<int32_t>(
+          1,
+          bits::roundUp(options.maxBufferedBatches(), parallelism_) /
+              parallelism_)) {
+  VELOX_CHECK_NOT_NULL(options_.getDecodingExecutor());
+  VELOX_CHECK_NOT_NULL(options_.getScanSpec());
+  units_.reserve(unitOffsets.size());
+  for (auto offset : unitOffsets) {
+    units_.push_back(std::make_unique<Unit>(offset));
+  }
+}
+
+ParallelRowReader::~ParallelRowReader() {
+  std::unique_lock<std::mutex> l(mutex_);
+  cancelled_ = true;
+  consumerCv_.wait(l, [&]() { return numRunning_ == 0; });
+}
+
+// static
+std::vector<uint64_t> ParallelRowReader::unitsInRange(
+    const std::vector<uint64_t>& offsets,
+    const RowReaderOptions& options) {
+  std::vector<uint64_t> units;
+  for (auto offset : offsets) {
+    if (offset >= options.getOffset() && offset < options.getLimit()) {
+      units.push_back(offset);
+    }
+  }
+  return units;
+}
+
+void ParallelRowReader::startUnits() {
+  active_.remove_if(
+      [](const Unit* unit) { return unit->done && unit->batches.empty(); });
+  while (active_.size() < static_cast<size_t>(parallelism_) &&
+         nextUnit_ < units_.size()) {
+    auto* unit = units_[nextUnit_++].get();
+    // The copy is made on the consumer thread, which is the one that changes
+    // the ScanSpec when adding dynamic filters.
+    unit->scanSpec = options_.getScanSpec()->deepCopy();
+    unit->filterVersion = filterVersion_;
+    active_.push_back(unit);
+    scheduleUnit(*unit);
+  }
+}
+
+void ParallelRowReader::scheduleUnit(Unit& unit) {
+  unit.scheduled = true;
+  ++numRunning_;
+  options_.getDecodingExecutor()->add([this, &unit]() { readBatch(unit); });
+}
+
+void ParallelRowReader::readBatch(Unit& unit) {
+  std::unique_ptr<RowReader> doneReader;
+  try {
+    uint64_t batchSize;
+    Filters newFilters;
+    int32_t filterVersion;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      batchSize = batchSize_;
+      newFilters.swap(unit.newFilters);
+      filterVersion = unit.filterVersion;
+    }
+    if (!newFilters.empty()) {
+      for (auto& [name, filter] : newFilters) {
+        unit.scanSpec->childByName(name)->setFilter(std::move(filter));
+      }
+      unit.scanSpec->resetCachedValues(true);
+      if (unit.reader) {
+        unit.reader->resetFilterCaches();
+      }
+    }
+    if (!unit.reader) {
+      auto options = options_;
+      options.range(unit.offset, 1);
+      options.setScanSpec(unit.scanSpec);
+      options.setDecodingParallelism(1);
+      unit.reader = factory_(options);
+    }
+    VectorPtr rows = BaseVector::create(resultType_, 0, pool_);
+    const auto rowsScanned = unit.reader->next(batchSize, rows);
+    if (rowsScanned > 0) {
+      // Lazy vectors would be loaded through the reader on the consumer
+      // thread while the reader is decoding the next batch.
+      rows->loadedVector();
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!estimatedRowSize_.has_value()) {
+      estimatedRowSize_ = unit.reader->estimatedRowSize();
+    }
+    if (rowsScanned == 0) {
+      unit.reader->updateRuntimeStats(stats_);
+      stats_.numFilterReorders += unit.scanSpec->numFilterReorders();
+      unit.done = true;
+      doneReader = std::move(unit.reader);
+    } else {
+      unit.batches.push_back({rowsScanned, std::move(rows), filterVersion});
+    }
+  } catch (const std::exception&) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+    unit.done = true;
+  }
+  // Frees the reader of a finished unit before the task exits.
+  doneReader.reset();
+  std::lock_guard<std::mutex> l(mutex_);
+  --numRunning_;
+  unit.scheduled = false;
+  if (!unit.done && !cancelled_ &&
+      unit.batches.size() < maxBatchesPerUnit_) {
+    scheduleUnit(unit);
+  }
+  consumerCv_.notify_all();
+}
+
+uint64_t ParallelRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const Mutation* mutation) {
+  VELOX_CHECK_NULL(
+      mutation, "Mutations are not supported when decoding in parallel");
+  VELOX_CHECK_GT(size, 0);
+  std::unique_lock<std::mutex> l(mutex_);
+  if (!resultType_) {
+    VELOX_CHECK_NOT_NULL(result);
+    resultType_ = result->type();
+    pool_ = result->pool();
+  }
+  batchSize_ = size;
+  for (;;) {
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    startUnits();
+    Unit* unit = nullptr;
+    for (auto* active : active_) {
+      if (!active->batches.empty()) {
+        unit = active;
+        break;
+      }
+      if (preserveOrder_) {
+        break;
+      }
+    }
+    if (unit) {
+      auto& batch = unit->batches.front();
+      filterBatch(batch);
+      if (batch.rows->size() > size) {
+        // Returns the first 'size' rows. The rows that did not pass the
+        // filters count as scanned with the rest of the batch, which has at
+        // least as many scanned rows as it has rows.
+        result = batch.rows->slice(0, size);
+        batch.rows = batch.rows->slice(size, batch.rows->size() - size);
+        batch.rowsScanned -= size;
+        return size;
+      }
+      result = std::move(batch.rows);
+      const auto rowsScanned = batch.rowsScanned;
+      unit->batches.pop_front();
+      if (!unit->scheduled && !unit->done) {
+        scheduleUnit(*unit);
+      }
+      return rowsScanned;
+    }
+    if (active_.empty()) {
+      return 0;
+    }
+    consumerCv_.wait(l);
+  }
+}
+
+void ParallelRowReader::filterBatch(Batch& batch) {
+  if (batch.filterVersion == filterVersion_) {
+    return;
+  }
+  batch.filterVersion = filterVersion_;
+  const auto* rows = batch.rows->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(rows);
+  const auto numRows = rows->size();
+  SelectivityVector passed(numRows);
+  DecodedVector decoded;
+  for (const auto& child : options_.getScanSpec()->children()) {
+    if (!child->filter() || !child->projectOut() ||
+        child->channel() >= rows->childrenSize()) {
+      // Dynamic filters are on projected columns. The other filters were
+      // applied when decoding.
+      continue;
+    }
+    const auto& values = rows->childAt(child->channel());
+    const auto kind = values->typeKind();
+    decoded.decode(*values);
+    passed.applyToSelected([&](auto row) {
+      if (!testValue(*child->filter(), decoded, row, kind)) {
+        passed.setValid(row, false);
+      }
+    });
+    passed.updateBounds();
+  }
+  const auto numPassed = passed.countSelected();
+  if (numPassed == numRows) {
+    return;
+  }
+  auto indices = allocateIndices(numPassed, pool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  passed.applyToSelected([&](auto row) { rawIndices[numIndices++] = row; });
+  std::vector<VectorPtr> children;
+  children.reserve(rows->childrenSize());
+  for (const auto& child : rows->children()) {
+    children.push_back(
+        BaseVector::wrapInDictionary(nullptr, indices, numPassed, child));
+  }
+  batch.rows = std::make_shared<RowVector>(
+      pool_, rows->type(), nullptr, numPassed, std::move(children));
+}
+
+int64_t ParallelRowReader::nextRowNumber() {
+  VELOX_UNSUPPORTED("Row numbers are not supported when decoding in parallel");
+}
+
+int64_t ParallelRowReader::nextReadSize(uint64_t /*size*/) {
+  VELOX_UNSUPPORTED("Read sizes are not supported when decoding in parallel");
+}
+
+void ParallelRowReader::updateRuntimeStats(RuntimeStatistics& stats) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  stats.skippedSplits += stats_.skippedSplits;
+  stats.skippedSplitBytes += stats_.skippedSplitBytes;
+  stats.skippedStrides += stats_.skippedStrides;
+  stats.skippedPageRows += stats_.skippedPageRows;
+  stats.numFilterReorders += stats_.numFilterReorders;
+}
+
+void ParallelRowReader::resetFilterCaches() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++filterVersion_;
+  for (auto* unit : active_) {
+    if (unit->done) {
+      continue;
+    }
+    unit->newFilters.clear();
+    for (const auto& child : options_.getScanSpec()->children()) {
+      unit->newFilters.emplace_back(
+          child->fieldName(),
+          child->filter() ? child->filter()->clone() : nullptr);
+    }
+    unit->filterVersion = filterVersion_;
+  }
+}
+
+std::optional<size_t> ParallelRowReader::estimatedRowSize() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return estimatedRowSize_;
+}
+
+bool ParallelRowReader::allPrefetchIssued() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return nextUnit_ == units_.size();
+}
+
+} // namespace facebook::velox::dwio::common
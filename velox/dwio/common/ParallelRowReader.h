@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+
+#include "velox/dwio/common/Reader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Reads the stripes or row groups of a range of a file in parallel on the
+/// decoding executor of the RowReaderOptions. Each stripe or row group is a
+/// unit that is read by its own RowReader with its own copy of the ScanSpec.
+/// Up to RowReaderOptions::decodingParallelism() units are read at a time.
+/// The decoded batches are buffered in a bounded queue per unit and returned
+/// by next() in file order or, if order is not preserved, as they become
+/// available.
+///
+/// Each task on the executor reads one batch of a unit and schedules the
+/// next batch of the unit as a new task. A unit whose queue is full has no
+/// task and no thread. It is scheduled again when next() takes a batch from
+/// its queue. The executor may be shared with other readers.
+///
+/// The batches are loaded on the decoding threads, so that lazy loading and
+/// aggregation pushdown do not apply. Mutations and row numbers are not
+/// supported.
+///
+/// Filters added to the ScanSpec during the read, e.g. dynamic filters of a
+/// join, are copied to the ScanSpec of each unit being read before its next
+/// batch. The batches that were decoded before are filtered again when
+/// next() returns them, so that all rows returned after the change pass the
+/// new filters.
+class ParallelRowReader : public RowReader {
+ public:
+  /// Makes a RowReader for 'options'.
+  using RowReaderFactory =
+      std::function<std::unique_ptr<RowReader>(const RowReaderOptions&)>;
+
+  /// 'unitOffsets' are the file offsets of the units in the range of
+  /// 'options' in file order. A unit is read by a RowReader made by
+  /// 'factory' for 'options' restricted to the range of the unit.
+  ParallelRowReader(
+      std::vector<uint64_t> unitOffsets,
+      const RowReaderOptions& options,
+      RowReaderFactory factory);
+
+  ~ParallelRowReader() override;
+
+  /// Returns the elements of 'offsets' that are in the range of 'options'.
+  /// A stripe or row group is in the range if its first byte is.
+  static std::vector<uint64_t> unitsInRange(
+      const std::vector<uint64_t>& offsets,
+      const RowReaderOptions& options);
+
+  /// Returns at most 'size' rows. Batches decoded before a call with a
+  /// smaller 'size' are split.
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const Mutation* mutation = nullptr) override;
+
+  int64_t nextRowNumber() override;
+
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(RuntimeStatistics& stats) const override;
+
+  /// Copies the filters of the ScanSpec of the options to the ScanSpecs of
+  /// the units being read before their next batch and resets the filter
+  /// caches of their readers. The units that start after this copy the
+  /// changed ScanSpec. The batches decoded with the earlier filters are
+  /// filtered again by next().
+  void resetFilterCaches() override;
+
+  std::optional<size_t> estimatedRowSize() const override;
+
+  bool allPrefetchIssued() const override;
+
+ private:
+  struct Batch {
+    // Number of rows scanned for the batch, including the rows that did not
+    // pass the filters.
+    uint64_t rowsScanned;
+    VectorPtr rows;
+    // Value of 'filterVersion_' for the filters that 'rows' passed.
+    int32_t filterVersion;
+  };
+
+  // The top level filters of a ScanSpec by field name.
+  using Filters = std::vector<
+      std::pair<std::string, std::unique_ptr<velox::common::Filter>>>;
+
+  struct Unit {
+    explicit Unit(uint64_t _offset) : offset(_offset) {}
+
+    const uint64_t offset;
+    std::shared_ptr<velox::common::ScanSpec> scanSpec;
+    // Made by the first task of the unit. Used by one task at a time.
+    std::unique_ptr<RowReader> reader;
+    std::deque<Batch> batches;
+    // True while a task for the unit is on the executor.
+    bool scheduled{false};
+    // Filters to set in 'scanSpec' before the next batch. Set by
+    // resetFilterCaches() on the consumer thread, which is the one that
+    // changes the ScanSpec of the options.
+    Filters newFilters;
+    // Value of 'filterVersion_' for the filters of 'scanSpec' after
+    // 'newFilters' are set.
+    int32_t filterVersion{0};
+    // True after the last batch of the unit is in 'batches'.
+    bool done{false};
+  };
+
+  // Drops the units that are fully consumed and starts reading units until
+  // 'parallelism_' units are being read or consumed. Called by the consumer
+  // with 'mutex_' held.
+  void startUnits();
+
+  // Adds a task that reads the next batch of 'unit' to the executor. Called
+  // with 'mutex_' held.
+  void scheduleUnit(Unit& unit);
+
+  // Reads the next batch of 'unit' on the executor and schedules the batch
+  // after it if the queue of 'unit' has space.
+  void readBatch(Unit& unit);
+
+  // Removes the rows of 'batch' that do not pass the filters of the ScanSpec
+  // of the options if they changed after 'batch' was decoded. Called with
+  // 'mutex_' held.
+  void filterBatch(Batch& batch);
+
+  const RowReaderOptions options_;
+  const RowReaderFactory factory_;
+  const int32_t parallelism_;
+  const bool preserveOrder_;
+  const size_t maxBatchesPerUnit_;
+
+  std::vector<std::unique_ptr<Unit>> units_;
+  // Index of the next unit to start reading.
+  size_t nextUnit_{0};
+  // The units that are started and not fully consumed in file order.
+  std::list<Unit*> active_;
+
+  // Type and pool of the batches, set on the first next().
+  TypePtr resultType_;
+  memory::MemoryPool* pool_{nullptr};
+  // Size of the batches to read, set by each next().
+  uint64_t batchSize_{0};
+  // Incremented by each resetFilterCaches().
+  int32_t filterVersion_{0};
+
+  mutable std::mutex mutex_;
+  // Signaled when a batch is added, a unit is done or a task exits.
+  std::condition_variable consumerCv_;
+  // Number of tasks on the executor.
+  int32_t numRunning_{0};
+  bool cancelled_{false};
+  std::exception_ptr error_;
+  // Stats of the units that are done.
+  RuntimeStatistics stats_;
+  std::optional<size_t> estimatedRowSize_;
+};
+
+} // namespace facebook::velox::dwio::common
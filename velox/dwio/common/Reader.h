@@ -147,6 +147,19 @@ class RowReader {
       const velox::common::ScanSpec&);
 };
 
+/// Row count and column statistics of one or more consecutive stripes or row
+/// groups.
+struct RowGroupStatistics {
+  /// The stripes or row groups are the ones read by a RowReader with the
+  /// range ['offset', 'offset' + 'length').
+  uint64_t offset;
+  uint64_t length;
+  uint64_t numRows;
+  /// Statistics of each top level column of the file schema. nullptr for a
+  /// column without statistics.
+  std::vector<std::unique_ptr<ColumnStatistics>> columns;
+};
+
 /**
  * Abstract reader class.
  *
@@ -177,6 +190,17 @@ class Reader {
   virtual std::unique_ptr<ColumnStatistics> columnStatistics(
       uint32_t index) const = 0;
 
+  /// Returns the row counts and column statistics of the stripes or row
+  /// groups that are read with the range ['offset', 'offset' + 'length'), in
+  /// file order. The statistics may be for groups of stripes or row groups
+  /// if the format has no finer grained statistics. Returns std::nullopt if
+  /// the format does not support this.
+  virtual std::optional<std::vector<RowGroupStatistics>> rowGroupStatistics(
+      uint64_t /*offset*/,
+      uint64_t /*length*/) const {
+    return std::nullopt;
+  }
+
   /**
    * Get the file schema.
    * @return file schema
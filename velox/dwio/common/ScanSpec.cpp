@@ -33,6 +33,7 @@ ScanSpec& ScanSpec::operator=(const ScanSpec& other) {
     metadataFilters_ = other.metadataFilters_;
     selectivity_ = other.selectivity_;
     enableFilterReorder_ = other.enableFilterReorder_;
+    numReorders_ = other.numReorders_;
     children_ = other.children_;
     stableChildren_ = other.stableChildren_;
     childByFieldName_ = other.childByFieldName_;
@@ -43,6 +44,21 @@ ScanSpec& ScanSpec::operator=(const ScanSpec& other) {
   return *this;
 }
 
+std::shared_ptr<ScanSpec> ScanSpec::deepCopy() const {
+  auto copy = std::make_shared<ScanSpec>(*this);
+  copy->children_.clear();
+  copy->stableChildren_.clear();
+  copy->childByFieldName_.clear();
+  for (const auto& child : children_) {
+    copy->children_.push_back(child->deepCopy());
+    copy->childByFieldName_[child->fieldName_] = copy->children_.back().get();
+  }
+  for (const auto* child : stableChildren_) {
+    copy->stableChildren_.push_back(copy->childByFieldName_[child->fieldName_]);
+  }
+  return copy;
+}
+
 ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
   auto container = this;
   auto& path = subfield.path();
@@ -67,20 +83,53 @@ uint64_t ScanSpec::newRead() {
   if (!numReads_) {
     reorder();
   } else if (enableFilterReorder_) {
-    for (auto i = 1; i < children_.size(); ++i) {
-      if (!children_[i]->filter_) {
-        break;
-      }
-      if (children_[i - 1]->selectivity_.timeToDropValue() >
-          children_[i]->selectivity_.timeToDropValue()) {
-        reorder();
-        break;
+    if (!isFilterOrderSorted()) {
+      reorder();
+      ++numReorders_;
+    }
+    if (numReads_ % kSelectivityDecayInterval == 0) {
+      for (auto& child : children_) {
+        if (!child->hasFilter()) {
+          break;
+        }
+        child->selectivity_.decay();
       }
     }
   }
   return numReads_++;
 }
 
+bool ScanSpec::isFilterOrderSorted() const {
+  for (auto i = 1; i < children_.size(); ++i) {
+    if (!children_[i]->filter_) {
+      break;
+    }
+    if (children_[i - 1]->selectivity_.timeToDropValue() >
+        children_[i]->selectivity_.timeToDropValue()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int64_t ScanSpec::numFilterReorders() const {
+  auto numReorders = numReorders_;
+  for (auto& child : children_) {
+    numReorders += child->numFilterReorders();
+  }
+  return numReorders;
+}
+
+std::vector<std::string> ScanSpec::filterOrder() const {
+  std::vector<std::string> names;
+  for (auto& child : children_) {
+    if (child->hasFilter()) {
+      names.push_back(child->fieldName_);
+    }
+  }
+  return names;
+}
+
 void ScanSpec::reorder() {
   if (children_.empty()) {
     return;
@@ -168,6 +217,7 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
           // received.
           child->filter_ = std::move(otherChild->filter_);
           child->selectivity_ = otherChild->selectivity_;
+          child->numReorders_ = otherChild->numReorders_;
         }
         childByFieldName_[child->fieldName_] = child.get();
         newChildren.push_back(std::move(child));
@@ -178,6 +228,7 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
     VELOX_CHECK(found);
   }
   children_ = std::move(newChildren);
+  numReorders_ = other.numReorders_;
   stableChildren_.clear();
   for (auto& otherChild : other.stableChildren_) {
     auto child = childByName(otherChild->fieldName_);
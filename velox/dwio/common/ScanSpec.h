@@ -216,6 +216,11 @@ class ScanSpec {
     return it->second;
   }
 
+  // Returns a copy of the tree under 'this' that can be used by a reader
+  // on another thread. The copy shares the filters and value hooks but not
+  // the children or the adaptation state that reading updates.
+  std::shared_ptr<ScanSpec> deepCopy() const;
+
   // Remove a child from this scan spec, returning the removed child.  This is
   // used for example to transform a flatmap scan spec into a struct scan spec.
   std::shared_ptr<ScanSpec> removeChild(const ScanSpec* child);
@@ -224,6 +229,14 @@ class ScanSpec {
     return selectivity_;
   }
 
+  // Returns the number of times the filter order of 'this' or its
+  // descendants changed after the first read.
+  int64_t numFilterReorders() const;
+
+  // Returns the field names of the children with filters in the order in
+  // which the filters are evaluated.
+  std::vector<std::string> filterOrder() const;
+
   ValueHook* valueHook() const {
     return valueHook_;
   }
@@ -275,6 +288,10 @@ class ScanSpec {
     }
   }
 
+  // Filters are reordered by their measured selectivity on each read when
+  // enabled. The measurements also decay every kSelectivityDecayInterval
+  // reads then, so that the order follows changes in the data. When
+  // disabled, the order set by the first read is kept.
   void setEnableFilterReorder(bool enableFilterReorder) {
     enableFilterReorder_ = enableFilterReorder;
   }
@@ -325,8 +342,16 @@ class ScanSpec {
   void addAllChildFields(const Type&);
 
  private:
+  // Number of reads between halvings of the selectivity history of the
+  // filtered children. Only applies if filter reordering is enabled.
+  static constexpr uint64_t kSelectivityDecayInterval = 8;
+
   void reorder();
 
+  // Returns true if the filtered children are sorted by the time to drop a
+  // row. The time covers decoding the column as well as the filter.
+  bool isFilterOrderSorted() const;
+
   // Serializes stableChildren().
   std::mutex mutex_;
 
@@ -367,6 +392,8 @@ class ScanSpec {
   SelectivityInfo selectivity_;
   // Sort children by filtering efficiency.
   bool enableFilterReorder_ = true;
+  // Number of times the order of 'children_' changed after the first read.
+  int64_t numReorders_ = 0;
 
   // Specification of action on child fields. This is filled in as
   // follows: Top level ScanSpec: All top level fields mentioned are
@@ -20,11 +20,26 @@ namespace facebook::velox::dwio::common {
 
 SortingWriter::SortingWriter(
     std::unique_ptr<Writer> writer,
-    std::unique_ptr<exec::SortBuffer> sortBuffer)
-    : outputWriter_(std::move(writer)), sortBuffer_(std::move(sortBuffer)) {}
+    std::unique_ptr<exec::SortBuffer> sortBuffer,
+    RowTypePtr outputType,
+    AddSortKeys addSortKeys)
+    : outputWriter_(std::move(writer)),
+      sortBuffer_(std::move(sortBuffer)),
+      outputType_(std::move(outputType)),
+      addSortKeys_(std::move(addSortKeys)) {
+  VELOX_CHECK_EQ(
+      outputType_ != nullptr,
+      addSortKeys_ != nullptr,
+      "Sort key columns require the output type");
+}
 
 void SortingWriter::write(const VectorPtr& data) {
-  sortBuffer_->addInput(data);
+  if (addSortKeys_ == nullptr) {
+    sortBuffer_->addInput(data);
+    return;
+  }
+  sortBuffer_->addInput(
+      addSortKeys_(std::dynamic_pointer_cast<RowVector>(data)));
 }
 
 void SortingWriter::flush() {}
@@ -33,6 +48,18 @@ void SortingWriter::close() {
   sortBuffer_->noMoreInput();
   RowVectorPtr output = sortBuffer_->getOutput();
   while (output != nullptr) {
+    if (outputType_ != nullptr) {
+      // Drops the sort key columns after the output columns.
+      std::vector<VectorPtr> children(
+          output->children().begin(),
+          output->children().begin() + outputType_->size());
+      output = std::make_shared<RowVector>(
+          output->pool(),
+          outputType_,
+          nullptr,
+          output->size(),
+          std::move(children));
+    }
     outputWriter_->write(output);
     output = sortBuffer_->getOutput();
   }
@@ -24,9 +24,18 @@ namespace facebook::velox::dwio::common {
 /// Sorting Writer object is used to write sorted data into a single file.
 class SortingWriter : public Writer {
  public:
+  /// Appends columns computed from the input rows to sort by, such as a
+  /// Z-order key.
+  using AddSortKeys = std::function<RowVectorPtr(const RowVectorPtr&)>;
+
+  /// If 'addSortKeys' is set, the input of 'sortBuffer' is the input rows
+  /// with the columns appended by 'addSortKeys', and these columns are
+  /// dropped from the sorted rows before writing them as 'outputType'.
   SortingWriter(
       std::unique_ptr<Writer> writer,
-      std::unique_ptr<exec::SortBuffer> sortBuffer);
+      std::unique_ptr<exec::SortBuffer> sortBuffer,
+      RowTypePtr outputType = nullptr,
+      AddSortKeys addSortKeys = nullptr);
 
   virtual void write(const VectorPtr& data) override;
 
@@ -40,6 +49,10 @@ class SortingWriter : public Writer {
 
   const std::unique_ptr<Writer> outputWriter_;
   std::unique_ptr<exec::SortBuffer> sortBuffer_;
+
+ private:
+  const RowTypePtr outputType_;
+  const AddSortKeys addSortKeys_;
 };
 
 } // namespace facebook::velox::dwio::common
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <string>
+#include <string_view>
+
 #include <folly/Hash.h>
 #include <folly/container/F14Map.h>
 
@@ -25,6 +28,18 @@
 
 namespace facebook::velox::dwio::common {
 
+/// Prefix of the file metadata keys under which the writers store a
+/// serialized HyperLogLog sketch of the distinct values of a column.
+inline constexpr std::string_view kDistinctCountKeyPrefix{
+    "velox.distinct.count."};
+
+/// Returns the metadata key of the distinct value sketch of a column. 'nodeId'
+/// is the id of the column in TypeWithId::create() of the file schema, so the
+/// key of a column is the same in DWRF and Parquet files.
+inline std::string distinctCountKey(uint32_t nodeId) {
+  return std::string(kDistinctCountKeyPrefix) + std::to_string(nodeId);
+}
+
 // Common base for writer version information used in interpreting
 // metadata. Needed to have format-independent signatures for
 // format-specific functions. Each format implementation downcasts this to the
@@ -528,12 +543,20 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows in pages skipped based on page level statistics.
+  int64_t skippedPageRows{0};
+
+  // Number of times the order of the filters changed during the scan.
+  int64_t numFilterReorders{0};
+
   std::unordered_map<std::string, RuntimeCounter> toMap() {
     return {
         {"skippedSplits", RuntimeCounter(skippedSplits)},
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
-        {"skippedStrides", RuntimeCounter(skippedStrides)}};
+        {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedPageRows", RuntimeCounter(skippedPageRows)},
+        {"numFilterReorders", RuntimeCounter(numFilterReorders)}};
   }
 };
 
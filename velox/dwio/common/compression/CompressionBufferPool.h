@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "velox/dwio/common/DataBuffer.h"
 
 namespace facebook::velox::dwio::common::compression {
@@ -29,6 +31,21 @@ class CompressionBufferPool {
 
   virtual void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) = 0;
+
+  /// Returns true if the streams that use this pool pass the compression and
+  /// encryption of the page they hold at flush() to deferPage() instead of
+  /// doing it inline.
+  virtual bool deferPages() const {
+    return false;
+  }
+
+  /// Takes 'page', which compresses and encrypts the last page of a stream
+  /// into its DataBufferHolder. 'page' must run before the stream is written
+  /// again or its holder is read. The pages of different streams may run in
+  /// parallel. 'page' does not use getBuffer().
+  virtual void deferPage(std::function<void()> /*page*/) {
+    VELOX_UNREACHABLE();
+  }
 };
 
 } // namespace facebook::velox::dwio::common::compression
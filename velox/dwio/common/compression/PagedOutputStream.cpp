@@ -18,7 +18,7 @@
 
 namespace facebook::velox::dwio::common::compression {
 
-std::vector<folly::StringPiece> PagedOutputStream::createPage() {
+std::vector<folly::StringPiece> PagedOutputStream::createPage(bool deferred) {
   auto origSize = buffer_.size();
   VELOX_CHECK_GT(origSize, pageHeaderSize_);
   origSize -= pageHeaderSize_;
@@ -27,7 +27,10 @@ std::vector<folly::StringPiece> PagedOutputStream::createPage() {
   // Applies compression if there is compressor and original data size exceeds
   // threshold.
   if (compressor_ && origSize >= threshold_) {
-    compressionBuffer_ = pool_->getBuffer(buffer_.size());
+    compressionBuffer_ = deferred
+        ? std::make_unique<dwio::common::DataBuffer<char>>(
+              bufferHolder_.getMemoryPool(), buffer_.size())
+        : pool_->getBuffer(buffer_.size());
     compressedSize = compressor_->compress(
         buffer_.data() + pageHeaderSize_,
         compressionBuffer_->data() + pageHeaderSize_,
@@ -78,25 +81,47 @@ void PagedOutputStream::updateSize(char* buffer, size_t compressedSize) {
   buffer[2] = static_cast<char>(compressedSize >> 15);
 }
 
-void PagedOutputStream::resetBuffers() {
+void PagedOutputStream::resetBuffers(bool deferred) {
   // Reset compression buffer size and return.
   if (compressionBuffer_ != nullptr) {
-    pool_->returnBuffer(std::move(compressionBuffer_));
+    if (deferred) {
+      compressionBuffer_ = nullptr;
+    } else {
+      pool_->returnBuffer(std::move(compressionBuffer_));
+    }
   }
   encryptionBuffer_ = nullptr;
 }
 
+void PagedOutputStream::flushPage(bool deferred) {
+  auto buffers = createPage(deferred);
+  const auto cleanup = folly::makeGuard([this, deferred]() {
+    resetBuffers(deferred);
+    // Reset input buffers.
+    buffer_.resize(pageHeaderSize_);
+  });
+  bufferHolder_.take(std::move(buffers));
+}
+
 uint64_t PagedOutputStream::flush() {
   const auto size = buffer_.size();
   const auto originalSize = bufferHolder_.size();
   if (size > pageHeaderSize_) {
-    auto buffers = createPage();
-    const auto cleanup = folly::makeGuard([this]() {
-      resetBuffers();
-      // Reset input buffers.
-      buffer_.resize(pageHeaderSize_);
-    });
-    bufferHolder_.take(std::move(buffers));
+    // The streams of a node share the encrypter, which is not thread safe,
+    // so that encrypted pages are not run in parallel.
+    if (pool_->deferPages() && encryptor_ == nullptr) {
+      // A stream flushed again before its page runs has not been written
+      // since.
+      if (!pagePending_) {
+        pagePending_ = true;
+        pool_->deferPage([this]() {
+          pagePending_ = false;
+          flushPage(true);
+        });
+      }
+      return 0;
+    }
+    flushPage(false);
   }
   return bufferHolder_.size() - originalSize;
 }
@@ -109,6 +134,7 @@ void PagedOutputStream::BackUp(int32_t count) {
 }
 
 bool PagedOutputStream::Next(void** data, int32_t* size, uint64_t increment) {
+  VELOX_CHECK(!pagePending_, "Write to a stream with a deferred page");
   if (!tryResize(data, size, pageHeaderSize_, increment)) {
     auto buffers = createPage();
     const auto cleanup = folly::makeGuard([this]() { resetBuffers(); });
@@ -42,6 +42,11 @@ class PagedOutputStream : public BufferedOutputStream {
 
   bool Next(void** data, int32_t* size, uint64_t increment) override;
 
+  /// Compresses and encrypts the buffered page into the DataBufferHolder
+  /// and returns the number of bytes added to it. If the pool defers pages
+  /// and the stream is not encrypted, passes the page to the pool and
+  /// returns 0. The page is then in size() after the pool has run it, e.g.
+  /// after WriterContext::finishDeferredPages() for DWRF.
   uint64_t flush() override;
 
   uint64_t size() const override {
@@ -62,14 +67,19 @@ class PagedOutputStream : public BufferedOutputStream {
       int32_t strideIndex = -1) const override;
 
  private:
-  // create page using compressor and encryptor
-  std::vector<folly::StringPiece> createPage();
+  // create page using compressor and encryptor. A 'deferred' page does not
+  // use the shared buffer of 'pool_' because it may run in parallel with the
+  // pages of other streams.
+  std::vector<folly::StringPiece> createPage(bool deferred = false);
+
+  // Adds the page to the DataBufferHolder and resets the buffers.
+  void flushPage(bool deferred);
 
   void writeHeader(char* buffer, size_t compressedSize, bool original);
 
   void updateSize(char* buffer, size_t compressedSize);
 
-  void resetBuffers();
+  void resetBuffers(bool deferred = false);
 
   CompressionBufferPool* const pool_;
 
@@ -88,6 +98,9 @@ class PagedOutputStream : public BufferedOutputStream {
 
   // buffer that holds encrypted data
   std::unique_ptr<folly::IOBuf> encryptionBuffer_{nullptr};
+
+  // True while the page is passed to the pool and not yet flushed.
+  bool pagePending_{false};
 };
 
 } // namespace facebook::velox::dwio::common::compression
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+#include "velox/common/memory/Memory.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+
+namespace {
+class TestMetadata : public CachedFileMetadata {
+ public:
+  TestMetadata(int32_t value, uint64_t size) : value_(value), size_(size) {}
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+  int32_t value() const {
+    return value_;
+  }
+
+ private:
+  const int32_t value_;
+  const uint64_t size_;
+};
+
+class OtherMetadata : public CachedFileMetadata {
+ public:
+  uint64_t size() const override {
+    return 1;
+  }
+};
+} // namespace
+
+TEST(FileMetadataCacheTest, findAndInsert) {
+  FileMetadataCache cache(1000);
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>({1, 100}));
+  cache.insert({1, 100}, std::make_shared<TestMetadata>(1, 10));
+  auto metadata = cache.find<TestMetadata>({1, 100});
+  ASSERT_NE(nullptr, metadata);
+  EXPECT_EQ(1, metadata->value());
+
+  // A file replaced under the same path does not hit.
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>({1, 101}));
+  // An entry of a different type does not hit.
+  EXPECT_EQ(nullptr, cache.find<OtherMetadata>({1, 100}));
+
+  // The first entry for a key is kept.
+  cache.insert({1, 100}, std::make_shared<TestMetadata>(2, 10));
+  EXPECT_EQ(1, cache.find<TestMetadata>({1, 100})->value());
+
+  auto stats = cache.stats();
+  EXPECT_EQ(3, stats.numHits);
+  EXPECT_EQ(2, stats.numMisses);
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(10, stats.bytes);
+}
+
+TEST(FileMetadataCacheTest, evictLeastRecentlyUsed) {
+  FileMetadataCache cache(300);
+  for (uint64_t i = 0; i < 3; ++i) {
+    cache.insert({i, 0}, std::make_shared<TestMetadata>(i, 100));
+  }
+  // Touches 0 so that 1 is the least recently used.
+  EXPECT_NE(nullptr, cache.find<TestMetadata>({0, 0}));
+  cache.insert({3, 0}, std::make_shared<TestMetadata>(3, 100));
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>({1, 0}));
+  EXPECT_NE(nullptr, cache.find<TestMetadata>({0, 0}));
+  EXPECT_NE(nullptr, cache.find<TestMetadata>({3, 0}));
+  EXPECT_EQ(1, cache.stats().numEvictions);
+  EXPECT_EQ(300, cache.stats().bytes);
+
+  // Larger than the capacity.
+  cache.insert({4, 0}, std::make_shared<TestMetadata>(4, 301));
+  EXPECT_EQ(nullptr, cache.find<TestMetadata>({4, 0}));
+  EXPECT_EQ(3, cache.stats().numEntries);
+}
+
+TEST(FileMetadataCacheTest, memoryPoolReservation) {
+  auto pool = memory::addDefaultLeafMemoryPool("FileMetadataCacheTest");
+  {
+    FileMetadataCache cache(100 << 20, pool);
+    EXPECT_EQ(0, pool->reservedBytes());
+    cache.insert({1, 0}, std::make_shared<TestMetadata>(1, 1 << 20));
+    EXPECT_GE(pool->reservedBytes(), 1 << 20);
+    cache.insert({2, 0}, std::make_shared<TestMetadata>(2, 20 << 20));
+    EXPECT_GE(pool->reservedBytes(), 21 << 20);
+    cache.clear();
+    EXPECT_EQ(0, pool->reservedBytes());
+    cache.insert({3, 0}, std::make_shared<TestMetadata>(3, 1 << 20));
+    EXPECT_GT(pool->reservedBytes(), 0);
+  }
+  // The reservation is released when the cache is destroyed.
+  EXPECT_EQ(0, pool->reservedBytes());
+}
+
+TEST(FileMetadataCacheTest, instance) {
+  EXPECT_EQ(nullptr, FileMetadataCache::getInstance());
+  FileMetadataCache cache(1000);
+  FileMetadataCache::setInstance(&cache);
+  EXPECT_EQ(&cache, FileMetadataCache::getInstance());
+  FileMetadataCache::setInstance(nullptr);
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/IoTuner.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+namespace {
+constexpr int32_t kLoadQuantum = 8 << 20;
+constexpr int32_t kCoalesceDistance = 512 << 10;
+
+// Records reads of varying size that take 'latencyUs' plus 'bytes /
+// bytesPerUs' microseconds.
+void simulateReads(IoTuner& tuner, double latencyUs, double bytesPerUs) {
+  for (auto i = 0; i < 50; ++i) {
+    uint64_t bytes = (64 << 10) * (1 + i % 16);
+    tuner.recordRead(bytes, latencyUs + bytes / bytesPerUs);
+  }
+}
+} // namespace
+
+TEST(IoTunerTest, defaultsBeforeSamples) {
+  IoTuner tuner(kLoadQuantum, kCoalesceDistance);
+  for (auto i = 0; i < IoTuner::kMinSamples - 1; ++i) {
+    tuner.recordRead(1 << 20, 1000 + i);
+  }
+  auto params = tuner.parameters();
+  EXPECT_EQ(kCoalesceDistance, params.coalesceDistance);
+  EXPECT_EQ(kLoadQuantum, params.loadQuantum);
+  EXPECT_EQ(IoTuner::kMaxOutstandingLoads, params.maxOutstandingLoads);
+  EXPECT_EQ(0, tuner.latencyMicros());
+}
+
+TEST(IoTunerTest, sameSizeReads) {
+  // Reads of a single size do not separate latency from bandwidth.
+  IoTuner tuner(kLoadQuantum, kCoalesceDistance);
+  for (auto i = 0; i < 100; ++i) {
+    tuner.recordRead(1 << 20, 5000);
+  }
+  EXPECT_EQ(100, tuner.numReads());
+  EXPECT_EQ(kCoalesceDistance, tuner.parameters().coalesceDistance);
+}
+
+TEST(IoTunerTest, localSsd) {
+  // 100us latency, 2GB/s.
+  IoTuner tuner(kLoadQuantum, kCoalesceDistance);
+  simulateReads(tuner, 100, 2000);
+  EXPECT_NEAR(100, tuner.latencyMicros(), 1);
+  EXPECT_NEAR(2000, tuner.bytesPerMicro(), 10);
+  auto params = tuner.parameters();
+  // 200K break even distance.
+  EXPECT_NEAR(200'000, params.coalesceDistance, 2'000);
+  // 4 * 200K rounded up to a power of 2 is below the minimum.
+  EXPECT_EQ(IoTuner::kMinLoadQuantum, params.loadQuantum);
+  EXPECT_EQ(2, params.maxOutstandingLoads);
+}
+
+TEST(IoTunerTest, objectStore) {
+  // 30ms latency, 100MB/s.
+  IoTuner tuner(kLoadQuantum, kCoalesceDistance);
+  simulateReads(tuner, 30'000, 100);
+  auto params = tuner.parameters();
+  // The break even of 3MB is larger than the configured distance.
+  EXPECT_NEAR(3'000'000, params.coalesceDistance, 30'000);
+  EXPECT_GT(params.coalesceDistance, kCoalesceDistance);
+  // The load quantum is capped at the configured maximum.
+  EXPECT_EQ(kLoadQuantum, params.loadQuantum);
+  EXPECT_EQ(31, params.maxOutstandingLoads);
+}
+
+TEST(IoTunerTest, adaptsToChange) {
+  IoTuner tuner(kLoadQuantum, kCoalesceDistance);
+  simulateReads(tuner, 30'000, 100);
+  EXPECT_EQ(31, tuner.parameters().maxOutstandingLoads);
+  // Old samples decay after the storage becomes fast.
+  for (auto i = 0; i < 10; ++i) {
+    simulateReads(tuner, 100, 2000);
+  }
+  EXPECT_EQ(2, tuner.parameters().maxOutstandingLoads);
+  EXPECT_LT(tuner.parameters().coalesceDistance, kCoalesceDistance);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ScanSpec.h"
+
+#include <folly/Benchmark.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+
+namespace {
+// Records a filter on 'numIn' rows that passes 'numOut' of them.
+void recordFilter(ScanSpec& spec, uint64_t numIn, uint64_t numOut) {
+  SelectivityTimer timer(spec.selectivity(), numIn);
+  for (auto i = 0; i < 1'000; ++i) {
+    folly::doNotOptimizeAway(i);
+  }
+  spec.selectivity().addOutput(numOut);
+}
+} // namespace
+
+TEST(ScanSpecTest, reorderFilters) {
+  ScanSpec spec("<root>");
+  spec.addAllChildFields(
+      *ROW({"a", "b", "c"}, {BIGINT(), VARCHAR(), BIGINT()}));
+  auto* a = spec.childByName("a");
+  auto* b = spec.childByName("b");
+  a->setFilter(std::make_unique<BigintRange>(0, 10, false));
+  b->setFilter(std::make_unique<BytesValues>(
+      std::vector<std::string>{"x"}, false));
+
+  // Integer filters go first when there is no history.
+  spec.newRead();
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), spec.filterOrder());
+
+  // 'b' drops all rows and 'a' none. The order is checked on each read.
+  recordFilter(*a, 1'000, 1'000);
+  recordFilter(*b, 1'000, 0);
+  spec.newRead();
+  EXPECT_EQ((std::vector<std::string>{"b", "a"}), spec.filterOrder());
+  EXPECT_EQ(1, spec.numFilterReorders());
+  for (auto i = 0; i < 7; ++i) {
+    recordFilter(*a, 1'000, 1'000);
+    recordFilter(*b, 1'000, 0);
+    spec.newRead();
+  }
+  EXPECT_EQ((std::vector<std::string>{"b", "a"}), spec.filterOrder());
+  EXPECT_EQ(1, spec.numFilterReorders());
+
+  // The history decays, so that a change in selectivity is picked up.
+  for (auto i = 0; i < 32; ++i) {
+    recordFilter(*a, 1'000, 0);
+    recordFilter(*b, 1'000, 1'000);
+    spec.newRead();
+  }
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), spec.filterOrder());
+  EXPECT_EQ(2, spec.numFilterReorders());
+}
+
+TEST(ScanSpecTest, disableReorder) {
+  ScanSpec spec("<root>");
+  spec.addAllChildFields(*ROW({"a", "b"}, {BIGINT(), VARCHAR()}));
+  auto* a = spec.childByName("a");
+  auto* b = spec.childByName("b");
+  a->setFilter(std::make_unique<BigintRange>(0, 10, false));
+  b->setFilter(std::make_unique<BytesValues>(
+      std::vector<std::string>{"x"}, false));
+  spec.setEnableFilterReorder(false);
+  for (auto i = 0; i < 16; ++i) {
+    recordFilter(*a, 1'000, 1'000);
+    recordFilter(*b, 1'000, 0);
+    spec.newRead();
+  }
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), spec.filterOrder());
+  EXPECT_EQ(0, spec.numFilterReorders());
+}
+
+TEST(ScanSpecTest, selectivityDecay) {
+  auto decayed = [](uint64_t numIn, uint64_t numOut) {
+    SelectivityInfo info;
+    {
+      SelectivityTimer timer(info, numIn);
+    }
+    info.addOutput(numOut);
+    info.decay();
+    return std::make_pair(info.numIn(), info.numOut());
+  };
+  EXPECT_EQ(std::make_pair<uint64_t, uint64_t>(500, 250), decayed(1'000, 500));
+  // A filter that dropped rows keeps dropping rows after the decay.
+  EXPECT_EQ(std::make_pair<uint64_t, uint64_t>(2, 1), decayed(3, 2));
+  EXPECT_EQ(std::make_pair<uint64_t, uint64_t>(1, 0), decayed(1, 0));
+  // A filter that dropped no rows keeps dropping none.
+  EXPECT_EQ(std::make_pair<uint64_t, uint64_t>(1, 1), decayed(3, 3));
+}
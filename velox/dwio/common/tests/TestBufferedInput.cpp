@@ -95,6 +95,43 @@ void expectPreadvs(
       });
 }
 
+// Serves reads from a mapped view and records hints. Fails on copying reads.
+class MappedReadFile : public facebook::velox::InMemoryReadFile {
+ public:
+  explicit MappedReadFile(std::string_view content)
+      : InMemoryReadFile(content), content_(content) {}
+
+  std::string_view pread(
+      uint64_t /*offset*/,
+      uint64_t /*length*/,
+      void* /*buf*/) const override {
+    VELOX_FAIL("Unexpected copying read");
+  }
+
+  bool hasMappedView() const override {
+    return true;
+  }
+
+  std::string_view mappedView(uint64_t offset, uint64_t length)
+      const override {
+    return content_.substr(offset, length);
+  }
+
+  void advise(uint64_t offset, uint64_t length, AccessHint hint)
+      const override {
+    EXPECT_EQ(hint, AccessHint::kWillNeed);
+    advised_.push_back({offset, length});
+  }
+
+  const std::vector<Region>& advised() const {
+    return advised_;
+  }
+
+ private:
+  const std::string_view content_;
+  mutable std::vector<Region> advised_;
+};
+
 std::optional<std::string> getNext(SeekableInputStream& input) {
   const void* buf = nullptr;
   int32_t size;
@@ -347,3 +384,30 @@ TEST(TestBufferedInput, VReadSortingWithLabels) {
     EXPECT_EQ(next.value(), r.second);
   }
 }
+
+TEST(TestBufferedInput, MappedFile) {
+  std::string content = "hello world";
+  auto readFile = std::make_shared<MappedReadFile>(content);
+  auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
+  BufferedInput input(readFile, *pool);
+  auto first = input.enqueue({0, 5});
+  auto second = input.enqueue({6, 5});
+  EXPECT_TRUE(input.isBuffered(2, 3));
+  input.load(LogType::TEST);
+  ASSERT_EQ(2, readFile->advised().size());
+  EXPECT_EQ(0, readFile->advised()[0].offset);
+  EXPECT_EQ(6, readFile->advised()[1].offset);
+
+  // The streams point into the mapping.
+  const void* buf = nullptr;
+  int32_t size;
+  ASSERT_TRUE(first->Next(&buf, &size));
+  EXPECT_EQ(content.data(), buf);
+  EXPECT_EQ(5, size);
+  EXPECT_EQ("world", getNext(*second));
+
+  auto unplanned = input.read(3, 4, LogType::TEST);
+  ASSERT_TRUE(unplanned->Next(&buf, &size));
+  EXPECT_EQ(content.data() + 3, buf);
+  EXPECT_EQ(4, size);
+}
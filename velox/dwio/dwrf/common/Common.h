@@ -32,6 +32,12 @@ namespace facebook::velox::dwrf {
 constexpr folly::StringPiece WRITER_NAME_KEY{"orc.writer.name"};
 constexpr folly::StringPiece WRITER_VERSION_KEY{"orc.writer.version"};
 constexpr folly::StringPiece WRITER_HOSTNAME_KEY{"orc.writer.host"};
+// Encodings chosen per stripe by the adaptive encoding selection.
+constexpr folly::StringPiece WRITER_ENCODINGS_KEY{"orc.writer.encodings"};
+// Prefix of the keys of the string dictionaries shared by the stripes. The key
+// of a column is the prefix followed by its node id.
+constexpr folly::StringPiece WRITER_SHARED_DICTIONARY_KEY_PREFIX{
+    "orc.writer.shared.dictionary."};
 constexpr folly::StringPiece kDwioWriter{"dwio"};
 constexpr folly::StringPiece kPrestoWriter{"presto"};
 
@@ -105,10 +105,34 @@ Config::Entry<uint32_t> Config::ENTROPY_STRING_THRESHOLD{
     "hive.exec.orc.entropy.string.threshold",
     20};
 
+Config::Entry<bool> Config::ADAPTIVE_ENCODING_SELECTION{
+    "orc.adaptive.encoding.selection",
+    false};
+
+Config::Entry<float> Config::ADAPTIVE_ENCODING_READ_COST_WEIGHT{
+    "orc.adaptive.encoding.read.cost.weight",
+    0.1f};
+
+Config::Entry<uint32_t> Config::ADAPTIVE_ENCODING_SAMPLE_RATE{
+    "orc.adaptive.encoding.sample.rate",
+    16};
+
 Config::Entry<uint32_t> Config::STRING_STATS_LIMIT(
     "hive.orc.string.stats.limit",
     64);
 
+Config::Entry<bool> Config::DISTINCT_COUNT_STATS(
+    "orc.distinct.count.stats",
+    false);
+
+Config::Entry<bool> Config::SHARED_STRING_DICTIONARY(
+    "orc.shared.string.dictionary",
+    false);
+
+Config::Entry<uint64_t> Config::SHARED_STRING_DICTIONARY_MAX_SIZE(
+    "orc.shared.string.dictionary.max.size",
+    64 * 1024);
+
 Config::Entry<bool> Config::FLATTEN_MAP("orc.flatten.map", false);
 
 Config::Entry<bool> Config::MAP_FLAT_DISABLE_DICT_ENCODING(
@@ -51,7 +51,30 @@ class Config : public common::ConfigBase<Config> {
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
   static Entry<uint32_t> ENTROPY_STRING_THRESHOLD;
+  /// Re-evaluate dictionary versus direct encoding of integer and string
+  /// columns for every stripe with a cost model instead of keeping the
+  /// decision made on the first stripe.
+  static Entry<bool> ADAPTIVE_ENCODING_SELECTION;
+  /// Weight of the estimated read cost relative to the size on disk in the
+  /// cost model of the adaptive encoding selection.
+  static Entry<float> ADAPTIVE_ENCODING_READ_COST_WEIGHT;
+  /// One in this many values written directly is sampled to decide whether
+  /// to switch back to dictionary encoding.
+  static Entry<uint32_t> ADAPTIVE_ENCODING_SAMPLE_RATE;
   static Entry<uint32_t> STRING_STATS_LIMIT;
+  /// Keep a HyperLogLog sketch of the distinct values of each integer,
+  /// floating point and string column and write it to the file footer.
+  static Entry<bool> DISTINCT_COUNT_STATS;
+  /// Share the dictionary of each dictionary encoded string column between
+  /// the stripes of the file. A column stops sharing once its shared
+  /// dictionary would get larger than SHARED_STRING_DICTIONARY_MAX_SIZE bytes.
+  /// A shared dictionary is unsorted: its entries stay in insertion order, so
+  /// columns written with DICTIONARY_SORT_KEYS do not share their
+  /// dictionaries. Readers without support for the sharedDictionary flag of
+  /// the column encoding cannot read the stripes that use a shared
+  /// dictionary.
+  static Entry<bool> SHARED_STRING_DICTIONARY;
+  static Entry<uint64_t> SHARED_STRING_DICTIONARY_MAX_SIZE;
   static Entry<bool> FLATTEN_MAP;
   static Entry<bool> MAP_FLAT_DISABLE_DICT_ENCODING;
   static Entry<bool> MAP_FLAT_DISABLE_DICT_ENCODING_STRING;
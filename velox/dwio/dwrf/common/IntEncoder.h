@@ -180,7 +180,24 @@ class IntEncoder {
   }
   FOLLY_ALWAYS_INLINE void writeLongLE(int64_t val);
 
+  // Writes 'numValues' values of 'data' as varints. The values are encoded a
+  // block at a time, so that the compiler vectorizes the encoding and the
+  // blocks of values that fit in one byte are written without branches.
+  template <typename T>
+  void writeVarints(const T* data, int32_t numValues);
+
  private:
+  static constexpr int32_t kVarintBlockSize = 16;
+
+  template <typename T>
+  FOLLY_ALWAYS_INLINE static uint64_t toVarint(T value) {
+    if constexpr (isSigned) {
+      return ZigZag::encode(value);
+    } else {
+      return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+  }
+
   template <typename T>
   uint64_t
   addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
@@ -256,6 +273,13 @@ uint64_t IntEncoder<isSigned>::addImpl(
     const uint64_t* nulls) {
   if (!useVInts_) {
     WRITE_INTS(writeLongLE);
+  } else if (!nulls) {
+    uint64_t count = 0;
+    for (const auto [start, end] : ranges.getRanges()) {
+      writeVarints(data + start, end - start);
+      count += end - start;
+    }
+    return count;
   } else {
     if constexpr (isSigned) {
       WRITE_INTS(writeVslong);
@@ -266,6 +290,44 @@ uint64_t IntEncoder<isSigned>::addImpl(
 }
 
 #undef WRITE_INTS
+
+template <bool isSigned>
+template <typename T>
+void IntEncoder<isSigned>::writeVarints(const T* data, int32_t numValues) {
+  char buffer[1024];
+  char* writeLoc = buffer;
+  // Leaves room for a block of varints of the maximum size.
+  char* const endBuf =
+      buffer + sizeof(buffer) - kVarintBlockSize * folly::kMaxVarintLength64;
+  int32_t i = 0;
+  for (; i + kVarintBlockSize <= numValues; i += kVarintBlockSize) {
+    uint64_t values[kVarintBlockSize];
+    uint64_t allBits = 0;
+    for (auto j = 0; j < kVarintBlockSize; ++j) {
+      values[j] = toVarint(data[i + j]);
+      allBits |= values[j];
+    }
+    if (allBits < 0x80) {
+      for (auto j = 0; j < kVarintBlockSize; ++j) {
+        writeLoc[j] = static_cast<char>(values[j]);
+      }
+      writeLoc += kVarintBlockSize;
+    } else {
+      for (auto j = 0; j < kVarintBlockSize; ++j) {
+        writeLoc += write64Varint(values[j], writeLoc);
+      }
+    }
+    if (writeLoc > endBuf) {
+      writeBuffer(buffer, writeLoc);
+      writeLoc = buffer;
+    }
+  }
+  for (; i < numValues; ++i) {
+    writeLoc += write64Varint(toVarint(data[i]), writeLoc);
+  }
+  writeBuffer(buffer, writeLoc);
+}
+
 template <bool isSigned>
 void IntEncoder<isSigned>::writeByte(char c) {
   if (UNLIKELY(bufferPosition_ == bufferLength_)) {
@@ -43,15 +43,7 @@ void RleEncoderV1<isSigned>::writeValues() {
           IntEncoder<isSigned>::writeLongLE(literals[i]);
         }
       } else {
-        if constexpr (isSigned) {
-          for (int32_t i = 0; i < numLiterals; ++i) {
-            IntEncoder<isSigned>::writeVslong(literals[i]);
-          }
-        } else {
-          for (int32_t i = 0; i < numLiterals; ++i) {
-            IntEncoder<isSigned>::writeVulong(literals[i]);
-          }
-        }
+        IntEncoder<isSigned>::writeVarints(literals.data(), numLiterals);
       }
     }
     repeat = false;
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace facebook::velox::dwrf {
@@ -100,6 +101,8 @@ class RleEncoderV1 : public IntEncoder<isSigned> {
  private:
   constexpr static int32_t MAX_DELTA = 127;
   constexpr static int32_t MIN_DELTA = -128;
+  // Number of values checked at a time for runs.
+  constexpr static int32_t kBlockSize = 16;
 
   std::array<int64_t, RLE_MAX_LITERAL_SIZE> literals;
   int32_t numLiterals;
@@ -160,6 +163,133 @@ class RleEncoderV1 : public IntEncoder<isSigned> {
 
   void writeValues();
 
+  // Adds 'numValues' values without nulls. The values that extend a run or
+  // that cannot start a run are detected a block at a time and added without
+  // going through write().
+  template <typename T>
+  void addValues(const T* data, int32_t numValues) {
+    int32_t i = 0;
+    while (i < numValues) {
+      int32_t numAdded = 0;
+      if (repeat) {
+        numAdded = extendRun(data + i, numValues - i);
+      } else if (numLiterals != 0) {
+        numAdded = addLiterals(data + i, numValues - i);
+      }
+      if (numAdded == 0) {
+        write(data[i++]);
+      } else {
+        i += numAdded;
+      }
+    }
+  }
+
+  // Returns the number of leading values of 'data' that continue the current
+  // run and adds them to the run.
+  template <typename T>
+  int32_t extendRun(const T* data, int32_t numValues) {
+    const int32_t maxValues =
+        std::min(numValues, RLE_MAXIMUM_REPEAT - numLiterals);
+    int64_t previous = literals[0] + delta * (numLiterals - 1);
+    int32_t numInRun = 0;
+    while (numInRun < maxValues) {
+      const int32_t blockSize = std::min(kBlockSize, maxValues - numInRun);
+      bool inRun[kBlockSize];
+      bool allInRun = true;
+      for (auto j = 0; j < blockSize; ++j) {
+        const int64_t value = data[numInRun + j];
+        const int64_t last = j == 0 ? previous : data[numInRun + j - 1];
+        inRun[j] = isStep(last, value) &&
+            static_cast<int64_t>(
+                static_cast<uint64_t>(value) - static_cast<uint64_t>(last)) ==
+                delta;
+        allInRun &= inRun[j];
+      }
+      if (!allInRun) {
+        numInRun += std::find(inRun, inRun + blockSize, false) - inRun;
+        break;
+      }
+      numInRun += blockSize;
+      previous = data[numInRun - 1];
+    }
+    if (numInRun > 0) {
+      isOverflow = false;
+    }
+    numLiterals += numInRun;
+    if (numLiterals == RLE_MAXIMUM_REPEAT) {
+      writeValues();
+    }
+    return numInRun;
+  }
+
+  // Returns the number of leading values of 'data' that do not start a run
+  // and adds them to the literals. Leaves the value that would fill the
+  // literals to write().
+  template <typename T>
+  int32_t addLiterals(const T* data, int32_t numValues) {
+    const int32_t maxValues =
+        std::min(numValues, RLE_MAX_LITERAL_SIZE - 1 - numLiterals);
+    int64_t previous = literals[numLiterals - 1];
+    // True if the last two values differ by 'previousDelta' and the difference
+    // fits in a run.
+    bool previousInRange = tailRunLength == 2;
+    int64_t previousDelta = delta;
+    int32_t numAdded = 0;
+    while (numAdded < maxValues) {
+      const int32_t blockSize = std::min(kBlockSize, maxValues - numAdded);
+      int64_t deltas[kBlockSize];
+      bool inRange[kBlockSize];
+      bool startsRun[kBlockSize];
+      bool anyStartsRun = false;
+      for (auto j = 0; j < blockSize; ++j) {
+        const int64_t value = data[numAdded + j];
+        const int64_t last = j == 0 ? previous : data[numAdded + j - 1];
+        deltas[j] = static_cast<int64_t>(
+            static_cast<uint64_t>(value) - static_cast<uint64_t>(last));
+        inRange[j] = isStep(last, value) && deltas[j] >= MIN_DELTA &&
+            deltas[j] <= MAX_DELTA;
+        const bool lastInRange = j == 0 ? previousInRange : inRange[j - 1];
+        const int64_t lastDelta = j == 0 ? previousDelta : deltas[j - 1];
+        startsRun[j] = lastInRange && inRange[j] && deltas[j] == lastDelta;
+        anyStartsRun |= startsRun[j];
+      }
+      const int32_t numNonRun = anyStartsRun
+          ? std::find(startsRun, startsRun + blockSize, true) - startsRun
+          : blockSize;
+      if (numNonRun > 0) {
+        std::copy(
+            data + numAdded,
+            data + numAdded + numNonRun,
+            literals.begin() + numLiterals + numAdded);
+        previous = data[numAdded + numNonRun - 1];
+        previousInRange = inRange[numNonRun - 1];
+        previousDelta = deltas[numNonRun - 1];
+        numAdded += numNonRun;
+      }
+      if (anyStartsRun) {
+        break;
+      }
+    }
+    if (numAdded > 0) {
+      if constexpr (sizeof(T) == sizeof(delta)) {
+        isOverflow = !isStep(
+            numAdded > 1 ? data[numAdded - 2] : literals[numLiterals - 1],
+            data[numAdded - 1]);
+      }
+      numLiterals += numAdded;
+      tailRunLength = previousInRange ? 2 : 1;
+      delta = previousDelta;
+    }
+    return numAdded;
+  }
+
+  // Returns true if 'value' - 'last' does not overflow.
+  static bool isStep(int64_t last, int64_t value) {
+    const auto step = static_cast<int64_t>(
+        static_cast<uint64_t>(value) - static_cast<uint64_t>(last));
+    return (step >= 0) == (value >= last);
+  }
+
   template <typename T>
   uint64_t
   addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
@@ -227,9 +357,9 @@ uint64_t RleEncoderV1<isSigned>::addImpl(
       }
     }
   } else {
-    for (auto& pos : ranges) {
-      write(data[pos]);
-      ++count;
+    for (const auto [start, end] : ranges.getRanges()) {
+      addValues(data + start, end - start);
+      count += end - start;
     }
   }
   return count;
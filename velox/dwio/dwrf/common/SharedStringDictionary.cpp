@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/SharedStringDictionary.h"
+
+#include <cstring>
+
+#include "velox/dwio/common/exception/Exception.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+// Keeps the dictionary alive while a buffer over its memory is referenced.
+class DictionaryReleaser {
+ public:
+  explicit DictionaryReleaser(
+      std::shared_ptr<const SharedStringDictionary> dictionary)
+      : dictionary_{std::move(dictionary)} {}
+
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  const std::shared_ptr<const SharedStringDictionary> dictionary_;
+};
+
+uint32_t readUint32(std::string_view serialized, size_t& offset) {
+  DWIO_ENSURE_LE(
+      offset + sizeof(uint32_t),
+      serialized.size(),
+      "Corrupted shared dictionary");
+  uint32_t value;
+  std::memcpy(&value, serialized.data() + offset, sizeof(value));
+  offset += sizeof(value);
+  return value;
+}
+
+void appendUint32(uint32_t value, std::string& out) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+SharedStringDictionary::SharedStringDictionary(std::string_view serialized) {
+  size_t offset = 0;
+  const auto numEntries = readUint32(serialized, offset);
+  offsets_.reserve(numEntries + 1);
+  offsets_.push_back(0);
+  for (uint32_t i = 0; i < numEntries; ++i) {
+    offsets_.push_back(offsets_.back() + readUint32(serialized, offset));
+  }
+  DWIO_ENSURE_EQ(
+      offset + offsets_.back(),
+      serialized.size(),
+      "Corrupted shared dictionary");
+  data_.assign(serialized.data() + offset, offsets_.back());
+  views_.reserve(numEntries);
+  for (uint32_t i = 0; i < numEntries; ++i) {
+    views_.emplace_back(
+        data_.data() + offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+}
+
+// static
+std::string SharedStringDictionary::serialize(
+    uint32_t numEntries,
+    const std::function<std::string_view(uint32_t)>& entryAt) {
+  std::string serialized;
+  appendUint32(numEntries, serialized);
+  size_t dataSize = 0;
+  for (uint32_t i = 0; i < numEntries; ++i) {
+    const auto size = entryAt(i).size();
+    appendUint32(size, serialized);
+    dataSize += size;
+  }
+  serialized.reserve(serialized.size() + dataSize);
+  for (uint32_t i = 0; i < numEntries; ++i) {
+    serialized.append(entryAt(i));
+  }
+  return serialized;
+}
+
+BufferPtr SharedStringDictionary::viewsBuffer(uint32_t numEntries) const {
+  DWIO_ENSURE_LE(numEntries, size(), "Shared dictionary is too small");
+  return BufferView<DictionaryReleaser>::create(
+      reinterpret_cast<const uint8_t*>(views_.data()),
+      numEntries * sizeof(StringView),
+      DictionaryReleaser(shared_from_this()));
+}
+
+BufferPtr SharedStringDictionary::offsetsBuffer(uint32_t numEntries) const {
+  DWIO_ENSURE_LE(numEntries, size(), "Shared dictionary is too small");
+  return BufferView<DictionaryReleaser>::create(
+      reinterpret_cast<const uint8_t*>(offsets_.data()),
+      (numEntries + 1) * sizeof(int64_t),
+      DictionaryReleaser(shared_from_this()));
+}
+
+BufferPtr SharedStringDictionary::dataBuffer() const {
+  return BufferView<DictionaryReleaser>::create(
+      reinterpret_cast<const uint8_t*>(data_.data()),
+      data_.size(),
+      DictionaryReleaser(shared_from_this()));
+}
+
+std::shared_ptr<const SharedStringDictionary> SharedStringDictionaries::get(
+    uint32_t node,
+    const std::function<std::string_view()>& serialized) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& dictionary = dictionaries_[node];
+  if (dictionary == nullptr) {
+    dictionary = std::make_shared<SharedStringDictionary>(serialized());
+  }
+  return dictionary;
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/buffer/Buffer.h"
+#include "velox/type/StringView.h"
+
+namespace facebook::velox::dwrf {
+
+/// Dictionary of a string column shared by the stripes of a file. The writer
+/// appends the new entries of each stripe, so that a stripe uses the first
+/// ColumnEncoding.dictionarySize entries. The dictionary is stored in the
+/// footer user metadata as the number of entries, the length of each entry
+/// and the bytes of the entries. The count and lengths are uint32_t.
+class SharedStringDictionary
+    : public std::enable_shared_from_this<SharedStringDictionary> {
+ public:
+  /// Parses a dictionary serialized by serialize().
+  explicit SharedStringDictionary(std::string_view serialized);
+
+  SharedStringDictionary(const SharedStringDictionary&) = delete;
+  SharedStringDictionary& operator=(const SharedStringDictionary&) = delete;
+
+  /// Serializes 'numEntries' entries. 'entryAt' returns the entry at an
+  /// index.
+  static std::string serialize(
+      uint32_t numEntries,
+      const std::function<std::string_view(uint32_t)>& entryAt);
+
+  uint32_t size() const {
+    return views_.size();
+  }
+
+  /// Returns a buffer of the StringViews of the first 'numEntries' entries.
+  /// The buffer keeps this alive.
+  BufferPtr viewsBuffer(uint32_t numEntries) const;
+
+  /// Returns a buffer of the offsets of the first 'numEntries' entries in
+  /// dataBuffer() followed by the end of the last one. The buffer keeps this
+  /// alive.
+  BufferPtr offsetsBuffer(uint32_t numEntries) const;
+
+  /// Returns a buffer of the concatenated entries. The buffer keeps this
+  /// alive.
+  BufferPtr dataBuffer() const;
+
+ private:
+  std::string data_;
+  std::vector<int64_t> offsets_;
+  // Point into 'data_' for the entries that are not inlined.
+  std::vector<StringView> views_;
+};
+
+/// Parsed shared dictionaries of the columns of a file. Thread safe.
+class SharedStringDictionaries {
+ public:
+  /// Returns the dictionary of 'node'. Calls 'serialized' and parses its
+  /// result the first time the dictionary of 'node' is requested.
+  std::shared_ptr<const SharedStringDictionary> get(
+      uint32_t node,
+      const std::function<std::string_view()>& serialized);
+
+ private:
+  std::mutex mutex_;
+  folly::F14FastMap<uint32_t, std::shared_ptr<const SharedStringDictionary>>
+      dictionaries_;
+};
+
+} // namespace facebook::velox::dwrf
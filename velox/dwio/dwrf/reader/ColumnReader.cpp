@@ -1070,6 +1070,10 @@ class StringDictionaryColumnReader : public ColumnReader {
       const char*& outputStarts,
       int64_t& outputLengths) const;
 
+  // Returns the values of the stripe dictionary. These are shared by the
+  // results of the stripe.
+  const FlatVectorPtr<StringView>& makeStripeDictionaryValues();
+
   void readDictionaryVector(
       uint64_t numValues,
       VectorPtr& result,
@@ -1094,6 +1098,9 @@ class StringDictionaryColumnReader : public ColumnReader {
 
   FlatVectorPtr<StringView> combinedDictionaryValues_;
   FlatVectorPtr<StringView> dictionaryValues_;
+  // Values of 'combinedDictionaryValues_'. Starts with the values of the
+  // stripe dictionary, which are kept when the buffer is reused.
+  BufferPtr combinedValues_;
 
   uint64_t dictionaryCount_;
   uint64_t strideDictCount_;
@@ -1108,6 +1115,9 @@ class StringDictionaryColumnReader : public ColumnReader {
   // lazy load the dictionary
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> lengthDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
+  // Set instead of 'lengthDecoder_' and 'blobStream_' if the stripe uses the
+  // dictionary shared by the stripes of the file.
+  std::shared_ptr<const SharedStringDictionary> sharedDictionary_;
   const bool returnFlatVector_;
   bool initialized_{false};
 };
@@ -1126,9 +1136,9 @@ StringDictionaryColumnReader::StringDictionaryColumnReader(
       provider_(stripe.getStrideIndexProvider()),
       returnFlatVector_(stripe.getRowReaderOptions().getReturnFlatVector()) {
   EncodingKey encodingKey{nodeType_->id(), flatMapContext_.sequence};
-  RleVersion rleVersion =
-      convertRleVersion(stripe.getEncoding(encodingKey).kind());
-  dictionaryCount_ = stripe.getEncoding(encodingKey).dictionarysize();
+  const auto& encoding = stripe.getEncoding(encodingKey);
+  RleVersion rleVersion = convertRleVersion(encoding.kind());
+  dictionaryCount_ = encoding.dictionarysize();
 
   const auto dataId = encodingKey.forKind(proto::Stream_Kind_DATA);
   bool dictVInts = stripe.getUseVInts(dataId);
@@ -1139,19 +1149,23 @@ StringDictionaryColumnReader::StringDictionaryColumnReader(
       dictVInts,
       dwio::common::INT_BYTE_SIZE);
 
-  const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
-  bool lenVInts = stripe.getUseVInts(lenId);
-  lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
-      stripe.getStream(lenId, streamLabels.label(), false),
-      rleVersion,
-      memoryPool_,
-      lenVInts,
-      dwio::common::INT_BYTE_SIZE);
+  if (encoding.shareddictionary()) {
+    sharedDictionary_ = stripe.getSharedStringDictionary(nodeType_->id());
+  } else {
+    const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
+    bool lenVInts = stripe.getUseVInts(lenId);
+    lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
+        stripe.getStream(lenId, streamLabels.label(), false),
+        rleVersion,
+        memoryPool_,
+        lenVInts,
+        dwio::common::INT_BYTE_SIZE);
 
-  blobStream_ = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
-      streamLabels.label(),
-      false);
+    blobStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
+        streamLabels.label(),
+        false);
+  }
 
   // handle in dictionary stream
   std::unique_ptr<dwio::common::SeekableInputStream> inDictStream =
@@ -1250,7 +1264,7 @@ void StringDictionaryColumnReader::loadStrideDictionary() {
 
   lastStrideIndex_ = nextStride;
 
-  dictionaryValues_.reset();
+  // 'dictionaryValues_' only depends on the stripe dictionary.
   combinedDictionaryValues_.reset();
 }
 
@@ -1325,6 +1339,32 @@ void StringDictionaryColumnReader::next(
   }
 }
 
+const FlatVectorPtr<StringView>&
+StringDictionaryColumnReader::makeStripeDictionaryValues() {
+  if (dictionaryValues_) {
+    return dictionaryValues_;
+  }
+  BufferPtr values =
+      AlignedBuffer::allocate<StringView>(dictionaryCount_, &memoryPool_);
+  auto* valuesPtr = values->asMutable<StringView>();
+  const auto* dictionaryBlobPtr = dictionaryBlob_->as<char>();
+  const auto* dictionaryOffsetsPtr = dictionaryOffset_->as<int64_t>();
+  for (size_t i = 0; i < dictionaryCount_; i++) {
+    valuesPtr[i] = StringView(
+        dictionaryBlobPtr + dictionaryOffsetsPtr[i],
+        dictionaryOffsetsPtr[i + 1] - dictionaryOffsetsPtr[i]);
+  }
+
+  dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
+      &memoryPool_,
+      nodeType_->type(),
+      BufferPtr(nullptr), // TODO nulls
+      dictionaryCount_ /*length*/,
+      values,
+      std::vector<BufferPtr>{dictionaryBlob_});
+  return dictionaryValues_;
+}
+
 void StringDictionaryColumnReader::readDictionaryVector(
     uint64_t numValues,
     VectorPtr& result,
@@ -1387,20 +1427,23 @@ void StringDictionaryColumnReader::readDictionaryVector(
   }
 
   VectorPtr dictionaryValues;
-  const auto* dictionaryBlobPtr = dictionaryBlob_->as<char>();
-  const auto* dictionaryOffsetsPtr = dictionaryOffset_->as<int64_t>();
+  const auto& stripeDictionaryValues = makeStripeDictionaryValues();
   if (hasStrideDict) {
     if (!combinedDictionaryValues_) {
-      // TODO Reuse memory
-      BufferPtr values = AlignedBuffer::allocate<StringView>(
-          dictionaryCount_ + strideDictCount_, &memoryPool_);
-      auto* valuesPtr = values->asMutable<StringView>();
-      for (size_t i = 0; i < dictionaryCount_; i++) {
-        valuesPtr[i] = StringView(
-            dictionaryBlobPtr + dictionaryOffsetsPtr[i],
-            dictionaryOffsetsPtr[i + 1] - dictionaryOffsetsPtr[i]);
+      const auto numValues = dictionaryCount_ + strideDictCount_;
+      // The stripe part of the combined values does not change within the
+      // stripe. Copy it again only if a previous result still references
+      // the values.
+      if (!combinedValues_ || !combinedValues_->isMutable() ||
+          combinedValues_->capacity() < numValues * sizeof(StringView)) {
+        combinedValues_ =
+            AlignedBuffer::allocate<StringView>(numValues, &memoryPool_);
+        memcpy(
+            combinedValues_->asMutable<StringView>(),
+            stripeDictionaryValues->rawValues(),
+            dictionaryCount_ * sizeof(StringView));
       }
-
+      auto* valuesPtr = combinedValues_->asMutable<StringView>();
       const auto* strideDictPtr = strideDict_->as<char>();
       const auto* strideDictOffsetPtr = strideDictOffset_->as<int64_t>();
       for (size_t i = 0; i < strideDictCount_; i++) {
@@ -1408,38 +1451,20 @@ void StringDictionaryColumnReader::readDictionaryVector(
             strideDictPtr + strideDictOffsetPtr[i],
             strideDictOffsetPtr[i + 1] - strideDictOffsetPtr[i]);
       }
+      combinedValues_->setSize(numValues * sizeof(StringView));
 
       combinedDictionaryValues_ = std::make_shared<FlatVector<StringView>>(
           &memoryPool_,
           nodeType_->type(),
           BufferPtr(nullptr), // TODO nulls
-          dictionaryCount_ + strideDictCount_ /*length*/,
-          values,
+          numValues /*length*/,
+          combinedValues_,
           std::vector<BufferPtr>{dictionaryBlob_, strideDict_});
     }
 
     dictionaryValues = combinedDictionaryValues_;
   } else {
-    if (!dictionaryValues_) {
-      // TODO Reuse memory
-      BufferPtr values =
-          AlignedBuffer::allocate<StringView>(dictionaryCount_, &memoryPool_);
-      auto* valuesPtr = values->asMutable<StringView>();
-      for (size_t i = 0; i < dictionaryCount_; i++) {
-        valuesPtr[i] = StringView(
-            dictionaryBlobPtr + dictionaryOffsetsPtr[i],
-            dictionaryOffsetsPtr[i + 1] - dictionaryOffsetsPtr[i]);
-      }
-
-      dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
-          &memoryPool_,
-          nodeType_->type(),
-          BufferPtr(nullptr), // TODO nulls
-          dictionaryCount_ /*length*/,
-          values,
-          std::vector<BufferPtr>{dictionaryBlob_});
-    }
-    dictionaryValues = dictionaryValues_;
+    dictionaryValues = stripeDictionaryValues;
   }
 
   if (result) {
@@ -1496,13 +1521,13 @@ void StringDictionaryColumnReader::readFlatVector(
   dictIndex_->next(indices, numValues, nullsPtr);
 
   const char* strideDictPtr = nullptr;
-  int64_t* strideDictOffsetPtr = nullptr;
+  const int64_t* strideDictOffsetPtr = nullptr;
   if (strideDict_) {
     strideDictPtr = strideDict_->as<char>();
-    strideDictOffsetPtr = strideDictOffset_->asMutable<int64_t>();
+    strideDictOffsetPtr = strideDictOffset_->as<int64_t>();
   }
   auto* dictionaryBlobPtr = dictionaryBlob_->as<char>();
-  auto* dictionaryOffsetsPtr = dictionaryOffset_->asMutable<int64_t>();
+  auto* dictionaryOffsetsPtr = dictionaryOffset_->as<int64_t>();
   bool hasStrideDict = false;
   const char* strData;
   int64_t strLen;
@@ -1563,10 +1588,16 @@ void StringDictionaryColumnReader::ensureInitialized() {
     return;
   }
 
-  detail::ensureCapacity<int64_t>(
-      dictionaryOffset_, dictionaryCount_ + 1, &memoryPool_);
-  dictionaryBlob_ = loadDictionary(
-      dictionaryCount_, *blobStream_, *lengthDecoder_, dictionaryOffset_);
+  if (sharedDictionary_) {
+    // The stripe uses a prefix of the dictionary shared by the stripes.
+    dictionaryOffset_ = sharedDictionary_->offsetsBuffer(dictionaryCount_);
+    dictionaryBlob_ = sharedDictionary_->dataBuffer();
+  } else {
+    detail::ensureCapacity<int64_t>(
+        dictionaryOffset_, dictionaryCount_ + 1, &memoryPool_);
+    dictionaryBlob_ = loadDictionary(
+        dictionaryCount_, *blobStream_, *lengthDecoder_, dictionaryOffset_);
+  }
   dictionaryValues_.reset();
   combinedDictionaryValues_.reset();
 
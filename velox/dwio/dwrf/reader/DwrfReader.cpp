@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/common/ParallelRowReader.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/reader/ColumnReader.h"
@@ -31,8 +32,9 @@ using dwio::common::RowReaderOptions;
 
 DwrfRowReader::DwrfRowReader(
     const std::shared_ptr<ReaderBase>& reader,
-    const RowReaderOptions& opts)
-    : StripeReaderBase(reader),
+    const RowReaderOptions& opts,
+    std::unique_ptr<dwio::common::BufferedInput> input)
+    : StripeReaderBase(reader, std::move(input)),
       options_(opts),
       columnSelector_{std::make_shared<ColumnSelector>(
           ColumnSelector::apply(opts.getSelector(), reader->getSchema()))} {
@@ -461,9 +463,13 @@ DwrfRowReader::FetchResult DwrfRowReader::fetch(uint32_t stripeIndex) {
 
   auto prefetchedStripeBase = getStripeBase(stripeIndex);
 
+  // A stripe without its own input was preloaded with the footer.
+  auto* stripeInput = prefetchedStripeBase->stripeInput
+      ? prefetchedStripeBase->stripeInput.get()
+      : &bufferedInput();
   auto state = std::make_shared<StripeReadState>(
       readerBaseShared(),
-      prefetchedStripeBase->stripeInput.get(),
+      stripeInput,
       prefetchedStripeBase->footer,
       getDecryptionHandler());
 
@@ -723,7 +729,9 @@ DwrfReader::DwrfReader(
           options.getFilePreloadThreshold(),
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
-          options.isFileColumnNamesReadAsLowerCase())),
+          options.isFileColumnNamesReadAsLowerCase(),
+          options.fileMetadataCache(),
+          options.fileMetadataKey())),
       options_(options) {
   // If we are not using column names to map table columns to file columns, then
   // we use indices. In that case we need to ensure the names completely match,
@@ -1031,14 +1039,13 @@ uint64_t DwrfReader::getMemoryUse(
   return memory + decompressorMemory;
 }
 
-std::unique_ptr<dwio::common::RowReader> DwrfReader::createRowReader(
-    const RowReaderOptions& opts) const {
-  return createDwrfRowReader(opts);
-}
-
-std::unique_ptr<DwrfRowReader> DwrfReader::createDwrfRowReader(
-    const RowReaderOptions& opts) const {
-  auto rowReader = std::make_unique<DwrfRowReader>(readerBase_, opts);
+namespace {
+std::unique_ptr<DwrfRowReader> makeDwrfRowReader(
+    const std::shared_ptr<ReaderBase>& readerBase,
+    const RowReaderOptions& opts,
+    std::unique_ptr<dwio::common::BufferedInput> input = nullptr) {
+  auto rowReader =
+      std::make_unique<DwrfRowReader>(readerBase, opts, std::move(input));
   if (opts.getEagerFirstStripeLoad()) {
     // Load the first stripe on construction so that readers created in
     // background have a reader tree and can preload the first
@@ -1048,6 +1055,86 @@ std::unique_ptr<DwrfRowReader> DwrfReader::createDwrfRowReader(
   }
   return rowReader;
 }
+} // namespace
+
+std::unique_ptr<dwio::common::RowReader> DwrfReader::createRowReader(
+    const RowReaderOptions& opts) const {
+  if (opts.useParallelDecoding()) {
+    auto& footer = readerBase_->getFooter();
+    std::vector<uint64_t> stripeOffsets;
+    stripeOffsets.reserve(footer.stripesSize());
+    for (auto i = 0; i < footer.stripesSize(); ++i) {
+      stripeOffsets.push_back(footer.stripes(i).offset());
+    }
+    auto units = dwio::common::ParallelRowReader::unitsInRange(
+        stripeOffsets, opts);
+    if (units.size() > 1) {
+      // The stripe readers share 'readerBase_', not 'this', which may be
+      // destroyed before the returned reader. Each stripe gets its own input,
+      // since the stripes are read on different threads. clone() only copies
+      // the configuration of the input of 'readerBase_'.
+      return std::make_unique<dwio::common::ParallelRowReader>(
+          std::move(units),
+          opts,
+          [readerBase = readerBase_](const RowReaderOptions& stripeOpts) {
+            return makeDwrfRowReader(
+                readerBase,
+                stripeOpts,
+                readerBase->getBufferedInput().clone());
+          });
+    }
+  }
+  return createDwrfRowReader(opts);
+}
+
+std::unique_ptr<DwrfRowReader> DwrfReader::createDwrfRowReader(
+    const RowReaderOptions& opts) const {
+  return makeDwrfRowReader(readerBase_, opts);
+}
+
+std::optional<std::vector<dwio::common::RowGroupStatistics>>
+DwrfReader::rowGroupStatistics(uint64_t offset, uint64_t length) const {
+  RowReaderOptions range;
+  range.range(offset, length);
+  const auto& footer = readerBase_->getFooter();
+  const auto& schema = readerBase_->getSchemaWithId();
+  std::vector<dwio::common::RowGroupStatistics> stripes;
+  for (auto i = 0; i < footer.stripesSize(); ++i) {
+    auto stripe = footer.stripes(i);
+    if (stripe.offset() < range.getOffset() ||
+        stripe.offset() >= range.getLimit()) {
+      continue;
+    }
+    dwio::common::RowGroupStatistics stats;
+    stats.offset = stripe.offset();
+    stats.length =
+        stripe.indexLength() + stripe.dataLength() + stripe.footerLength();
+    stats.numRows = stripe.numberOfRows();
+    stats.columns.resize(schema->size());
+    stripes.push_back(std::move(stats));
+  }
+  if (stripes.empty() ||
+      stripes.size() < static_cast<size_t>(footer.stripesSize())) {
+    return stripes;
+  }
+  dwio::common::RowGroupStatistics file;
+  file.offset = stripes.front().offset;
+  file.length = stripes.back().offset + stripes.back().length - file.offset;
+  file.numRows = 0;
+  for (const auto& stripe : stripes) {
+    file.numRows += stripe.numRows;
+  }
+  for (auto i = 0; i < schema->size(); ++i) {
+    const auto nodeId = schema->childAt(i)->id();
+    file.columns.push_back(
+        nodeId < static_cast<uint32_t>(footer.statisticsSize())
+            ? readerBase_->getColumnStatistics(nodeId)
+            : nullptr);
+  }
+  std::vector<dwio::common::RowGroupStatistics> result;
+  result.push_back(std::move(file));
+  return result;
+}
 
 std::unique_ptr<DwrfReader> DwrfReader::create(
     std::unique_ptr<dwio::common::BufferedInput> input,
@@ -32,10 +32,12 @@ class DwrfRowReader : public StrideIndexProvider,
    * Constructor that lets the user specify additional options.
    * @param contents of the file
    * @param options options for reading
+   * @param input input for the stripes instead of the input of 'reader'
    */
   DwrfRowReader(
       const std::shared_ptr<ReaderBase>& reader,
-      const dwio::common::RowReaderOptions& options);
+      const dwio::common::RowReaderOptions& options,
+      std::unique_ptr<dwio::common::BufferedInput> input = nullptr);
 
   ~DwrfRowReader() override = default;
 
@@ -275,6 +277,12 @@ class DwrfReader : public dwio::common::Reader {
     return readerBase_->getColumnStatistics(nodeId);
   }
 
+  /// DWRF has column statistics only for the whole file. Returns these if
+  /// the range has all the stripes and else the stripes without column
+  /// statistics.
+  std::optional<std::vector<dwio::common::RowGroupStatistics>>
+  rowGroupStatistics(uint64_t offset, uint64_t length) const override;
+
   const std::shared_ptr<const RowType>& rowType() const override {
     return readerBase_->getSchema();
   }
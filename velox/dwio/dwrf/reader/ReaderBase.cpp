@@ -86,6 +86,12 @@ ReaderBase::ReaderBase(
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
           fileFormat) {}
 
+uint64_t FileTail::size() const {
+  // The PostScript is at most 255 bytes serialized.
+  return sizeof(FileTail) + sizeof(PostScript) + psLength +
+      arena->SpaceAllocated();
+}
+
 ReaderBase::ReaderBase(
     MemoryPool& pool,
     std::unique_ptr<dwio::common::BufferedInput> input,
@@ -93,19 +99,103 @@ ReaderBase::ReaderBase(
     uint64_t directorySizeGuess,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    dwio::common::FileMetadataCache* metadataCache,
+    std::optional<dwio::common::FileMetadataKey> metadataKey)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       directorySizeGuess_(directorySizeGuess),
       filePreloadThreshold_(filePreloadThreshold),
       input_(std::move(input)) {
-  // read last bytes into buffer to get PostScript
-  // If file is small, load the entire file.
-  // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  const bool useCache = metadataCache != nullptr && metadataKey.has_value();
+  std::shared_ptr<const FileTail> tail;
+  if (useCache) {
+    tail = metadataCache->find<FileTail>(metadataKey.value());
+    // The file may have been truncated or rewritten without a change of
+    // modification time.
+    if (tail != nullptr &&
+        (tail->fileLength != fileLength_ ||
+         (tail->postScript->format() == DwrfFormat::kDwrf) !=
+             (fileFormat == FileFormat::DWRF))) {
+      tail = nullptr;
+    }
+    tailCached_ = tail != nullptr;
+  }
+  if (tail == nullptr) {
+    auto newTail = readTail(fileFormat, fileColumnNamesReadAsLowerCase);
+    if (useCache) {
+      metadataCache->insert(metadataKey.value(), newTail);
+    }
+    tail = std::move(newTail);
+  }
+
+  tail_ = tail;
+  sharedDictionaries_ = tail->sharedDictionaries;
+  postScript_ = tail->postScript;
+  psLength_ = tail->psLength;
+  footer_ = std::make_unique<FooterWrapper>(*tail->footer);
+  if (tail->fileColumnNamesReadAsLowerCase == fileColumnNamesReadAsLowerCase) {
+    schema_ = tail->schema;
+  } else {
+    schema_ = std::dynamic_pointer_cast<const RowType>(
+        convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  }
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize =
+      1 + psLength_ + postScript_->footerLength() + cacheSize;
+
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+std::shared_ptr<FileTail> ReaderBase::readTail(
+    FileFormat fileFormat,
+    bool fileColumnNamesReadAsLowerCase) {
+  auto tail = std::make_shared<FileTail>();
+  tail->arena = std::make_unique<google::protobuf::Arena>();
+  tail->fileLength = fileLength_;
+
+  // read last bytes into buffer to get PostScript
+  // If file is small, load the entire file.
+  // TODO: make a config
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, directorySizeGuess_);
@@ -127,16 +217,18 @@ ReaderBase::ReaderBase(
       psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
       fileLength_,
       "Corrupted file, Post script size is invalid");
+  tail->psLength = psLength_;
 
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    postScript_ = std::make_shared<PostScript>(std::move(postScript));
   }
+  tail->postScript = postScript_;
 
   uint64_t footerSize = postScript_->footerLength();
   uint64_t cacheSize =
@@ -167,58 +259,25 @@ ReaderBase::ReaderBase(
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        tail->arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
   }
 
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  tail->schema = std::dynamic_pointer_cast<const RowType>(
+      convertType(*tail->footer, 0, fileColumnNamesReadAsLowerCase));
+  tail->fileColumnNamesReadAsLowerCase = fileColumnNamesReadAsLowerCase;
+  return tail;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
@@ -231,6 +290,21 @@ std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
   return rowsPerStripe;
 }
 
+std::shared_ptr<const SharedStringDictionary>
+ReaderBase::getSharedStringDictionary(uint32_t node) const {
+  return sharedDictionaries_->get(node, [&]() -> std::string_view {
+    const auto key =
+        fmt::format("{}{}", WRITER_SHARED_DICTIONARY_KEY_PREFIX, node);
+    for (int32_t index = 0; index < footer_->metadataSize(); ++index) {
+      auto entry = footer_->metadata(index);
+      if (entry.name() == key) {
+        return entry.value();
+      }
+    }
+    DWIO_RAISE("Shared dictionary of node ", node, " is missing");
+  });
+}
+
 std::unique_ptr<Statistics> ReaderBase::getStatistics() const {
   StatsContext statsContext(getWriterName(), getWriterVersion());
   return std::make_unique<FooterStatisticsImpl>(*this, statsContext);
@@ -17,12 +17,14 @@
 #pragma once
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/common/TypeWithId.h"
 #include "velox/dwio/dwrf/common/Compression.h"
 #include "velox/dwio/dwrf/common/Decryption.h"
 #include "velox/dwio/dwrf/common/FileMetadata.h"
+#include "velox/dwio/dwrf/common/SharedStringDictionary.h"
 #include "velox/dwio/dwrf/common/Statistics.h"
 #include "velox/dwio/dwrf/reader/StripeMetadataCache.h"
 #include "velox/dwio/dwrf/utils/ProtoUtils.h"
@@ -57,6 +59,25 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+/// Parsed PostScript and footer of a file, shared between readers through the
+/// FileMetadataCache.
+struct FileTail : public dwio::common::CachedFileMetadata {
+  // Owns the memory of 'footer'.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::shared_ptr<const PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  RowTypePtr schema;
+  bool fileColumnNamesReadAsLowerCase{false};
+  uint64_t fileLength{0};
+  uint64_t psLength{0};
+  // Parsed on first use, so that the readers of the file parse them once.
+  // Not counted in size().
+  std::shared_ptr<SharedStringDictionaries> sharedDictionaries{
+      std::make_shared<SharedStringDictionaries>()};
+
+  uint64_t size() const override;
+};
+
 class ReaderBase {
  public:
   // create reader base from buffered input
@@ -70,7 +91,9 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      dwio::common::FileMetadataCache* metadataCache = nullptr,
+      std::optional<dwio::common::FileMetadataKey> metadataKey = std::nullopt);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -231,20 +254,41 @@ class ReaderBase {
     return postScript_->format();
   }
 
+  /// Returns the dictionary of the string column 'node' shared by the
+  /// stripes. Throws if the file has none.
+  std::shared_ptr<const SharedStringDictionary> getSharedStringDictionary(
+      uint32_t node) const;
+
+  /// True if the PostScript and footer came from the FileMetadataCache.
+  bool isTailCached() const {
+    return tailCached_;
+  }
+
  private:
+  // Reads and parses the PostScript and footer from 'input_'.
+  std::shared_ptr<FileTail> readTail(
+      dwio::common::FileFormat fileFormat,
+      bool fileColumnNamesReadAsLowerCase);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
   memory::MemoryPool& pool_;
+  // Holds the stripe footers.
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
+  // Owns the memory of 'postScript_' and 'footer_' if not nullptr.
+  std::shared_ptr<const FileTail> tail_;
+  std::shared_ptr<const PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
   std::unique_ptr<encryption::DecryptionHandler> handler_;
+  // Shared with the other readers of the file through 'tail_' if not nullptr.
+  std::shared_ptr<SharedStringDictionaries> sharedDictionaries_{
+      std::make_shared<SharedStringDictionaries>()};
   const uint64_t directorySizeGuess_{
       dwio::common::ReaderOptions::kDefaultDirectorySizeGuess};
   const uint64_t filePreloadThreshold_{
@@ -256,6 +300,7 @@ class ReaderBase {
   mutable std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
   uint64_t fileLength_;
   uint64_t psLength_;
+  bool tailCached_{false};
 };
 
 } // namespace facebook::velox::dwrf
@@ -28,12 +28,13 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
     common::ScanSpec& scanSpec)
     : SelectiveColumnReader(nodeType->type(), params, scanSpec, nodeType),
       lastStrideIndex_(-1),
-      provider_(params.stripeStreams().getStrideIndexProvider()) {
+      provider_(params.stripeStreams().getStrideIndexProvider()),
+      options_(params.stripeStreams().getRowReaderOptions()) {
   auto& stripe = params.stripeStreams();
   EncodingKey encodingKey{fileType_->id(), params.flatMapContext().sequence};
-  version_ = convertRleVersion(stripe.getEncoding(encodingKey).kind());
-  scanState_.dictionary.numValues =
-      stripe.getEncoding(encodingKey).dictionarysize();
+  const auto& encoding = stripe.getEncoding(encodingKey);
+  version_ = convertRleVersion(encoding.kind());
+  scanState_.dictionary.numValues = encoding.dictionarysize();
 
   const auto dataId = encodingKey.forKind(proto::Stream_Kind_DATA);
   bool dictVInts = stripe.getUseVInts(dataId);
@@ -44,19 +45,23 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
       dictVInts,
       dwio::common::INT_BYTE_SIZE);
 
-  const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
-  bool lenVInts = stripe.getUseVInts(lenId);
-  lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
-      stripe.getStream(lenId, params.streamLabels().label(), false),
-      version_,
-      memoryPool_,
-      lenVInts,
-      dwio::common::INT_BYTE_SIZE);
+  if (encoding.shareddictionary()) {
+    sharedDictionary_ = stripe.getSharedStringDictionary(fileType_->id());
+  } else {
+    const auto lenId = encodingKey.forKind(proto::Stream_Kind_LENGTH);
+    bool lenVInts = stripe.getUseVInts(lenId);
+    lengthDecoder_ = createRleDecoder</*isSigned*/ false>(
+        stripe.getStream(lenId, params.streamLabels().label(), false),
+        version_,
+        memoryPool_,
+        lenVInts,
+        dwio::common::INT_BYTE_SIZE);
 
-  blobStream_ = stripe.getStream(
-      encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
-      params.streamLabels().label(),
-      false);
+    blobStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_DICTIONARY_DATA),
+        params.streamLabels().label(),
+        false);
+  }
 
   // handle in dictionary stream
   std::unique_ptr<SeekableInputStream> inDictStream = stripe.getStream(
@@ -91,6 +96,10 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
 
 uint64_t SelectiveStringDictionaryColumnReader::skip(uint64_t numValues) {
   numValues = SelectiveColumnReader::skip(numValues);
+  if (noValuePasses_) {
+    // The dictionary indices are not read for the rest of the stripe.
+    return numValues;
+  }
   dictIndex_->skip(numValues);
   if (inDictionaryReader_) {
     inDictionaryReader_->skip(numValues);
@@ -156,36 +165,63 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(
         scanState_.dictionary.numValues + scanState_.dictionary2.numValues);
-    simd::memset(
-        scanState_.filterCache.data() + scanState_.dictionary.numValues,
-        FilterResult::kUnknown,
-        scanState_.dictionary2.numValues);
+    fillFilterCache(
+        scanState_.dictionary2,
+        scanState_.filterCache.data() + scanState_.dictionary.numValues);
   }
   scanState_.updateRawState();
 }
 
+int32_t SelectiveStringDictionaryColumnReader::fillFilterCache(
+    const DictionaryValues& dictionary,
+    uint8_t* filterCache) {
+  auto* filter = scanSpec_->filter();
+  if (!filter || !filter->isDeterministic() || dictionary.numValues == 0) {
+    simd::memset(filterCache, FilterResult::kUnknown, dictionary.numValues);
+    return dictionary.numValues;
+  }
+  return fillStringFilterCache(
+      *filter,
+      dictionary.values->as<StringView>(),
+      dictionary.numValues,
+      filterCache);
+}
+
 void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
   if (scanState_.dictionary2.numValues) {
-    BufferPtr values = AlignedBuffer::allocate<StringView>(
-        scanState_.dictionary.numValues + scanState_.dictionary2.numValues,
-        &memoryPool_);
-    auto* valuesPtr = values->asMutable<StringView>();
-    memcpy(
-        valuesPtr,
-        scanState_.dictionary.values->as<char>(),
-        scanState_.dictionary.numValues * sizeof(StringView));
+    const auto numValues =
+        scanState_.dictionary.numValues + scanState_.dictionary2.numValues;
+    // The stripe dictionary does not change within the stripe. Copy it
+    // again only if the previous combined values are still referenced by a
+    // result or are too small.
+    if (!combinedDictionaryValues_ ||
+        !combinedDictionaryValues_->isMutable() ||
+        combinedDictionaryValues_->capacity() <
+            numValues * sizeof(StringView)) {
+      combinedDictionaryValues_ =
+          AlignedBuffer::allocate<StringView>(numValues, &memoryPool_);
+      numCombinedStripeValues_ = 0;
+    }
+    auto* valuesPtr = combinedDictionaryValues_->asMutable<StringView>();
+    if (numCombinedStripeValues_ != scanState_.dictionary.numValues) {
+      memcpy(
+          valuesPtr,
+          scanState_.dictionary.values->as<char>(),
+          scanState_.dictionary.numValues * sizeof(StringView));
+      numCombinedStripeValues_ = scanState_.dictionary.numValues;
+    }
     memcpy(
         valuesPtr + scanState_.dictionary.numValues,
         scanState_.dictionary2.values->as<char>(),
         scanState_.dictionary2.numValues * sizeof(StringView));
+    combinedDictionaryValues_->setSize(numValues * sizeof(StringView));
 
     dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
         &memoryPool_,
         fileType_->type(),
         BufferPtr(nullptr), // TODO nulls
-        scanState_.dictionary.numValues +
-            scanState_.dictionary2.numValues, // length
-        values,
+        numValues,
+        combinedDictionaryValues_,
         std::vector<BufferPtr>{
             scanState_.dictionary.strings, scanState_.dictionary2.strings});
   } else {
@@ -210,6 +246,14 @@ void SelectiveStringDictionaryColumnReader::read(
   // lazy loading dictionary data when first hit
   ensureInitialized();
 
+  if (noValuePasses_) {
+    if (scanSpec_->filter()->testNull()) {
+      filterNulls<int32_t>(rows, true, scanSpec_->keepValues());
+    }
+    readOffset_ += rows.back() + 1;
+    return;
+  }
+
   if (inDictionaryReader_) {
     auto end = rows.back() + 1;
     bool isBulk = useBulkPath();
@@ -281,7 +325,11 @@ void SelectiveStringDictionaryColumnReader::getValues(
       dictionaryValues_,
       values_);
 
-  if (scanSpec_->makeFlat()) {
+  // The dictionary is kept unless it is much larger than the batch, in
+  // which case consumers that work on the distinct values would do more
+  // work than on the rows.
+  if (scanSpec_->makeFlat() ||
+      options_.shouldFlattenDictionary(dictionaryValues_->size(), numValues_)) {
     BaseVector::ensureWritable(
         SelectivityVector::empty(), (*result)->type(), &memoryPool_, *result);
   }
@@ -294,14 +342,23 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
 
   Timer timer;
 
-  loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  if (sharedDictionary_) {
+    // The stripe uses a prefix of the dictionary shared by the stripes.
+    scanState_.dictionary.values =
+        sharedDictionary_->viewsBuffer(scanState_.dictionary.numValues);
+    scanState_.dictionary.strings = sharedDictionary_->dataBuffer();
+  } else {
+    loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  }
 
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
-    simd::memset(
-        scanState_.filterCache.data(),
-        FilterResult::kUnknown,
-        scanState_.dictionary.numValues);
+    // If all values are in the stripe dictionary and none of them passes,
+    // only nulls can pass for the rest of the stripe.
+    const auto numPassed = fillFilterCache(
+        scanState_.dictionary, scanState_.filterCache.data());
+    noValuePasses_ = numPassed == 0 && scanSpec_->filter() &&
+        !inDictionaryReader_ && !scanSpec_->valueHook();
   }
 
   // handle in dictionary stream
@@ -60,6 +60,15 @@ class SelectiveStringDictionaryColumnReader
 
  private:
   void loadStrideDictionary();
+
+  // Applies the filter of the column to each entry of 'dictionary' and
+  // stores the results in 'filterCache'. Returns the number of entries that
+  // pass. Leaves the results unknown if the filter is not deterministic and
+  // returns the size of the dictionary.
+  int32_t fillFilterCache(
+      const dwio::common::DictionaryValues& dictionary,
+      uint8_t* filterCache);
+
   void makeDictionaryBaseVector();
 
   template <typename TVisitor>
@@ -88,6 +97,13 @@ class SelectiveStringDictionaryColumnReader
       strideDictLengthDecoder_;
 
   FlatVectorPtr<StringView> dictionaryValues_;
+  // Values of the stripe dictionary followed by the ones of the stride
+  // dictionary. Kept for the stripe so that only the stride part is copied
+  // on a stride change if no earlier result references it.
+  BufferPtr combinedDictionaryValues_;
+  // Number of stripe dictionary values at the start of
+  // 'combinedDictionaryValues_'.
+  vector_size_t numCombinedStripeValues_{0};
 
   int64_t lastStrideIndex_;
   size_t positionOffset_;
@@ -95,11 +111,20 @@ class SelectiveStringDictionaryColumnReader
   RleVersion version_;
 
   const StrideIndexProvider& provider_;
+  const dwio::common::RowReaderOptions& options_;
 
   // lazy load the dictionary
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> lengthDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> blobStream_;
+  // Set instead of 'lengthDecoder_' and 'blobStream_' if the stripe uses the
+  // dictionary shared by the stripes of the file.
+  std::shared_ptr<const SharedStringDictionary> sharedDictionary_;
   bool initialized_{false};
+
+  // True if no entry of the stripe dictionary passes the filter and there
+  // are no stride dictionaries. Only nulls can pass then, so the dictionary
+  // indices are not decoded.
+  bool noValuePasses_{false};
 };
 
 template <typename TVisitor>
@@ -39,11 +39,11 @@ bool StripeReaderBase::fetchStripe(uint32_t index, bool& preload) {
       stripe.indexLength() + stripe.dataLength() + stripe.footerLength();
 
   std::unique_ptr<dwio::common::BufferedInput> prefetchedStripe;
-  if (reader_->getBufferedInput().isBuffered(offset, length)) {
+  if (bufferedInput().isBuffered(offset, length)) {
     preload = true;
     prefetchedStripe = nullptr;
   } else {
-    prefetchedStripe = reader_->getBufferedInput().clone();
+    prefetchedStripe = bufferedInput().clone();
     if (preload) {
       // If metadata cache exists, adjust read position to avoid re-reading
       // metadata sections
@@ -70,7 +70,7 @@ bool StripeReaderBase::fetchStripe(uint32_t index, bool& preload) {
 
   if (!stream) {
     dwio::common::BufferedInput& bi =
-        prefetchedStripe ? *prefetchedStripe : reader_->getBufferedInput();
+        prefetchedStripe ? *prefetchedStripe : bufferedInput();
     stream = bi.read(
         stripe.offset() + stripe.indexLength() + stripe.dataLength(),
         stripe.footerLength(),
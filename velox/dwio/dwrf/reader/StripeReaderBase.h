@@ -25,8 +25,14 @@ namespace facebook::velox::dwrf {
 
 class StripeReaderBase {
  public:
-  explicit StripeReaderBase(const std::shared_ptr<ReaderBase>& reader)
+  // If 'input' is set, the stripes are read through it instead of the
+  // BufferedInput of 'reader', e.g. when several readers of the same file
+  // are used from different threads.
+  explicit StripeReaderBase(
+      const std::shared_ptr<ReaderBase>& reader,
+      std::unique_ptr<dwio::common::BufferedInput> input = nullptr)
       : reader_{reader},
+        input_{std::move(input)},
         handler_{std::make_unique<encryption::DecryptionHandler>(
             reader_->getDecryptionHandler())} {}
 
@@ -68,7 +74,7 @@ class StripeReaderBase {
   }
 
   dwio::common::BufferedInput& getStripeInput() const {
-    return stripeInput_ ? *stripeInput_ : reader_->getBufferedInput();
+    return stripeInput_ ? *stripeInput_ : bufferedInput();
   }
 
   ReaderBase& getReader() const {
@@ -109,8 +115,16 @@ class StripeReaderBase {
     return prefetchedStripes_.wlock()->erase(index) == 1;
   }
 
+  // Returns the input for the stripes that are not read through their own
+  // BufferedInput.
+  dwio::common::BufferedInput& bufferedInput() const {
+    return input_ ? *input_ : reader_->getBufferedInput();
+  }
+
  private:
   const std::shared_ptr<ReaderBase> reader_;
+  // The input of 'this' if it does not use the one of 'reader_'.
+  const std::unique_ptr<dwio::common::BufferedInput> input_;
   const std::unique_ptr<encryption::DecryptionHandler> handler_;
   std::unique_ptr<dwio::common::BufferedInput> stripeInput_;
   std::optional<uint32_t> lastStripeIndex_;
@@ -138,6 +138,13 @@ class StripeStreams {
 
   virtual std::shared_ptr<StripeDictionaryCache> getStripeDictionaryCache() = 0;
 
+  /// Get the dictionary of the string column 'node' shared by the stripes of
+  /// the file.
+  virtual std::shared_ptr<const SharedStringDictionary>
+  getSharedStringDictionary(uint32_t /* node */) const {
+    DWIO_RAISE("Shared string dictionaries are not supported");
+  }
+
   /**
    * visit all streams of given node and execute visitor logic
    * return number of streams visited
@@ -347,6 +354,11 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return readState_->readerBase->getFooter().rowIndexStride();
   }
 
+  std::shared_ptr<const SharedStringDictionary> getSharedStringDictionary(
+      uint32_t node) const override {
+    return readState_->readerBase->getSharedStringDictionary(node);
+  }
+
  private:
   const StreamInformation& getStreamInfo(
       const DwrfStreamIdentifier& si,
@@ -16,6 +16,7 @@
 
 #include <folly/Random.h>
 #include <folly/container/F14Map.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
@@ -83,10 +84,38 @@ class TestReadFile : public ReadFile {
     VELOX_NYI();
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (asyncExecutor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    ++numAsyncReads_;
+    return folly::via(
+               asyncExecutor_,
+               [this, offset, buffers]() { return preadv(offset, buffers); })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const override {
+    return asyncExecutor_ != nullptr;
+  }
+
+  // Makes preadvAsync() run the reads on 'executor'.
+  void setAsyncExecutor(folly::Executor* executor) {
+    asyncExecutor_ = executor;
+  }
+
+  int32_t numAsyncReads() const {
+    return numAsyncReads_;
+  }
+
  private:
   const uint64_t seed_;
   const uint64_t length_;
   IoStatisticsPtr ioStats_;
+  folly::Executor* asyncExecutor_{nullptr};
+  mutable std::atomic<int32_t> numAsyncReads_{0};
 };
 
 class CacheTest : public testing::Test {
@@ -512,6 +541,71 @@ TEST_F(CacheTest, bufferedInput) {
   readLoop("testfile2", 30, 70, 70, 20, 4, ioStats_);
 }
 
+TEST_F(CacheTest, asyncRead) {
+  initializeCache(64 << 20);
+  // The reads run on their own executor so that loads waiting for them on
+  // 'executor_' cannot starve them.
+  folly::CPUThreadPoolExecutor readExecutor(4);
+  uint64_t fileId;
+  uint64_t groupId;
+  inputByPath("asyncfile", fileId, groupId)->setAsyncExecutor(&readExecutor);
+  readLoop("asyncfile", 30, 70, 10, 10, 4, ioStats_);
+  executor_->join();
+  EXPECT_LT(0, inputByPath("asyncfile", fileId, groupId)->numAsyncReads());
+}
+
+TEST_F(CacheTest, readAheadDepth) {
+  initializeCache(64 << 20);
+  // 100us latency at 2GB/s allows 2 outstanding read-ahead loads.
+  auto tuner = std::make_shared<IoTuner>(8 << 20, 512 << 10);
+  for (auto i = 0; i < 50; ++i) {
+    uint64_t bytes = (64 << 10) * (1 + i % 16);
+    tuner->recordRead(bytes, 100 + bytes / 2000);
+  }
+  ASSERT_EQ(2, tuner->parameters().maxOutstandingLoads);
+  ReaderOptions options(pool_.get());
+  options.setIoTuner(tuner);
+  uint64_t fileId;
+  uint64_t groupId;
+  auto file = inputByPath("depthfile", fileId, groupId);
+  auto input = std::make_unique<CachedBufferedInput>(
+      file,
+      MetricsLog::voidLog(),
+      fileId,
+      cache_.get(),
+      nullptr,
+      groupId,
+      ioStats_,
+      executor_.get(),
+      options);
+  // The regions are too far apart to coalesce, so each is its own load.
+  constexpr int32_t kNumRegions = 10;
+  constexpr int32_t kRegionSize = 100'000;
+  auto sequential = StreamIdentifier::sequentialFile();
+  std::vector<Region> regions;
+  std::vector<std::unique_ptr<SeekableInputStream>> streams;
+  for (auto i = 0; i < kNumRegions; ++i) {
+    regions.push_back(
+        Region{static_cast<uint64_t>(i) * (10 << 20), kRegionSize});
+    streams.push_back(input->enqueue(regions.back(), &sequential));
+  }
+  input->load(LogType::TEST);
+  executor_->join();
+  // The loads over the depth were started by the finishing ones, not by a
+  // reading stream.
+  EXPECT_EQ(kNumRegions * kRegionSize, ioStats_->prefetch().sum());
+  for (auto i = 0; i < kNumRegions; ++i) {
+    const void* data;
+    int32_t size;
+    uint64_t numRead = 0;
+    while (streams[i]->Next(&data, &size)) {
+      file->checkData(data, regions[i].offset + numRead, size);
+      numRead += size;
+    }
+    EXPECT_EQ(kRegionSize, numRead);
+  }
+}
+
 // Calibrates the data read for a densely and sparsely read stripe of
 // test data. Fills the SSD cache with test data. Reads 2x cache size
 // worth of data and checks that the cache population settles to a
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+#include "velox/dwio/common/TypeWithId.h"
+#include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include "velox/type/Type.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+// Measures the overhead of the sketches of distinct values on the column
+// writers. Each iteration writes and indexes 'kNumStrides' strides.
+constexpr vector_size_t kVectorSize = 10'000;
+constexpr int32_t kNumStrides = 100;
+
+VectorPtr
+makeVector(const TypePtr& type, int32_t numDistinct, memory::MemoryPool* pool) {
+  if (type->kind() == TypeKind::BIGINT) {
+    auto vector =
+        BaseVector::create<FlatVector<int64_t>>(type, kVectorSize, pool);
+    for (vector_size_t i = 0; i < kVectorSize; ++i) {
+      vector->set(i, (i % numDistinct) * 1'000'000'007L);
+    }
+    return vector;
+  }
+  auto vector =
+      BaseVector::create<FlatVector<StringView>>(type, kVectorSize, pool);
+  for (vector_size_t i = 0; i < kVectorSize; ++i) {
+    const auto value = fmt::format("value_{:020}", i % numDistinct);
+    vector->set(i, StringView(value));
+  }
+  return vector;
+}
+
+void runBenchmark(
+    const TypePtr& type,
+    int32_t numDistinct,
+    bool distinctCountStats) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  const auto vector = makeVector(type, numDistinct, pool.get());
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::DISTINCT_COUNT_STATS, distinctCountStats);
+  WriterContext context{
+      config,
+      memory::defaultMemoryManager().addRootPool(
+          "DistinctCountStatsBenchmark")};
+  const auto typeWithId = TypeWithId::create(type, 1);
+  auto writer = BaseColumnWriter::create(context, *typeWithId, 0);
+  suspender.dismiss();
+
+  for (auto i = 0; i < kNumStrides; ++i) {
+    writer->write(vector, common::Ranges::of(0, kVectorSize));
+    writer->createIndexEntry();
+  }
+}
+
+BENCHMARK(bigint100) {
+  runBenchmark(BIGINT(), 100, false);
+}
+
+BENCHMARK_RELATIVE(bigint100DistinctCounts) {
+  runBenchmark(BIGINT(), 100, true);
+}
+
+BENCHMARK(bigint10000) {
+  runBenchmark(BIGINT(), 10'000, false);
+}
+
+BENCHMARK_RELATIVE(bigint10000DistinctCounts) {
+  runBenchmark(BIGINT(), 10'000, true);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(varchar100) {
+  runBenchmark(VARCHAR(), 100, false);
+}
+
+BENCHMARK_RELATIVE(varchar100DistinctCounts) {
+  runBenchmark(VARCHAR(), 100, true);
+}
+
+BENCHMARK(varchar10000) {
+  runBenchmark(VARCHAR(), 10'000, false);
+}
+
+BENCHMARK_RELATIVE(varchar10000DistinctCounts) {
+  runBenchmark(VARCHAR(), 10'000, true);
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
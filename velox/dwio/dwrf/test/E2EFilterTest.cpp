@@ -20,6 +20,7 @@
 #include "velox/dwio/dwrf/writer/FlushPolicy.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 using namespace facebook::velox::dwio::common;
@@ -274,6 +275,164 @@ TEST_F(E2EFilterTest, stringDictionary) {
       true);
 }
 
+TEST_F(E2EFilterTest, stringDictionaryNoMatchInStripe) {
+  constexpr int32_t kNumBatches = 4;
+  constexpr int32_t kBatchSize = 1'000;
+  flushEveryNBatches_ = 1;
+  // Each batch is a stripe with 'apple', 'cherry' and nulls. Only the third
+  // stripe has 'banana'.
+  rowType_ = ROW({"id", "fruit"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    auto ids = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), kBatchSize, leafPool_.get());
+    auto fruits = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kBatchSize, leafPool_.get());
+    for (auto i = 0; i < kBatchSize; ++i) {
+      ids->set(i, batch * kBatchSize + i);
+      if (i % 7 == 0) {
+        fruits->setNull(i, true);
+      } else if (batch == 2 && i % 10 == 0) {
+        fruits->set(i, StringView("banana"));
+      } else {
+        fruits->set(i, StringView(i % 2 ? "apple" : "cherry"));
+      }
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kBatchSize,
+        std::vector<VectorPtr>{ids, fruits}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  // Returns the number of rows passing a filter on 'banana' and checks that
+  // they are 'banana' or null.
+  auto read = [&](bool nullAllowed) {
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("fruit")->setFilter(std::make_unique<BytesValues>(
+        std::vector<std::string>{"banana"}, nullAllowed));
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    dwio::common::RowReaderOptions rowReaderOpts;
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    int32_t numRows = 0;
+    while (rowReader->next(300, result) > 0) {
+      auto* rows = result->as<RowVector>();
+      auto* resultIds =
+          rows->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      auto* resultFruits =
+          rows->childAt(1)->loadedVector()->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < rows->size(); ++i) {
+        const auto id = resultIds->valueAt(i) % kBatchSize;
+        if (resultFruits->isNullAt(i)) {
+          EXPECT_EQ(0, id % 7);
+        } else {
+          EXPECT_EQ("banana", resultFruits->valueAt(i).str());
+          EXPECT_EQ(0, id % 10);
+        }
+        ++numRows;
+      }
+    }
+    return numRows;
+  };
+
+  // 'banana' is in rows multiple of 10 but not of 7 of the third stripe.
+  const int32_t numBananas = kBatchSize / 10 - (kBatchSize / 70 + 1);
+  const int32_t numNulls = kNumBatches * (kBatchSize / 7 + 1);
+  EXPECT_EQ(numBananas, read(false));
+  EXPECT_EQ(numBananas + numNulls, read(true));
+}
+
+TEST_F(E2EFilterTest, parallelDecoding) {
+  constexpr int32_t kNumBatches = 6;
+  constexpr int32_t kBatchSize = 1'000;
+  flushEveryNBatches_ = 1;
+  rowType_ = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    auto ids = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), kBatchSize, leafPool_.get());
+    auto names = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kBatchSize, leafPool_.get());
+    for (auto i = 0; i < kBatchSize; ++i) {
+      const auto id = batch * kBatchSize + i;
+      ids->set(i, id);
+      names->set(i, StringView(fmt::format("name{}", id % 97)));
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kBatchSize,
+        std::vector<VectorPtr>{ids, names}));
+  }
+  writeToMemory(rowType_, batches, false);
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+
+  // Returns the ids of the rows with an id divisible by 3, read with
+  // 'parallelism' stripes at a time. The size of the reads alternates
+  // between a large and a small one.
+  auto read = [&](int32_t parallelism, bool preserveOrder) {
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    dwio::common::RowReaderOptions rowReaderOpts;
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    rowReaderOpts.setDecodingExecutor(executor);
+    rowReaderOpts.setDecodingParallelism(parallelism, preserveOrder, 2);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    std::vector<int64_t> resultIds;
+    int64_t numScanned = 0;
+    uint64_t size = 300;
+    while (auto numRows = rowReader->next(size, result)) {
+      numScanned += numRows;
+      auto* rows = result->as<RowVector>();
+      EXPECT_LE(rows->size(), size);
+      size = size == 300 ? 7 : 300;
+      auto* ids =
+          rows->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      auto* names =
+          rows->childAt(1)->loadedVector()->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < rows->size(); ++i) {
+        EXPECT_EQ(
+            fmt::format("name{}", ids->valueAt(i) % 97),
+            names->valueAt(i).str());
+        if (ids->valueAt(i) % 3 == 0) {
+          resultIds.push_back(ids->valueAt(i));
+        }
+      }
+    }
+    EXPECT_EQ(kNumBatches * kBatchSize, numScanned);
+    return resultIds;
+  };
+
+  auto expected = read(1, true);
+  EXPECT_EQ(kNumBatches * kBatchSize / 3, expected.size());
+  EXPECT_TRUE(std::is_sorted(expected.begin(), expected.end()));
+  EXPECT_EQ(expected, read(3, true));
+  auto unordered = read(3, false);
+  std::sort(unordered.begin(), unordered.end());
+  EXPECT_EQ(expected, unordered);
+
+  // The units do not hold a thread while their queues are full, so that
+  // fewer threads than units in flight are enough.
+  executor = std::make_shared<folly::CPUThreadPoolExecutor>(1);
+  EXPECT_EQ(expected, read(3, true));
+}
+
 TEST_F(E2EFilterTest, timestamp) {
   testWithTypes(
       "timestamp_val:timestamp,"
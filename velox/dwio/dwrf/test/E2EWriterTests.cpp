@@ -15,7 +15,9 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
+#include "velox/common/hyperloglog/HllAccumulator.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/common/TypeWithId.h"
@@ -814,6 +816,473 @@ TEST_F(E2EWriterTests, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTests, parallelFlush) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>"
+      ">");
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 6; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 2'000, *leafPool_, nullptr, i));
+  }
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(
+      dwrf::Config::COMPRESSION,
+      facebook::velox::common::CompressionKind_ZSTD);
+  // Makes the streams span several pages.
+  config->set(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1'024UL);
+
+  // Encrypts two of the columns. The streams of a column share one
+  // encrypter, so that their pages are not deferred.
+  auto spec =
+      std::make_shared<EncryptionSpecification>(EncryptionProvider::Unknown);
+  spec->withEncryptedField(
+          FieldEncryptionSpecification{}.withIndex(1).withEncryptionProperties(
+              std::make_shared<TestEncryptionProperties>("key1")))
+      .withEncryptedField(
+          FieldEncryptionSpecification{}.withIndex(3).withEncryptionProperties(
+              std::make_shared<TestEncryptionProperties>("key2")));
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  const auto write = [&](std::shared_ptr<folly::Executor> flushExecutor,
+                         bool encrypted) {
+    std::string data;
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.flushExecutor = std::move(flushExecutor);
+    if (encrypted) {
+      options.encryptionSpec = spec;
+      options.encrypterFactory = std::make_shared<TestEncrypterFactory>();
+    }
+    // Flushes a stripe per batch.
+    options.flushPolicyFactory =
+        E2EWriterTestUtil::simpleFlushPolicyFactory(true);
+    // The sink is not buffered, so that the stripes are written on the
+    // executor.
+    dwrf::Writer writer{
+        std::make_unique<WriteFileSink>(
+            std::make_unique<InMemoryWriteFile>(&data), "test"),
+        options};
+    for (auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return data;
+  };
+
+  for (const bool encrypted : {false, true}) {
+    SCOPED_TRACE(fmt::format("encrypted {}", encrypted));
+    const auto expected = write(nullptr, encrypted);
+    const auto actual = write(executor, encrypted);
+    ASSERT_EQ(expected, actual);
+
+    ReaderOptions readerOpts{defaultPool.get()};
+    readerOpts.setDecrypterFactory(std::make_shared<TestDecrypterFactory>());
+    auto reader = std::make_unique<DwrfReader>(
+        readerOpts,
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(actual),
+            readerOpts.getMemoryPool()));
+    ASSERT_EQ(reader->getNumberOfStripes(), batches.size());
+    auto rowReader = reader->createRowReader(RowReaderOptions{});
+    auto result = BaseVector::create(type, 0, leafPool_.get());
+    for (auto& batch : batches) {
+      ASSERT_EQ(
+          rowReader->next(batch->size(), result),
+          static_cast<uint64_t>(batch->size()));
+      for (auto i = 0; i < batch->size(); ++i) {
+        ASSERT_TRUE(batch->equalValueAt(result.get(), i, i))
+            << "Content mismatch at index " << i << ": "
+            << batch->toString(i) << " vs. " << result->toString(i);
+      }
+    }
+  }
+}
+
+TEST_F(E2EWriterTests, adaptiveEncodingSelection) {
+  // The first and last stripes have 10 distinct values, the others have
+  // unique values.
+  const std::vector<bool> lowCardinality{true, true, false, false, true, true};
+  const vector_size_t size = 10'000;
+  VectorMaker maker{leafPool_.get()};
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < lowCardinality.size(); ++i) {
+    std::vector<int64_t> ints;
+    std::vector<std::string> strings;
+    for (auto row = 0; row < size; ++row) {
+      const int64_t value = lowCardinality[i]
+          ? row % 10 * 1'000'000'007L
+          : folly::Random::rand64() >> 1;
+      ints.push_back(value);
+      strings.push_back(fmt::format("value_{:020}", value));
+    }
+    batches.push_back(maker.rowVector(
+        {"int_val", "string_val"},
+        {maker.flatVector(ints), maker.flatVector(strings)}));
+  }
+  auto type = batches[0]->type();
+
+  auto config = std::make_shared<dwrf::Config>();
+  // The decisions depend on the compression ratio of each encoding.
+  config->set(
+      dwrf::Config::COMPRESSION,
+      facebook::velox::common::CompressionKind_NONE);
+  config->set(dwrf::Config::ADAPTIVE_ENCODING_SELECTION, true);
+
+  std::string data;
+  dwrf::WriterOptions options;
+  options.config = config;
+  options.schema = type;
+  options.memoryPool = rootPool_.get();
+  dwrf::Writer writer{
+      std::make_unique<WriteFileSink>(
+          std::make_unique<InMemoryWriteFile>(&data), "test"),
+      options};
+  for (auto& batch : batches) {
+    writer.write(batch);
+    writer.flush();
+  }
+  writer.close();
+
+  ReaderOptions readerOpts{defaultPool.get()};
+  auto reader = std::make_unique<DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data),
+          readerOpts.getMemoryPool()));
+  ASSERT_EQ(reader->getNumberOfStripes(), batches.size());
+  // The columns switch to direct encoding when the stripe is flushed and back
+  // to dictionary encoding on the stripe after a direct stripe with few
+  // distinct values.
+  ASSERT_EQ(
+      reader->getMetadataValue(std::string{WRITER_ENCODINGS_KEY}),
+      "1:DDRRRD,2:DDRRRD");
+
+  auto rowReader = reader->createRowReader(RowReaderOptions{});
+  auto result = BaseVector::create(type, 0, leafPool_.get());
+  for (auto& batch : batches) {
+    ASSERT_EQ(rowReader->next(size, result), size);
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_TRUE(batch->equalValueAt(result.get(), i, i))
+          << "Content mismatch at index " << i << ": "
+          << batch->toString(i) << " vs. " << result->toString(i);
+    }
+  }
+}
+
+TEST_F(E2EWriterTests, distinctCountStats) {
+  // Each stripe has 5'000 distinct values and the file has 8'000.
+  const int32_t numStripes = 4;
+  const vector_size_t size = 10'000;
+  VectorMaker maker{leafPool_.get()};
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < numStripes; ++i) {
+    auto value = [i](auto row) { return i * 1'000 + row % 5'000; };
+    batches.push_back(maker.rowVector(
+        {"int_val", "double_val", "string_val", "bool_val"},
+        {maker.flatVector<int64_t>(size, value),
+         maker.flatVector<double>(
+             size, [&](auto row) { return value(row) / 2.0; }),
+         maker.flatVector<std::string>(
+             size, [&](auto row) { return fmt::format("s{}", value(row)); }),
+         maker.flatVector<bool>(size, [](auto row) { return row % 2; })}));
+  }
+  auto type = batches[0]->type();
+
+  for (const bool enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled: {}", enabled));
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::DISTINCT_COUNT_STATS, enabled);
+
+    std::string data;
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    dwrf::Writer writer{
+        std::make_unique<WriteFileSink>(
+            std::make_unique<InMemoryWriteFile>(&data), "test"),
+        options};
+    for (auto& batch : batches) {
+      writer.write(batch);
+      writer.flush();
+    }
+    writer.close();
+
+    ReaderOptions readerOpts{defaultPool.get()};
+    auto reader = std::make_unique<DwrfReader>(
+        readerOpts,
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(data),
+            readerOpts.getMemoryPool()));
+    ASSERT_EQ(reader->getNumberOfStripes(), numStripes);
+    const auto key = [](uint32_t node) {
+      return dwio::common::distinctCountKey(node);
+    };
+    // Boolean columns and the root have no sketch.
+    ASSERT_FALSE(reader->hasMetadataValue(key(0)));
+    ASSERT_FALSE(reader->hasMetadataValue(key(4)));
+    for (uint32_t node = 1; node <= 3; ++node) {
+      SCOPED_TRACE(fmt::format("node: {}", node));
+      ASSERT_EQ(reader->hasMetadataValue(key(node)), enabled);
+      if (!enabled) {
+        continue;
+      }
+      const auto serialized = reader->getMetadataValue(key(node));
+      HashStringAllocator allocator{leafPool_.get()};
+      facebook::velox::common::hll::HllAccumulator sketch{&allocator};
+      sketch.mergeWith(StringView(serialized), &allocator);
+      ASSERT_NEAR(sketch.cardinality(), 8'000, 8'000 * 0.05);
+    }
+  }
+}
+
+TEST_F(E2EWriterTests, sharedStringDictionary) {
+  // Stripe i of 'shared' has the 10 + i values of the previous stripes and
+  // one more. Each stripe of 'grow' adds 50 values of 5 bytes, so that the
+  // last stripe would grow the shared dictionary over its maximum size.
+  const int32_t numStripes = 4;
+  const vector_size_t size = 10'000;
+  VectorMaker maker{leafPool_.get()};
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < numStripes; ++i) {
+    batches.push_back(maker.rowVector(
+        {"shared", "grow"},
+        {maker.flatVector<std::string>(
+             size,
+             [&](auto row) {
+               return fmt::format("shared_value_{}", row % (10 + i));
+             }),
+         maker.flatVector<std::string>(size, [&](auto row) {
+           return fmt::format("g{:04}", i * 50 + row % 100);
+         })}));
+  }
+  auto type = batches[0]->type();
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::SHARED_STRING_DICTIONARY, true);
+  config->set<uint64_t>(dwrf::Config::SHARED_STRING_DICTIONARY_MAX_SIZE, 1000);
+
+  std::string data;
+  dwrf::WriterOptions options;
+  options.config = config;
+  options.schema = type;
+  options.memoryPool = rootPool_.get();
+  dwrf::Writer writer{
+      std::make_unique<WriteFileSink>(
+          std::make_unique<InMemoryWriteFile>(&data), "test"),
+      options};
+  for (auto& batch : batches) {
+    writer.write(batch);
+    writer.flush();
+  }
+  writer.close();
+
+  ReaderOptions readerOpts{defaultPool.get()};
+  auto reader = std::make_unique<DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data),
+          readerOpts.getMemoryPool()));
+  ASSERT_EQ(reader->getNumberOfStripes(), numStripes);
+  for (uint32_t node = 1; node <= 2; ++node) {
+    ASSERT_TRUE(reader->hasMetadataValue(
+        fmt::format("{}{}", WRITER_SHARED_DICTIONARY_KEY_PREFIX, node)));
+  }
+
+  {
+    auto rowReader = reader->createRowReader(RowReaderOptions{});
+    auto dwrfRowReader = dynamic_cast<DwrfRowReader*>(rowReader.get());
+    for (int32_t i = 0; i < numStripes; ++i) {
+      SCOPED_TRACE(fmt::format("stripe: {}", i));
+      dwrfRowReader->loadStripe(i, true);
+      auto& footer = dwrfRowReader->getStripeFooter();
+      std::unordered_map<uint32_t, proto::ColumnEncoding> encodings;
+      for (auto& encoding : footer.encoding()) {
+        encodings[encoding.node()] = encoding;
+      }
+      ASSERT_EQ(encodings[1].kind(), proto::ColumnEncoding_Kind_DICTIONARY);
+      ASSERT_TRUE(encodings[1].shareddictionary());
+      ASSERT_EQ(encodings[1].dictionarysize(), 10 + i);
+      ASSERT_EQ(encodings[2].kind(), proto::ColumnEncoding_Kind_DICTIONARY);
+      ASSERT_EQ(encodings[2].shareddictionary(), i < numStripes - 1);
+      for (auto& stream : footer.streams()) {
+        if (stream.kind() == proto::Stream_Kind_DICTIONARY_DATA ||
+            stream.kind() == proto::Stream_Kind_LENGTH) {
+          ASSERT_NE(stream.node(), 1);
+        }
+      }
+    }
+  }
+
+  auto spec = std::make_shared<facebook::velox::common::ScanSpec>("<root>");
+  spec->addAllChildFields(*type);
+  for (const bool selective : {false, true}) {
+    SCOPED_TRACE(fmt::format("selective: {}", selective));
+    RowReaderOptions rowReaderOpts;
+    if (selective) {
+      rowReaderOpts.setScanSpec(spec);
+    }
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(type, 0, leafPool_.get());
+    for (auto& batch : batches) {
+      ASSERT_EQ(rowReader->next(size, result), size);
+      for (auto i = 0; i < size; ++i) {
+        ASSERT_TRUE(batch->equalValueAt(result.get(), i, i))
+            << "Content mismatch at index " << i << ": "
+            << batch->toString(i) << " vs. " << result->toString(i);
+      }
+    }
+  }
+}
+
+TEST_F(E2EWriterTests, dictionaryOutput) {
+  // 'large' has a dictionary of 5000 entries and 'small' one of 10. Half of
+  // the values of 'stride' are unique, so each stride of 1000 rows has a
+  // stride dictionary of 500 entries next to the stripe dictionary.
+  const vector_size_t size = 20'000;
+  constexpr uint32_t kRowIndexStride = 1'000;
+  VectorMaker maker{leafPool_.get()};
+  auto batch = maker.rowVector(
+      {"large", "small", "stride"},
+      {maker.flatVector<std::string>(
+           size,
+           [](auto row) { return fmt::format("large_value_{}", row % 5000); }),
+       maker.flatVector<std::string>(
+           size,
+           [](auto row) { return fmt::format("small_value_{}", row % 10); }),
+       maker.flatVector<std::string>(size, [](auto row) {
+         return row % 2 == 0 ? fmt::format("common_value_{}", row % 10)
+                             : fmt::format("unique_value_{}", row);
+       })});
+  auto type = batch->type();
+
+  std::string data;
+  dwrf::WriterOptions options;
+  options.config = std::make_shared<dwrf::Config>();
+  options.config->set(dwrf::Config::ROW_INDEX_STRIDE, kRowIndexStride);
+  // Keeps the dictionary encoding of 'stride' despite its unique values.
+  options.config->set(dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, 1.0f);
+  options.config->set(dwrf::Config::ENTROPY_KEY_STRING_SIZE_THRESHOLD, 1.0f);
+  options.schema = type;
+  options.memoryPool = rootPool_.get();
+  dwrf::Writer writer{
+      std::make_unique<WriteFileSink>(
+          std::make_unique<InMemoryWriteFile>(&data), "test"),
+      options};
+  writer.write(batch);
+  writer.close();
+
+  ReaderOptions readerOpts{defaultPool.get()};
+  auto reader = std::make_unique<DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data),
+          readerOpts.getMemoryPool()));
+  auto spec = std::make_shared<facebook::velox::common::ScanSpec>("<root>");
+  spec->addAllChildFields(*type);
+
+  // Reads the first 2 batches of 'batchSize' rows and returns the encoding
+  // of 'large' and 'small'. Checks that the batches share their
+  // dictionaries.
+  auto read = [&](vector_size_t batchSize, uint32_t ratio) {
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    rowReaderOpts.setMaxDictionaryToBatchRatio(ratio);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    std::vector<VectorPtr> results;
+    for (auto i = 0; i < 2; ++i) {
+      VectorPtr result = BaseVector::create(type, 0, leafPool_.get());
+      EXPECT_EQ(rowReader->next(batchSize, result), batchSize);
+      for (auto row = 0; row < batchSize; ++row) {
+        EXPECT_TRUE(
+            batch->equalValueAt(result.get(), i * batchSize + row, row))
+            << "Content mismatch at index " << row;
+      }
+      results.push_back(result);
+    }
+    std::vector<VectorEncoding::Simple> encodings;
+    for (auto column = 0; column < 2; ++column) {
+      auto first = BaseVector::loadedVectorShared(
+          results[0]->as<RowVector>()->childAt(column));
+      auto second = BaseVector::loadedVectorShared(
+          results[1]->as<RowVector>()->childAt(column));
+      EXPECT_EQ(first->encoding(), second->encoding());
+      if (first->encoding() == VectorEncoding::Simple::DICTIONARY) {
+        EXPECT_EQ(first->valueVector(), second->valueVector());
+      }
+      encodings.push_back(first->encoding());
+    }
+    return encodings;
+  };
+
+  using Encodings = std::vector<VectorEncoding::Simple>;
+  const auto kDictionary = VectorEncoding::Simple::DICTIONARY;
+  const auto kFlat = VectorEncoding::Simple::FLAT;
+  EXPECT_EQ(read(1'000, 16), (Encodings{kDictionary, kDictionary}));
+  EXPECT_EQ(read(100, 16), (Encodings{kFlat, kDictionary}));
+  EXPECT_EQ(read(100, 0), (Encodings{kDictionary, kDictionary}));
+
+  // Returns the buffer of the stripe and stride dictionary values of
+  // 'stride' in 'result'.
+  auto strideValues = [](const VectorPtr& result) {
+    auto* values = result->as<RowVector>()->childAt(2)->loadedVector();
+    EXPECT_EQ(values->encoding(), VectorEncoding::Simple::DICTIONARY);
+    return values->valueVector()->values().get();
+  };
+
+  // Reads 'stride' in batches of half a stride. The combined dictionary
+  // values are shared within a stride. On a stride change they are copied
+  // if an earlier result still references them and reused otherwise. The
+  // selective and the non-selective readers both do this.
+  constexpr vector_size_t kBatchSize = kRowIndexStride / 2;
+  for (const bool selective : {true, false}) {
+    SCOPED_TRACE(fmt::format("selective: {}", selective));
+    RowReaderOptions rowReaderOpts;
+    if (selective) {
+      rowReaderOpts.setScanSpec(spec);
+    }
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    vector_size_t offset = 0;
+    auto next = [&]() {
+      VectorPtr result = BaseVector::create(type, 0, leafPool_.get());
+      EXPECT_EQ(rowReader->next(kBatchSize, result), kBatchSize);
+      for (auto row = 0; row < kBatchSize; ++row) {
+        EXPECT_TRUE(batch->equalValueAt(result.get(), offset + row, row))
+            << "Content mismatch at index " << offset + row;
+      }
+      offset += kBatchSize;
+      return result;
+    };
+
+    auto first = next();
+    auto second = next();
+    EXPECT_EQ(strideValues(first), strideValues(second));
+    // 'first' and 'second' keep the values of stride 0.
+    auto third = next();
+    auto fourth = next();
+    EXPECT_NE(strideValues(third), strideValues(first));
+    EXPECT_EQ(strideValues(third), strideValues(fourth));
+    // Nothing references the values of stride 1 when stride 2 is read.
+    const auto* stride1Values = strideValues(third);
+    first.reset();
+    second.reset();
+    third.reset();
+    fourth.reset();
+    auto fifth = next();
+    EXPECT_EQ(strideValues(fifth), stride1Values);
+  }
+}
+
 TEST_F(E2EWriterTests, OversizeRows) {
   auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
 
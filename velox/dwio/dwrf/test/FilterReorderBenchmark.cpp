@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/writer/FlushPolicy.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/type/Filter.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::dwrf;
+using facebook::velox::common::BigintRange;
+using facebook::velox::common::BytesValues;
+using facebook::velox::common::ScanSpec;
+
+// Measures the periodic reordering of scan filters on a file with a filter on
+// a BIGINT column 'n' and one on a VARCHAR column 's'. Without history the
+// BIGINT filter runs first. In the 'stable' file the VARCHAR filter passes 1%
+// of the rows and the BIGINT filter 90% in all stripes. In the 'shifting'
+// file this holds for the first half of the stripes and is reversed for the
+// second half, so that the best order changes in the middle of the scan.
+constexpr int32_t kNumStripes = 20;
+constexpr vector_size_t kRowsPerStripe = 50'000;
+
+std::shared_ptr<memory::MemoryPool> rootPool;
+std::shared_ptr<memory::MemoryPool> leafPool;
+const RowTypePtr kRowType =
+    ROW({"n", "s", "payload"}, {BIGINT(), VARCHAR(), BIGINT()});
+std::string stableFile;
+std::string shiftingFile;
+
+RowVectorPtr makeStripe(int32_t stripe, bool shifting) {
+  const bool stringSelective = !shifting || stripe < kNumStripes / 2;
+  auto n = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kRowsPerStripe, leafPool.get());
+  auto s = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kRowsPerStripe, leafPool.get());
+  auto payload = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kRowsPerStripe, leafPool.get());
+  for (vector_size_t i = 0; i < kRowsPerStripe; ++i) {
+    // 'n' passes 'n <= 8' in 90% or 1% of the rows and 's' passes
+    // 's = hit' in 1% or 90% of the rows.
+    if (stringSelective) {
+      n->set(i, i % 10);
+      s->set(i, StringView(i % 100 == 0 ? "hit" : "miss"));
+    } else {
+      n->set(i, i % 100 == 0 ? 0 : 9);
+      s->set(i, StringView(i % 10 == 9 ? "miss" : "hit"));
+    }
+    payload->set(i, stripe * kRowsPerStripe + i);
+  }
+  return std::make_shared<RowVector>(
+      leafPool.get(),
+      kRowType,
+      nullptr,
+      kRowsPerStripe,
+      std::vector<VectorPtr>{n, s, payload});
+}
+
+std::string writeFile(bool shifting) {
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024, FileSink::Options{.pool = leafPool.get()});
+  auto* sinkPtr = sink.get();
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::COMPRESSION, CompressionKind_NONE);
+  dwrf::WriterOptions options;
+  options.config = config;
+  options.schema = kRowType;
+  // Each write is a stripe.
+  options.flushPolicyFactory = []() {
+    return std::make_unique<LambdaFlushPolicy>([]() { return true; });
+  };
+  dwrf::Writer writer{std::move(sink), options, rootPool};
+  for (auto stripe = 0; stripe < kNumStripes; ++stripe) {
+    writer.write(makeStripe(stripe, shifting));
+  }
+  writer.close();
+  return std::string(sinkPtr->data(), sinkPtr->size());
+}
+
+// Reads 'file' with both filters and returns the number of result rows.
+int64_t readFile(const std::string& file, bool reorder) {
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*kRowType);
+  spec->childByName("n")->setFilter(
+      std::make_unique<BigintRange>(0, 8, false));
+  spec->childByName("s")->setFilter(
+      std::make_unique<BytesValues>(std::vector<std::string>{"hit"}, false));
+  spec->setEnableFilterReorder(reorder);
+  ReaderOptions readerOpts{leafPool.get()};
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(std::string_view(file)), *leafPool);
+  auto reader = std::make_unique<DwrfReader>(readerOpts, std::move(input));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto result = BaseVector::create(kRowType, 1, leafPool.get());
+  int64_t numRows = 0;
+  while (rowReader->next(10'000, result)) {
+    numRows += result->size();
+  }
+  return numRows;
+}
+
+BENCHMARK(stableFixedOrder) {
+  folly::doNotOptimizeAway(readFile(stableFile, false));
+}
+
+BENCHMARK_RELATIVE(stableReorder) {
+  folly::doNotOptimizeAway(readFile(stableFile, true));
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(shiftingFixedOrder) {
+  folly::doNotOptimizeAway(readFile(shiftingFile, false));
+}
+
+BENCHMARK_RELATIVE(shiftingReorder) {
+  folly::doNotOptimizeAway(readFile(shiftingFile, true));
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  rootPool =
+      memory::defaultMemoryManager().addRootPool("FilterReorderBenchmark");
+  leafPool = rootPool->addLeafChild("leaf");
+  stableFile = writeFile(false);
+  shiftingFile = writeFile(true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
 #include <folly/Varint.h>
 #include <folly/init/Init.h>
 #include "velox/common/memory/Memory.h"
@@ -64,6 +65,45 @@ static size_t generateAutoId2(int64_t startId, int64_t count) {
   return encoder->flush();
 }
 
+// Encodes 'values' with a direct or RLE encoder one value at a time or in
+// batches of 1024 values.
+static size_t encode(
+    const std::vector<int64_t>& values,
+    bool rle,
+    bool batch) {
+  size_t capacity = values.size() * folly::kMaxVarintLength64;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  DataBufferHolder holder{*pool, capacity};
+  auto output = std::make_unique<BufferedOutputStream>(holder);
+  auto encoder = rle
+      ? createRleEncoder<true>(
+            RleVersion_1, std::move(output), true, sizeof(int64_t))
+      : createDirectEncoder<true>(std::move(output), true, sizeof(int64_t));
+  if (batch) {
+    for (size_t offset = 0; offset < values.size(); offset += 1024) {
+      encoder->add(
+          values.data(),
+          common::Ranges::of(
+              offset, std::min<size_t>(offset + 1024, values.size())),
+          nullptr);
+    }
+  } else {
+    for (auto value : values) {
+      encoder->writeValue(value);
+    }
+  }
+  return encoder->flush();
+}
+
+static std::vector<int64_t> makeValues(
+    std::function<int64_t(int64_t)> valueAt) {
+  std::vector<int64_t> values(100'000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = valueAt(i);
+  }
+  return values;
+}
+
 FOLLY_ALWAYS_INLINE static int32_t findSetBitsOld(uint64_t value) {
   if (value < (1ul << 14)) {
     if (value < (1ul << 7)) {
@@ -203,6 +243,46 @@ BENCHMARK_RELATIVE(GenerateAutoIdNew_64) {
   }
 }
 
+const auto kAutoIds = makeValues([](auto i) { return i; });
+const auto kSmallValues =
+    makeValues([](auto /*i*/) { return folly::Random::rand32(64); });
+const auto kLargeValues =
+    makeValues([](auto /*i*/) { return folly::Random::rand64() >> 8; });
+const auto kRepeatedValues = makeValues([](auto i) { return i / 1'000; });
+
+#define ENCODE_BENCHMARKS(name, values)           \
+  BENCHMARK(DirectSingle_##name) {                \
+    for (int64_t i = 0; i < 100; i++) {           \
+      auto result = encode(values, false, false); \
+      folly::doNotOptimizeAway(result);           \
+    }                                             \
+  }                                               \
+  BENCHMARK_RELATIVE(DirectBatch_##name) {        \
+    for (int64_t i = 0; i < 100; i++) {           \
+      auto result = encode(values, false, true);  \
+      folly::doNotOptimizeAway(result);           \
+    }                                             \
+  }                                               \
+  BENCHMARK(RleSingle_##name) {                   \
+    for (int64_t i = 0; i < 100; i++) {           \
+      auto result = encode(values, true, false);  \
+      folly::doNotOptimizeAway(result);           \
+    }                                             \
+  }                                               \
+  BENCHMARK_RELATIVE(RleBatch_##name) {           \
+    for (int64_t i = 0; i < 100; i++) {           \
+      auto result = encode(values, true, true);   \
+      folly::doNotOptimizeAway(result);           \
+    }                                             \
+  }
+
+ENCODE_BENCHMARKS(AutoIds, kAutoIds);
+ENCODE_BENCHMARKS(SmallValues, kSmallValues);
+ENCODE_BENCHMARKS(LargeValues, kLargeValues);
+ENCODE_BENCHMARKS(RepeatedValues, kRepeatedValues);
+
+#undef ENCODE_BENCHMARKS
+
 int32_t main(int32_t argc, char* argv[]) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
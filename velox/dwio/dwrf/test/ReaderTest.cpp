@@ -96,6 +96,45 @@ std::unique_ptr<BufferedInput> createFileBufferedInput(
       std::make_shared<LocalReadFile>(path), pool);
 }
 
+TEST(TestReader, fileMetadataCache) {
+  FileMetadataCache cache(1 << 20);
+  ReaderOptions readerOpts{getDefaultPool().get()};
+  readerOpts.setFileMetadataCache(&cache);
+  readerOpts.setFileMetadataKey(FileMetadataKey{1, 100});
+  auto first = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), *getDefaultPool()),
+      readerOpts);
+  auto second = DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), *getDefaultPool()),
+      readerOpts);
+  EXPECT_EQ(1, cache.stats().numHits);
+  EXPECT_EQ(1, cache.stats().numMisses);
+  EXPECT_EQ(1, cache.stats().numEntries);
+  EXPECT_EQ(first->rowType(), second->rowType());
+  EXPECT_EQ(first->numberOfRows(), second->numberOfRows());
+
+  // The reader on the cached footer reads all rows after the first reader is
+  // gone.
+  first.reset();
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.select(std::make_shared<ColumnSelector>(getFlatmapSchema()));
+  auto rowReader = second->createRowReader(rowReaderOpts);
+  VectorPtr batch;
+  uint64_t numRows = 0;
+  while (rowReader->next(1000, batch) > 0) {
+    numRows += batch->size();
+  }
+  EXPECT_EQ(second->numberOfRows().value(), numRows);
+
+  // A file replaced under the same path is read again.
+  readerOpts.setFileMetadataKey(FileMetadataKey{1, 101});
+  DwrfReader::create(
+      createFileBufferedInput(getFMSmallFile(), *getDefaultPool()),
+      readerOpts);
+  EXPECT_EQ(2, cache.stats().numMisses);
+  EXPECT_EQ(2, cache.stats().numEntries);
+}
+
 // This relies on schema and data inside of our fm_small and fm_large orc files,
 // and is not composeable with other schema/datas
 void verifyFlatMapReading(
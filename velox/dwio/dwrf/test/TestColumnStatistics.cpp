@@ -17,6 +17,12 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <cmath>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/hyperloglog/HllUtils.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 #include "velox/type/fbhive/HiveTypeParser.h"
@@ -502,6 +508,148 @@ TEST(StatisticsBuilder, stringLengthOverflow) {
   EXPECT_FALSE(stats->getTotalLength().has_value());
 }
 
+TEST(StatisticsBuilder, distinctCounts) {
+  auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
+  facebook::velox::HashStringAllocator allocator{pool.get()};
+  StatisticsBuilderOptions sketchOptions{16, std::nullopt, &allocator};
+
+  // Only integer, floating point and string builders keep a sketch, and
+  // only if they have an allocator for it.
+  EXPECT_EQ(IntegerStatisticsBuilder{options}.distinctCountSketch(), nullptr);
+  EXPECT_EQ(
+      BooleanStatisticsBuilder{sketchOptions}.distinctCountSketch(), nullptr);
+  Config config;
+  EXPECT_EQ(
+      StatisticsBuilderOptions::fromConfig(config, &allocator)
+          .distinctCountAllocator,
+      nullptr);
+  config.set(Config::DISTINCT_COUNT_STATS, true);
+  EXPECT_EQ(
+      StatisticsBuilderOptions::fromConfig(config, &allocator)
+          .distinctCountAllocator,
+      &allocator);
+
+  IntegerStatisticsBuilder intTarget{sketchOptions};
+  IntegerStatisticsBuilder intStride{sketchOptions};
+  DoubleStatisticsBuilder doubleTarget{sketchOptions};
+  DoubleStatisticsBuilder doubleStride{sketchOptions};
+  StringStatisticsBuilder stringTarget{sketchOptions};
+  StringStatisticsBuilder stringStride{sketchOptions};
+  // Two strides of 100 distinct values, 50 of which are in both.
+  auto* intSketch = intStride.distinctCountSketch();
+  for (int64_t start : {0, 50}) {
+    for (int64_t i = start; i < start + 100; ++i) {
+      intStride.addValues(i, 2);
+      doubleStride.addValues(i / 2.0);
+      stringStride.addValues(std::to_string(i));
+    }
+    intTarget.merge(intStride);
+    doubleTarget.merge(doubleStride);
+    stringTarget.merge(stringStride);
+    intStride.reset();
+    doubleStride.reset();
+    stringStride.reset();
+    // The stride sketch is cleared for reuse, not allocated again.
+    ASSERT_EQ(intStride.distinctCountSketch(), intSketch);
+    ASSERT_EQ(intStride.distinctCountSketch()->cardinality(), 0);
+  }
+  EXPECT_NEAR(intTarget.distinctCountSketch()->cardinality(), 150, 2);
+  EXPECT_NEAR(doubleTarget.distinctCountSketch()->cardinality(), 150, 2);
+  EXPECT_NEAR(stringTarget.distinctCountSketch()->cardinality(), 150, 2);
+
+  // Merging empty stats without a sketch keeps the sketch, merging values
+  // without a sketch makes it unknown.
+  proto::ColumnStatistics proto;
+  proto.set_numberofvalues(0);
+  intTarget.merge(*buildColumnStatisticsFromProto(proto, context));
+  ASSERT_NE(intTarget.distinctCountSketch(), nullptr);
+  proto.set_numberofvalues(10);
+  intTarget.merge(*buildColumnStatisticsFromProto(proto, context));
+  EXPECT_EQ(intTarget.distinctCountSketch(), nullptr);
+  intTarget.reset();
+  EXPECT_NE(intTarget.distinctCountSketch(), nullptr);
+}
+
+namespace {
+
+// Returns the serialized sketch of 'values' hashed as T like approx_distinct
+// does.
+template <typename T>
+std::string approxDistinctSketch(
+    const std::vector<T>& values,
+    facebook::velox::HashStringAllocator& allocator) {
+  namespace hll = facebook::velox::common::hll;
+  hll::HllAccumulator sketch{&allocator};
+  sketch.setIndexBitLength(hll::toIndexBitLength(hll::kDefaultStandardError));
+  for (auto value : values) {
+    sketch.append(XXH64(&value, sizeof(T), 0));
+  }
+  std::string serialized(sketch.serializedSize(), '\0');
+  sketch.serialize(serialized.data());
+  return serialized;
+}
+
+std::string serializeSketch(const StatisticsBuilder& builder) {
+  auto* sketch = builder.distinctCountSketch();
+  std::string serialized(sketch->serializedSize(), '\0');
+  sketch->serialize(serialized.data());
+  return serialized;
+}
+
+} // namespace
+
+TEST(StatisticsBuilder, distinctCountsNativeHash) {
+  using facebook::velox::TypeKind;
+  auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
+  facebook::velox::HashStringAllocator allocator{pool.get()};
+  StatisticsBuilderOptions sketchOptions{16, std::nullopt, &allocator};
+
+  // The values are hashed in the width of the column type so that the
+  // sketches can be merged with the ones of approx_distinct.
+  IntegerStatisticsBuilder tinyint{sketchOptions, TypeKind::TINYINT};
+  IntegerStatisticsBuilder smallint{sketchOptions, TypeKind::SMALLINT};
+  IntegerStatisticsBuilder integer{sketchOptions, TypeKind::INTEGER};
+  IntegerStatisticsBuilder bigint{sketchOptions, TypeKind::BIGINT};
+  DoubleStatisticsBuilder real{sketchOptions, TypeKind::REAL};
+  DoubleStatisticsBuilder doubles{sketchOptions, TypeKind::DOUBLE};
+  std::vector<int64_t> values;
+  for (int64_t i = -50; i < 50; ++i) {
+    values.push_back(i);
+    tinyint.addValues(i);
+    smallint.addValues(i);
+    integer.addValues(i);
+    bigint.addValues(i);
+    real.addValues(i / 2.0);
+    doubles.addValues(i / 2.0);
+  }
+  EXPECT_EQ(
+      serializeSketch(tinyint),
+      approxDistinctSketch(
+          std::vector<int8_t>(values.begin(), values.end()), allocator));
+  EXPECT_EQ(
+      serializeSketch(smallint),
+      approxDistinctSketch(
+          std::vector<int16_t>(values.begin(), values.end()), allocator));
+  EXPECT_EQ(
+      serializeSketch(integer),
+      approxDistinctSketch(
+          std::vector<int32_t>(values.begin(), values.end()), allocator));
+  EXPECT_EQ(serializeSketch(bigint), approxDistinctSketch(values, allocator));
+
+  std::vector<float> floats;
+  std::vector<double> doubleValues;
+  for (auto value : values) {
+    floats.push_back(value / 2.0);
+    doubleValues.push_back(value / 2.0);
+  }
+  EXPECT_EQ(serializeSketch(real), approxDistinctSketch(floats, allocator));
+  EXPECT_EQ(
+      serializeSketch(doubles), approxDistinctSketch(doubleValues, allocator));
+  EXPECT_NE(
+      approxDistinctSketch(floats, allocator),
+      approxDistinctSketch(doubleValues, allocator));
+}
+
 TEST(StatisticsBuilder, boolean) {
   BooleanStatisticsBuilder builder{options};
   // empty builder should have all defaults
@@ -16,6 +16,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "velox/dwio/dwrf/writer/AdaptiveEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
 
 using namespace facebook::velox::memory;
@@ -212,4 +213,82 @@ TEST(TestEntropyEncodingSelector, Sampling) {
   }
 }
 
+TEST(TestAdaptiveEncodingSelector, Ctor) {
+  EXPECT_ANY_THROW(AdaptiveEncodingSelector(-0.1f, 16));
+  EXPECT_ANY_THROW(AdaptiveEncodingSelector(0.1f, 0));
+}
+
+TEST(TestAdaptiveEncodingSelector, UseDictionary) {
+  AdaptiveEncodingSelector selector{0.1f, 1};
+  AdaptiveEncodingSelector::Stats stats;
+  EXPECT_FALSE(selector.useDictionary(stats));
+
+  // 10 distinct values of 5 bytes in 10'000 values.
+  stats.numValues = 10'000;
+  stats.numDistinct = 10;
+  stats.directBytes = 50'000;
+  stats.distinctBytes = 50;
+  EXPECT_EQ(10'050, AdaptiveEncodingSelector::dictionaryBytes(stats));
+  EXPECT_TRUE(selector.useDictionary(stats));
+
+  // All values distinct.
+  stats.numDistinct = 10'000;
+  stats.distinctBytes = 50'000;
+  EXPECT_FALSE(selector.useDictionary(stats));
+
+  // Dictionary stripes that compress much worse than direct stripes make
+  // direct encoding cheaper.
+  stats.numDistinct = 2'000;
+  stats.distinctBytes = 10'000;
+  EXPECT_TRUE(selector.useDictionary(stats));
+  for (auto i = 0; i < 10; ++i) {
+    selector.recordStripe(true, 1'000, 1'000);
+    selector.recordStripe(false, 1'000, 100);
+  }
+  EXPECT_FALSE(selector.useDictionary(stats));
+}
+
+TEST(TestAdaptiveEncodingSelector, SampledStats) {
+  AdaptiveEncodingSelector selector{0.1f, 4};
+  EXPECT_EQ(0, selector.sampledStats().numValues);
+
+  const auto sample = [&](auto value) {
+    if (selector.shouldSample()) {
+      selector.addSample(value, 4);
+    }
+  };
+
+  // 7 values repeated.
+  for (auto i = 0; i < 10'000; ++i) {
+    sample(i % 7);
+  }
+  auto stats = selector.sampledStats();
+  EXPECT_EQ(10'000, stats.numValues);
+  EXPECT_EQ(40'000, stats.directBytes);
+  EXPECT_EQ(7, stats.numDistinct);
+  EXPECT_EQ(28, stats.distinctBytes);
+  EXPECT_TRUE(selector.useDictionary(stats));
+
+  // All values distinct.
+  selector.clearSample();
+  for (auto i = 0; i < 10'000; ++i) {
+    sample(i);
+  }
+  stats = selector.sampledStats();
+  EXPECT_EQ(10'000, stats.numValues);
+  EXPECT_EQ(10'000, stats.numDistinct);
+  EXPECT_EQ(40'000, stats.distinctBytes);
+  EXPECT_FALSE(selector.useDictionary(stats));
+}
+
+TEST(TestAdaptiveEncodingSelector, VarintSize) {
+  EXPECT_EQ(1, AdaptiveEncodingSelector::varintSize(0));
+  EXPECT_EQ(1, AdaptiveEncodingSelector::varintSize(127));
+  EXPECT_EQ(2, AdaptiveEncodingSelector::varintSize(128));
+  EXPECT_EQ(10, AdaptiveEncodingSelector::varintSize(UINT64_MAX));
+  EXPECT_EQ(1, AdaptiveEncodingSelector::signedVarintSize(-64));
+  EXPECT_EQ(2, AdaptiveEncodingSelector::signedVarintSize(64));
+  EXPECT_EQ(10, AdaptiveEncodingSelector::signedVarintSize(INT64_MIN));
+}
+
 } // namespace facebook::velox::dwrf
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/Nulls.h"
+#include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/common/RLEv1.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
@@ -350,4 +351,88 @@ TEST(RleEncoderV1Test, backfillPosition) {
   }
 }
 
+namespace {
+// Checks that adding values of type T in batches writes the same bytes as
+// adding them one at a time. A nulls bitmap without nulls makes the encoders
+// add the values one at a time.
+template <typename T, bool isSigned>
+void testBatchMatchesSingleValues() {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  constexpr size_t kSize = 10'000;
+  std::vector<T> data;
+  data.reserve(kSize);
+  while (data.size() < kSize) {
+    const auto length = 1 + folly::Random::rand32(300);
+    const int64_t delta = folly::Random::rand32(300) - 150;
+    T value = static_cast<T>(folly::Random::rand64());
+    const auto kind = folly::Random::rand32(5);
+    for (uint32_t i = 0; i < length && data.size() < kSize; ++i) {
+      switch (kind) {
+        case 0:
+          data.push_back(static_cast<T>(folly::Random::rand64()));
+          break;
+        case 1:
+          data.push_back(folly::Random::rand32(4));
+          break;
+        case 2:
+          data.push_back(
+              i % 2 ? std::numeric_limits<T>::max()
+                    : std::numeric_limits<T>::min());
+          break;
+        case 3:
+          // Runs that overflow.
+          data.push_back(value);
+          value = static_cast<T>(
+              static_cast<uint64_t>(value) + static_cast<uint64_t>(delta));
+          break;
+        default:
+          data.push_back(value);
+          break;
+      }
+    }
+  }
+  std::vector<uint64_t> noNulls(bits::nwords(kSize), bits::kNotNull64);
+
+  for (auto rle : {true, false}) {
+    const auto encode = [&](bool batch) {
+      MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+      DataBufferHolder holder{
+          *pool, 1024, 0, DEFAULT_PAGE_GROW_RATIO, &memSink};
+      auto output = std::make_unique<BufferedOutputStream>(holder);
+      auto encoder = rle
+          ? createRleEncoder<isSigned>(
+                RleVersion_1, std::move(output), true, sizeof(T))
+          : createDirectEncoder<isSigned>(std::move(output), true, sizeof(T));
+      if (batch) {
+        size_t offset = 0;
+        while (offset < kSize) {
+          const size_t size =
+              std::min<size_t>(1 + folly::Random::rand32(700), kSize - offset);
+          encoder->add(
+              data.data(), common::Ranges::of(offset, offset + size), nullptr);
+          offset += size;
+        }
+      } else {
+        encoder->add(
+            data.data(), common::Ranges::of(0, kSize), noNulls.data());
+      }
+      encoder->flush();
+      return std::string(memSink.data(), memSink.size());
+    };
+    ASSERT_EQ(encode(true), encode(false))
+        << "rle: " << rle << ", bytes: " << sizeof(T)
+        << ", signed: " << isSigned;
+  }
+}
+} // namespace
+
+TEST(RleEncoderV1Test, batchMatchesSingleValues) {
+  testBatchMatchesSingleValues<int16_t, true>();
+  testBatchMatchesSingleValues<int32_t, true>();
+  testBatchMatchesSingleValues<int64_t, true>();
+  testBatchMatchesSingleValues<int16_t, false>();
+  testBatchMatchesSingleValues<int32_t, false>();
+  testBatchMatchesSingleValues<int64_t, false>();
+}
+
 } // namespace facebook::velox::dwrf
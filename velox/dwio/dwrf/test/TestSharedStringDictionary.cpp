@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/SharedStringDictionary.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+std::string serialize(const std::vector<std::string>& entries) {
+  return SharedStringDictionary::serialize(
+      entries.size(),
+      [&](uint32_t index) -> std::string_view { return entries[index]; });
+}
+
+} // namespace
+
+TEST(TestSharedStringDictionary, roundTrip) {
+  const std::vector<std::string> entries{
+      "a", "", "a string longer than inlined", "b"};
+  auto dictionary =
+      std::make_shared<SharedStringDictionary>(serialize(entries));
+  ASSERT_EQ(dictionary->size(), entries.size());
+
+  // A stripe uses a prefix of the entries.
+  auto views = dictionary->viewsBuffer(3);
+  ASSERT_EQ(views->size(), 3 * sizeof(StringView));
+  auto offsets = dictionary->offsetsBuffer(3);
+  ASSERT_EQ(offsets->size(), 4 * sizeof(int64_t));
+  auto data = dictionary->dataBuffer();
+  const auto* offsetsPtr = offsets->as<int64_t>();
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_EQ(views->as<StringView>()[i].str(), entries[i]);
+    const auto size = offsetsPtr[i + 1] - offsetsPtr[i];
+    EXPECT_EQ(std::string(data->as<char>() + offsetsPtr[i], size), entries[i]);
+  }
+
+  // The buffers keep the dictionary alive.
+  dictionary.reset();
+  EXPECT_EQ(views->as<StringView>()[2].str(), entries[2]);
+  EXPECT_THROW(
+      SharedStringDictionary(serialize(entries)).viewsBuffer(5),
+      dwio::common::exception::LoggedException);
+}
+
+TEST(TestSharedStringDictionary, corrupted) {
+  const auto serialized = serialize({"abc", "de"});
+  EXPECT_THROW(
+      SharedStringDictionary(serialized.substr(0, serialized.size() - 1)),
+      dwio::common::exception::LoggedException);
+  EXPECT_THROW(
+      SharedStringDictionary(serialized.substr(0, 6)),
+      dwio::common::exception::LoggedException);
+  EXPECT_THROW(
+      SharedStringDictionary(serialized + "x"),
+      dwio::common::exception::LoggedException);
+}
+
+TEST(TestSharedStringDictionary, parseOnce) {
+  SharedStringDictionaries dictionaries;
+  const auto serialized = serialize({"x", "y"});
+  int32_t numParsed = 0;
+  auto getSerialized = [&]() -> std::string_view {
+    ++numParsed;
+    return serialized;
+  };
+  auto first = dictionaries.get(1, getSerialized);
+  auto second = dictionaries.get(1, getSerialized);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(numParsed, 1);
+  EXPECT_NE(dictionaries.get(2, getSerialized), first);
+  EXPECT_EQ(numParsed, 2);
+}
+
+} // namespace facebook::velox::dwrf
@@ -240,6 +240,34 @@ TEST_F(TestStringDictionaryEncoder, Clear) {
   EXPECT_LT(pool->currentBytes(), peakMemory);
 }
 
+TEST_F(TestStringDictionaryEncoder, Truncate) {
+  auto pool = addDefaultLeafMemoryPool();
+  StringDictionaryEncoder encoder{*pool, *pool};
+  std::string baseString{"jjkkll"};
+  for (size_t i = 0; i != 100; ++i) {
+    encoder.addKey(baseString + genPaddedIntegerString(i, 4), 0);
+  }
+  const auto keyBytes = encoder.keyBytes_.size();
+  for (size_t i = 50; i != 150; ++i) {
+    encoder.addKey(baseString + genPaddedIntegerString(i, 4), 1);
+  }
+  EXPECT_EQ(150, encoder.size());
+
+  encoder.truncate(100);
+  EXPECT_EQ(100, encoder.size());
+  EXPECT_EQ(100, encoder.keyIndex_.size());
+  EXPECT_EQ(keyBytes, encoder.keyBytes_.size());
+  for (size_t i = 0; i != 150; ++i) {
+    const auto key = baseString + genPaddedIntegerString(i, 4);
+    EXPECT_EQ(i < 100 ? i : 100, encoder.getIndex(key));
+  }
+  // A removed key is added back at the end.
+  const auto removedKey = baseString + genPaddedIntegerString(120, 4);
+  EXPECT_EQ(100, encoder.addKey(removedKey, 2));
+  EXPECT_EQ(2, encoder.getStride(100));
+  EXPECT_EQ(removedKey, encoder.getKey(100).str());
+}
+
 TEST_F(TestStringDictionaryEncoder, MemBenchmark) {
   auto pool = addDefaultLeafMemoryPool();
   StringDictionaryEncoder stringDictEncoder{*pool, *pool};
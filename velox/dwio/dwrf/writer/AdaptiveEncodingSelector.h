@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/writer/RatioTracker.h"
+
+namespace facebook::velox::dwrf {
+
+/// Chooses between dictionary and direct encoding for each stripe of a column
+/// with a cost model. The cost of an encoding is its estimated size on disk
+/// plus its estimated read cost times a weight. The size on disk is the
+/// estimated encoded size times the compression ratio observed for the
+/// encoding in the previous stripes of the column. The read cost counts the
+/// bytes and values a reader decodes: a dictionary stripe decodes each
+/// distinct value once and an index per value, a direct stripe decodes every
+/// value.
+///
+/// While a column is written directly, the selector samples the values to
+/// estimate the number of distinct values, so that the column can switch back
+/// to dictionary encoding in a later stripe.
+class AdaptiveEncodingSelector {
+ public:
+  /// Statistics of the values of a column stripe.
+  struct Stats {
+    // Number of non-null values.
+    uint64_t numValues{0};
+    // Number of distinct values.
+    uint64_t numDistinct{0};
+    // Encoded size of the values when written directly.
+    uint64_t directBytes{0};
+    // Encoded size of the distinct values.
+    uint64_t distinctBytes{0};
+  };
+
+  AdaptiveEncodingSelector(float readCostWeight, uint32_t sampleRate)
+      : readCostWeight_{readCostWeight}, sampleRate_{sampleRate} {
+    DWIO_ENSURE_LE(0.0f, readCostWeight_);
+    DWIO_ENSURE_LT(0, sampleRate_);
+  }
+
+  bool useDictionary(const Stats& stats) const {
+    return stats.numValues != 0 && dictionaryCost(stats) <= directCost(stats);
+  }
+
+  /// Returns the encoded size of the stripe with dictionary encoding.
+  static uint64_t dictionaryBytes(const Stats& stats) {
+    return stats.distinctBytes +
+        stats.numValues * varintSize(std::max<uint64_t>(stats.numDistinct, 1));
+  }
+
+  double dictionaryCost(const Stats& stats) const {
+    const auto bytes = dictionaryBytes(stats);
+    return bytes * compressionRatio(dictionaryRatio_, directRatio_) +
+        readCostWeight_ * (bytes + stats.numValues + stats.numDistinct);
+  }
+
+  double directCost(const Stats& stats) const {
+    return stats.directBytes *
+        compressionRatio(directRatio_, dictionaryRatio_) +
+        readCostWeight_ * (stats.directBytes + stats.numValues);
+  }
+
+  /// Records that a stripe whose estimated encoded size was 'encodedBytes'
+  /// took 'physicalBytes' in the file.
+  void recordStripe(
+      bool dictionary,
+      uint64_t encodedBytes,
+      uint64_t physicalBytes) {
+    (dictionary ? dictionaryRatio_ : directRatio_)
+        .takeSample(encodedBytes, physicalBytes);
+  }
+
+  /// Returns true if the next value written directly is to be passed to
+  /// addSample().
+  bool shouldSample() {
+    return ++numSeen_ % sampleRate_ == 0 && counts_.size() < kMaxSamples;
+  }
+
+  /// Adds a sampled value with 'hash' and encoded size 'bytes'.
+  void addSample(uint64_t hash, uint64_t bytes) {
+    ++sample_.numValues;
+    sample_.directBytes += bytes;
+    auto& count = counts_[hash];
+    if (++count == 1) {
+      ++sample_.numDistinct;
+      sample_.distinctBytes += bytes;
+    }
+  }
+
+  /// Returns the statistics of the values seen since the last clearSample()
+  /// estimated from the sampled values. The values seen more than once in the
+  /// sample are assumed to be all the frequent values. The values seen once
+  /// are scaled by a factor between the square root of the inverse sampling
+  /// fraction, as in the GEE estimator, and the inverse sampling fraction,
+  /// weighted by the fraction of the sample seen once. This keeps GEE's
+  /// bound on skewed data without underestimating mostly unique data.
+  Stats sampledStats() const {
+    Stats stats;
+    if (sample_.numValues == 0) {
+      return stats;
+    }
+    uint64_t numSingletons = 0;
+    for (const auto& [hash, count] : counts_) {
+      numSingletons += count == 1;
+    }
+    const double scale = static_cast<double>(numSeen_) / sample_.numValues;
+    const double unique =
+        static_cast<double>(numSingletons) / sample_.numValues;
+    const double numDistinct =
+        (unique * scale + (1 - unique) * std::sqrt(scale)) * numSingletons +
+        (sample_.numDistinct - numSingletons);
+    stats.numValues = numSeen_;
+    stats.directBytes = sample_.directBytes * scale;
+    stats.numDistinct = std::min<uint64_t>(numDistinct, numSeen_);
+    stats.distinctBytes =
+        sample_.distinctBytes * numDistinct / sample_.numDistinct;
+    return stats;
+  }
+
+  void clearSample() {
+    numSeen_ = 0;
+    sample_ = Stats{};
+    counts_.clear();
+  }
+
+  /// Returns the size of 'value' as a base 128 varint.
+  static uint32_t varintSize(uint64_t value) {
+    uint32_t size = 1;
+    while (value >= 0x80) {
+      value >>= 7;
+      ++size;
+    }
+    return size;
+  }
+
+  /// Returns the size of 'value' as a zigzag encoded base 128 varint.
+  static uint32_t signedVarintSize(int64_t value) {
+    return varintSize((static_cast<uint64_t>(value) << 1) ^ (value >> 63));
+  }
+
+ private:
+  // Returns the ratio of 'tracker', or the ratio of 'other' if no stripe was
+  // written with the encoding of 'tracker', so that the first stripe of an
+  // encoding is not compared against the initial guess.
+  static float compressionRatio(
+      const CompressionRatioTracker& tracker,
+      const CompressionRatioTracker& other) {
+    return tracker.getSampleSize() != 0 || other.getSampleSize() == 0
+        ? tracker.getEstimatedRatio()
+        : other.getEstimatedRatio();
+  }
+
+  // Maximum number of distinct hashes kept in a sample.
+  static constexpr size_t kMaxSamples = 10'000;
+
+  const float readCostWeight_;
+  const uint32_t sampleRate_;
+  CompressionRatioTracker dictionaryRatio_;
+  CompressionRatioTracker directRatio_;
+
+  // Number of values written directly since the last clearSample().
+  uint64_t numSeen_{0};
+  Stats sample_;
+  // Number of occurrences of each sampled hash.
+  folly::F14FastMap<uint64_t, uint32_t> counts_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -18,6 +18,7 @@
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
+#include "velox/dwio/dwrf/common/SharedStringDictionary.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/FlatMapColumnWriter.h"
@@ -214,6 +215,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
     DWIO_ENSURE_GE(dictionaryKeySizeThreshold_, 0.0);
     DWIO_ENSURE_LE(dictionaryKeySizeThreshold_, 1.0);
     DWIO_ENSURE(firstStripe_);
+    initAdaptiveEncodingSelection();
     if (!useDictionaryEncoding_) {
       // Suppress the stream used to initialize dictionary encoder.
       // TODO: passing factory method into the dict encoder also works
@@ -229,6 +231,14 @@ class IntegerColumnWriter : public BaseColumnWriter {
   uint64_t write(const VectorPtr& slice, const common::Ranges& ranges) override;
 
   void reset() override {
+    if (adaptiveSelector_ != nullptr) {
+      recordStripePhysicalSize();
+      if (switchToDictionary_) {
+        switchToDictionary_ = false;
+        removeStreamWriters();
+        useDictionaryEncoding_ = true;
+      }
+    }
     // Lots of decisions regarding the presence of streams are made at flush
     // time. We would defer recording all stream positions till then, and
     // only record position for PRESENT stream upon construction.
@@ -250,6 +260,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     tryAbandonDictionaries(false);
     initStreamWriters(useDictionaryEncoding_);
+    if (adaptiveSelector_ != nullptr) {
+      selectEncoding();
+    }
 
     size_t dictEncoderSize = dictEncoder_.size();
     if (useDictionaryEncoding_) {
@@ -331,10 +344,12 @@ class IntegerColumnWriter : public BaseColumnWriter {
   // This incurs additional memory usage. A good long term adjustment but not
   // viable mitigation to memory pressure.
   bool tryAbandonDictionaries(bool force) override {
-    // We can not switch encodings beyond the first stripe.
+    // We can not switch encodings beyond the first stripe unless the adaptive
+    // encoding selection is enabled.
     // We won't need to do any additional checks if we are already
     // using direct encodings.
-    if (!useDictionaryEncoding_ || !firstStripe_) {
+    if (!useDictionaryEncoding_ ||
+        (!firstStripe_ && adaptiveSelector_ == nullptr)) {
       return false;
     }
 
@@ -345,6 +360,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
       return false;
     }
 
+    removeStreamWriters();
     initStreamWriters(useDictionaryEncoding_);
     // Record direct encoding stream starting position.
     recordDirectEncodingStreamPositions(0);
@@ -401,8 +417,51 @@ class IntegerColumnWriter : public BaseColumnWriter {
     ensureValidStreamWriters(dictEncoding);
   }
 
+  // Destroys the stream writers of the current encoding and removes their
+  // streams, so that the stream writers of the other encoding can be created.
+  void removeStreamWriters() {
+    data_.reset();
+    dataDirect_.reset();
+    inDictionary_.reset();
+    removeStream(StreamKind::StreamKind_DATA);
+    removeStream(StreamKind::StreamKind_IN_DICTIONARY);
+  }
+
+  // Returns the statistics of the values in 'dictEncoder_'.
+  AdaptiveEncodingSelector::Stats dictionaryStats() const {
+    AdaptiveEncodingSelector::Stats stats;
+    stats.numValues = dictEncoder_.getTotalCount();
+    stats.numDistinct = dictEncoder_.size();
+    for (uint32_t i = 0; i < dictEncoder_.size(); ++i) {
+      const auto bytes =
+          AdaptiveEncodingSelector::signedVarintSize(dictEncoder_.getKey(i));
+      stats.distinctBytes += bytes;
+      stats.directBytes += bytes * dictEncoder_.getCount(i);
+    }
+    return stats;
+  }
+
+  // Records the encoding of the stripe being flushed. If the stripe is written
+  // directly, decides from the sampled values whether the next stripe
+  // switches to dictionary encoding.
+  void selectEncoding() {
+    if (useDictionaryEncoding_) {
+      recordStripeEncoding(
+          true, AdaptiveEncodingSelector::dictionaryBytes(dictionaryStats()));
+      return;
+    }
+    const auto stats = adaptiveSelector_->sampledStats();
+    recordStripeEncoding(false, stats.directBytes);
+    switchToDictionary_ =
+        !context_.isLowMemoryMode() && adaptiveSelector_->useDictionary(stats);
+    adaptiveSelector_->clearSample();
+  }
+
   // NOTE: This should be called *before* clearing the rows_ buffer.
   bool shouldKeepDictionary() const {
+    if (adaptiveSelector_ != nullptr) {
+      return adaptiveSelector_->useDictionary(dictionaryStats());
+    }
     // TODO(T91508412): Move the dictionary efficiency based decision into
     // dictionary encoder.
     auto totalElementCount = dictEncoder_.getTotalCount();
@@ -467,6 +526,8 @@ class IntegerColumnWriter : public BaseColumnWriter {
   // encoding.
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
+  // True if the next stripe switches from direct to dictionary encoding.
+  bool switchToDictionary_{false};
   DataBuffer<size_t> strideOffsets_;
 };
 
@@ -548,6 +609,16 @@ uint64_t IntegerColumnWriter<T>::writeDirect(
   auto vals = flatVector->rawValues();
 
   auto count = dataDirect_->add(vals, ranges, nulls);
+  if (adaptiveSelector_ != nullptr) {
+    for (auto& pos : ranges) {
+      if ((nulls == nullptr || !bits::isBitNull(nulls, pos)) &&
+          adaptiveSelector_->shouldSample()) {
+        adaptiveSelector_->addSample(
+            folly::hasher<T>{}(vals[pos]),
+            AdaptiveEncodingSelector::signedVarintSize(vals[pos]));
+      }
+    }
+  }
   StatisticsBuilderUtils::addValues<T>(
       dynamic_cast<IntegerStatisticsBuilder&>(*indexStatsBuilder_),
       slice,
@@ -805,8 +876,21 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
-        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
+        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)},
+        maxSharedDictionarySize_{
+            getConfig(Config::SHARED_STRING_DICTIONARY_MAX_SIZE)} {
     DWIO_ENSURE(firstStripe_);
+    // The shared dictionary is written to the footer in the clear and its
+    // entries are in insertion order, so sorted and encrypted dictionaries are
+    // not shared.
+    if (getConfig(Config::SHARED_STRING_DICTIONARY) && sequence_ == 0 &&
+        !sort_ && !context_.getEncryptionHandler().isEncrypted(id_)) {
+      sharedDictEncoder_ = std::make_unique<StringDictionaryEncoder>(
+          getMemoryPool(MemoryUsageCategory::DICTIONARY),
+          getMemoryPool(MemoryUsageCategory::GENERAL));
+      shareDictionary_ = true;
+    }
+    initAdaptiveEncodingSelection();
     if (!useDictionaryEncoding_) {
       initStreamWriters(useDictionaryEncoding_);
     }
@@ -816,6 +900,14 @@ class StringColumnWriter : public BaseColumnWriter {
   uint64_t write(const VectorPtr& slice, const common::Ranges& ranges) override;
 
   void reset() override {
+    if (adaptiveSelector_ != nullptr) {
+      recordStripePhysicalSize();
+      if (switchToDictionary_) {
+        switchToDictionary_ = false;
+        removeStreamWriters();
+        useDictionaryEncoding_ = true;
+      }
+    }
     // Lots of decisions regarding the presence of streams are made at flush
     // time. We would defer recording all stream positions till then, and
     // only record position for PRESENT stream upon construction.
@@ -837,6 +929,9 @@ class StringColumnWriter : public BaseColumnWriter {
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     tryAbandonDictionaries(false);
     initStreamWriters(useDictionaryEncoding_);
+    if (adaptiveSelector_ != nullptr) {
+      selectEncoding();
+    }
 
     size_t dictEncoderSize = dictEncoder_.size();
     if (useDictionaryEncoding_) {
@@ -856,7 +951,9 @@ class StringColumnWriter : public BaseColumnWriter {
       // TODO: T46365785 It would be nice if the suppression
       // could be pushed down to the index builder as well so we don't have to
       // micromanage when and whether to write specific streams.
-      if (UNLIKELY(finalDictionarySize_ == dictEncoderSize)) {
+      if (UNLIKELY(
+              useSharedDictionary_ ||
+              finalDictionarySize_ == dictEncoderSize)) {
         suppressStream(StreamKind::StreamKind_STRIDE_DICTIONARY);
         suppressStream(StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH);
         suppressStream(StreamKind::StreamKind_IN_DICTIONARY);
@@ -865,8 +962,14 @@ class StringColumnWriter : public BaseColumnWriter {
         strideDictionaryDataLength_->flush();
         inDictionary_->flush();
       }
-      dictionaryData_->flush();
-      dictionaryDataLength_->flush();
+      // The entries of a shared dictionary are written to the footer.
+      if (useSharedDictionary_) {
+        suppressStream(StreamKind::StreamKind_DICTIONARY_DATA);
+        suppressStream(StreamKind::StreamKind_LENGTH);
+      } else {
+        dictionaryData_->flush();
+        dictionaryDataLength_->flush();
+      }
       data_->flush();
     } else {
       dataDirect_->flush();
@@ -885,7 +988,26 @@ class StringColumnWriter : public BaseColumnWriter {
       encoding.set_kind(
           proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY);
       encoding.set_dictionarysize(finalDictionarySize_);
+      if (useSharedDictionary_) {
+        encoding.set_shareddictionary(true);
+      }
+    }
+  }
+
+  void writeSharedDictionaries(
+      const std::function<void(uint32_t, const std::string&)>& consumer)
+      const override {
+    // The shared dictionary has entries only if some stripe used it.
+    if (sharedDictEncoder_ == nullptr || sharedDictEncoder_->size() == 0) {
+      return;
     }
+    consumer(
+        id_,
+        SharedStringDictionary::serialize(
+            sharedDictEncoder_->size(), [&](uint32_t index) {
+              const auto key = sharedDictEncoder_->getKey(index);
+              return std::string_view(key.data(), key.size());
+            }));
   }
 
   void createIndexEntry() override {
@@ -930,9 +1052,10 @@ class StringColumnWriter : public BaseColumnWriter {
   }
 
   bool tryAbandonDictionaries(bool force) override {
-    // TODO: hopefully not required in the future, but need to solve the problem
-    // of replacing/deleting streams.
-    if (!useDictionaryEncoding_ || !firstStripe_) {
+    // Encodings are switched after the first stripe only if the adaptive
+    // encoding selection is enabled.
+    if (!useDictionaryEncoding_ ||
+        (!firstStripe_ && adaptiveSelector_ == nullptr)) {
       return false;
     }
 
@@ -941,6 +1064,7 @@ class StringColumnWriter : public BaseColumnWriter {
       return false;
     }
 
+    removeStreamWriters();
     initStreamWriters(useDictionaryEncoding_);
     // Record direct encoding stream starting position.
     recordDirectEncodingStreamPositions(0);
@@ -1017,8 +1141,64 @@ class StringColumnWriter : public BaseColumnWriter {
     ensureValidStreamWriters(dictEncoding);
   }
 
+  // Destroys the stream writers of the current encoding and removes their
+  // streams, so that the stream writers of the other encoding can be created.
+  void removeStreamWriters() {
+    data_.reset();
+    dataDirect_.reset();
+    dataDirectLength_.reset();
+    dictionaryData_.reset();
+    dictionaryDataLength_.reset();
+    inDictionary_.reset();
+    strideDictionaryData_.reset();
+    strideDictionaryDataLength_.reset();
+    for (auto kind :
+         {StreamKind::StreamKind_DATA,
+          StreamKind::StreamKind_LENGTH,
+          StreamKind::StreamKind_DICTIONARY_DATA,
+          StreamKind::StreamKind_IN_DICTIONARY,
+          StreamKind::StreamKind_STRIDE_DICTIONARY,
+          StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH}) {
+      removeStream(kind);
+    }
+  }
+
+  // Returns the statistics of the values in 'dictEncoder_'. The encoded size
+  // of a value includes its length.
+  AdaptiveEncodingSelector::Stats dictionaryStats() const {
+    AdaptiveEncodingSelector::Stats stats;
+    stats.numValues = rows_.size();
+    stats.numDistinct = dictEncoder_.size();
+    for (uint32_t i = 0; i < dictEncoder_.size(); ++i) {
+      const auto size = dictEncoder_.getKey(i).size();
+      const auto bytes = size + AdaptiveEncodingSelector::varintSize(size);
+      stats.distinctBytes += bytes;
+      stats.directBytes += bytes * dictEncoder_.getCount(i);
+    }
+    return stats;
+  }
+
+  // Records the encoding of the stripe being flushed. If the stripe is written
+  // directly, decides from the sampled values whether the next stripe
+  // switches to dictionary encoding.
+  void selectEncoding() {
+    if (useDictionaryEncoding_) {
+      recordStripeEncoding(
+          true, AdaptiveEncodingSelector::dictionaryBytes(dictionaryStats()));
+      return;
+    }
+    const auto stats = adaptiveSelector_->sampledStats();
+    recordStripeEncoding(false, stats.directBytes);
+    switchToDictionary_ =
+        !context_.isLowMemoryMode() && adaptiveSelector_->useDictionary(stats);
+    adaptiveSelector_->clearSample();
+  }
+
   // NOTE: This should be called *before* clearing the rows_ buffer.
   bool shouldKeepDictionary() const {
+    if (adaptiveSelector_ != nullptr) {
+      return adaptiveSelector_->useDictionary(dictionaryStats());
+    }
     return rows_.size() != 0 &&
         encodingSelector_.useDictionary(dictEncoder_, rows_.size());
   }
@@ -1054,6 +1234,11 @@ class StringColumnWriter : public BaseColumnWriter {
     }
   }
 
+  // Adds the entries of 'dictEncoder_' to 'sharedDictEncoder_' and sets
+  // 'lookupTable' to their indices in it. Stops sharing the dictionary and
+  // returns false if the shared dictionary would grow over its maximum size.
+  bool addToSharedDictionary(DataBuffer<uint32_t>& lookupTable);
+
   void populateDictionaryEncodingStreams();
   void convertToDirectEncoding();
 
@@ -1083,7 +1268,19 @@ class StringColumnWriter : public BaseColumnWriter {
   // encoding.
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
+  // True if the next stripe switches from direct to dictionary encoding.
+  bool switchToDictionary_{false};
   DataBuffer<size_t> strideOffsets_;
+  // Entries of the dictionary shared by the stripes of the file. Each stripe
+  // that shares the dictionary appends its new entries.
+  std::unique_ptr<StringDictionaryEncoder> sharedDictEncoder_;
+  // Bytes of the entries in 'sharedDictEncoder_'.
+  uint64_t sharedDictionarySize_{0};
+  const uint64_t maxSharedDictionarySize_;
+  // True until the shared dictionary would get too large.
+  bool shareDictionary_{false};
+  // True if the stripe being flushed uses the shared dictionary.
+  bool useSharedDictionary_{false};
 };
 
 uint64_t StringColumnWriter::write(
@@ -1157,6 +1354,12 @@ uint64_t StringColumnWriter::writeDirect(
     auto sp = decodedVector.valueAt<StringView>(pos);
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
+    if (adaptiveSelector_ != nullptr && adaptiveSelector_->shouldSample()) {
+      adaptiveSelector_->addSample(
+          folly::hasher<folly::StringPiece>{}(
+              folly::StringPiece{sp.data(), size}),
+          size + AdaptiveEncodingSelector::varintSize(size));
+    }
     statsBuilder.addValues(sp);
     rawSize += size;
     lengths.unsafeAppend(size);
@@ -1189,6 +1392,31 @@ uint64_t StringColumnWriter::writeDirect(
   return rawSize;
 }
 
+bool StringColumnWriter::addToSharedDictionary(
+    DataBuffer<uint32_t>& lookupTable) {
+  // Adds the keys with a single lookup each and drops the new ones again if
+  // the shared dictionary gets too large. The counts are not used by the
+  // shared dictionary, so the keys are added with a count of 0.
+  const auto oldSize = sharedDictEncoder_->size();
+  uint64_t newSize = 0;
+  lookupTable.resize(dictEncoder_.size());
+  for (uint32_t i = 0; i < dictEncoder_.size(); ++i) {
+    const auto key = dictEncoder_.getKey(i);
+    const auto numKeys = sharedDictEncoder_->size();
+    lookupTable[i] = sharedDictEncoder_->addKey(key, 0, 0);
+    if (lookupTable[i] == numKeys) {
+      newSize += key.size();
+    }
+  }
+  if (sharedDictionarySize_ + newSize > maxSharedDictionarySize_) {
+    sharedDictEncoder_->truncate(oldSize);
+    shareDictionary_ = false;
+    return false;
+  }
+  sharedDictionarySize_ += newSize;
+  return true;
+}
+
 // TODO: T45220726 Reduce memory usage in this method by
 // allocating fewer buffers.
 // One way to do so is via passing a getData function into writer instead of
@@ -1204,22 +1432,30 @@ void StringColumnWriter::populateDictionaryEncodingStreams() {
       pool,
       strideOffsets_.size(),
   };
-  finalDictionarySize_ = DictionaryEncodingUtils::getSortedIndexLookupTable(
-      dictEncoder_,
-      pool,
-      sort_,
-      DictionaryEncodingUtils::frequencyOrdering,
-      true,
-      lookupTable,
-      inDict,
-      strideDictCounts,
-      [&](auto buf, auto size) { dictionaryData_->write(buf, size); },
-      [&](auto buf, auto size) {
-        dictionaryDataLength_->add(buf, common::Ranges::of(0, size), nullptr);
-      });
+  useSharedDictionary_ = shareDictionary_ && addToSharedDictionary(lookupTable);
+  if (useSharedDictionary_) {
+    finalDictionarySize_ = sharedDictEncoder_->size();
+  } else {
+    finalDictionarySize_ = DictionaryEncodingUtils::getSortedIndexLookupTable(
+        dictEncoder_,
+        pool,
+        sort_,
+        DictionaryEncodingUtils::frequencyOrdering,
+        true,
+        lookupTable,
+        inDict,
+        strideDictCounts,
+        [&](auto buf, auto size) { dictionaryData_->write(buf, size); },
+        [&](auto buf, auto size) {
+          dictionaryDataLength_->add(
+              buf, common::Ranges::of(0, size), nullptr);
+        });
+  }
 
-  // When all the Keys are in Dictionary, inDictionaryStream is omitted.
-  bool writeInDictionaryStream = finalDictionarySize_ != dictEncoder_.size();
+  // When all the Keys are in Dictionary, inDictionaryStream is omitted. A
+  // shared dictionary has all the keys.
+  bool writeInDictionaryStream =
+      !useSharedDictionary_ && finalDictionarySize_ != dictEncoder_.size();
 
   // Record starting positions of the dictionary encoding streams.
   recordDictionaryEncodingStreamPositions(
@@ -21,6 +21,7 @@
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
+#include "velox/dwio/dwrf/writer/AdaptiveEncodingSelector.h"
 #include "velox/dwio/dwrf/writer/IndexBuilder.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 #include "velox/dwio/dwrf/writer/WriterContext.h"
@@ -52,6 +53,18 @@ class ColumnWriter {
   virtual uint64_t writeFileStats(
       std::function<proto::ColumnStatistics&(uint32_t)> statsFactory) const = 0;
 
+  /// Calls 'consumer' with the node id and the file level sketch of distinct
+  /// values of each column in the tree that keeps one.
+  virtual void writeDistinctCounts(
+      const std::function<void(uint32_t, common::hll::HllAccumulator&)>&
+          consumer) const = 0;
+
+  /// Calls 'consumer' with the node id and the serialized dictionary of each
+  /// string column in the tree that shares its dictionary between stripes.
+  virtual void writeSharedDictionaries(
+      const std::function<void(uint32_t, const std::string&)>& consumer)
+      const = 0;
+
   virtual bool tryAbandonDictionaries(bool force) = 0;
 
  protected:
@@ -131,10 +144,29 @@ class BaseColumnWriter : public ColumnWriter {
     return size;
   }
 
+  void writeDistinctCounts(
+      const std::function<void(uint32_t, common::hll::HllAccumulator&)>&
+          consumer) const override {
+    if (auto sketch = fileStatsBuilder_->distinctCountSketch()) {
+      consumer(id_, *sketch);
+    }
+    for (auto& child : children_) {
+      child->writeDistinctCounts(consumer);
+    }
+  }
+
+  void writeSharedDictionaries(
+      const std::function<void(uint32_t, const std::string&)>& consumer)
+      const override {
+    for (auto& child : children_) {
+      child->writeSharedDictionaries(consumer);
+    }
+  }
+
   /// Determines whether dictionary is the right encoding to use when writing
   /// the first stripe. We will continue using the same decision for all
-  /// subsequent stripes. Returns true if an encoding change is performed, false
-  /// otherwise.
+  /// subsequent stripes unless the adaptive encoding selection is enabled.
+  /// Returns true if an encoding change is performed, false otherwise.
   bool tryAbandonDictionaries(bool force) override {
     bool result = false;
     for (auto& child : children_) {
@@ -168,8 +200,8 @@ class BaseColumnWriter : public ColumnWriter {
       present_ =
           createBooleanRleEncoder(newStream(StreamKind::StreamKind_PRESENT));
     }
-    const auto options =
-        StatisticsBuilderOptions::fromConfig(context.getConfigs());
+    const auto options = StatisticsBuilderOptions::fromConfig(
+        context.getConfigs(), context.distinctCountAllocator());
     indexStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
   }
@@ -234,6 +266,47 @@ class BaseColumnWriter : public ColumnWriter {
     suppressStream(kind, sequence_);
   }
 
+  // Removes the stream of 'kind' so that it can be created again for a
+  // different encoding. The writer of the stream must be destroyed first.
+  void removeStream(StreamKind kind) {
+    const DwrfStreamIdentifier stream{id_, sequence_, type_.column(), kind};
+    context_.removeStreams(
+        [&](const DwrfStreamIdentifier& other) { return other == stream; });
+  }
+
+  // Creates 'adaptiveSelector_' if the adaptive encoding selection is enabled.
+  // Columns of flat maps keep the encoding chosen on the first stripe.
+  void initAdaptiveEncodingSelection() {
+    if (sequence_ == 0 && getConfig(Config::ADAPTIVE_ENCODING_SELECTION)) {
+      adaptiveSelector_ = std::make_unique<AdaptiveEncodingSelector>(
+          getConfig(Config::ADAPTIVE_ENCODING_READ_COST_WEIGHT),
+          getConfig(Config::ADAPTIVE_ENCODING_SAMPLE_RATE));
+    }
+  }
+
+  // Records the encoding and the estimated encoded size of the stripe being
+  // flushed.
+  void recordStripeEncoding(bool dictionary, uint64_t encodedBytes) {
+    context_.recordEncoding(id_, dictionary);
+    stripeEncoding_ = {dictionary, encodedBytes};
+  }
+
+  // Passes the size on disk of the last flushed stripe to 'adaptiveSelector_'.
+  // Called on reset, after the streams of the stripe are written.
+  void recordStripePhysicalSize() {
+    if (!stripeEncoding_.has_value()) {
+      return;
+    }
+    const auto physicalSize =
+        context_.getPhysicalSizeAggregator(id_).getResult();
+    adaptiveSelector_->recordStripe(
+        stripeEncoding_->first,
+        stripeEncoding_->second,
+        physicalSize - physicalSize_);
+    physicalSize_ = physicalSize;
+    stripeEncoding_.reset();
+  }
+
   template <typename T>
   T getConfig(const Config::Entry<T>& config) const {
     return context_.getConfig(config);
@@ -264,6 +337,13 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
   bool hasNull_ = false;
+  // Chooses the encoding of each stripe if the adaptive encoding selection is
+  // enabled for the column.
+  std::unique_ptr<AdaptiveEncodingSelector> adaptiveSelector_;
+  // Encoding and estimated encoded size of the last flushed stripe.
+  std::optional<std::pair<bool, uint64_t>> stripeEncoding_;
+  // Size on disk of the column after the previous stripe.
+  uint64_t physicalSize_{0};
   // callback used to inject the logic that captures positions for flat map
   // in_map stream
   const std::function<void(IndexBuilder&)> onRecordPosition_;
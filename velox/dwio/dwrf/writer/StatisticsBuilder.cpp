@@ -16,6 +16,11 @@
 
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/hyperloglog/HllUtils.h"
+
 namespace facebook::velox::dwrf {
 
 namespace {
@@ -118,6 +123,39 @@ std::unique_ptr<dwio::common::ColumnStatistics> StatisticsBuilder::build()
   return buildColumnStatisticsFromProto(stats, context);
 }
 
+void StatisticsBuilder::initDistinctCountSketch() {
+  if (options_.distinctCountAllocator == nullptr) {
+    return;
+  }
+  // The stride statistics are reset at every stride, so reuse the memory of
+  // the sketch.
+  if (distinctCountSketch_ != nullptr) {
+    distinctCountSketch_->clear();
+    return;
+  }
+  distinctCountSketch_ = std::make_unique<common::hll::HllAccumulator>(
+      options_.distinctCountAllocator);
+  distinctCountSketch_->setIndexBitLength(
+      common::hll::toIndexBitLength(common::hll::kDefaultStandardError));
+}
+
+void StatisticsBuilder::addDistinctValue(const void* data, size_t size) {
+  distinctCountSketch_->append(XXH64(data, size, 0));
+}
+
+void StatisticsBuilder::mergeDistinctCountSketch(
+    const dwio::common::ColumnStatistics& other) {
+  if (distinctCountSketch_ == nullptr) {
+    return;
+  }
+  auto builder = dynamic_cast<const StatisticsBuilder*>(&other);
+  if (builder != nullptr && builder->distinctCountSketch_ != nullptr) {
+    distinctCountSketch_->mergeWith(*builder->distinctCountSketch_);
+  } else if (!isEmpty(other)) {
+    distinctCountSketch_.reset();
+  }
+}
+
 std::unique_ptr<StatisticsBuilder> StatisticsBuilder::create(
     const Type& type,
     const StatisticsBuilderOptions& options) {
@@ -128,10 +166,10 @@ std::unique_ptr<StatisticsBuilder> StatisticsBuilder::create(
     case TypeKind::SMALLINT:
     case TypeKind::INTEGER:
     case TypeKind::BIGINT:
-      return std::make_unique<IntegerStatisticsBuilder>(options);
+      return std::make_unique<IntegerStatisticsBuilder>(options, type.kind());
     case TypeKind::REAL:
     case TypeKind::DOUBLE:
-      return std::make_unique<DoubleStatisticsBuilder>(options);
+      return std::make_unique<DoubleStatisticsBuilder>(options, type.kind());
     case TypeKind::VARCHAR:
       return std::make_unique<StringStatisticsBuilder>(options);
     case TypeKind::VARBINARY:
@@ -226,10 +264,28 @@ void BooleanStatisticsBuilder::toProto(proto::ColumnStatistics& stats) const {
   }
 }
 
+void IntegerStatisticsBuilder::addDistinctInteger(int64_t value) {
+  switch (kind_) {
+    case TypeKind::TINYINT:
+      addDistinctValue<int8_t>(value);
+      break;
+    case TypeKind::SMALLINT:
+      addDistinctValue<int16_t>(value);
+      break;
+    case TypeKind::INTEGER:
+      addDistinctValue<int32_t>(value);
+      break;
+    default:
+      addDistinctValue<int64_t>(value);
+      break;
+  }
+}
+
 void IntegerStatisticsBuilder::merge(
     const dwio::common::ColumnStatistics& other,
     bool ignoreSize) {
   StatisticsBuilder::merge(other, ignoreSize);
+  mergeDistinctCountSketch(other);
   auto stats =
       dynamic_cast<const dwio::common::IntegerColumnStatistics*>(&other);
   if (!stats) {
@@ -267,10 +323,19 @@ void IntegerStatisticsBuilder::toProto(proto::ColumnStatistics& stats) const {
   }
 }
 
+void DoubleStatisticsBuilder::addDistinctDouble(double value) {
+  if (kind_ == TypeKind::REAL) {
+    addDistinctValue<float>(value);
+  } else {
+    addDistinctValue<double>(value);
+  }
+}
+
 void DoubleStatisticsBuilder::merge(
     const dwio::common::ColumnStatistics& other,
     bool ignoreSize) {
   StatisticsBuilder::merge(other, ignoreSize);
+  mergeDistinctCountSketch(other);
   auto stats =
       dynamic_cast<const dwio::common::DoubleColumnStatistics*>(&other);
   if (!stats) {
@@ -317,6 +382,7 @@ void StringStatisticsBuilder::merge(
   // differently.
   auto isSelfEmpty = isEmpty(*this);
   StatisticsBuilder::merge(other, ignoreSize);
+  mergeDistinctCountSketch(other);
   auto stats =
       dynamic_cast<const dwio::common::StringColumnStatistics*>(&other);
   if (!stats) {
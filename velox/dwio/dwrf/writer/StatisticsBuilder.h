@@ -17,6 +17,7 @@
 #pragma once
 
 #include <velox/common/base/Exceptions.h>
+#include "velox/common/hyperloglog/HllAccumulator.h"
 #include "velox/dwio/dwrf/common/Config.h"
 #include "velox/dwio/dwrf/common/Statistics.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
@@ -76,14 +77,26 @@ inline dwio::common::KeyInfo constructKey(const dwrf::proto::KeyInfo& keyInfo) {
 struct StatisticsBuilderOptions {
   explicit StatisticsBuilderOptions(
       uint32_t stringLengthLimit,
-      std::optional<uint64_t> initialSize = std::nullopt)
-      : stringLengthLimit{stringLengthLimit}, initialSize{initialSize} {}
+      std::optional<uint64_t> initialSize = std::nullopt,
+      HashStringAllocator* distinctCountAllocator = nullptr)
+      : stringLengthLimit{stringLengthLimit},
+        initialSize{initialSize},
+        distinctCountAllocator{distinctCountAllocator} {}
 
   uint32_t stringLengthLimit;
   std::optional<uint64_t> initialSize;
-
-  static StatisticsBuilderOptions fromConfig(const Config& config) {
-    return StatisticsBuilderOptions{config.get(Config::STRING_STATS_LIMIT)};
+  /// If set, the builders of integer, floating point and string columns keep
+  /// a HyperLogLog sketch of their distinct values allocated from it.
+  HashStringAllocator* distinctCountAllocator;
+
+  static StatisticsBuilderOptions fromConfig(
+      const Config& config,
+      HashStringAllocator* distinctCountAllocator = nullptr) {
+    return StatisticsBuilderOptions{
+        config.get(Config::STRING_STATS_LIMIT),
+        std::nullopt,
+        config.get(Config::DISTINCT_COUNT_STATS) ? distinctCountAllocator
+                                                 : nullptr};
   }
 };
 
@@ -154,6 +167,12 @@ class StatisticsBuilder : public virtual dwio::common::ColumnStatistics {
 
   std::unique_ptr<dwio::common::ColumnStatistics> build() const;
 
+  /// Returns the HyperLogLog sketch of the distinct non-null values, or
+  /// nullptr if the distinct values are not tracked or unknown.
+  common::hll::HllAccumulator* distinctCountSketch() const {
+    return distinctCountSketch_.get();
+  }
+
   static std::unique_ptr<StatisticsBuilder> create(
       const Type& type,
       const StatisticsBuilderOptions& options);
@@ -173,7 +192,28 @@ class StatisticsBuilder : public virtual dwio::common::ColumnStatistics {
   }
 
  protected:
+  // Starts an empty sketch of distinct values if the options have an
+  // allocator for it.
+  void initDistinctCountSketch();
+
+  // Adds the value made of 'size' bytes at 'data' to the sketch of distinct
+  // values.
+  void addDistinctValue(const void* data, size_t size);
+
+  // Adds 'value' to the sketch of distinct values as a T. Hashing the values
+  // in the width of the column type like approx_distinct lets the sketches
+  // be merged with its results.
+  template <typename T>
+  void addDistinctValue(T value) {
+    addDistinctValue(&value, sizeof(T));
+  }
+
+  // Merges the sketch of distinct values of 'other'. The sketch becomes
+  // unknown if 'other' has values but no sketch.
+  void mergeDistinctCountSketch(const dwio::common::ColumnStatistics& other);
+
   StatisticsBuilderOptions options_;
+  std::unique_ptr<common::hll::HllAccumulator> distinctCountSketch_;
 };
 
 class BooleanStatisticsBuilder : public StatisticsBuilder,
@@ -213,8 +253,12 @@ class BooleanStatisticsBuilder : public StatisticsBuilder,
 class IntegerStatisticsBuilder : public StatisticsBuilder,
                                  public dwio::common::IntegerColumnStatistics {
  public:
-  explicit IntegerStatisticsBuilder(const StatisticsBuilderOptions& options)
-      : StatisticsBuilder{options} {
+  /// 'kind' is the integer type of the column, which decides how the values
+  /// are hashed into the sketch of distinct values.
+  explicit IntegerStatisticsBuilder(
+      const StatisticsBuilderOptions& options,
+      TypeKind kind = TypeKind::BIGINT)
+      : StatisticsBuilder{options}, kind_{kind} {
     init();
   }
 
@@ -222,6 +266,9 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
 
   void addValues(int64_t value, uint64_t count = 1) {
     increaseValueCount(count);
+    if (UNLIKELY(distinctCountSketch_ != nullptr)) {
+      addDistinctInteger(value);
+    }
     if (min_.has_value() && value < min_.value()) {
       min_ = value;
     }
@@ -247,7 +294,12 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
     min_ = std::numeric_limits<int64_t>::max();
     max_ = std::numeric_limits<int64_t>::min();
     sum_ = 0;
+    initDistinctCountSketch();
   }
+
+  void addDistinctInteger(int64_t value);
+
+  const TypeKind kind_;
 };
 
 static_assert(
@@ -257,8 +309,12 @@ static_assert(
 class DoubleStatisticsBuilder : public StatisticsBuilder,
                                 public dwio::common::DoubleColumnStatistics {
  public:
-  explicit DoubleStatisticsBuilder(const StatisticsBuilderOptions& options)
-      : StatisticsBuilder{options} {
+  /// 'kind' is REAL or DOUBLE, which decides how the values are hashed into
+  /// the sketch of distinct values.
+  explicit DoubleStatisticsBuilder(
+      const StatisticsBuilderOptions& options,
+      TypeKind kind = TypeKind::DOUBLE)
+      : StatisticsBuilder{options}, kind_{kind} {
     init();
   }
 
@@ -266,6 +322,9 @@ class DoubleStatisticsBuilder : public StatisticsBuilder,
 
   void addValues(double value, uint64_t count = 1) {
     increaseValueCount(count);
+    if (UNLIKELY(distinctCountSketch_ != nullptr)) {
+      addDistinctDouble(value);
+    }
     // min/max/sum is defined only when none of the values added is NaN
     if (std::isnan(value)) {
       clear();
@@ -306,6 +365,7 @@ class DoubleStatisticsBuilder : public StatisticsBuilder,
     min_ = std::numeric_limits<double>::infinity();
     max_ = -std::numeric_limits<double>::infinity();
     sum_ = 0;
+    initDistinctCountSketch();
   }
 
   void clear() {
@@ -313,6 +373,10 @@ class DoubleStatisticsBuilder : public StatisticsBuilder,
     max_.reset();
     sum_.reset();
   }
+
+  void addDistinctDouble(double value);
+
+  const TypeKind kind_;
 };
 
 class StringStatisticsBuilder : public StatisticsBuilder,
@@ -331,6 +395,9 @@ class StringStatisticsBuilder : public StatisticsBuilder,
     // differently.
     auto isSelfEmpty = isEmpty(*this);
     increaseValueCount(count);
+    if (UNLIKELY(distinctCountSketch_ != nullptr)) {
+      addDistinctValue(value.data(), value.size());
+    }
     if (isSelfEmpty) {
       min_ = value;
       max_ = value;
@@ -364,6 +431,7 @@ class StringStatisticsBuilder : public StatisticsBuilder,
     min_.reset();
     max_.reset();
     length_ = 0;
+    initDistinctCountSketch();
   }
 
   bool shouldKeep(const std::optional<std::string>& val) const {
@@ -161,6 +161,21 @@ class StringDictionaryEncoder {
         keyBytes_.data() + startOffset, endOffset - startOffset};
   }
 
+  // Removes the keys added after the first 'size' ones. The counts of the
+  // remaining keys stay as they are.
+  void truncate(uint32_t size) {
+    DCHECK_LE(size, this->size());
+    // The keys must stay readable while they are erased from 'keyIndex_'.
+    for (auto index = this->size(); index > size; --index) {
+      keyIndex_.erase(detail::DictStringId{index - 1});
+    }
+    keyBytes_.resize(keyOffsets_[size]);
+    keyOffsets_.resize(size + 1);
+    counts_.resize(size);
+    firstSeenStrideIndex_.resize(size);
+    hash_.resize(size);
+  }
+
   void clear() {
     keyIndex_.clear();
     keyBytes_.clear();
@@ -176,6 +191,7 @@ class StringDictionaryEncoder {
   VELOX_FRIEND_TEST(TestStringDictionaryEncoder, GetIndex);
   VELOX_FRIEND_TEST(TestStringDictionaryEncoder, GetStride);
   VELOX_FRIEND_TEST(TestStringDictionaryEncoder, Clear);
+  VELOX_FRIEND_TEST(TestStringDictionaryEncoder, Truncate);
 
   // Intended for testing only.
   uint32_t getIndex(folly::StringPiece sp) {
@@ -19,6 +19,7 @@
 #include <folly/ScopeGuard.h>
 
 #include "velox/common/time/CpuWallTimer.h"
+#include "velox/dwio/common/Statistics.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/utils/ProtoUtils.h"
 #include "velox/dwio/dwrf/writer/FlushPolicy.h"
@@ -60,7 +61,8 @@ Writer::Writer(
     const WriterOptions& options,
     std::shared_ptr<memory::MemoryPool> pool)
     : writerBase_(std::make_unique<WriterBase>(std::move(sink))),
-      schema_{dwio::common::TypeWithId::create(options.schema)} {
+      schema_{dwio::common::TypeWithId::create(options.schema)},
+      flushExecutor_{options.flushExecutor} {
   VELOX_CHECK(
       !pool->isLeaf(),
       "Memory pool {} for DWRF writer can't be leaf",
@@ -267,9 +269,15 @@ void Writer::flushStripe(bool close) {
   const auto& handler = context.getEncryptionHandler();
   EncodingManager encodingManager{handler};
 
+  if (flushExecutor_) {
+    context.startDeferringPages();
+  }
   writer_->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
     return encodingManager.addEncodingToFooter(nodeId);
   });
+  if (flushExecutor_) {
+    context.finishDeferredPages(*flushExecutor_);
+  }
 
   // Collects the memory increment from flushing data to output streams.
   const auto flushOverhead =
@@ -493,11 +501,38 @@ void Writer::flushInternal(bool close) {
         }
       }
 
+      const auto encodings = context.encodings();
+      if (!encodings.empty()) {
+        writerBase_->addUserMetadata(
+            std::string{WRITER_ENCODINGS_KEY}, encodings);
+      }
+      writer_->writeDistinctCounts(
+          [&](uint32_t nodeId, common::hll::HllAccumulator& sketch) {
+            // The sketch of an encrypted column would leak its values.
+            if (handler.isEncrypted(nodeId)) {
+              return;
+            }
+            std::string serialized(sketch.serializedSize(), '\0');
+            sketch.serialize(serialized.data());
+            writerBase_->addUserMetadata(
+                dwio::common::distinctCountKey(nodeId), serialized);
+          });
+      writer_->writeSharedDictionaries(
+          [&](uint32_t nodeId, const std::string& serialized) {
+            writerBase_->addUserMetadata(
+                fmt::format(
+                    "{}{}", WRITER_SHARED_DICTIONARY_KEY_PREFIX, nodeId),
+                serialized);
+          });
       writerBase_->writeFooter(*schema_->type());
     }
 
     // flush to sink
-    sink.flush();
+    if (flushExecutor_ && !close) {
+      sink.flushAsync(*flushExecutor_);
+    } else {
+      sink.flush();
+    }
   }
 
   if (close) {
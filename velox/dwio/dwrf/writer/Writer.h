@@ -47,6 +47,12 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the last pages of the streams of a stripe are compressed and
+  /// encrypted in parallel on this executor at stripe flush, and a stripe is
+  /// written to the sink on it while the next stripe is encoded. The data of
+  /// a flush that does not close the writer is then not yet in the sink when
+  /// flush() returns. close() waits for all writes.
+  std::shared_ptr<folly::Executor> flushExecutor;
 };
 
 class Writer : public dwio::common::Writer {
@@ -149,6 +155,7 @@ class Writer : public dwio::common::Writer {
   std::unique_ptr<DWRFFlushPolicy> flushPolicy_;
   std::unique_ptr<LayoutPlanner> layoutPlanner_;
   std::unique_ptr<ColumnWriter> writer_;
+  const std::shared_ptr<folly::Executor> flushExecutor_;
 };
 
 class DwrfWriterFactory : public dwio::common::WriterFactory {
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/writer/WriterContext.h"
 
+#include <folly/futures/Future.h>
+
 namespace facebook::velox::dwrf {
 namespace {
 constexpr uint32_t MIN_INDEX_STRIDE = 1000;
@@ -68,6 +70,28 @@ WriterContext::WriterContext(
     compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
         *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
   }
+  if (getConfig(Config::DISTINCT_COUNT_STATS)) {
+    distinctCountAllocator_ =
+        std::make_unique<HashStringAllocator>(generalPool_.get());
+  }
+}
+
+void WriterContext::finishDeferredPages(folly::Executor& executor) {
+  VELOX_CHECK(deferPages_);
+  deferPages_ = false;
+  auto pages = std::move(deferredPages_);
+  deferredPages_.clear();
+  std::vector<folly::Future<folly::Unit>> futures;
+  futures.reserve(pages.size());
+  for (auto& page : pages) {
+    futures.push_back(folly::via(&executor, std::move(page)));
+  }
+  // Waits for all pages before surfacing an error since the pages refer to
+  // the streams.
+  auto results = folly::collectAll(std::move(futures)).get();
+  for (auto& result : results) {
+    result.throwUnlessValue();
+  }
 }
 
 void WriterContext::validateConfigs() const {
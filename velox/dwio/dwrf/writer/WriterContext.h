@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <map>
 #include "velox/common/base/GTestMacros.h"
+#include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/Compression.h"
@@ -187,6 +190,12 @@ class WriterContext : public CompressionBufferPool {
     return pool_->maxCapacity();
   }
 
+  /// Returns the allocator of the sketches of distinct values of the columns,
+  /// or nullptr if Config::DISTINCT_COUNT_STATS is off.
+  HashStringAllocator* distinctCountAllocator() const {
+    return distinctCountAllocator_.get();
+  }
+
   const encryption::EncryptionHandler& getEncryptionHandler() const {
     return *handler_;
   }
@@ -251,6 +260,27 @@ class WriterContext : public CompressionBufferPool {
     compressionBuffer_ = std::move(buffer);
   }
 
+  bool deferPages() const override {
+    return deferPages_;
+  }
+
+  void deferPage(std::function<void()> page) override {
+    VELOX_CHECK(deferPages_);
+    deferredPages_.push_back(std::move(page));
+  }
+
+  /// Makes the unencrypted paged streams defer the compression of their last
+  /// page at flush until finishDeferredPages(). Their flush() then returns 0
+  /// and their size() includes the page only after finishDeferredPages().
+  void startDeferringPages() {
+    VELOX_CHECK(deferredPages_.empty());
+    deferPages_ = true;
+  }
+
+  /// Compresses the pages deferred since startDeferringPages() in parallel
+  /// on 'executor' and waits for them to finish.
+  void finishDeferredPages(folly::Executor& executor);
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize[node] += size;
   }
@@ -328,6 +358,27 @@ class WriterContext : public CompressionBufferPool {
     return lowMemoryMode_;
   }
 
+  /// Records the encoding chosen for a stripe of 'node' by the adaptive
+  /// encoding selection.
+  void recordEncoding(uint32_t node, bool dictionary) {
+    encodings_[node].push_back(dictionary ? 'D' : 'R');
+  }
+
+  /// Returns the encodings recorded by recordEncoding() as a list of
+  /// <node>:<encodings> separated by commas, with one character per stripe:
+  /// 'D' for dictionary and 'R' for direct encoding. Empty if none is
+  /// recorded.
+  std::string encodings() const {
+    std::string result;
+    for (const auto& [node, encodings] : encodings_) {
+      if (!result.empty()) {
+        result.push_back(',');
+      }
+      result += fmt::format("{}:{}", node, encodings);
+    }
+    return result;
+  }
+
   PhysicalSizeAggregator& getPhysicalSizeAggregator(uint32_t node) {
     return *physicalSizeAggregators_.at(node);
   }
@@ -601,6 +652,10 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  std::unique_ptr<HashStringAllocator> distinctCountAllocator_;
+  // True while the paged streams pass their last page to deferPage().
+  bool deferPages_{false};
+  std::vector<std::function<void()>> deferredPages_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -615,6 +670,7 @@ class WriterContext : public CompressionBufferPool {
   AverageRowSizeTracker rowSizeTracker_;
   bool checkLowMemoryMode_;
   bool lowMemoryMode_{false};
+  std::map<uint32_t, std::string> encodings_;
 
   /// stats
   uint32_t stripeIndex_{0};
@@ -58,4 +58,22 @@ void WriterSink::addBuffer(dwio::common::DataBuffer<char> buffer) {
     sink_->write(std::move(buffer));
   }
 }
+
+void WriterSink::flushAsync(folly::Executor& executor) {
+  waitForFlush();
+  if (buffers_.empty()) {
+    return;
+  }
+  sizeAfterFlush_ = sink_->size() + size_;
+  pendingFlush_ =
+      folly::via(
+          &executor,
+          [sink = sink_,
+           buffers = std::make_shared<
+               std::vector<dwio::common::DataBuffer<char>>>(
+               std::move(buffers_))]() { sink->write(*buffers); })
+          .semi();
+  buffers_.clear();
+  size_ = 0;
+}
 } // namespace facebook::velox::dwrf
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/Array.h>
+#include <folly/futures/Future.h>
 
 #include "velox/dwio/common/DataBufferHolder.h"
 #include "velox/dwio/dwrf/common/Checksum.h"
@@ -61,13 +63,19 @@ class WriterSink {
   }
 
   ~WriterSink() {
+    try {
+      waitForFlush();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Asynchronous flush of writer sink failed: " << e.what();
+    }
     if (!buffers_.empty() || size_ != 0) {
       LOG(WARNING) << "Unflushed data in writer sink!";
     }
   }
 
   uint64_t size() const {
-    return sink_->size() + size_;
+    // The size of 'sink_' is not read while it is written asynchronously.
+    return (pendingFlush_.valid() ? sizeAfterFlush_ : sink_->size()) + size_;
   }
 
   void addBuffer(memory::MemoryPool& pool, const char* data, size_t size) {
@@ -87,11 +95,23 @@ class WriterSink {
   }
 
   void flush() {
+    waitForFlush();
     sink_->write(buffers_);
     buffers_.clear();
     size_ = 0;
   }
 
+  /// Writes the buffered data to the sink on 'executor'. The next flush
+  /// waits for the write and rethrows its error.
+  void flushAsync(folly::Executor& executor);
+
+  /// Waits for the write started by flushAsync(), if any.
+  void waitForFlush() {
+    if (pendingFlush_.valid()) {
+      std::move(pendingFlush_).get();
+    }
+  }
+
   Checksum* getChecksum() {
     return checksum_.get();
   }
@@ -186,6 +206,11 @@ class WriterSink {
   bool exceedsLimit_;
 
   std::vector<dwio::common::DataBuffer<char>> buffers_;
+
+  // The write started by flushAsync() and the size of 'sink_' after it.
+  folly::SemiFuture<folly::Unit> pendingFlush_{
+      folly::SemiFuture<folly::Unit>::makeEmpty()};
+  uint64_t sizeAfterFlush_{0};
 };
 
 } // namespace facebook::velox::dwrf
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Salts of the 8 hash functions of a block, one per word.
+constexpr uint32_t kSalts[] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// The Bloom filter header is a few bytes. Reads this much to get it in one
+// read.
+constexpr int32_t kHeaderSizeGuess = 256;
+
+inline uint32_t bitInWord(uint32_t key, int32_t word) {
+  return 1U << ((key * kSalts[word]) >> 27);
+}
+
+void readBytes(
+    const dwio::common::BufferedInput& input,
+    uint64_t offset,
+    int32_t length,
+    char* buffer) {
+  auto stream = input.read(offset, length, dwio::common::LogType::FOOTER);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(length, stream.get(), buffer, bufferStart, bufferEnd);
+}
+} // namespace
+
+BlockSplitBloomFilter::BlockSplitBloomFilter(int32_t numBytes) {
+  VELOX_CHECK(
+      numBytes > 0 && numBytes <= kMaxBytes && numBytes % kBytesPerBlock == 0,
+      "Bad Bloom filter size: {}",
+      numBytes);
+  bitset_.resize(numBytes / sizeof(uint32_t));
+}
+
+BlockSplitBloomFilter::BlockSplitBloomFilter(const char* data, int32_t numBytes)
+    : BlockSplitBloomFilter(numBytes) {
+  memcpy(bitset_.data(), data, numBytes);
+}
+
+uint32_t BlockSplitBloomFilter::blockOffset(uint64_t hash) const {
+  const uint64_t numBlocks = bitset_.size() / kWordsPerBlock;
+  return ((hash >> 32) * numBlocks >> 32) * kWordsPerBlock;
+}
+
+void BlockSplitBloomFilter::insertHash(uint64_t hash) {
+  auto* block = bitset_.data() + blockOffset(hash);
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= bitInWord(key, i);
+  }
+}
+
+bool BlockSplitBloomFilter::findHash(uint64_t hash) const {
+  const auto* block = bitset_.data() + blockOffset(hash);
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if ((block[i] & bitInWord(key, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+uint64_t BlockSplitBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BlockSplitBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BlockSplitBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+std::unique_ptr<BlockSplitBloomFilter> readBloomFilter(
+    const dwio::common::BufferedInput& input,
+    const thrift::ColumnMetaData& metaData) {
+  if (!metaData.__isset.bloom_filter_offset) {
+    return nullptr;
+  }
+  const int64_t offset = metaData.bloom_filter_offset;
+  const int64_t fileSize = input.getReadFile()->size();
+  VELOX_CHECK(
+      offset >= 0 && offset < fileSize,
+      "Bad Bloom filter offset: {}",
+      offset);
+  const int32_t headerSize =
+      std::min<int64_t>(kHeaderSizeGuess, fileSize - offset);
+  std::vector<char> header(headerSize);
+  readBytes(input, offset, headerSize, header.data());
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      header.data(), headerSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader bloomFilterHeader;
+  const auto bitsetOffset = offset + bloomFilterHeader.read(&protocol);
+
+  if (!bloomFilterHeader.algorithm.__isset.BLOCK ||
+      !bloomFilterHeader.hash.__isset.XXHASH ||
+      !bloomFilterHeader.compression.__isset.UNCOMPRESSED) {
+    return nullptr;
+  }
+  const auto numBytes = bloomFilterHeader.numBytes;
+  VELOX_CHECK(
+      numBytes > 0 && bitsetOffset + numBytes <= fileSize,
+      "Bad Bloom filter size: {}",
+      numBytes);
+  std::vector<char> bitset(numBytes);
+  readBytes(input, bitsetOffset, numBytes, bitset.data());
+  return std::make_unique<BlockSplitBloomFilter>(bitset.data(), numBytes);
+}
+
+bool canUseBloomFilter(
+    const common::Filter& filter,
+    const Type& type,
+    thrift::Type::type physicalType) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      if (!static_cast<const common::BigintRange&>(filter).isSingleValue()) {
+        return false;
+      }
+      [[fallthrough]];
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      // TINYINT and SMALLINT may be stored zero extended if unsigned, so that
+      // the stored value is not the value read.
+      return (physicalType == thrift::Type::INT32 &&
+              (type.kind() == TypeKind::INTEGER ||
+               type.kind() == TypeKind::BIGINT)) ||
+          (physicalType == thrift::Type::INT64 &&
+           type.kind() == TypeKind::BIGINT);
+    case common::FilterKind::kBytesRange:
+      if (!static_cast<const common::BytesRange&>(filter).isSingleValue()) {
+        return false;
+      }
+      [[fallthrough]];
+    case common::FilterKind::kBytesValues:
+      return physicalType == thrift::Type::BYTE_ARRAY;
+    default:
+      return false;
+  }
+}
+
+namespace {
+bool testBigint(
+    int64_t value,
+    const BlockSplitBloomFilter& bloomFilter,
+    thrift::Type::type physicalType) {
+  if (physicalType == thrift::Type::INT64) {
+    return bloomFilter.findHash(BlockSplitBloomFilter::hash(value));
+  }
+  // Values outside of the INT32 range are not in the column.
+  return value >= std::numeric_limits<int32_t>::min() &&
+      value <= std::numeric_limits<int32_t>::max() &&
+      bloomFilter.findHash(
+          BlockSplitBloomFilter::hash(static_cast<int32_t>(value)));
+}
+
+template <typename T>
+bool testBigints(
+    const T& values,
+    const BlockSplitBloomFilter& bloomFilter,
+    thrift::Type::type physicalType) {
+  for (auto value : values) {
+    if (testBigint(value, bloomFilter, physicalType)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BlockSplitBloomFilter& bloomFilter,
+    thrift::Type::type physicalType) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return testBigint(
+          static_cast<const common::BigintRange&>(filter).lower(),
+          bloomFilter,
+          physicalType);
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return testBigints(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values(),
+          bloomFilter,
+          physicalType);
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return testBigints(
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values(),
+          bloomFilter,
+          physicalType);
+    case common::FilterKind::kBytesRange:
+      return bloomFilter.findHash(BlockSplitBloomFilter::hash(
+          std::string_view(
+              static_cast<const common::BytesRange&>(filter).lower())));
+    case common::FilterKind::kBytesValues:
+      for (const auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (bloomFilter.findHash(
+                BlockSplitBloomFilter::hash(std::string_view(value)))) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter of a Parquet column chunk as described in
+/// https://github.com/apache/parquet-format/blob/master/BloomFilter.md.
+/// Values are hashed with xxHash64 of their plain encoding.
+class BlockSplitBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+  static constexpr int32_t kMaxBytes = 128 << 20;
+
+  /// Makes an empty filter of 'numBytes', which must be a positive multiple
+  /// of kBytesPerBlock.
+  explicit BlockSplitBloomFilter(int32_t numBytes);
+
+  /// Makes a filter over the bitset 'data' of 'numBytes' read from a file.
+  BlockSplitBloomFilter(const char* data, int32_t numBytes);
+
+  void insertHash(uint64_t hash);
+
+  /// Returns false if no value with 'hash' was inserted.
+  bool findHash(uint64_t hash) const;
+
+  static uint64_t hash(int32_t value);
+
+  static uint64_t hash(int64_t value);
+
+  static uint64_t hash(std::string_view value);
+
+  int32_t numBytes() const {
+    return bitset_.size() * sizeof(uint32_t);
+  }
+
+  /// Returns the bitset in the layout of the file.
+  const char* data() const {
+    return reinterpret_cast<const char*>(bitset_.data());
+  }
+
+ private:
+  static constexpr int32_t kWordsPerBlock = kBytesPerBlock / sizeof(uint32_t);
+
+  // Returns the first word of the block for 'hash'.
+  uint32_t blockOffset(uint64_t hash) const;
+
+  // Little endian words, 'kWordsPerBlock' per block.
+  std::vector<uint32_t> bitset_;
+};
+
+/// Reads the Bloom filter of the column chunk with 'metaData'. Returns nullptr
+/// if the chunk has no Bloom filter or if its algorithm, hash or compression
+/// is not supported.
+std::unique_ptr<BlockSplitBloomFilter> readBloomFilter(
+    const dwio::common::BufferedInput& input,
+    const thrift::ColumnMetaData& metaData);
+
+/// Returns true if the Bloom filter of a column can exclude values for
+/// 'filter'. This is the case for equality and IN filters that do not accept
+/// nulls on columns of 'type' stored as 'physicalType'.
+bool canUseBloomFilter(
+    const common::Filter& filter,
+    const Type& type,
+    thrift::Type::type physicalType);
+
+/// Returns false if none of the values accepted by 'filter' is in
+/// 'bloomFilter'. 'filter' must satisfy canUseBloomFilter().
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BlockSplitBloomFilter& bloomFilter,
+    thrift::Type::type physicalType);
+
+} // namespace facebook::velox::parquet
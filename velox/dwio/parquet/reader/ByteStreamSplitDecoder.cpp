@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+
+#include <xsimd/xsimd.hpp>
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+#if XSIMD_WITH_SSE2
+// Number of values transposed per iteration. Each stream contributes one
+// 16 byte register.
+constexpr int32_t kBatchSize = 16;
+
+// Transposes 4 streams of 16 bytes into 16 values of 4 bytes.
+void transpose4(const char* data, int32_t numValues, char* result) {
+  auto load = [&](int32_t stream) {
+    return _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + stream * numValues));
+  };
+  const auto s0 = load(0);
+  const auto s1 = load(1);
+  const auto s2 = load(2);
+  const auto s3 = load(3);
+  // Byte pairs (0, 1) and (2, 3) of values 0-7 and 8-15.
+  const auto a0 = _mm_unpacklo_epi8(s0, s1);
+  const auto a1 = _mm_unpackhi_epi8(s0, s1);
+  const auto b0 = _mm_unpacklo_epi8(s2, s3);
+  const auto b1 = _mm_unpackhi_epi8(s2, s3);
+  auto* out = reinterpret_cast<__m128i*>(result);
+  _mm_storeu_si128(out, _mm_unpacklo_epi16(a0, b0));
+  _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(a0, b0));
+  _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(a1, b1));
+  _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(a1, b1));
+}
+
+// Transposes 8 streams of 16 bytes into 16 values of 8 bytes.
+void transpose8(const char* data, int32_t numValues, char* result) {
+  __m128i streams[8];
+  for (auto i = 0; i < 8; ++i) {
+    streams[i] = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + i * numValues));
+  }
+  // Byte pairs of values 0-7 in 'pairs[i]' and of values 8-15 in
+  // 'pairs[i + 4]'.
+  __m128i pairs[8];
+  for (auto i = 0; i < 4; ++i) {
+    pairs[i] = _mm_unpacklo_epi8(streams[2 * i], streams[2 * i + 1]);
+    pairs[i + 4] = _mm_unpackhi_epi8(streams[2 * i], streams[2 * i + 1]);
+  }
+  auto* out = reinterpret_cast<__m128i*>(result);
+  for (auto half = 0; half < 2; ++half) {
+    const auto* p = pairs + 4 * half;
+    // Bytes 0-3 and bytes 4-7 of 4 consecutive values each.
+    const auto low0 = _mm_unpacklo_epi16(p[0], p[1]);
+    const auto low1 = _mm_unpackhi_epi16(p[0], p[1]);
+    const auto high0 = _mm_unpacklo_epi16(p[2], p[3]);
+    const auto high1 = _mm_unpackhi_epi16(p[2], p[3]);
+    _mm_storeu_si128(out, _mm_unpacklo_epi32(low0, high0));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi32(low0, high0));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi32(low1, high1));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi32(low1, high1));
+    out += 4;
+  }
+}
+#endif
+
+void decodeScalar(
+    const char* data,
+    int32_t begin,
+    int32_t numValues,
+    int32_t width,
+    char* result) {
+  for (auto i = begin; i < numValues; ++i) {
+    for (auto stream = 0; stream < width; ++stream) {
+      result[i * width + stream] = data[stream * numValues + i];
+    }
+  }
+}
+
+} // namespace
+
+void decodeByteStreamSplit(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* result) {
+  int32_t i = 0;
+#if XSIMD_WITH_SSE2
+  if (width == 4) {
+    for (; i + kBatchSize <= numValues; i += kBatchSize) {
+      transpose4(data + i, numValues, result + i * 4);
+    }
+  } else if (width == 8) {
+    for (; i + kBatchSize <= numValues; i += kBatchSize) {
+      transpose8(data + i, numValues, result + i * 8);
+    }
+  }
+#endif
+  decodeScalar(data, i, numValues, width, result);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::parquet {
+
+/// Reassembles values from BYTE_STREAM_SPLIT encoded data. 'data' consists of
+/// 'width' streams of 'numValues' bytes each, where stream k holds byte k of
+/// every value. Writes 'numValues' values of 'width' bytes to 'result' in
+/// plain layout. Widths 4 and 8 are transposed with SIMD shuffles where
+/// available.
+void decodeByteStreamSplit(
+    const char* data,
+    int32_t numValues,
+    int32_t width,
+    char* result);
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include "velox/dwio/common/BitPackDecoder.h"
+
+#include <folly/Varint.h>
+#include <folly/lang/Bits.h>
+
+namespace facebook::velox::parquet {
+
+DeltaBpDecoder::DeltaBpDecoder(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end)
+    : bufferStart_(start), bufferEnd_(end) {
+  valuesPerBlock_ = readVarint();
+  miniblocksPerBlock_ = readVarint();
+  totalValues_ = readVarint();
+  lastValue_ = readZigZagVarint();
+  VELOX_CHECK(
+      valuesPerBlock_ > 0 && valuesPerBlock_ % 128 == 0,
+      "Invalid DELTA_BINARY_PACKED block size: {}",
+      valuesPerBlock_);
+  VELOX_CHECK(
+      miniblocksPerBlock_ > 0 && valuesPerBlock_ % miniblocksPerBlock_ == 0,
+      "Invalid DELTA_BINARY_PACKED miniblock count: {}",
+      miniblocksPerBlock_);
+  valuesPerMiniblock_ = valuesPerBlock_ / miniblocksPerBlock_;
+  VELOX_CHECK(
+      valuesPerMiniblock_ % 32 == 0 && valuesPerMiniblock_ <= (1 << 20),
+      "Invalid DELTA_BINARY_PACKED miniblock size: {}",
+      valuesPerMiniblock_);
+  // Starts past the last miniblock so that the first decode reads a block
+  // header.
+  miniblockIndex_ = miniblocksPerBlock_;
+  values_.resize(valuesPerMiniblock_);
+  if (totalValues_ > 0) {
+    values_[0] = lastValue_;
+    numDecoded_ = 1;
+    remainingValues_ = totalValues_ - 1;
+  }
+}
+
+uint64_t DeltaBpDecoder::readVarint() {
+  auto maxVarIntLen = std::min<uint64_t>(
+      folly::kMaxVarintLength64, bufferEnd_ - bufferStart_);
+  folly::ByteRange range(
+      reinterpret_cast<const unsigned char*>(bufferStart_),
+      reinterpret_cast<const unsigned char*>(bufferStart_ + maxVarIntLen));
+  // decodeVarint() advances the begin of 'range'.
+  auto value = folly::decodeVarint(range);
+  bufferStart_ = reinterpret_cast<const char*>(range.begin());
+  return value;
+}
+
+void DeltaBpDecoder::readBlockHeader() {
+  minDelta_ = readZigZagVarint();
+  VELOX_CHECK_LE(
+      miniblocksPerBlock_,
+      bufferEnd_ - bufferStart_,
+      "DELTA_BINARY_PACKED block header past end of page");
+  bitWidths_ = reinterpret_cast<const uint8_t*>(bufferStart_);
+  bufferStart_ += miniblocksPerBlock_;
+  miniblockIndex_ = 0;
+}
+
+void DeltaBpDecoder::decodeMiniblock() {
+  VELOX_CHECK(
+      remainingValues_ > 0, "Reading past the end of DELTA_BINARY_PACKED data");
+  if (miniblockIndex_ == miniblocksPerBlock_) {
+    readBlockHeader();
+  }
+  const auto bitWidth = bitWidths_[miniblockIndex_++];
+  VELOX_CHECK_LE(bitWidth, 64, "Invalid DELTA_BINARY_PACKED bit width");
+  // A miniblock is a multiple of 32 values, so it is a whole number of bytes.
+  const int32_t numBytes = valuesPerMiniblock_ / 8 * bitWidth;
+  const char* data = bufferStart_;
+  if (bufferEnd_ - bufferStart_ <
+      numBytes + static_cast<int64_t>(sizeof(uint64_t))) {
+    // The last miniblock may be truncated. Copies it to a zero padded buffer
+    // so that the unpacking can load whole words.
+    const auto available =
+        std::min<int64_t>(numBytes, bufferEnd_ - bufferStart_);
+    paddedMiniblock_.resize(numBytes + sizeof(uint64_t));
+    std::memset(paddedMiniblock_.data(), 0, paddedMiniblock_.size());
+    std::memcpy(paddedMiniblock_.data(), bufferStart_, available);
+    data = paddedMiniblock_.data();
+  }
+  unpackDeltas(data, bitWidth);
+  bufferStart_ += std::min<int64_t>(numBytes, bufferEnd_ - bufferStart_);
+
+  const int32_t numValues =
+      std::min<uint64_t>(remainingValues_, valuesPerMiniblock_);
+  // Wraps around on overflow like the encoder.
+  auto value = static_cast<uint64_t>(lastValue_);
+  const auto minDelta = static_cast<uint64_t>(minDelta_);
+  auto* deltas = deltas_.data();
+  auto* values = values_.data();
+  for (auto i = 0; i < numValues; ++i) {
+    value += minDelta + deltas[i];
+    values[i] = static_cast<int64_t>(value);
+  }
+  lastValue_ = static_cast<int64_t>(value);
+  remainingValues_ -= numValues;
+  numDecoded_ = numValues;
+  valueIndex_ = 0;
+}
+
+void DeltaBpDecoder::unpackDeltas(
+    const char* FOLLY_NONNULL data,
+    uint8_t bitWidth) {
+  const int32_t numValues = valuesPerMiniblock_;
+  deltas_.resize(numValues);
+  auto* deltas = deltas_.data();
+  if (bitWidth == 0) {
+    std::memset(deltas, 0, numValues * sizeof(uint64_t));
+    return;
+  }
+  if (bitWidth <= 32) {
+    narrowDeltas_.resize(numValues);
+    auto* input = reinterpret_cast<const uint8_t*>(data);
+    auto* output = narrowDeltas_.data();
+    dwio::common::unpack<uint32_t>(
+        input, numValues / 8 * bitWidth, numValues, bitWidth, output);
+    auto* narrow = narrowDeltas_.data();
+    for (auto i = 0; i < numValues; ++i) {
+      deltas[i] = narrow[i];
+    }
+    return;
+  }
+  // Wider than 32 bits. Each value is in the 9 bytes starting at the byte of
+  // its first bit.
+  const auto mask = bitWidth == 64 ? ~0UL : bits::lowMask(bitWidth);
+  uint64_t bit = 0;
+  for (auto i = 0; i < numValues; ++i, bit += bitWidth) {
+    const auto* start = data + (bit >> 3);
+    const auto shift = bit & 7;
+    auto value = folly::loadUnaligned<uint64_t>(start) >> shift;
+    if (shift + bitWidth > 64) {
+      value |= static_cast<uint64_t>(static_cast<uint8_t>(start[8]))
+          << (64 - shift);
+    }
+    deltas[i] = value & mask;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Nulls.h"
+#include "velox/common/base/RawVector.h"
+
+namespace facebook::velox::parquet {
+
+namespace detail {
+// Runs 'visitor' over the values of 'decoder'. 'decoder' provides
+// skip<hasNulls>(numValues, current, nulls) and 'readValue' returns its next
+// value. Shared by the decoders of the delta encodings.
+template <bool hasNulls, typename Decoder, typename Visitor, typename ReadValue>
+void readWithVisitor(
+    Decoder& decoder,
+    const uint64_t* FOLLY_NULLABLE nulls,
+    Visitor& visitor,
+    ReadValue readValue) {
+  int32_t current = visitor.start();
+  decoder.template skip<hasNulls>(current, 0, nulls);
+  int32_t toSkip;
+  bool atEnd = false;
+  const bool allowNulls = hasNulls && visitor.allowNulls();
+  for (;;) {
+    if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+      toSkip = visitor.processNull(atEnd);
+    } else {
+      if (hasNulls && !allowNulls) {
+        toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+        if (!Visitor::dense) {
+          decoder.template skip<false>(toSkip, current, nullptr);
+        }
+        if (atEnd) {
+          return;
+        }
+      }
+
+      // We are at a non-null value on a row to visit.
+      toSkip = visitor.process(readValue(), atEnd);
+    }
+    ++current;
+    if (toSkip) {
+      decoder.template skip<hasNulls>(toSkip, current, nulls);
+      current += toSkip;
+    }
+    if (atEnd) {
+      return;
+    }
+  }
+}
+} // namespace detail
+
+/// Decodes DELTA_BINARY_PACKED values. The values are stored as blocks of
+/// miniblocks of bit packed deltas from the previous value. Decoding is done a
+/// miniblock at a time: the deltas of a miniblock are unpacked with the
+/// vectorized kernels of dwio::common::unpack() and then prefix summed into
+/// 'values_', from which the values are returned one by one. Used for INT32
+/// and INT64 columns and for the lengths in DELTA_LENGTH_BYTE_ARRAY and
+/// DELTA_BYTE_ARRAY.
+class DeltaBpDecoder {
+ public:
+  DeltaBpDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end);
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    while (numValues > 0) {
+      if (valueIndex_ == numDecoded_) {
+        decodeMiniblock();
+      }
+      auto numSkipped = std::min(numValues, numDecoded_ - valueIndex_);
+      valueIndex_ += numSkipped;
+      numValues -= numSkipped;
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    detail::readWithVisitor<hasNulls>(
+        *this, nulls, visitor, [&]() { return readLong(); });
+  }
+
+  /// Decodes the next 'numValues' values into 'result'. Values wider than 'T'
+  /// are truncated.
+  template <typename T>
+  void next(T* FOLLY_NONNULL result, int32_t numValues) {
+    while (numValues > 0) {
+      if (valueIndex_ == numDecoded_) {
+        decodeMiniblock();
+      }
+      auto numCopied = std::min(numValues, numDecoded_ - valueIndex_);
+      for (auto i = 0; i < numCopied; ++i) {
+        result[i] = static_cast<T>(values_[valueIndex_ + i]);
+      }
+      result += numCopied;
+      valueIndex_ += numCopied;
+      numValues -= numCopied;
+    }
+  }
+
+  int64_t readLong() {
+    if (valueIndex_ == numDecoded_) {
+      decodeMiniblock();
+    }
+    return values_[valueIndex_++];
+  }
+
+  /// Returns the number of values in the encoding, as given by the header.
+  uint64_t totalValues() const {
+    return totalValues_;
+  }
+
+  /// Returns the first byte after the encoded values. Valid after all the
+  /// values have been read since the encoding does not record its size.
+  const char* FOLLY_NONNULL bufferStart() const {
+    return bufferStart_;
+  }
+
+ private:
+  uint64_t readVarint();
+
+  int64_t readZigZagVarint() {
+    auto value = readVarint();
+    return static_cast<int64_t>((value >> 1) ^ -(value & 1));
+  }
+
+  // Reads the min delta and bit widths of the next block.
+  void readBlockHeader();
+
+  // Decodes the next miniblock into 'values_'.
+  void decodeMiniblock();
+
+  // Unpacks 'valuesPerMiniblock_' deltas of 'bitWidth' bits from 'data' into
+  // 'deltas_'. 'data' has at least 'numBytes' + 8 addressable bytes.
+  void unpackDeltas(const char* FOLLY_NONNULL data, uint8_t bitWidth);
+
+  const char* FOLLY_NONNULL bufferStart_;
+  const char* FOLLY_NONNULL const bufferEnd_;
+
+  uint64_t valuesPerBlock_{0};
+  uint32_t miniblocksPerBlock_{0};
+  uint32_t valuesPerMiniblock_{0};
+  uint64_t totalValues_{0};
+
+  // Number of values that are not yet in 'values_'.
+  uint64_t remainingValues_{0};
+
+  // Last value decoded into 'values_'. The next value is this plus the next
+  // delta.
+  int64_t lastValue_{0};
+
+  // Min delta and bit widths of the current block.
+  int64_t minDelta_{0};
+  const uint8_t* FOLLY_NULLABLE bitWidths_{nullptr};
+
+  // Index of the next miniblock in the current block.
+  uint32_t miniblockIndex_{0};
+
+  // Decoded values of the current miniblock. The first value is stored in
+  // the header and is returned on its own.
+  raw_vector<int64_t> values_;
+  int32_t numDecoded_{0};
+  int32_t valueIndex_{0};
+
+  // Unpacked deltas of the current miniblock.
+  raw_vector<uint64_t> deltas_;
+  raw_vector<uint32_t> narrowDeltas_;
+
+  // Copy of a miniblock that ends less than 8 bytes before 'bufferEnd_'.
+  raw_vector<char> paddedMiniblock_;
+};
+
+} // namespace facebook::velox::parquet
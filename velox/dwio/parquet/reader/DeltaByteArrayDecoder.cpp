@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Decodes all the lengths in the DELTA_BINARY_PACKED data at 'start' into
+// 'lengths'. Returns the first byte after the lengths.
+const char* FOLLY_NONNULL decodeLengths(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end,
+    raw_vector<int32_t>& lengths) {
+  DeltaBpDecoder decoder(start, end);
+  VELOX_CHECK(
+      decoder.totalValues() <= std::numeric_limits<int32_t>::max(),
+      "Too many values in a page: {}",
+      decoder.totalValues());
+  lengths.resize(decoder.totalValues());
+  decoder.next(lengths.data(), lengths.size());
+  return decoder.bufferStart();
+}
+} // namespace
+
+DeltaLengthByteArrayDecoder::DeltaLengthByteArrayDecoder(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end) {
+  bufferStart_ = decodeLengths(start, end, lengths_);
+  int64_t totalLength = 0;
+  for (auto length : lengths_) {
+    VELOX_CHECK_GE(length, 0, "Negative length in DELTA_LENGTH_BYTE_ARRAY");
+    totalLength += length;
+  }
+  VELOX_CHECK_LE(
+      totalLength,
+      end - bufferStart_,
+      "DELTA_LENGTH_BYTE_ARRAY values past end of page");
+}
+
+DeltaByteArrayDecoder::DeltaByteArrayDecoder(
+    const char* FOLLY_NONNULL start,
+    const char* FOLLY_NONNULL end) {
+  auto suffixStart = decodeLengths(start, end, prefixLengths_);
+  suffixDecoder_ =
+      std::make_unique<DeltaLengthByteArrayDecoder>(suffixStart, end);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <folly/Range.h>
+
+namespace facebook::velox::parquet {
+
+/// Decodes DELTA_LENGTH_BYTE_ARRAY values: the lengths of all values encoded
+/// as DELTA_BINARY_PACKED followed by the concatenated bytes of the values.
+/// The lengths are decoded on construction since the bytes start where the
+/// lengths end.
+class DeltaLengthByteArrayDecoder {
+ public:
+  DeltaLengthByteArrayDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end);
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_CHECK_LE(lengthIndex_ + numValues, lengths_.size());
+    for (auto i = 0; i < numValues; ++i) {
+      bufferStart_ += lengths_[lengthIndex_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    detail::readWithVisitor<hasNulls>(
+        *this, nulls, visitor, [&]() { return readString(); });
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, lengths_.size());
+    auto length = lengths_[lengthIndex_++];
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  raw_vector<int32_t> lengths_;
+  int32_t lengthIndex_{0};
+  const char* FOLLY_NONNULL bufferStart_;
+};
+
+/// Decodes DELTA_BYTE_ARRAY values, also known as incremental encoding: the
+/// length of the prefix shared with the previous value encoded as
+/// DELTA_BINARY_PACKED, followed by the suffixes encoded as
+/// DELTA_LENGTH_BYTE_ARRAY. Each value depends on the previous one, so skipped
+/// values are reconstructed as well.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end);
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    detail::readWithVisitor<hasNulls>(
+        *this, nulls, visitor, [&]() { return readString(); });
+  }
+
+  /// Returns the next value. The result is valid until the next call.
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(prefixIndex_, prefixLengths_.size());
+    const auto prefixLength = prefixLengths_[prefixIndex_++];
+    VELOX_CHECK(
+        prefixLength >= 0 &&
+            static_cast<size_t>(prefixLength) <= lastValue_.size(),
+        "Invalid DELTA_BYTE_ARRAY prefix length: {}",
+        prefixLength);
+    auto suffix = suffixDecoder_->readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+ private:
+  raw_vector<int32_t> prefixLengths_;
+  int32_t prefixIndex_{0};
+  std::unique_ptr<DeltaLengthByteArrayDecoder> suffixDecoder_;
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/dwio/parquet/reader/Statistics.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+template <typename T>
+T readThrift(
+    const dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length) {
+  VELOX_CHECK_GE(offset, 0);
+  VELOX_CHECK_GT(length, 0);
+  auto stream = input.read(offset, length, dwio::common::LogType::FOOTER);
+  std::vector<char> copy(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), copy.data(), bufferStart, bufferEnd);
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(copy.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+} // namespace
+
+std::optional<thrift::OffsetIndex> readOffsetIndex(
+    const dwio::common::BufferedInput& input,
+    const thrift::ColumnChunk& chunk) {
+  if (!chunk.__isset.offset_index_offset ||
+      !chunk.__isset.offset_index_length || chunk.offset_index_length <= 0) {
+    return std::nullopt;
+  }
+  return readThrift<thrift::OffsetIndex>(
+      input, chunk.offset_index_offset, chunk.offset_index_length);
+}
+
+std::optional<thrift::ColumnIndex> readColumnIndex(
+    const dwio::common::BufferedInput& input,
+    const thrift::ColumnChunk& chunk) {
+  if (!chunk.__isset.column_index_offset ||
+      !chunk.__isset.column_index_length || chunk.column_index_length <= 0) {
+    return std::nullopt;
+  }
+  return readThrift<thrift::ColumnIndex>(
+      input, chunk.column_index_offset, chunk.column_index_length);
+}
+
+std::vector<int64_t> pageRowBoundaries(
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows) {
+  std::vector<int64_t> boundaries;
+  boundaries.reserve(offsetIndex.page_locations.size() + 1);
+  for (const auto& location : offsetIndex.page_locations) {
+    VELOX_CHECK(
+        boundaries.empty() ? location.first_row_index == 0
+                           : boundaries.back() < location.first_row_index,
+        "Page first rows are not increasing from 0 in OffsetIndex");
+    boundaries.push_back(location.first_row_index);
+  }
+  VELOX_CHECK(
+      boundaries.empty() || boundaries.back() < numRows,
+      "Page first row past the end of the row group");
+  boundaries.push_back(numRows);
+  return boundaries;
+}
+
+std::unique_ptr<dwio::common::ColumnStatistics> pageStatistics(
+    const thrift::ColumnIndex& columnIndex,
+    int32_t page,
+    const velox::Type& type,
+    uint64_t numRows) {
+  VELOX_CHECK_LT(page, columnIndex.null_pages.size());
+  thrift::Statistics stats;
+  if (columnIndex.null_pages[page]) {
+    // Min and max of an all null page are empty strings.
+    stats.__set_null_count(numRows);
+  } else {
+    if (columnIndex.__isset.null_counts &&
+        page < columnIndex.null_counts.size()) {
+      stats.__set_null_count(columnIndex.null_counts[page]);
+    }
+    stats.__set_min_value(columnIndex.min_values[page]);
+    stats.__set_max_value(columnIndex.max_values[page]);
+  }
+  return buildColumnStatisticsFromThrift(stats, type, numRows);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::parquet {
+
+/// Rows [begin, end) of a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Rows to read in the row groups where the page index excludes some pages.
+/// The ranges are sorted and disjoint. Row groups without an entry are read
+/// in full.
+using RowGroupRowRanges = folly::F14FastMap<uint32_t, std::vector<RowRange>>;
+
+/// Reads the OffsetIndex of 'chunk'. Returns std::nullopt if the file has no
+/// page index for 'chunk'.
+std::optional<thrift::OffsetIndex> readOffsetIndex(
+    const dwio::common::BufferedInput& input,
+    const thrift::ColumnChunk& chunk);
+
+/// Reads the ColumnIndex of 'chunk'. Returns std::nullopt if the file has no
+/// page index for 'chunk'.
+std::optional<thrift::ColumnIndex> readColumnIndex(
+    const dwio::common::BufferedInput& input,
+    const thrift::ColumnChunk& chunk);
+
+/// Returns the first row of each page in 'offsetIndex' followed by
+/// 'numRows', the number of rows in the row group.
+std::vector<int64_t> pageRowBoundaries(
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows);
+
+/// Returns the statistics of the 'page'th page in 'columnIndex'. 'numRows' is
+/// the number of rows in the page.
+std::unique_ptr<dwio::common::ColumnStatistics> pageStatistics(
+    const thrift::ColumnIndex& columnIndex,
+    int32_t page,
+    const velox::Type& type,
+    uint64_t numRows);
+
+} // namespace facebook::velox::parquet
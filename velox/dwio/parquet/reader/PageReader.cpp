@@ -39,8 +39,11 @@ void PageReader::seekToPage(int64_t row) {
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (pageStart_ >= pageRunEnd_ && nextPageRun_ < pageRuns_.size()) {
+      startNextPageRun();
+    }
     auto dataStart = pageStart_;
-    if (chunkSize_ <= pageStart_) {
+    if (chunkSize_ <= pageStart_ || pageRunEnd_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
       numRepDefsInPage_ = 0;
       numRowsInPage_ = 0;
@@ -77,6 +80,17 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::startNextPageRun() {
+  auto& run = pageRuns_[nextPageRun_++];
+  inputStream_ = std::move(run.stream);
+  bufferStart_ = nullptr;
+  bufferEnd_ = nullptr;
+  pageStart_ = run.offset;
+  pageRunEnd_ = run.offset + run.size;
+  rowOfPage_ = run.firstRow;
+  numRowsInPage_ = 0;
+}
+
 PageHeader PageReader::readPageHeader() {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
@@ -577,14 +591,40 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
-void PageReader::makeFilterCache(dwio::common::ScanState& state) {
+bool PageReader::readDictionaryPage() {
+  VELOX_CHECK_EQ(pageStart_, 0, "The dictionary page starts the chunk");
+  if (chunkSize_ <= 0) {
+    return false;
+  }
+  auto pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return false;
+  }
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  prepareDictionary(pageHeader);
+  return true;
+}
+
+void PageReader::makeFilterCache(
+    dwio::common::ScanState& state,
+    const common::Filter* filter) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
   state.filterCache.resize(state.dictionary.numValues);
-  simd::memset(
-      state.filterCache.data(),
-      dwio::common::FilterResult::kUnknown,
-      state.filterCache.size());
+  const auto kind = type_->type()->kind();
+  if (filter && filter->isDeterministic() &&
+      (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY)) {
+    dwio::common::fillStringFilterCache(
+        *filter,
+        state.dictionary.values->as<StringView>(),
+        state.dictionary.numValues,
+        state.filterCache.data());
+  } else {
+    simd::memset(
+        state.filterCache.data(),
+        dwio::common::FilterResult::kUnknown,
+        state.filterCache.size());
+  }
   state.rawState.filterCache = state.filterCache.data();
 }
 
@@ -716,6 +756,14 @@ int32_t PageReader::getLengthsAndNulls(
 
 void PageReader::makeDecoder() {
   auto parquetType = type_->parquetType_.value();
+  // A column chunk may mix encodings, e.g. when the writer falls back from
+  // dictionary to another encoding.
+  directDecoder_.reset();
+  stringDecoder_.reset();
+  booleanDecoder_.reset();
+  deltaBpDecoder_.reset();
+  deltaLengthByteArrayDecoder_.reset();
+  deltaByteArrayDecoder_.reset();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
     case Encoding::PLAIN_DICTIONARY:
@@ -750,6 +798,70 @@ void PageReader::makeDecoder() {
       }
       break;
     case Encoding::DELTA_BINARY_PACKED:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          deltaBpDecoder_ = std::make_unique<DeltaBpDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BINARY_PACKED not supported for type: {}",
+              thrift::to_string(parquetType));
+      }
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_LENGTH_BYTE_ARRAY not supported for type: {}",
+            thrift::to_string(parquetType));
+      }
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(
+              pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "DELTA_BYTE_ARRAY not supported for type: {}",
+            thrift::to_string(parquetType));
+      }
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT: {
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT not supported for type: {}",
+              thrift::to_string(parquetType));
+      }
+      // Reassembles the page in plain layout so that the direct decoder and
+      // its filter fast paths apply unchanged.
+      const auto width = parquetTypeBytes(parquetType);
+      VELOX_CHECK_EQ(
+          encodedDataSize_ % width,
+          0,
+          "BYTE_STREAM_SPLIT page size is not a multiple of the value size");
+      dwio::common::ensureCapacity<char>(
+          byteStreamSplitData_, encodedDataSize_, &pool_);
+      decodeByteStreamSplit(
+          pageData_,
+          encodedDataSize_ / width,
+          width,
+          byteStreamSplitData_->asMutable<char>());
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              byteStreamSplitData_->as<char>(), encodedDataSize_),
+          false,
+          width);
+      break;
+    }
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
@@ -782,6 +894,12 @@ void PageReader::skip(int64_t numRows) {
     stringDecoder_->skip(toSkip);
   } else if (booleanDecoder_) {
     booleanDecoder_->skip(toSkip);
+  } else if (deltaBpDecoder_) {
+    deltaBpDecoder_->skip(toSkip);
+  } else if (deltaLengthByteArrayDecoder_) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (deltaByteArrayDecoder_) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
@@ -904,7 +1022,7 @@ bool PageReader::rowsForPage(
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
-        makeFilterCache(scanState);
+        makeFilterCache(scanState, reader.scanSpec()->filter());
       }
       scanState.updateRawState();
     }
@@ -23,6 +23,9 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -30,6 +33,19 @@
 
 namespace facebook::velox::parquet {
 
+/// Pages of a column chunk that are adjacent in the file. A PageReader over
+/// page runs only reads the pages in the runs. Used when the page index
+/// excludes the pages between the runs.
+struct PageRun {
+  // Offset of the first byte from the start of the column chunk.
+  uint64_t offset;
+  // Size in bytes, including page headers.
+  uint64_t size;
+  // Row number of the first row from the start of the column chunk.
+  int64_t firstRow;
+  std::unique_ptr<dwio::common::SeekableInputStream> stream;
+};
+
 /// Manages access to pages inside a ColumnChunk. Interprets page headers and
 /// encodings and presents the combination of pages and encoded values as a
 /// continuous stream accessible via readWithVisitor().
@@ -53,6 +69,21 @@ class PageReader {
     type_->makeLevelInfo(leafInfo_);
   }
 
+  // Reads the pages in 'runs', which are in file order. The rows between the
+  // runs must be skipped.
+  PageReader(
+      std::vector<PageRun> runs,
+      memory::MemoryPool& pool,
+      ParquetTypeWithIdPtr nodeType,
+      thrift::CompressionCodec::type codec,
+      int64_t chunkSize)
+      : PageReader(nullptr, pool, std::move(nodeType), codec, chunkSize) {
+    VELOX_CHECK(!runs.empty());
+    VELOX_CHECK_EQ(maxRepeat_, 0, "Page runs require a non-repeated column");
+    pageRuns_ = std::move(runs);
+    startNextPageRun();
+  }
+
   // This PageReader constructor is for unit test only.
   PageReader(
       std::unique_ptr<dwio::common::SeekableInputStream> stream,
@@ -150,6 +181,16 @@ class PageReader {
   // Returns the current string dictionary as a FlatVector<StringView>.
   const VectorPtr& dictionaryValues(const TypePtr& type);
 
+  /// Reads the first page of the column chunk if it is a dictionary page.
+  /// Returns false if the chunk does not start with a dictionary page. The
+  /// dictionary is then available from dictionary(). This is used for
+  /// testing filters against the dictionary before reading the data pages.
+  bool readDictionaryPage();
+
+  const dwio::common::DictionaryValues& dictionary() const {
+    return dictionary_;
+  }
+
   // True if the current page holds dictionary indices.
   bool isDictionary() const {
     return encoding_ == thrift::Encoding::PLAIN_DICTIONARY ||
@@ -189,8 +230,14 @@ class PageReader {
   // current page.
   int32_t skipNulls(int32_t numRows);
 
-  // Initializes a filter result cache for the dictionary in 'state'.
-  void makeFilterCache(dwio::common::ScanState& state);
+  // Initializes a filter result cache for the dictionary in 'state'. The
+  // entries of a string dictionary are tested against 'filter' up front.
+  void makeFilterCache(
+      dwio::common::ScanState& state,
+      const common::Filter* FOLLY_NULLABLE filter);
+
+  // Continues reading at the start of the next run in 'pageRuns_'.
+  void startNextPageRun();
 
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
@@ -301,6 +348,9 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (deltaBpDecoder_) {
+        nullsFromFastPath = false;
+        deltaBpDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -309,6 +359,8 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (deltaBpDecoder_) {
+        deltaBpDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -332,12 +384,22 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
       } else {
         nullsFromFastPath = false;
-        stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        if (deltaLengthByteArrayDecoder_) {
+          deltaLengthByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+        } else if (deltaByteArrayDecoder_) {
+          deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
+        } else {
+          stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        }
       }
     } else {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (deltaLengthByteArrayDecoder_) {
+        deltaLengthByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
+      } else if (deltaByteArrayDecoder_) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -443,9 +505,23 @@ class PageReader {
   // level column.
   int32_t numRepDefsInPage_{0};
 
+  // Runs of pages to read if not all pages of the chunk are read.
+  std::vector<PageRun> pageRuns_;
+
+  // Index of the next run in 'pageRuns_'.
+  int32_t nextPageRun_{0};
+
+  // Offset from the start of the chunk of the end of the current page run or
+  // the chunk.
+  uint64_t pageRunEnd_{std::numeric_limits<uint64_t>::max()};
+
   // Copy of data if data straddles buffer boundary.
   BufferPtr pageBuffer_;
 
+  // Values of a BYTE_STREAM_SPLIT page reassembled in plain layout for
+  // 'directDecoder_'.
+  BufferPtr byteStreamSplitData_;
+
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
@@ -513,6 +589,9 @@ class PageReader {
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
+  std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -24,13 +24,14 @@ using thrift::RowGroup;
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, pool(), rowRanges_);
 }
 
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
-    const dwio::common::StatsContext& /*writerContext*/,
+    const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
   result.totalCount = std::max<int>(result.totalCount, rowGroups_.size());
   auto nwords = bits::nwords(result.totalCount);
@@ -42,14 +43,32 @@ void ParquetData::filterRowGroups(
     result.metadataFilterResults.emplace_back(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
+  auto* parquetContext =
+      dynamic_cast<const ParquetStatsContext*>(&writerContext);
   for (auto i = 0; i < rowGroups_.size(); ++i) {
-    if (scanSpec.filter() && !rowGroupMatches(i, scanSpec.filter())) {
+    const bool useBloomFilter = parquetContext && parquetContext->input &&
+        i < parquetContext->useBloomFilter.size() &&
+        parquetContext->useBloomFilter[i];
+    const bool useDictionary = parquetContext && parquetContext->input &&
+        i < parquetContext->useDictionary.size() &&
+        parquetContext->useDictionary[i];
+    std::optional<std::unique_ptr<BlockSplitBloomFilter>> bloomFilter;
+    std::optional<dwio::common::DictionaryValues> dictionary;
+    auto matches = [&](common::Filter* filter) {
+      return rowGroupMatches(i, filter) &&
+          (!useBloomFilter ||
+           bloomFilterMatches(
+               i, *filter, *parquetContext->input, bloomFilter)) &&
+          (!useDictionary ||
+           dictionaryMatches(i, *filter, *parquetContext->input, dictionary));
+    };
+    if (scanSpec.filter() && !matches(scanSpec.filter())) {
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
-      if (!rowGroupMatches(i, metadataFilter)) {
+      if (!matches(metadataFilter)) {
         bits::setBit(
             result.metadataFilterResults[metadataFiltersStartIndex + j]
                 .second.data(),
@@ -82,6 +101,235 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter,
+    const dwio::common::BufferedInput& input,
+    std::optional<std::unique_ptr<BlockSplitBloomFilter>>& bloomFilter) {
+  if (maxRepeat_ > 0 || !type_->parquetType_.has_value() ||
+      !canUseBloomFilter(filter, *type_->type(), *type_->parquetType_)) {
+    return true;
+  }
+  if (!bloomFilter.has_value()) {
+    auto& chunk = rowGroups_[rowGroupId].columns[type_->column()];
+    bloomFilter = chunk.__isset.meta_data
+        ? readBloomFilter(input, chunk.meta_data)
+        : nullptr;
+  }
+  return !bloomFilter.value() ||
+      testBloomFilter(filter, *bloomFilter.value(), *type_->parquetType_);
+}
+
+namespace {
+bool isDictionaryEncoding(thrift::Encoding::type encoding) {
+  return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+      encoding == thrift::Encoding::RLE_DICTIONARY;
+}
+
+// True if all data pages of the column chunk with 'metaData' are dictionary
+// encoded. Writers fall back to plain encoding when the dictionary grows too
+// large, after which the dictionary no longer covers all values.
+bool isEntirelyDictionaryEncoded(const thrift::ColumnMetaData& metaData) {
+  if (!metaData.__isset.dictionary_page_offset ||
+      metaData.dictionary_page_offset <= 0 ||
+      metaData.dictionary_page_offset >= metaData.data_page_offset) {
+    return false;
+  }
+  if (metaData.__isset.encoding_stats) {
+    for (const auto& stats : metaData.encoding_stats) {
+      if (stats.page_type != thrift::PageType::DICTIONARY_PAGE &&
+          stats.count > 0 && !isDictionaryEncoding(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Without page encoding stats, the encodings of the chunk must not include
+  // any value encoding besides the dictionary. RLE and BIT_PACKED are used
+  // for levels.
+  for (auto encoding : metaData.encodings) {
+    if (!isDictionaryEncoding(encoding) &&
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+bool ParquetData::dictionaryMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter,
+    const dwio::common::BufferedInput& input,
+    std::optional<dwio::common::DictionaryValues>& dictionary) {
+  const auto kind = type_->type()->kind();
+  if (maxRepeat_ > 0 || filter.testNull() || !filter.isDeterministic() ||
+      (kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY) ||
+      type_->parquetType_ != thrift::Type::BYTE_ARRAY) {
+    return true;
+  }
+  if (!dictionary.has_value()) {
+    dictionary = dwio::common::DictionaryValues();
+    auto& chunk = rowGroups_[rowGroupId].columns[type_->column()];
+    if (!chunk.__isset.meta_data ||
+        !isEntirelyDictionaryEncoded(chunk.meta_data)) {
+      return true;
+    }
+    auto& metaData = chunk.meta_data;
+    const auto size =
+        metaData.data_page_offset - metaData.dictionary_page_offset;
+    PageReader reader(
+        input.read(
+            metaData.dictionary_page_offset,
+            size,
+            dwio::common::LogType::FOOTER),
+        pool_,
+        type_,
+        metaData.codec,
+        size);
+    if (reader.readDictionaryPage()) {
+      dictionary = reader.dictionary();
+    }
+  }
+  if (!dictionary->values) {
+    return true;
+  }
+  auto* values = dictionary->values->as<StringView>();
+  for (auto i = 0; i < dictionary->numValues; ++i) {
+    if (filter.testBytes(values[i].data(), values[i].size())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::optional<PageFilterResult> ParquetData::filterPages(
+    const common::ScanSpec& scanSpec,
+    uint32_t rowGroupId,
+    const dwio::common::BufferedInput& input) {
+  if (maxRepeat_ > 0 ||
+      (!scanSpec.filter() && scanSpec.numMetadataFilters() == 0)) {
+    return std::nullopt;
+  }
+  auto& rowGroup = rowGroups_[rowGroupId];
+  auto& chunk = rowGroup.columns[type_->column()];
+  auto offsetIndex = readOffsetIndex(input, chunk);
+  if (!offsetIndex.has_value() || offsetIndex->page_locations.empty()) {
+    return std::nullopt;
+  }
+  auto columnIndex = readColumnIndex(input, chunk);
+  const auto numPages = offsetIndex->page_locations.size();
+  if (!columnIndex.has_value() ||
+      columnIndex->null_pages.size() != numPages ||
+      columnIndex->min_values.size() != numPages ||
+      columnIndex->max_values.size() != numPages) {
+    return std::nullopt;
+  }
+
+  PageFilterResult result;
+  result.offsetIndex =
+      std::make_shared<const thrift::OffsetIndex>(std::move(*offsetIndex));
+  result.pageRowBoundaries =
+      pageRowBoundaries(*result.offsetIndex, rowGroup.num_rows);
+  const auto nwords = bits::nwords(numPages);
+  result.filterResult.resize(nwords);
+  for (auto i = 0; i < scanSpec.numMetadataFilters(); ++i) {
+    result.metadataFilterResults.emplace_back(
+        scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
+  }
+  auto type = type_->type();
+  for (auto page = 0; page < numPages; ++page) {
+    const auto numRows = result.pageRowBoundaries[page + 1] -
+        result.pageRowBoundaries[page];
+    auto stats = pageStatistics(*columnIndex, page, *type, numRows);
+    if (scanSpec.filter() &&
+        !testFilter(scanSpec.filter(), stats.get(), numRows, type)) {
+      bits::setBit(result.filterResult.data(), page);
+    }
+    for (auto i = 0; i < scanSpec.numMetadataFilters(); ++i) {
+      if (!testFilter(
+              scanSpec.metadataFilterAt(i), stats.get(), numRows, type)) {
+        bits::setBit(result.metadataFilterResults[i].second.data(), page);
+      }
+    }
+  }
+  offsetIndices_[rowGroupId] = result.offsetIndex;
+  return result;
+}
+
+namespace {
+// Returns the file offset of the first page of 'metaData'.
+uint64_t chunkReadOffset(const thrift::ColumnMetaData& metaData) {
+  uint64_t chunkReadOffset = metaData.data_page_offset;
+  if (metaData.__isset.dictionary_page_offset &&
+      metaData.dictionary_page_offset >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    chunkReadOffset = metaData.dictionary_page_offset;
+  }
+  return chunkReadOffset;
+}
+} // namespace
+
+bool ParquetData::enqueuePageRuns(
+    uint32_t index,
+    const std::vector<RowRange>& ranges,
+    dwio::common::BufferedInput& input) {
+  auto& rowGroup = rowGroups_[index];
+  auto& chunk = rowGroup.columns[type_->column()];
+  std::shared_ptr<const thrift::OffsetIndex> offsetIndex;
+  auto it = offsetIndices_.find(index);
+  if (it != offsetIndices_.end()) {
+    offsetIndex = std::move(it->second);
+    offsetIndices_.erase(it);
+  } else if (auto read = readOffsetIndex(input, chunk)) {
+    offsetIndex =
+        std::make_shared<const thrift::OffsetIndex>(std::move(read.value()));
+  }
+  if (!offsetIndex || offsetIndex->page_locations.empty()) {
+    return false;
+  }
+  const auto& pages = offsetIndex->page_locations;
+  const auto chunkStart = chunkReadOffset(chunk.meta_data);
+  const auto boundaries = pageRowBoundaries(*offsetIndex, rowGroup.num_rows);
+
+  std::vector<PageRun> runs;
+  auto addPages = [&](uint64_t offset, uint64_t size, int64_t firstRow) {
+    if (!runs.empty() && runs.back().offset + runs.back().size == offset) {
+      runs.back().size += size;
+      return;
+    }
+    runs.push_back({offset, size, firstRow, nullptr});
+  };
+  VELOX_CHECK_GE(pages[0].offset, chunkStart);
+  if (pages[0].offset > chunkStart) {
+    // The dictionary page precedes the data pages.
+    addPages(0, pages[0].offset - chunkStart, 0);
+  }
+  size_t range = 0;
+  for (auto page = 0; page < pages.size(); ++page) {
+    while (range < ranges.size() && ranges[range].end <= boundaries[page]) {
+      ++range;
+    }
+    if (range == ranges.size()) {
+      break;
+    }
+    if (ranges[range].begin < boundaries[page + 1]) {
+      addPages(
+          pages[page].offset - chunkStart,
+          pages[page].compressed_page_size,
+          boundaries[page]);
+    }
+  }
+
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  for (auto& run : runs) {
+    run.stream = input.enqueue({chunkStart + run.offset, run.size}, &id);
+  }
+  pageRuns_[index] = std::move(runs);
+  return true;
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -93,27 +341,40 @@ void ParquetData::enqueueRowGroup(
       type_->column());
   auto& metaData = chunk.meta_data;
 
-  uint64_t chunkReadOffset = metaData.data_page_offset;
-  if (metaData.__isset.dictionary_page_offset &&
-      metaData.dictionary_page_offset >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = metaData.dictionary_page_offset;
+  if (rowRanges_ && maxRepeat_ == 0) {
+    auto it = rowRanges_->find(index);
+    if (it != rowRanges_->end() && enqueuePageRuns(index, it->second, input)) {
+      return;
+    }
   }
-  VELOX_CHECK_GE(chunkReadOffset, 0);
+  offsetIndices_.erase(index);
+
+  const auto readOffset = chunkReadOffset(metaData);
 
   uint64_t readSize = (metaData.codec == thrift::CompressionCodec::UNCOMPRESSED)
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({readOffset, readSize}, &id);
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
   static std::vector<uint64_t> empty;
   VELOX_CHECK_LT(index, streams_.size());
-  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
   auto& metadata = rowGroups_[index].columns[type_->column()].meta_data;
+  auto it = pageRuns_.find(index);
+  if (it != pageRuns_.end()) {
+    reader_ = std::make_unique<PageReader>(
+        std::move(it->second),
+        pool_,
+        type_,
+        metadata.codec,
+        metadata.total_compressed_size);
+    pageRuns_.erase(it);
+    return dwio::common::PositionProvider(empty);
+  }
+  VELOX_CHECK(streams_[index], "Stream not enqueued for column");
   reader_ = std::make_unique<PageReader>(
       std::move(streams_[index]),
       pool_,
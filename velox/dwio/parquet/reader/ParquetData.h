@@ -21,6 +21,8 @@
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -28,14 +30,53 @@
 namespace facebook::velox::parquet {
 class ParquetParams : public dwio::common::FormatParams {
  public:
-  ParquetParams(memory::MemoryPool& pool, const thrift::FileMetaData& metaData)
-      : FormatParams(pool), metaData_(metaData) {}
+  /// 'rowRanges' are the rows to read in row groups where the page index
+  /// excludes some pages. May be nullptr.
+  ParquetParams(
+      memory::MemoryPool& pool,
+      const thrift::FileMetaData& metaData,
+      std::shared_ptr<const RowGroupRowRanges> rowRanges = nullptr)
+      : FormatParams(pool),
+        metaData_(metaData),
+        rowRanges_(std::move(rowRanges)) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const thrift::FileMetaData& metaData_;
+  const std::shared_ptr<const RowGroupRowRanges> rowRanges_;
+};
+
+/// Context for filtering row groups with ParquetData::filterRowGroups(). If
+/// 'input' is set, the Bloom filters of the row groups flagged in
+/// 'useBloomFilter' are read from 'input' and tested against the equality and
+/// IN filters of the columns. The dictionaries of the string column chunks
+/// flagged in 'useDictionary' that are entirely dictionary encoded are read
+/// from 'input' and tested against the filters of the columns.
+struct ParquetStatsContext : public dwio::common::StatsContext {
+  const dwio::common::BufferedInput* FOLLY_NULLABLE input{nullptr};
+  std::vector<bool> useBloomFilter;
+  std::vector<bool> useDictionary;
+};
+
+/// Result of filtering the pages of a column chunk with the page index.
+struct PageFilterResult {
+  /// The offset index of the column chunk. Also used for reading only the
+  /// pages with rows passing the filters.
+  std::shared_ptr<const thrift::OffsetIndex> offsetIndex;
+
+  /// First row of each page followed by the number of rows in the row group.
+  std::vector<int64_t> pageRowBoundaries;
+
+  /// Bit set for each page that has no rows passing the filter of the column.
+  std::vector<uint64_t> filterResult;
+
+  /// Same as 'filterResult' for each metadata filter on the column.
+  std::vector<std::pair<
+      const common::MetadataFilter::LeafNode*,
+      std::vector<uint64_t>>>
+      metadataFilterResults;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -44,10 +85,12 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      std::shared_ptr<const RowGroupRowRanges> rowRanges = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        rowRanges_(std::move(rowRanges)),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -66,6 +109,15 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Filters the pages of 'rowGroup' with the page index read from 'input'
+  /// and the filters in 'scanSpec'. Returns std::nullopt if the column has no
+  /// filters or no page index. The offset index is kept for enqueueing the
+  /// pages of 'rowGroup' that are read.
+  std::optional<PageFilterResult> filterPages(
+      const common::ScanSpec& scanSpec,
+      uint32_t rowGroup,
+      const dwio::common::BufferedInput& input);
+
   PageReader* FOLLY_NONNULL reader() const {
     return reader_.get();
   }
@@ -180,14 +232,52 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // True if 'filter' may have hits for the column of 'this' according to the
+  // Bloom filter in 'rowGroupId'. 'bloomFilter' is the Bloom filter of the
+  // column chunk, read from 'input' on first use.
+  bool bloomFilterMatches(
+      uint32_t rowGroupId,
+      const common::Filter& filter,
+      const dwio::common::BufferedInput& input,
+      std::optional<std::unique_ptr<BlockSplitBloomFilter>>& bloomFilter);
+
+  // True if 'filter' may have hits for the column of 'this' according to the
+  // dictionary of the column chunk in 'rowGroupId'. The dictionary is read
+  // from 'input' into 'dictionary' on first use. Returns true if the chunk
+  // has data pages that are not dictionary encoded.
+  bool dictionaryMatches(
+      uint32_t rowGroupId,
+      const common::Filter& filter,
+      const dwio::common::BufferedInput& input,
+      std::optional<dwio::common::DictionaryValues>& dictionary);
+
+  // Enqueues the runs of pages of 'index'th row group that contain rows in
+  // 'ranges'. Uses the offset index kept by filterPages() or reads it from
+  // 'input'. Returns false if the chunk has no page index, in which case
+  // nothing is enqueued.
+  bool enqueuePageRuns(
+      uint32_t index,
+      const std::vector<RowRange>& ranges,
+      dwio::common::BufferedInput& input);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
+  const std::shared_ptr<const RowGroupRowRanges> rowRanges_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Runs of pages of the row groups that are read partially. Used instead of
+  // 'streams_' for these row groups.
+  folly::F14FastMap<uint32_t, std::vector<PageRun>> pageRuns_;
+
+  // Offset indices read by filterPages(), by row group. Removed when the row
+  // group is enqueued. Small, so entries of skipped row groups are kept.
+  folly::F14FastMap<uint32_t, std::shared_ptr<const thrift::OffsetIndex>>
+      offsetIndices_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
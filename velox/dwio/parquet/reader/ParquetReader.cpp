@@ -17,7 +17,9 @@
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 #include "velox/dwio/common/MetricsLog.h"
+#include "velox/dwio/common/ParallelRowReader.h"
 #include "velox/dwio/common/TypeUtils.h"
+#include "velox/dwio/parquet/reader/Statistics.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
@@ -26,12 +28,66 @@ DEFINE_int32(
     1,
     "Number of next row groups to "
     "prefetch. 1 means prefetch the next row group before decoding "
-    "the current one");
+    "the current one. ReaderOptions::setPrefetchRowGroups() overrides this");
+
+DEFINE_bool(
+    parquet_late_materialization,
+    true,
+    "With filters, load the columns without filters of a row group only if "
+    "rows of the row group are read after the filters are evaluated");
+
+DEFINE_bool(
+    parquet_use_bloom_filter,
+    true,
+    "Use the Bloom filters of Parquet files to skip row groups that cannot "
+    "pass equality and IN filters");
+
+DEFINE_bool(
+    parquet_use_dictionary_filter,
+    true,
+    "Test the filters on string columns against the dictionaries of column "
+    "chunks that are entirely dictionary encoded to skip row groups");
+
+DEFINE_bool(
+    parquet_use_page_index,
+    true,
+    "Use the column and offset indexes of Parquet files to skip pages that "
+    "cannot pass the filters");
 
 namespace facebook::velox::parquet {
 
 using dwio::common::ColumnSelector;
 
+namespace {
+// Parsed footer of a Parquet file, shared between readers through the
+// FileMetadataCache.
+struct CachedFooter : public dwio::common::CachedFileMetadata {
+  // Deserialized Thrift structs take about twice the space of the serialized
+  // footer.
+  static constexpr int32_t kParsedSizeRatio = 2;
+
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData;
+  uint64_t fileLength;
+  uint64_t footerLength;
+
+  uint64_t size() const override {
+    return sizeof(CachedFooter) + footerLength * kParsedSizeRatio;
+  }
+};
+
+// Returns the offset of the first byte of 'rowGroup'.
+uint64_t rowGroupFileOffset(const thrift::RowGroup& rowGroup) {
+  VELOX_CHECK_GT(rowGroup.columns.size(), 0);
+  auto fileOffset = rowGroup.__isset.file_offset
+      ? rowGroup.file_offset
+      : rowGroup.columns[0].meta_data.__isset.dictionary_page_offset
+      ? rowGroup.columns[0].meta_data.dictionary_page_offset
+      : rowGroup.columns[0].meta_data.data_page_offset;
+  VELOX_CHECK_GT(fileOffset, 0);
+  return fileOffset;
+}
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -49,6 +105,11 @@ class ReaderBase {
     return *input_;
   }
 
+  const std::shared_ptr<dwio::common::BufferedInput>& sharedBufferedInput()
+      const {
+    return input_;
+  }
+
   uint64_t fileLength() const {
     return fileLength_;
   }
@@ -74,11 +135,21 @@ class ReaderBase {
   }
 
   /// Ensures that streams are enqueued and loading for the row group at
-  /// 'currentGroup'. May start loading one or more subsequent groups.
+  /// 'currentGroup'. May start loading one or more subsequent groups. See
+  /// StructColumnReader::loadRowGroup() for 'lateMaterialization'. The
+  /// loading inputs are cloned from 'input' and kept in 'inputs', which
+  /// belongs to the calling row reader. 'filterPages' is called with the
+  /// index in 'groups' of each group before it is loaded and returns false
+  /// if the group is to be skipped. It records the rows of the group to
+  /// read, so that only the pages with these rows are loaded.
   void scheduleRowGroups(
       const std::vector<uint32_t>& groups,
       int32_t currentGroup,
-      StructColumnReader& reader);
+      StructColumnReader& reader,
+      bool lateMaterialization,
+      const std::function<bool(int32_t)>& filterPages,
+      const std::shared_ptr<dwio::common::BufferedInput>& input,
+      RowGroupInputs& inputs) const;
 
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row
@@ -88,8 +159,8 @@ class ReaderBase {
       const dwio::common::TypeWithId& type) const;
 
  private:
-  // Reads and parses file footer.
-  void loadFileMetaData();
+  // Reads and parses file footer. Returns the serialized size of the footer.
+  uint32_t loadFileMetaData();
 
   void initializeSchema();
 
@@ -114,15 +185,11 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
   const bool binaryAsString = false;
-
-  // Map from row group index to pre-created loading BufferedInput.
-  std::unordered_map<uint32_t, std::shared_ptr<dwio::common::BufferedInput>>
-      inputs_;
 };
 
 ReaderBase::ReaderBase(
@@ -137,11 +204,29 @@ ReaderBase::ReaderBase(
   VELOX_CHECK_GT(fileLength_, 0, "Parquet file is empty");
   VELOX_CHECK_GE(fileLength_, 12, "Parquet file is too small");
 
-  loadFileMetaData();
+  auto* metadataCache = options.fileMetadataCache();
+  const auto& metadataKey = options.fileMetadataKey();
+  const bool useCache = metadataCache != nullptr && metadataKey.has_value();
+  if (useCache) {
+    auto cached = metadataCache->find<CachedFooter>(metadataKey.value());
+    if (cached != nullptr && cached->fileLength == fileLength_) {
+      fileMetaData_ = cached->fileMetaData;
+    }
+  }
+  if (fileMetaData_ == nullptr) {
+    const auto footerLength = loadFileMetaData();
+    if (useCache) {
+      auto cached = std::make_shared<CachedFooter>();
+      cached->fileMetaData = fileMetaData_;
+      cached->fileLength = fileLength_;
+      cached->footerLength = footerLength;
+      metadataCache->insert(metadataKey.value(), std::move(cached));
+    }
+  }
   initializeSchema();
 }
 
-void ReaderBase::loadFileMetaData() {
+uint32_t ReaderBase::loadFileMetaData() {
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, directorySizeGuess_);
   uint64_t readSize = preloadFile ? fileLength_ : directorySizeGuess_;
@@ -188,8 +273,10 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  return footerLength;
 }
 
 void ReaderBase::initializeSchema() {
@@ -570,28 +657,38 @@ std::shared_ptr<const RowType> ReaderBase::createRowType(
 void ReaderBase::scheduleRowGroups(
     const std::vector<uint32_t>& rowGroupIds,
     int32_t currentGroup,
-    StructColumnReader& reader) {
-  auto thisGroup = rowGroupIds[currentGroup];
-  auto nextGroup =
-      currentGroup + 1 < rowGroupIds.size() ? rowGroupIds[currentGroup + 1] : 0;
-  auto input = inputs_[thisGroup].get();
-  if (!input) {
-    inputs_[thisGroup] = reader.loadRowGroup(thisGroup, input_);
-  }
-  for (auto counter = 0; counter < FLAGS_parquet_prefetch_rowgroups;
-       ++counter) {
-    if (nextGroup) {
-      if (inputs_.count(nextGroup) != 0) {
-        inputs_[nextGroup] = reader.loadRowGroup(thisGroup, input_);
-      }
-    } else {
-      break;
+    StructColumnReader& reader,
+    bool lateMaterialization,
+    const std::function<bool(int32_t)>& filterPages,
+    const std::shared_ptr<dwio::common::BufferedInput>& input,
+    RowGroupInputs& inputs) const {
+  const int32_t numPrefetch = std::max<int32_t>(
+      0,
+      options_.prefetchRowGroups().value_or(FLAGS_parquet_prefetch_rowgroups));
+  // Loads the current group and the next 'numPrefetch' groups that are not
+  // excluded by the page index.
+  int32_t numScheduled = 0;
+  for (auto i = currentGroup;
+       i < rowGroupIds.size() && numScheduled <= numPrefetch;
+       ++i) {
+    if (!filterPages(i)) {
+      continue;
+    }
+    ++numScheduled;
+    const auto group = rowGroupIds[i];
+    if (inputs.count(group) == 0) {
+      inputs[group] = reader.loadRowGroup(group, input, lateMaterialization);
     }
-    nextGroup =
-        nextGroup + 1 < rowGroupIds.size() ? rowGroupIds[nextGroup + 1] : 0;
   }
-  if (currentGroup > 1) {
-    inputs_.erase(rowGroupIds[currentGroup - 1]);
+  // Drops the inputs of the groups before the current one, including
+  // prefetched groups that were skipped after all.
+  const auto thisGroup = rowGroupIds[currentGroup];
+  for (auto it = inputs.begin(); it != inputs.end();) {
+    if (it->first < thisGroup) {
+      it = inputs.erase(it);
+    } else {
+      ++it;
+    }
   }
 }
 
@@ -612,10 +709,12 @@ int64_t ReaderBase::rowGroupUncompressedSize(
 
 ParquetRowReader::ParquetRowReader(
     const std::shared_ptr<ReaderBase>& readerBase,
-    const dwio::common::RowReaderOptions& options)
+    const dwio::common::RowReaderOptions& options,
+    std::shared_ptr<dwio::common::BufferedInput> input)
     : pool_(readerBase->getMemoryPool()),
       readerBase_(readerBase),
       options_(options),
+      input_(input ? std::move(input) : readerBase->sharedBufferedInput()),
       rowGroups_(readerBase_->fileMetaData().row_groups),
       nextRowGroupIdsIdx_(0),
       currentRowGroupPtr_(nullptr),
@@ -637,7 +736,8 @@ ParquetRowReader::ParquetRowReader(
   if (rowGroups_.empty()) {
     return; // TODO
   }
-  ParquetParams params(pool_, readerBase_->fileMetaData());
+  rowRanges_ = std::make_shared<RowGroupRowRanges>();
+  ParquetParams params(pool_, readerBase_->fileMetaData(), rowRanges_);
   auto columnSelector = std::make_shared<ColumnSelector>(
       ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
   columnReader_ = ParquetColumnReader::build(
@@ -646,7 +746,30 @@ ParquetRowReader::ParquetRowReader(
       params,
       *options_.getScanSpec());
 
+  usePageIndex_ = FLAGS_parquet_use_page_index &&
+      (options_.getScanSpec()->hasFilter() || options_.getMetadataFilter());
+  for (auto* child : columnReader_->children()) {
+    // Skipping rows in nested columns would need the repdefs of the skipped
+    // pages.
+    if (!child->fileType().type()->isPrimitiveType()) {
+      usePageIndex_ = false;
+    }
+  }
+
+  if (FLAGS_parquet_late_materialization &&
+      options_.getScanSpec()->hasFilter()) {
+    for (auto* child : columnReader_->children()) {
+      if (!child->scanSpec()->hasFilter()) {
+        lateMaterialization_ = true;
+        break;
+      }
+    }
+  }
+
   filterRowGroups();
+  if (usePageIndex_) {
+    pageFilterResults_.resize(rowGroupIds_.size());
+  }
   if (!rowGroupIds_.empty()) {
     // schedule prefetch of first row group right after reading the metadata.
     // This is usually on a split preload thread before the split goes to table
@@ -655,34 +778,39 @@ ParquetRowReader::ParquetRowReader(
   }
 }
 
-namespace {
-struct ParquetStatsContext : dwio::common::StatsContext {};
-} // namespace
-
 void ParquetRowReader::filterRowGroups() {
   rowGroupIds_.reserve(rowGroups_.size());
   firstRowOfRowGroup_.reserve(rowGroups_.size());
 
+  // Row groups are in the split if their first byte is.
+  std::vector<bool> rowGroupInRange(rowGroups_.size());
+  for (auto i = 0; i < rowGroups_.size(); i++) {
+    auto fileOffset = rowGroupFileOffset(rowGroups_[i]);
+    rowGroupInRange[i] =
+        (fileOffset >= options_.getOffset() &&
+         fileOffset < options_.getLimit());
+  }
+
+  ParquetStatsContext context;
+  if (FLAGS_parquet_use_bloom_filter) {
+    // Bloom filters are only read for the row groups of the split.
+    context.input = input_.get();
+    context.useBloomFilter = rowGroupInRange;
+  }
+  if (FLAGS_parquet_use_dictionary_filter) {
+    context.input = input_.get();
+    context.useDictionary = rowGroupInRange;
+  }
   ParquetData::FilterRowGroupsResult res;
-  columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
+  columnReader_->filterRowGroups(0, context, res);
   if (auto& metadataFilter = options_.getMetadataFilter()) {
     metadataFilter->eval(res.metadataFilterResults, res.filterResult);
   }
 
   uint64_t rowNumber = 0;
   for (auto i = 0; i < rowGroups_.size(); i++) {
-    VELOX_CHECK_GT(rowGroups_[i].columns.size(), 0);
-    auto fileOffset = rowGroups_[i].__isset.file_offset
-        ? rowGroups_[i].file_offset
-        : rowGroups_[i].columns[0].meta_data.__isset.dictionary_page_offset
-        ? rowGroups_[i].columns[0].meta_data.dictionary_page_offset
-        : rowGroups_[i].columns[0].meta_data.data_page_offset;
-    VELOX_CHECK_GT(fileOffset, 0);
-    auto rowGroupInRange =
-        (fileOffset >= options_.getOffset() &&
-         fileOffset < options_.getLimit());
     // A skipped row group is one that is in range and is in the excluded list.
-    if (rowGroupInRange) {
+    if (rowGroupInRange[i]) {
       if (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i)) {
         ++skippedRowGroups_;
       } else {
@@ -694,10 +822,129 @@ void ParquetRowReader::filterRowGroups() {
   }
 }
 
+bool ParquetRowReader::filterPagesOnce(int32_t rowGroupIdsIdx) {
+  if (!usePageIndex_) {
+    return true;
+  }
+  auto& passed = pageFilterResults_[rowGroupIdsIdx];
+  if (!passed.has_value()) {
+    passed = filterPages(rowGroupIds_[rowGroupIdsIdx]);
+  }
+  return passed.value();
+}
+
+bool ParquetRowReader::filterPages(uint32_t rowGroup) {
+  // The page index is used only if all top level columns are primitive.
+  std::vector<PageFilterResult> results;
+  for (auto* child : columnReader_->children()) {
+    auto result = child->formatData().as<ParquetData>().filterPages(
+        *child->scanSpec(), rowGroup, *input_);
+    if (result.has_value()) {
+      results.push_back(std::move(result.value()));
+    }
+  }
+  if (results.empty()) {
+    return true;
+  }
+
+  // Splits the row group at the page boundaries of all filtered columns.
+  // Each part is in a single page of each of these columns.
+  std::vector<int64_t> boundaries;
+  for (const auto& result : results) {
+    boundaries.insert(
+        boundaries.end(),
+        result.pageRowBoundaries.begin(),
+        result.pageRowBoundaries.end());
+  }
+  std::sort(boundaries.begin(), boundaries.end());
+  boundaries.erase(
+      std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+  const int32_t numParts = boundaries.size() - 1;
+  const auto nwords = bits::nwords(numParts);
+
+  ParquetData::FilterRowGroupsResult res;
+  res.totalCount = numParts;
+  res.filterResult.resize(nwords);
+  std::vector<int32_t> pageOfPart(numParts);
+  for (auto& result : results) {
+    int32_t page = 0;
+    for (auto i = 0; i < numParts; ++i) {
+      while (result.pageRowBoundaries[page + 1] <= boundaries[i]) {
+        ++page;
+      }
+      pageOfPart[i] = page;
+    }
+    auto toParts = [&](const std::vector<uint64_t>& pageBits,
+                       std::vector<uint64_t>& partBits) {
+      for (auto i = 0; i < numParts; ++i) {
+        if (bits::isBitSet(pageBits.data(), pageOfPart[i])) {
+          bits::setBit(partBits.data(), i);
+        }
+      }
+    };
+    toParts(result.filterResult, res.filterResult);
+    for (auto& [leaf, pageBits] : result.metadataFilterResults) {
+      std::vector<uint64_t> partBits(nwords);
+      toParts(pageBits, partBits);
+      res.metadataFilterResults.emplace_back(leaf, std::move(partBits));
+    }
+  }
+  if (auto& metadataFilter = options_.getMetadataFilter()) {
+    metadataFilter->eval(res.metadataFilterResults, res.filterResult);
+  }
+
+  std::vector<RowRange> ranges;
+  for (auto i = 0; i < numParts; ++i) {
+    if (bits::isBitSet(res.filterResult.data(), i)) {
+      skippedPageRows_ += boundaries[i + 1] - boundaries[i];
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == boundaries[i]) {
+      ranges.back().end = boundaries[i + 1];
+    } else {
+      ranges.push_back({boundaries[i], boundaries[i + 1]});
+    }
+  }
+  if (ranges.empty()) {
+    return false;
+  }
+  if (ranges.size() > 1 || ranges[0].begin > 0 ||
+      ranges[0].end < rowGroups_[rowGroup].num_rows) {
+    (*rowRanges_)[rowGroup] = std::move(ranges);
+  }
+  return true;
+}
+
+void ParquetRowReader::skipExcludedRows() {
+  if (!currentRowRanges_) {
+    return;
+  }
+  const auto& ranges = *currentRowRanges_;
+  const int64_t row = currentRowInGroup_;
+  while (nextRowRange_ < ranges.size() && ranges[nextRowRange_].end <= row) {
+    ++nextRowRange_;
+  }
+  const uint64_t nextRow = nextRowRange_ < ranges.size()
+      ? std::max(ranges[nextRowRange_].begin, row)
+      : rowsInCurrentRowGroup_;
+  if (nextRow == currentRowInGroup_) {
+    return;
+  }
+  currentRowInGroup_ = nextRow;
+  // The column readers skip to the new position on their next read.
+  columnReader_->setReadOffset(nextRow);
+}
+
 int64_t ParquetRowReader::nextRowNumber() {
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-      !advanceToNextRowGroup()) {
-    return kAtEnd;
+  for (;;) {
+    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+        !advanceToNextRowGroup()) {
+      return kAtEnd;
+    }
+    skipExcludedRows();
+    if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+      break;
+    }
   }
   return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
 }
@@ -707,7 +954,14 @@ int64_t ParquetRowReader::nextReadSize(uint64_t size) {
   if (nextRowNumber() == kAtEnd) {
     return kAtEnd;
   }
-  return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  auto rowsToRead = std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  if (currentRowRanges_) {
+    // Don't allow read to cross into excluded rows.
+    rowsToRead = std::min<uint64_t>(
+        rowsToRead,
+        (*currentRowRanges_)[nextRowRange_].end - currentRowInGroup_);
+  }
+  return rowsToRead;
 }
 
 uint64_t ParquetRowReader::next(
@@ -726,6 +980,15 @@ uint64_t ParquetRowReader::next(
 }
 
 bool ParquetRowReader::advanceToNextRowGroup() {
+  if (nextRowGroupIdsIdx_ > 0) {
+    rowRanges_->erase(rowGroupIds_[nextRowGroupIdsIdx_ - 1]);
+    currentRowRanges_ = nullptr;
+  }
+  while (nextRowGroupIdsIdx_ < rowGroupIds_.size() &&
+         !filterPagesOnce(nextRowGroupIdsIdx_)) {
+    ++skippedRowGroups_;
+    ++nextRowGroupIdsIdx_;
+  }
   if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
     return false;
   }
@@ -734,18 +997,28 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   readerBase_->scheduleRowGroups(
       rowGroupIds_,
       nextRowGroupIdsIdx_,
-      static_cast<StructColumnReader&>(*columnReader_));
+      static_cast<StructColumnReader&>(*columnReader_),
+      lateMaterialization_,
+      [&](int32_t rowGroupIdsIdx) { return filterPagesOnce(rowGroupIdsIdx); },
+      input_,
+      inputs_);
   currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
   rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
   currentRowInGroup_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
+  auto it = rowRanges_->find(nextRowGroupIndex);
+  if (it != rowRanges_->end()) {
+    currentRowRanges_ = &it->second;
+    nextRowRange_ = 0;
+  }
   return true;
 }
 
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
+  stats.skippedPageRows += skippedPageRows_;
 }
 
 void ParquetRowReader::resetFilterCaches() {
@@ -782,8 +1055,75 @@ size_t ParquetReader::numberOfRowGroups() const {
   return readerBase_->fileMetaData().row_groups.size();
 }
 
+std::optional<std::string> ParquetReader::keyValueMetadata(
+    const std::string& key) const {
+  for (const auto& keyValue :
+       readerBase_->fileMetaData().key_value_metadata) {
+    if (keyValue.key == key && keyValue.__isset.value) {
+      return keyValue.value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::vector<dwio::common::RowGroupStatistics>>
+ParquetReader::rowGroupStatistics(uint64_t offset, uint64_t length) const {
+  dwio::common::RowReaderOptions range;
+  range.range(offset, length);
+  const auto& schema = readerBase_->schemaWithId();
+  std::vector<dwio::common::RowGroupStatistics> result;
+  for (const auto& rowGroup : readerBase_->fileMetaData().row_groups) {
+    const auto fileOffset = rowGroupFileOffset(rowGroup);
+    if (fileOffset < range.getOffset() || fileOffset >= range.getLimit()) {
+      continue;
+    }
+    dwio::common::RowGroupStatistics stats;
+    stats.offset = fileOffset;
+    stats.length = rowGroup.__isset.total_compressed_size
+        ? rowGroup.total_compressed_size
+        : rowGroup.total_byte_size;
+    stats.numRows = rowGroup.num_rows;
+    for (auto i = 0; i < schema->size(); ++i) {
+      const auto& child = schema->childAt(i);
+      if (child->column() == ParquetTypeWithId::kNonLeaf ||
+          !rowGroup.columns[child->column()].meta_data.__isset.statistics) {
+        stats.columns.push_back(nullptr);
+        continue;
+      }
+      stats.columns.push_back(buildColumnStatisticsFromThrift(
+          rowGroup.columns[child->column()].meta_data.statistics,
+          *child->type(),
+          rowGroup.num_rows));
+    }
+    result.push_back(std::move(stats));
+  }
+  return result;
+}
+
 std::unique_ptr<dwio::common::RowReader> ParquetReader::createRowReader(
     const dwio::common::RowReaderOptions& options) const {
+  if (options.useParallelDecoding()) {
+    std::vector<uint64_t> rowGroupOffsets;
+    for (const auto& rowGroup : readerBase_->fileMetaData().row_groups) {
+      rowGroupOffsets.push_back(rowGroupFileOffset(rowGroup));
+    }
+    auto units = dwio::common::ParallelRowReader::unitsInRange(
+        rowGroupOffsets, options);
+    if (units.size() > 1) {
+      return std::make_unique<dwio::common::ParallelRowReader>(
+          std::move(units),
+          options,
+          [readerBase = readerBase_](
+              const dwio::common::RowReaderOptions& unitOptions) {
+            // Each row group gets its own input so that the row groups are
+            // loaded independently of each other.
+            return std::make_unique<ParquetRowReader>(
+                readerBase,
+                unitOptions,
+                readerBase->bufferedInput().clone());
+          });
+    }
+  }
   return std::make_unique<ParquetRowReader>(readerBase_, options);
 }
 } // namespace facebook::velox::parquet
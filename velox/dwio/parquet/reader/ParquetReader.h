@@ -20,6 +20,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -31,12 +32,19 @@ class StructColumnReader;
 
 class ReaderBase;
 
+/// Map from row group index to pre-created loading BufferedInput.
+using RowGroupInputs =
+    std::unordered_map<uint32_t, std::shared_ptr<dwio::common::BufferedInput>>;
+
 /// Implements the RowReader interface for Parquet.
 class ParquetRowReader : public dwio::common::RowReader {
  public:
+  /// Reads through 'input' if given, else through the input of
+  /// 'readerBase'.
   ParquetRowReader(
       const std::shared_ptr<ReaderBase>& readerBase,
-      const dwio::common::RowReaderOptions& options);
+      const dwio::common::RowReaderOptions& options,
+      std::shared_ptr<dwio::common::BufferedInput> input = nullptr);
   ~ParquetRowReader() override = default;
 
   int64_t nextRowNumber() override;
@@ -73,9 +81,25 @@ class ParquetRowReader : public dwio::common::RowReader {
   // by filterRowGroups().
   bool advanceToNextRowGroup();
 
+  // Compares the page index of 'rowGroup' to the filters and records the rows
+  // to read in 'rowRanges_'. Returns false if no rows can pass the filters.
+  bool filterPages(uint32_t rowGroup);
+
+  // Calls filterPages() for the group at 'rowGroupIdsIdx' in 'rowGroupIds_'
+  // the first time and returns the remembered result after that. Both
+  // prefetch and advancing to the group need the result.
+  bool filterPagesOnce(int32_t rowGroupIdsIdx);
+
+  // Moves 'currentRowInGroup_' past the rows excluded by the page index.
+  void skipExcludedRows();
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
+  const std::shared_ptr<dwio::common::BufferedInput> input_;
+
+  // Inputs of the row groups that are being read or prefetched.
+  RowGroupInputs inputs_;
 
   // All row groups from file metadata.
   const std::vector<thrift::RowGroup>& rowGroups_;
@@ -91,6 +115,32 @@ class ParquetRowReader : public dwio::common::RowReader {
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
+  // True if the page index is used to skip pages. Set if there are filters
+  // and all the top level columns are primitive.
+  bool usePageIndex_{false};
+
+  // True if the columns without filters are loaded only when read. Set if
+  // there are both columns with and without filters.
+  bool lateMaterialization_{false};
+
+  // Rows to read in row groups where the page index excludes pages. Shared
+  // with the ParquetData of each column.
+  std::shared_ptr<RowGroupRowRanges> rowRanges_;
+
+  // Result of filterPages() for each group in 'rowGroupIds_', unset until
+  // computed. Empty if the page index is not used.
+  std::vector<std::optional<bool>> pageFilterResults_;
+
+  // Rows to read in the current row group, nullptr if all are read.
+  const std::vector<RowRange>* FOLLY_NULLABLE currentRowRanges_{nullptr};
+
+  // Index of the first range in 'currentRowRanges_' that ends after
+  // 'currentRowInGroup_'.
+  size_t nextRowRange_{0};
+
+  // Number of rows skipped based on the page index.
+  int64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -112,6 +162,9 @@ class ParquetReader : public dwio::common::Reader {
     return nullptr;
   }
 
+  std::optional<std::vector<dwio::common::RowGroupStatistics>>
+  rowGroupStatistics(uint64_t offset, uint64_t length) const override;
+
   const velox::RowTypePtr& rowType() const override;
 
   const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
@@ -119,6 +172,10 @@ class ParquetReader : public dwio::common::Reader {
 
   size_t numberOfRowGroups() const;
 
+  /// Returns the value of 'key' in the key-value metadata of the file, or
+  /// std::nullopt if the file has no value for 'key'.
+  std::optional<std::string> keyValueMetadata(const std::string& key) const;
+
   std::unique_ptr<dwio::common::RowReader> createRowReader(
       const dwio::common::RowReaderOptions& options = {}) const override;
 
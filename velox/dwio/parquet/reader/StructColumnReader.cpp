@@ -17,8 +17,117 @@
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
+#include <mutex>
+
 namespace facebook::velox::parquet {
 
+namespace {
+class DeferredLoadInput;
+
+// Stream that loads its DeferredLoadInput before the first access to the
+// data.
+class LoadOnReadInputStream : public dwio::common::SeekableInputStream {
+ public:
+  LoadOnReadInputStream(
+      std::unique_ptr<dwio::common::SeekableInputStream> stream,
+      std::shared_ptr<DeferredLoadInput> input)
+      : stream_(std::move(stream)), input_(std::move(input)) {}
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override {
+    stream_->BackUp(count);
+  }
+
+  bool Skip(int32_t count) override;
+
+  google::protobuf::int64 ByteCount() const override {
+    return stream_->ByteCount();
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override {
+    return stream_->getName();
+  }
+
+  size_t positionSize() override {
+    return stream_->positionSize();
+  }
+
+ private:
+  std::unique_ptr<dwio::common::SeekableInputStream> stream_;
+  const std::shared_ptr<DeferredLoadInput> input_;
+};
+
+// Enqueues regions in another BufferedInput and loads it the first time one
+// of the enqueued streams is read.
+class DeferredLoadInput
+    : public dwio::common::BufferedInput,
+      public std::enable_shared_from_this<DeferredLoadInput> {
+ public:
+  DeferredLoadInput(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      memory::MemoryPool& pool)
+      : BufferedInput(input->getInputStream(), pool),
+        deferred_(std::move(input)) {}
+
+  std::unique_ptr<dwio::common::SeekableInputStream> enqueue(
+      common::Region region,
+      const dwio::common::StreamIdentifier* si) override {
+    return std::make_unique<LoadOnReadInputStream>(
+        deferred_->enqueue(region, si), shared_from_this());
+  }
+
+  // May be called concurrently by the streams of columns decoded on
+  // different threads. The callers that lose the race wait for the load.
+  void load(const dwio::common::LogType logType) override {
+    std::call_once(loaded_, [&]() { deferred_->load(logType); });
+  }
+
+  bool isBuffered(uint64_t offset, uint64_t length) const override {
+    return deferred_->isBuffered(offset, length);
+  }
+
+  std::unique_ptr<dwio::common::SeekableInputStream> read(
+      uint64_t offset,
+      uint64_t length,
+      dwio::common::LogType logType) const override {
+    return deferred_->read(offset, length, logType);
+  }
+
+  // A clone of 'deferred_' would load eagerly and a DeferredLoadInput must
+  // be owned by a shared_ptr for enqueue().
+  std::unique_ptr<dwio::common::BufferedInput> clone() const override {
+    VELOX_UNSUPPORTED("DeferredLoadInput cannot be cloned");
+  }
+
+  folly::Executor* executor() const override {
+    return deferred_->executor();
+  }
+
+ private:
+  const std::unique_ptr<dwio::common::BufferedInput> deferred_;
+  std::once_flag loaded_;
+};
+
+bool LoadOnReadInputStream::Next(const void** data, int32_t* size) {
+  input_->load(dwio::common::LogType::STRIPE);
+  return stream_->Next(data, size);
+}
+
+bool LoadOnReadInputStream::Skip(int32_t count) {
+  input_->load(dwio::common::LogType::STRIPE);
+  return stream_->Skip(count);
+}
+
+void LoadOnReadInputStream::seekToPosition(
+    dwio::common::PositionProvider& position) {
+  input_->load(dwio::common::LogType::STRIPE);
+  stream_->seekToPosition(position);
+}
+} // namespace
+
 StructColumnReader::StructColumnReader(
     const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
     const std::shared_ptr<const dwio::common::TypeWithId>& dataType,
@@ -98,13 +207,25 @@ void StructColumnReader::read(
 
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
-    const std::shared_ptr<dwio::common::BufferedInput>& input) {
+    const std::shared_ptr<dwio::common::BufferedInput>& input,
+    bool lateMaterialization) {
   if (isRowGroupBuffered(index, *input)) {
     enqueueRowGroup(index, *input);
     return input;
   }
   auto newInput = input->clone();
-  enqueueRowGroup(index, *newInput);
+  if (lateMaterialization) {
+    auto deferredInput =
+        std::make_shared<DeferredLoadInput>(input->clone(), memoryPool_);
+    for (auto* child : children_) {
+      enqueueChild(
+          *child,
+          index,
+          child->scanSpec()->hasFilter() ? *newInput : *deferredInput);
+    }
+  } else {
+    enqueueRowGroup(index, *newInput);
+  }
   newInput->load(dwio::common::LogType::STRIPE);
   return newInput;
 }
@@ -120,16 +241,24 @@ bool StructColumnReader::isRowGroupBuffered(
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
-  for (auto& child : children_) {
-    if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
-      structChild->enqueueRowGroup(index, input);
-    } else if (auto listChild = dynamic_cast<ListColumnReader*>(child)) {
-      listChild->enqueueRowGroup(index, input);
-    } else if (auto mapChild = dynamic_cast<MapColumnReader*>(child)) {
-      mapChild->enqueueRowGroup(index, input);
-    } else {
-      child->formatData().as<ParquetData>().enqueueRowGroup(index, input);
-    }
+  for (auto* child : children_) {
+    enqueueChild(*child, index, input);
+  }
+}
+
+// static
+void StructColumnReader::enqueueChild(
+    dwio::common::SelectiveColumnReader& child,
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  if (auto structChild = dynamic_cast<StructColumnReader*>(&child)) {
+    structChild->enqueueRowGroup(index, input);
+  } else if (auto listChild = dynamic_cast<ListColumnReader*>(&child)) {
+    listChild->enqueueRowGroup(index, input);
+  } else if (auto mapChild = dynamic_cast<MapColumnReader*>(&child)) {
+    mapChild->enqueueRowGroup(index, input);
+  } else {
+    child.formatData().as<ParquetData>().enqueueRowGroup(index, input);
   }
 }
 
@@ -36,10 +36,14 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
-  /// the streams in a new input and loads.
+  /// the streams in a new input and loads. If 'lateMaterialization' is true,
+  /// only the children with filters are loaded. The data of the other
+  /// children is loaded when first read, so that it is not read if no row of
+  /// the row group passes the filters.
   std::shared_ptr<dwio::common::BufferedInput> loadRowGroup(
       uint32_t index,
-      const std::shared_ptr<dwio::common::BufferedInput>& input);
+      const std::shared_ptr<dwio::common::BufferedInput>& input,
+      bool lateMaterialization = false);
 
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
@@ -72,6 +76,11 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
+  static void enqueueChild(
+      dwio::common::SelectiveColumnReader& child,
+      uint32_t index,
+      dwio::common::BufferedInput& input);
+
   bool isRowGroupBuffered(uint32_t index, dwio::common::BufferedInput& input);
 
   // Leaf column reader used for getting nullability information for
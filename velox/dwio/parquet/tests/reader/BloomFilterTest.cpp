@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+
+#include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+std::string serializeHeader(int32_t numBytes) {
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(numBytes);
+  thrift::BloomFilterAlgorithm algorithm;
+  algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.__set_algorithm(algorithm);
+  thrift::BloomFilterHash hash;
+  hash.__set_XXHASH(thrift::XxHash());
+  header.__set_hash(hash);
+  thrift::BloomFilterCompression compression;
+  compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+  header.__set_compression(compression);
+
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  header.write(&protocol);
+  return buffer->getBufferAsString();
+}
+
+} // namespace
+
+TEST(BloomFilterTest, hash) {
+  // xxHash64 with seed 0 of the empty string.
+  EXPECT_EQ(
+      0xef46db3751d8e999ULL, BlockSplitBloomFilter::hash(std::string_view()));
+  // Integers are hashed as their little endian bytes.
+  int32_t value = 123;
+  EXPECT_EQ(
+      BlockSplitBloomFilter::hash(std::string_view(
+          reinterpret_cast<const char*>(&value), sizeof(value))),
+      BlockSplitBloomFilter::hash(value));
+}
+
+TEST(BloomFilterTest, insertAndFind) {
+  BlockSplitBloomFilter bloomFilter(1024);
+  for (int64_t i = 0; i < 200; i += 2) {
+    bloomFilter.insertHash(BlockSplitBloomFilter::hash(i));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 200; ++i) {
+    auto found = bloomFilter.findHash(BlockSplitBloomFilter::hash(i));
+    if (i % 2 == 0) {
+      EXPECT_TRUE(found) << i;
+    } else if (found) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 10);
+
+  VELOX_ASSERT_THROW(BlockSplitBloomFilter(0), "Bad Bloom filter size");
+  VELOX_ASSERT_THROW(BlockSplitBloomFilter(100), "Bad Bloom filter size");
+}
+
+TEST(BloomFilterTest, filters) {
+  BlockSplitBloomFilter bloomFilter(1024);
+  for (int32_t value : {10, 20, 30}) {
+    bloomFilter.insertHash(BlockSplitBloomFilter::hash(value));
+  }
+  const auto int32Type = thrift::Type::INT32;
+  EXPECT_TRUE(
+      canUseBloomFilter(BigintRange(10, 10, false), *INTEGER(), int32Type));
+  EXPECT_FALSE(
+      canUseBloomFilter(BigintRange(10, 10, true), *INTEGER(), int32Type));
+  EXPECT_FALSE(
+      canUseBloomFilter(BigintRange(10, 11, false), *INTEGER(), int32Type));
+  EXPECT_FALSE(
+      canUseBloomFilter(BigintRange(10, 10, false), *SMALLINT(), int32Type));
+  EXPECT_FALSE(canUseBloomFilter(
+      BigintRange(10, 10, false), *VARCHAR(), thrift::Type::BYTE_ARRAY));
+
+  EXPECT_TRUE(
+      testBloomFilter(BigintRange(20, 20, false), bloomFilter, int32Type));
+  EXPECT_FALSE(
+      testBloomFilter(BigintRange(21, 21, false), bloomFilter, int32Type));
+  // Not in the INT32 range.
+  EXPECT_FALSE(testBloomFilter(
+      BigintRange(1LL << 40, 1LL << 40, false), bloomFilter, int32Type));
+  // Hashed as INT64.
+  EXPECT_FALSE(testBloomFilter(
+      BigintRange(20, 20, false), bloomFilter, thrift::Type::INT64));
+
+  auto hashTable =
+      createBigintValues({1, 1'000, 100'000, 30, 10'000'000}, false);
+  ASSERT_EQ(FilterKind::kBigintValuesUsingHashTable, hashTable->kind());
+  EXPECT_TRUE(testBloomFilter(*hashTable, bloomFilter, int32Type));
+  auto bitmask = createBigintValues({1, 2, 5, 9}, false);
+  ASSERT_EQ(FilterKind::kBigintValuesUsingBitmask, bitmask->kind());
+  EXPECT_FALSE(testBloomFilter(*bitmask, bloomFilter, int32Type));
+
+  BlockSplitBloomFilter stringBloomFilter(1024);
+  stringBloomFilter.insertHash(BlockSplitBloomFilter::hash("apple"));
+  const auto byteArrayType = thrift::Type::BYTE_ARRAY;
+  BytesValues values({"pear", "apple"}, false);
+  ASSERT_TRUE(canUseBloomFilter(values, *VARCHAR(), byteArrayType));
+  EXPECT_TRUE(testBloomFilter(values, stringBloomFilter, byteArrayType));
+  EXPECT_FALSE(testBloomFilter(
+      BytesValues({"pear", "plum"}, false), stringBloomFilter, byteArrayType));
+  BytesRange range("apple", false, false, "apple", false, false, false);
+  ASSERT_TRUE(canUseBloomFilter(range, *VARCHAR(), byteArrayType));
+  EXPECT_TRUE(testBloomFilter(range, stringBloomFilter, byteArrayType));
+}
+
+TEST(BloomFilterTest, readFromFile) {
+  BlockSplitBloomFilter bloomFilter(256);
+  bloomFilter.insertHash(BlockSplitBloomFilter::hash(int64_t{7}));
+  std::string file(100, 'x');
+  file += serializeHeader(bloomFilter.numBytes());
+  file.append(bloomFilter.data(), bloomFilter.numBytes());
+
+  auto pool = memory::addDefaultLeafMemoryPool();
+  dwio::common::BufferedInput input(
+      std::make_shared<InMemoryReadFile>(file), *pool);
+  thrift::ColumnMetaData metaData;
+  EXPECT_EQ(nullptr, readBloomFilter(input, metaData));
+
+  metaData.__set_bloom_filter_offset(100);
+  auto result = readBloomFilter(input, metaData);
+  ASSERT_NE(nullptr, result);
+  EXPECT_EQ(256, result->numBytes());
+  EXPECT_TRUE(result->findHash(BlockSplitBloomFilter::hash(int64_t{7})));
+  EXPECT_EQ(
+      std::string(bloomFilter.data(), 256), std::string(result->data(), 256));
+
+  metaData.__set_bloom_filter_offset(file.size());
+  VELOX_ASSERT_THROW(
+      readBloomFilter(input, metaData), "Bad Bloom filter offset");
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace facebook::velox::parquet;
+
+namespace {
+
+// Encodes 'values' of 'width' bytes by writing byte k of each value to
+// stream k.
+std::string encode(const std::string& values, int32_t width) {
+  const auto numValues = values.size() / width;
+  std::string encoded(values.size(), 0);
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto stream = 0; stream < width; ++stream) {
+      encoded[stream * numValues + i] = values[i * width + stream];
+    }
+  }
+  return encoded;
+}
+
+} // namespace
+
+TEST(ByteStreamSplitDecoderTest, widths) {
+  std::mt19937 rng(1);
+  // Sizes around the 16 value SIMD batch.
+  for (auto width : {2, 4, 8, 16}) {
+    for (auto numValues : {0, 1, 15, 16, 17, 31, 32, 1000}) {
+      std::string values(numValues * width, 0);
+      for (auto& byte : values) {
+        byte = static_cast<char>(rng());
+      }
+      auto encoded = encode(values, width);
+      std::string result(values.size(), 0);
+      decodeByteStreamSplit(encoded.data(), numValues, width, result.data());
+      EXPECT_EQ(values, result) << width << " " << numValues;
+    }
+  }
+}
+
+TEST(ByteStreamSplitDecoderTest, doubles) {
+  std::vector<double> values;
+  for (auto i = 0; i < 100; ++i) {
+    values.push_back(i * 1.5 - 20);
+  }
+  std::string plain(
+      reinterpret_cast<const char*>(values.data()),
+      values.size() * sizeof(double));
+  auto encoded = encode(plain, sizeof(double));
+  std::vector<double> result(values.size());
+  decodeByteStreamSplit(
+      encoded.data(),
+      values.size(),
+      sizeof(double),
+      reinterpret_cast<char*>(result.data()));
+  EXPECT_EQ(values, result);
+}
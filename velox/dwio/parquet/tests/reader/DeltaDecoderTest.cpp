@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+void writeVarint(uint64_t value, std::string& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+uint64_t zigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+      static_cast<uint64_t>(value >> 63);
+}
+
+// Encodes 'values' as DELTA_BINARY_PACKED following the Parquet spec.
+std::string encodeDeltaBinaryPacked(
+    const std::vector<int64_t>& values,
+    int32_t blockSize = 128,
+    int32_t numMiniblocks = 4) {
+  std::string out;
+  writeVarint(blockSize, out);
+  writeVarint(numMiniblocks, out);
+  writeVarint(values.size(), out);
+  writeVarint(zigZag(values.empty() ? 0 : values[0]), out);
+  const int32_t miniblockSize = blockSize / numMiniblocks;
+  for (size_t start = 1; start < values.size(); start += blockSize) {
+    const auto end = std::min<size_t>(values.size(), start + blockSize);
+    std::vector<uint64_t> deltas;
+    int64_t minDelta = std::numeric_limits<int64_t>::max();
+    for (auto i = start; i < end; ++i) {
+      deltas.push_back(
+          static_cast<uint64_t>(values[i]) -
+          static_cast<uint64_t>(values[i - 1]));
+      minDelta = std::min(minDelta, static_cast<int64_t>(deltas.back()));
+    }
+    writeVarint(zigZag(minDelta), out);
+    for (auto& delta : deltas) {
+      delta -= static_cast<uint64_t>(minDelta);
+    }
+    const int32_t numUsed = bits::divRoundUp(deltas.size(), miniblockSize);
+    deltas.resize(numUsed * miniblockSize, 0);
+    std::vector<uint8_t> widths(numMiniblocks, 0);
+    for (auto i = 0; i < numUsed; ++i) {
+      for (auto j = 0; j < miniblockSize; ++j) {
+        auto delta = deltas[i * miniblockSize + j];
+        widths[i] = std::max<uint8_t>(
+            widths[i], delta == 0 ? 0 : 64 - __builtin_clzll(delta));
+      }
+    }
+    out.append(reinterpret_cast<const char*>(widths.data()), widths.size());
+    for (auto i = 0; i < numUsed; ++i) {
+      std::string packed(miniblockSize * widths[i] / 8, 0);
+      for (auto j = 0; j < miniblockSize; ++j) {
+        auto delta = deltas[i * miniblockSize + j];
+        for (auto bit = 0; bit < widths[i]; ++bit) {
+          if (delta >> bit & 1) {
+            auto position = j * widths[i] + bit;
+            packed[position / 8] |= 1 << (position % 8);
+          }
+        }
+      }
+      out += packed;
+    }
+  }
+  return out;
+}
+
+std::string encodeDeltaLengthByteArray(const std::vector<std::string>& values) {
+  std::vector<int64_t> lengths;
+  std::string data;
+  for (auto& value : values) {
+    lengths.push_back(value.size());
+    data += value;
+  }
+  return encodeDeltaBinaryPacked(lengths) + data;
+}
+
+std::string encodeDeltaByteArray(const std::vector<std::string>& values) {
+  std::vector<int64_t> prefixLengths;
+  std::vector<std::string> suffixes;
+  std::string previous;
+  for (auto& value : values) {
+    size_t prefix = 0;
+    while (prefix < previous.size() && prefix < value.size() &&
+           previous[prefix] == value[prefix]) {
+      ++prefix;
+    }
+    prefixLengths.push_back(prefix);
+    suffixes.push_back(value.substr(prefix));
+    previous = value;
+  }
+  return encodeDeltaBinaryPacked(prefixLengths) +
+      encodeDeltaLengthByteArray(suffixes);
+}
+
+void checkDecode(const std::vector<int64_t>& values) {
+  // Trailing bytes are not part of the encoding.
+  auto encoded = encodeDeltaBinaryPacked(values) + "end";
+  DeltaBpDecoder decoder(encoded.data(), encoded.data() + encoded.size());
+  ASSERT_EQ(values.size(), decoder.totalValues());
+  for (auto i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(values[i], decoder.readLong()) << i;
+  }
+  EXPECT_EQ("end", std::string(decoder.bufferStart(), 3));
+}
+
+} // namespace
+
+TEST(DeltaBpDecoderTest, bitWidths) {
+  std::mt19937_64 rng(1);
+  checkDecode({});
+  checkDecode({-5});
+  // Constant, 0 bit deltas.
+  checkDecode(std::vector<int64_t>(300, 11));
+  // Increasing with small deltas and a partial last miniblock.
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1000; ++i) {
+    values.push_back(i * 3 + rng() % 7);
+  }
+  checkDecode(values);
+  // Every width from 1 to 64 bits.
+  for (auto width = 1; width <= 64; ++width) {
+    values.clear();
+    int64_t value = 0;
+    for (auto i = 0; i < 129; ++i) {
+      value += (width == 64 ? rng() : rng() & bits::lowMask(width));
+      values.push_back(value);
+    }
+    checkDecode(values);
+  }
+  // Overflowing deltas.
+  checkDecode(
+      {std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       0,
+       std::numeric_limits<int64_t>::max(),
+       -1});
+}
+
+TEST(DeltaBpDecoderTest, skipAndNext) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1000; ++i) {
+    values.push_back(i % 2 == 0 ? i * 1000 : -i);
+  }
+  auto encoded = encodeDeltaBinaryPacked(values, 256, 8);
+  DeltaBpDecoder decoder(encoded.data(), encoded.data() + encoded.size());
+  decoder.skip(10);
+  EXPECT_EQ(values[10], decoder.readLong());
+  decoder.skip(300);
+  std::vector<int32_t> result(100);
+  decoder.next(result.data(), result.size());
+  for (auto i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(static_cast<int32_t>(values[311 + i]), result[i]);
+  }
+  decoder.skip(588);
+  EXPECT_EQ(values[999], decoder.readLong());
+  EXPECT_THROW(decoder.readLong(), VeloxException);
+}
+
+TEST(DeltaBpDecoderTest, invalidHeader) {
+  std::string encoded;
+  // Block size not a multiple of 128.
+  writeVarint(100, encoded);
+  writeVarint(4, encoded);
+  writeVarint(1, encoded);
+  writeVarint(0, encoded);
+  EXPECT_THROW(
+      DeltaBpDecoder(encoded.data(), encoded.data() + encoded.size()),
+      VeloxException);
+}
+
+TEST(DeltaByteArrayDecoderTest, deltaLengthByteArray) {
+  std::vector<std::string> values = {"", "a", "abc", "", std::string(300, 'x')};
+  for (auto i = 0; i < 200; ++i) {
+    values.push_back(std::to_string(i * 7919));
+  }
+  auto encoded = encodeDeltaLengthByteArray(values);
+  DeltaLengthByteArrayDecoder decoder(
+      encoded.data(), encoded.data() + encoded.size());
+  for (auto i = 0; i < 5; ++i) {
+    EXPECT_EQ(values[i], decoder.readString());
+  }
+  decoder.skip(100);
+  for (auto i = 105; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], decoder.readString());
+  }
+}
+
+TEST(DeltaByteArrayDecoderTest, deltaByteArray) {
+  std::vector<std::string> values = {"apple", "application", "apply", "b", ""};
+  for (auto i = 0; i < 300; ++i) {
+    values.push_back(fmt::format("prefix_{:05}", i * 31));
+  }
+  auto encoded = encodeDeltaByteArray(values);
+  DeltaByteArrayDecoder decoder(
+      encoded.data(), encoded.data() + encoded.size());
+  for (auto i = 0; i < 5; ++i) {
+    EXPECT_EQ(values[i], decoder.readString());
+  }
+  // Skipped values are the prefixes of later ones.
+  decoder.skip(150);
+  for (auto i = 155; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], decoder.readString());
+  }
+}
@@ -14,11 +14,21 @@
  * limitations under the License.
  */
 
+#include "velox/common/hyperloglog/HllUtils.h"
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/vector/DecodedVector.h"
 
 #include <folly/init/Init.h>
+#include <folly/lang/Bits.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
@@ -27,6 +37,11 @@ using namespace facebook::velox::parquet;
 
 using dwio::common::MemorySink;
 
+DECLARE_bool(parquet_late_materialization);
+DECLARE_bool(parquet_use_bloom_filter);
+DECLARE_bool(parquet_use_dictionary_filter);
+DECLARE_bool(parquet_use_page_index);
+
 class E2EFilterTest : public E2EFilterTestBase {
  protected:
   void SetUp() override {
@@ -128,6 +143,436 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  options_.enableDictionary = false;
+  options_.encoding = ValueEncoding::kDeltaBinaryPacked;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, integerPageIndex) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val", "long_null"},
+      20);
+}
+
+TEST_F(E2EFilterTest, pageIndexSkipsPages) {
+  constexpr int32_t kSize = 20'000;
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 1024;
+  rowsInRowGroup_ = kSize;
+
+  rowType_ = ROW({"id", "value"}, {BIGINT(), DOUBLE()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kSize, leafPool_.get());
+  auto values = BaseVector::create<FlatVector<double>>(
+      DOUBLE(), kSize, leafPool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    ids->set(i, i);
+    values->set(i, i * 0.5);
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kSize,
+      std::vector<VectorPtr>{ids, values})};
+  writeToMemory(rowType_, batches, false);
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  spec->childByName("id")->setFilter(
+      std::make_unique<BigintRange>(5'000, 5'099, false));
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  dwio::common::RowReaderOptions rowReaderOpts;
+  std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+  int64_t expected = 5'000;
+  while (rowReader->next(1'000, result) > 0) {
+    auto* rows = result->as<RowVector>();
+    auto* resultIds =
+        rows->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+    auto* resultValues =
+        rows->childAt(1)->loadedVector()->as<SimpleVector<double>>();
+    for (auto i = 0; i < rows->size(); ++i) {
+      ASSERT_EQ(expected, resultIds->valueAt(i));
+      ASSERT_EQ(expected * 0.5, resultValues->valueAt(i));
+      ++expected;
+    }
+  }
+  EXPECT_EQ(5'100, expected);
+
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(0, stats.skippedStrides);
+  EXPECT_GT(stats.skippedPageRows, kSize / 2);
+}
+
+TEST_F(E2EFilterTest, pageIndexWithPrefetch) {
+  constexpr int32_t kSize = 20'000;
+  constexpr int32_t kRowsInRowGroup = 5'000;
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 1024;
+  rowsInRowGroup_ = kRowsInRowGroup;
+
+  // All row groups have the same range of ids so that their stats pass the
+  // filter and only the page index skips rows.
+  rowType_ = ROW({"id", "value"}, {BIGINT(), DOUBLE()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kSize, leafPool_.get());
+  auto values = BaseVector::create<FlatVector<double>>(
+      DOUBLE(), kSize, leafPool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    ids->set(i, i % kRowsInRowGroup);
+    values->set(i, i * 0.5);
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kSize,
+      std::vector<VectorPtr>{ids, values})};
+  writeToMemory(rowType_, batches, false);
+
+  // Reads the rows with ids in [1000, 1099] and returns the number of bytes
+  // read from the file.
+  auto read = [&](bool usePageIndex) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_parquet_use_page_index = usePageIndex;
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("id")->setFilter(
+        std::make_unique<BigintRange>(1'000, 1'099, false));
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    readerOpts.setDirectorySizeGuess(1024);
+    readerOpts.setFilePreloadThreshold(1024);
+    // The groups after the first are loaded by prefetch.
+    readerOpts.setPrefetchRowGroups(3);
+    dwio::common::RowReaderOptions rowReaderOpts;
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    IoStatistics ioStats;
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data),
+        *leafPool_,
+        MetricsLog::voidLog(),
+        &ioStats);
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    int32_t numRows = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      auto* rows = result->as<RowVector>();
+      auto* resultValues =
+          rows->childAt(1)->loadedVector()->as<SimpleVector<double>>();
+      for (auto i = 0; i < rows->size(); ++i) {
+        const auto row =
+            (numRows / 100) * kRowsInRowGroup + 1'000 + numRows % 100;
+        ASSERT_EQ(row * 0.5, resultValues->valueAt(i));
+        ++numRows;
+      }
+    }
+    EXPECT_EQ(4 * 100, numRows);
+    return ioStats.rawBytesRead();
+  };
+
+  EXPECT_LT(read(true) * 4, read(false));
+}
+
+TEST_F(E2EFilterTest, lateMaterialization) {
+  constexpr int32_t kSize = 20'000;
+  constexpr int32_t kRowsInRowGroup = 5'000;
+  options_.enableDictionary = false;
+  rowsInRowGroup_ = kRowsInRowGroup;
+
+  // All row groups have the same range of ids so that their stats pass any
+  // filter in the range.
+  rowType_ = ROW({"id", "payload"}, {BIGINT(), VARCHAR()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kSize, leafPool_.get());
+  auto payloads = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kSize, leafPool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    ids->set(i, (i % kRowsInRowGroup) * 2);
+    payloads->set(i, StringView(fmt::format("{:0100}", i)));
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kSize,
+      std::vector<VectorPtr>{ids, payloads})};
+  writeToMemory(rowType_, batches, false);
+
+  // Reads the rows with 'id' and returns the number of bytes read from the
+  // file.
+  auto read = [&](int64_t id, bool lateMaterialization) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_parquet_late_materialization = lateMaterialization;
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("id")->setFilter(
+        std::make_unique<BigintRange>(id, id, false));
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    // Reads only the footer up front so that the row groups are not
+    // buffered with it.
+    readerOpts.setDirectorySizeGuess(1024);
+    readerOpts.setFilePreloadThreshold(1024);
+    readerOpts.setPrefetchRowGroups(2);
+    dwio::common::RowReaderOptions rowReaderOpts;
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    IoStatistics ioStats;
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data),
+        *leafPool_,
+        MetricsLog::voidLog(),
+        &ioStats);
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    int32_t numRows = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      auto* rows = result->as<RowVector>();
+      auto* resultPayloads =
+          rows->childAt(1)->loadedVector()->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < rows->size(); ++i) {
+        const auto row = numRows * kRowsInRowGroup + id / 2;
+        EXPECT_EQ(
+            fmt::format("{:0100}", row), resultPayloads->valueAt(i).str());
+        ++numRows;
+      }
+    }
+    EXPECT_EQ(id % 2 == 0 ? kSize / kRowsInRowGroup : 0, numRows);
+    return ioStats.rawBytesRead();
+  };
+
+  // No row passes the filter. The payloads are not read.
+  const auto eagerBytes = read(4'001, false);
+  const auto lateBytes = read(4'001, true);
+  EXPECT_LT(lateBytes * 4, eagerBytes);
+
+  // A row of each row group passes the filter.
+  read(4'000, false);
+  read(4'000, true);
+}
+
+TEST_F(E2EFilterTest, dictionarySkipsRowGroups) {
+  constexpr int32_t kSize = 20'000;
+  constexpr int32_t kRowsInRowGroup = 5'000;
+  rowsInRowGroup_ = kRowsInRowGroup;
+
+  // All row groups have 'apple' and 'cherry', so that the stats pass a filter
+  // on 'banana'. Only the third row group has 'banana'.
+  rowType_ = ROW({"id", "fruit"}, {BIGINT(), VARCHAR()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kSize, leafPool_.get());
+  auto fruits = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kSize, leafPool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    ids->set(i, i);
+    if (i / kRowsInRowGroup == 2 && i % 100 == 0) {
+      fruits->set(i, StringView("banana"));
+    } else {
+      fruits->set(i, StringView(i % 2 ? "apple" : "cherry"));
+    }
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kSize,
+      std::vector<VectorPtr>{ids, fruits})};
+  writeToMemory(rowType_, batches, false);
+
+  auto read = [&](bool useDictionary) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_parquet_use_dictionary_filter = useDictionary;
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("fruit")->setFilter(std::make_unique<BytesValues>(
+        std::vector<std::string>{"banana"}, false));
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    dwio::common::RowReaderOptions rowReaderOpts;
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    int64_t expected = 2 * kRowsInRowGroup;
+    while (rowReader->next(1'000, result) > 0) {
+      auto* rows = result->as<RowVector>();
+      auto* resultIds =
+          rows->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      auto* resultFruits =
+          rows->childAt(1)->loadedVector()->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < rows->size(); ++i) {
+        ASSERT_EQ(expected, resultIds->valueAt(i));
+        ASSERT_EQ("banana", resultFruits->valueAt(i).str());
+        expected += 100;
+      }
+    }
+    EXPECT_EQ(3 * kRowsInRowGroup, expected);
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+
+  EXPECT_EQ(3, read(true));
+  EXPECT_EQ(0, read(false));
+}
+
+namespace {
+template <typename T>
+std::string serializeThrift(const T& object) {
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  object.write(&protocol);
+  return buffer->getBufferAsString();
+}
+
+// Returns 'file' with a Bloom filter of 'rowGroupValues[i]' for 'column' of
+// row group i. The Velox writer does not write Bloom filters, so they are
+// appended after the column chunks and the footer is rewritten to point to
+// them.
+std::string addBloomFilters(
+    std::string_view file,
+    int32_t column,
+    const std::vector<std::vector<int64_t>>& rowGroupValues) {
+  const auto footerLength =
+      folly::loadUnaligned<uint32_t>(file.data() + file.size() - 8);
+  const auto footerStart = file.size() - 8 - footerLength;
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      file.data() + footerStart, footerLength);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+      protocol(transport);
+  thrift::FileMetaData fileMetaData;
+  fileMetaData.read(&protocol);
+
+  std::string result(file.substr(0, footerStart));
+  for (auto i = 0; i < rowGroupValues.size(); ++i) {
+    BlockSplitBloomFilter bloomFilter(1024);
+    for (auto value : rowGroupValues[i]) {
+      bloomFilter.insertHash(BlockSplitBloomFilter::hash(value));
+    }
+    thrift::BloomFilterHeader header;
+    header.__set_numBytes(bloomFilter.numBytes());
+    thrift::BloomFilterAlgorithm algorithm;
+    algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+    header.__set_algorithm(algorithm);
+    thrift::BloomFilterHash hash;
+    hash.__set_XXHASH(thrift::XxHash());
+    header.__set_hash(hash);
+    thrift::BloomFilterCompression compression;
+    compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+    header.__set_compression(compression);
+
+    auto& metaData = fileMetaData.row_groups[i].columns[column].meta_data;
+    metaData.__set_bloom_filter_offset(result.size());
+    result += serializeThrift(header);
+    result.append(bloomFilter.data(), bloomFilter.numBytes());
+  }
+  const auto newFooter = serializeThrift(fileMetaData);
+  result += newFooter;
+  const uint32_t newFooterLength = newFooter.size();
+  result.append(
+      reinterpret_cast<const char*>(&newFooterLength), sizeof(newFooterLength));
+  result += "PAR1";
+  return result;
+}
+} // namespace
+
+TEST_F(E2EFilterTest, bloomFilterSkipsRowGroups) {
+  constexpr int32_t kSize = 2'000;
+  constexpr int32_t kRowsInRowGroup = 1'000;
+  rowsInRowGroup_ = kRowsInRowGroup;
+  // Without dictionaries only the Bloom filters can skip row groups.
+  options_.enableDictionary = false;
+
+  // The first row group has the even and the second the odd numbers, so that
+  // the min/max stats of both pass a filter on any one number.
+  rowType_ = ROW({"id"}, {BIGINT()});
+  auto ids = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), kSize, leafPool_.get());
+  std::vector<std::vector<int64_t>> rowGroupValues(2);
+  for (auto i = 0; i < kSize; ++i) {
+    const int64_t id =
+        i < kRowsInRowGroup ? 2 * i : 2 * (i - kRowsInRowGroup) + 1;
+    ids->set(i, id);
+    rowGroupValues[i / kRowsInRowGroup].push_back(id);
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(), rowType_, nullptr, kSize, std::vector<VectorPtr>{ids})};
+  writeToMemory(rowType_, batches, false);
+  const auto file = addBloomFilters(
+      std::string_view(sinkPtr_->data(), sinkPtr_->size()), 0, rowGroupValues);
+
+  auto read = [&](bool useBloomFilter) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_parquet_use_bloom_filter = useBloomFilter;
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("id")->setFilter(
+        std::make_unique<BigintRange>(501, 501, false));
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    dwio::common::RowReaderOptions rowReaderOpts;
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(file), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    EXPECT_EQ(2, dynamic_cast<ParquetReader&>(*reader).numberOfRowGroups());
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    std::vector<int64_t> resultIds;
+    while (rowReader->next(1'000, result) > 0) {
+      auto* rows = result->as<RowVector>();
+      auto* values =
+          rows->childAt(0)->loadedVector()->as<SimpleVector<int64_t>>();
+      for (auto i = 0; i < rows->size(); ++i) {
+        resultIds.push_back(values->valueAt(i));
+      }
+    }
+    EXPECT_EQ(std::vector<int64_t>{501}, resultIds);
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+
+  EXPECT_EQ(1, read(true));
+  EXPECT_EQ(0, read(false));
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {common::CompressionKind_SNAPPY,
@@ -258,6 +703,27 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.encoding = ValueEncoding::kByteStreamSplit;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -430,6 +896,42 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding = ValueEncoding::kDeltaLengthByteArray;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, stringDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding = ValueEncoding::kDeltaByteArray;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string,"
+      "string_const: string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+        makeStringDistribution("string_const", 1, true, false);
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -615,6 +1117,189 @@ TEST_F(E2EFilterTest, combineRowGroup) {
   EXPECT_EQ(parquetReader.numberOfRows(), 5);
 }
 
+TEST_F(E2EFilterTest, nativeWriter) {
+  options_.nativeWriter = true;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "boolean_val:boolean,"
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint,"
+      "float_val:float,"
+      "double_val:double,"
+      "string_val:string,"
+      "date_val:date",
+      [&]() {
+        makeAllNulls("long_null");
+        makeStringDistribution("string_val", 100, true, false);
+      },
+      false,
+      {"short_val", "int_val", "long_val", "double_val", "string_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDictionaryInput) {
+  constexpr int32_t kBatchSize = 500;
+  options_.nativeWriter = true;
+  rowsInRowGroup_ = 300;
+
+  rowType_ = ROW({"id", "name"}, {BIGINT(), VARCHAR()});
+  // The last name is not referenced by any row. It is still in the written
+  // dictionary page if the dictionary of the input is preserved.
+  auto names = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), 4, leafPool_.get());
+  names->set(0, StringView("apple"));
+  names->set(1, StringView("banana"));
+  names->set(2, StringView("a string that is not inlined"));
+  names->set(3, StringView("not referenced"));
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < 2; ++batch) {
+    auto ids = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), kBatchSize, leafPool_.get());
+    auto indices = allocateIndices(kBatchSize, leafPool_.get());
+    auto nulls = allocateNulls(kBatchSize, leafPool_.get());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    for (auto i = 0; i < kBatchSize; ++i) {
+      const auto row = batch * kBatchSize + i;
+      ids->set(i, row);
+      rawIndices[i] = row % 3;
+      bits::setNull(rawNulls, i, row % 7 == 0);
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kBatchSize,
+        std::vector<VectorPtr>{
+            ids,
+            BaseVector::wrapInDictionary(
+                nulls, indices, kBatchSize, names)}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  EXPECT_EQ(4, dynamic_cast<ParquetReader&>(*reader).numberOfRowGroups());
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  dwio::common::RowReaderOptions rowReaderOpts;
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+  int64_t expected = 0;
+  while (rowReader->next(100, result) > 0) {
+    auto* rows = result->as<RowVector>();
+    DecodedVector ids(*rows->childAt(0)->loadedVector());
+    DecodedVector resultNames(*rows->childAt(1)->loadedVector());
+    auto* dictionary = rows->childAt(1)
+                           ->loadedVector()
+                           ->as<DictionaryVector<StringView>>();
+    ASSERT_NE(nullptr, dictionary);
+    auto* dictionaryValues =
+        dictionary->valueVector()->as<SimpleVector<StringView>>();
+    ASSERT_EQ(names->size(), dictionaryValues->size());
+    EXPECT_EQ(names->valueAt(3), dictionaryValues->valueAt(3));
+    for (auto i = 0; i < rows->size(); ++i) {
+      ASSERT_EQ(expected, ids.valueAt<int64_t>(i));
+      if (expected % 7 == 0) {
+        ASSERT_TRUE(resultNames.isNullAt(i));
+      } else {
+        ASSERT_EQ(
+            names->valueAt(expected % 3),
+            resultNames.valueAt<StringView>(i));
+      }
+      ++expected;
+    }
+  }
+  EXPECT_EQ(2 * kBatchSize, expected);
+}
+
+TEST_F(E2EFilterTest, distinctCountStats) {
+  constexpr int32_t kBatchSize = 1'000;
+  options_.distinctCountStats = true;
+  rowType_ = ROW({"id", "name", "flag"}, {INTEGER(), VARCHAR(), BOOLEAN()});
+  HashStringAllocator allocator{leafPool_.get()};
+  auto makeSketch = [&]() {
+    auto sketch = std::make_unique<hll::HllAccumulator>(&allocator);
+    sketch->setIndexBitLength(
+        hll::toIndexBitLength(hll::kDefaultStandardError));
+    return sketch;
+  };
+  auto serialize = [](hll::HllAccumulator& sketch) {
+    std::string serialized(sketch.serializedSize(), '\0');
+    sketch.serialize(serialized.data());
+    return serialized;
+  };
+
+  // The expected sketches hash the values like approx_distinct.
+  auto expectedIds = makeSketch();
+  auto expectedNames = makeSketch();
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < 2; ++batch) {
+    auto ids = BaseVector::create<FlatVector<int32_t>>(
+        INTEGER(), kBatchSize, leafPool_.get());
+    auto names = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kBatchSize, leafPool_.get());
+    auto flags = BaseVector::create<FlatVector<bool>>(
+        BOOLEAN(), kBatchSize, leafPool_.get());
+    for (auto i = 0; i < kBatchSize; ++i) {
+      const auto row = batch * kBatchSize + i;
+      const int32_t id = row % 300;
+      // Short enough to be inlined in the StringView.
+      const auto name = fmt::format("n{}", row % 500);
+      if (row % 11 == 0) {
+        ids->setNull(i, true);
+      } else {
+        ids->set(i, id);
+        expectedIds->append(XXH64(&id, sizeof(id), 0));
+      }
+      names->set(i, StringView(name));
+      expectedNames->append(XXH64(name.data(), name.size(), 0));
+      flags->set(i, row % 2 == 0);
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kBatchSize,
+        std::vector<VectorPtr>{ids, names, flags}));
+  }
+
+  for (const bool nativeWriter : {false, true}) {
+    SCOPED_TRACE(fmt::format("nativeWriter: {}", nativeWriter));
+    options_.nativeWriter = nativeWriter;
+    writeToMemory(rowType_, batches, false);
+
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    auto& parquetReader = dynamic_cast<ParquetReader&>(*reader);
+    // The keys end with the node ids of the columns.
+    const auto idKey = dwio::common::distinctCountKey(1);
+    EXPECT_EQ(parquetReader.keyValueMetadata(idKey), serialize(*expectedIds));
+    EXPECT_EQ(
+        parquetReader.keyValueMetadata(dwio::common::distinctCountKey(2)),
+        serialize(*expectedNames));
+    EXPECT_FALSE(
+        parquetReader.keyValueMetadata(dwio::common::distinctCountKey(3))
+            .has_value());
+
+    hll::HllAccumulator ids{&allocator};
+    ids.mergeWith(
+        StringView(*parquetReader.keyValueMetadata(idKey)), &allocator);
+    EXPECT_NEAR(ids.cardinality(), 300, 6);
+  }
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
@@ -39,7 +39,9 @@ const double kFilterErrorMargin = 0.2;
 
 class ParquetReaderBenchmark {
  public:
-  explicit ParquetReaderBenchmark(bool disableDictionary)
+  explicit ParquetReaderBenchmark(
+      bool disableDictionary,
+      ValueEncoding encoding = ValueEncoding::kPlain)
       : disableDictionary_(disableDictionary) {
     rootPool_ =
         memory::defaultMemoryManager().addRootPool("ParquetReaderBenchmark");
@@ -54,6 +56,7 @@ class ParquetReaderBenchmark {
       // The parquet file is in plain encoding format.
       options.enableDictionary = false;
     }
+    options.encoding = encoding;
     options.memoryPool = rootPool_.get();
     writer_ = std::make_unique<facebook::velox::parquet::Writer>(
         std::move(sink), options);
@@ -255,6 +258,19 @@ void run(
       columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
 }
 
+// Reads a column written without dictionary in DELTA_BINARY_PACKED encoding.
+void runDelta(
+    uint32_t,
+    const std::string& columnName,
+    const TypePtr& type,
+    float filterRateX100,
+    uint8_t nullsRateX100,
+    uint32_t nextSize) {
+  ParquetReaderBenchmark benchmark(true, ValueEncoding::kDeltaBinaryPacked);
+  benchmark.readSingleColumn(
+      columnName, type, 0, filterRateX100, nullsRateX100, nextSize);
+}
+
 #define PARQUET_BENCHMARKS_FILTER_NULLS(_type_, _name_, _filter_, _null_) \
   BENCHMARK_NAMED_PARAM(                                                  \
       run,                                                                \
@@ -367,7 +383,29 @@ void run(
   PARQUET_BENCHMARKS_FILTERS(_type_, _name_, 100)    \
   BENCHMARK_DRAW_LINE();
 
+#define PARQUET_BENCHMARKS_DELTA(_type_, _name_, _filter_, _null_)  \
+  BENCHMARK_NAMED_PARAM(                                            \
+      runDelta,                                                     \
+      _name_##_Filter_##_filter_##_Nulls_##_null_##_next_5k_delta,  \
+      #_name_,                                                      \
+      _type_,                                                       \
+      _filter_,                                                     \
+      _null_,                                                       \
+      5000);                                                        \
+  BENCHMARK_NAMED_PARAM(                                            \
+      runDelta,                                                     \
+      _name_##_Filter_##_filter_##_Nulls_##_null_##_next_20k_delta, \
+      #_name_,                                                      \
+      _type_,                                                       \
+      _filter_,                                                     \
+      _null_,                                                       \
+      20000);
+
 PARQUET_BENCHMARKS(BIGINT(), BigInt);
+PARQUET_BENCHMARKS_DELTA(BIGINT(), BigInt, 20, 0);
+PARQUET_BENCHMARKS_DELTA(BIGINT(), BigInt, 20, 20);
+PARQUET_BENCHMARKS_DELTA(BIGINT(), BigInt, 100, 0);
+BENCHMARK_DRAW_LINE();
 PARQUET_BENCHMARKS(DOUBLE(), Double);
 PARQUET_BENCHMARKS_NO_FILTER(MAP(BIGINT(), BIGINT()), Map);
 PARQUET_BENCHMARKS_NO_FILTER(ARRAY(BIGINT()), List);
@@ -86,6 +86,26 @@ TEST_F(ParquetReaderTest, parseSample) {
   assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  FileMetadataCache cache(1 << 20);
+  ReaderOptions readerOptions{defaultPool.get()};
+  readerOptions.setFileMetadataCache(&cache);
+  readerOptions.setFileMetadataKey(FileMetadataKey{1, 100});
+  auto first = createReader(sample, readerOptions);
+  auto second = createReader(sample, readerOptions);
+  EXPECT_EQ(1, cache.stats().numHits);
+  EXPECT_EQ(1, cache.stats().numMisses);
+  EXPECT_EQ(first.numberOfRows(), second.numberOfRows());
+
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  auto rowReader = second.createRowReader(rowReaderOpts);
+  auto expected = vectorMaker_->rowVector(
+      {rangeVector<int64_t>(20, 1), rangeVector<double>(20, 1)});
+  assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
+}
+
 TEST_F(ParquetReaderTest, parseSampleRange1) {
   const std::string sample(getExampleFilePath("sample.parquet"));
 
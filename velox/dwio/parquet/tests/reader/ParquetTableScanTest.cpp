@@ -17,11 +17,16 @@
 #include <folly/init/Init.h>
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/RegisterParquetReader.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
 #include "velox/type/tests/SubfieldFiltersBuilder.h"
 
 #include "velox/connectors/hive/HiveConfig.h"
@@ -121,6 +126,31 @@ class ParquetTableScanTest : public HiveConnectorTestBase {
         filePath, 1, dwio::common::FileFormat::PARQUET)[0];
   }
 
+  // Writes 'vectors' to a Parquet file with row groups of 'rowsInRowGroup'
+  // rows.
+  void writeToParquetFile(
+      const std::string& filePath,
+      const std::vector<RowVectorPtr>& vectors,
+      uint64_t rowsInRowGroup) {
+    auto localWriteFile =
+        std::make_unique<LocalWriteFile>(filePath, true, false);
+    auto sink = std::make_unique<dwio::common::WriteFileSink>(
+        std::move(localWriteFile), filePath);
+    auto childPool =
+        rootPool_->addAggregateChild("ParquetTableScanTest.Writer");
+    facebook::velox::parquet::WriterOptions options;
+    options.memoryPool = childPool.get();
+    options.flushPolicyFactory = [rowsInRowGroup]() {
+      return std::make_unique<facebook::velox::parquet::DefaultFlushPolicy>(
+          rowsInRowGroup, 128 * 1'024 * 1'024);
+    };
+    facebook::velox::parquet::Writer writer(std::move(sink), options);
+    for (const auto& vector : vectors) {
+      writer.write(vector);
+    }
+    writer.close();
+  }
+
  private:
   RowTypePtr getRowType(std::vector<std::string>&& outputColumnNames) const {
     std::vector<TypePtr> types;
@@ -442,6 +472,74 @@ TEST_F(ParquetTableScanTest, readAsLowerCase) {
       result.second, {makeRowVector({"a"}, {makeFlatVector<int64_t>({0, 1})})});
 }
 
+TEST_F(ParquetTableScanTest, statsAggregates) {
+  // 3 row groups of 1'000 rows. The writer records the number of nulls and
+  // the min and max of each column chunk.
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  auto data = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(3'000, [](auto row) { return row; }),
+       makeFlatVector<int32_t>(
+           3'000, [](auto row) { return row % 100 - 50; }, nullEvery(7))});
+  auto filePath = TempFilePath::create();
+  writeToParquetFile(filePath->path, {data}, 1'000);
+
+  using Kind = connector::hive::HiveStatsAggregate::Kind;
+  auto outputType =
+      ROW({"a0", "a1", "a2", "a3"}, {BIGINT(), BIGINT(), BIGINT(), INTEGER()});
+  auto tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
+      kHiveConnectorId,
+      "hive_table",
+      true,
+      connector::hive::SubfieldFilters{},
+      nullptr,
+      rowType,
+      std::unordered_map<std::string, std::string>{},
+      std::vector<connector::hive::HiveStatsAggregate>{
+          {Kind::kCount, ""},
+          {Kind::kCount, "c1"},
+          {Kind::kMin, "c0"},
+          {Kind::kMax, "c1"}});
+  auto statsPlan =
+      PlanBuilder()
+          .tableScan(outputType, tableHandle, {})
+          .finalAggregation(
+              {},
+              {"count(a0)", "count(a1)", "min(a2)", "max(a3)"},
+              outputType->children())
+          .planNode();
+  auto scanPlan =
+      PlanBuilder()
+          .tableScan(rowType)
+          .singleAggregation(
+              {}, {"count(1)", "count(c1)", "min(c0)", "max(c1)"})
+          .planNode();
+  auto getStat = [](const std::shared_ptr<exec::Task>& task,
+                    const std::string& name) {
+    auto& stats =
+        task->taskStats().pipelineStats[0].operatorStats[0].runtimeStats;
+    auto it = stats.find(name);
+    return it != stats.end() ? it->second.sum : 0;
+  };
+
+  // Each row group is aggregated from its statistics, also when the file is
+  // read in several splits.
+  for (auto numSplits : {1, 3}) {
+    SCOPED_TRACE(fmt::format("numSplits: {}", numSplits));
+    std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+    for (auto& split : makeHiveConnectorSplits(
+             filePath->path, numSplits, dwio::common::FileFormat::PARQUET)) {
+      splits.push_back(split);
+    }
+    auto expected =
+        AssertQueryBuilder(scanPlan).splits(splits).copyResults(pool());
+    auto task =
+        AssertQueryBuilder(statsPlan).splits(splits).assertResults(expected);
+    EXPECT_EQ(3, getStat(task, "statsAggregatedRowGroups"));
+    EXPECT_EQ(0, getStat(task, "statsAggregateReadRowGroups"));
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   folly::init(&argc, &argv, false);
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/tpch/gen/TpchGen.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::parquet;
+
+// Compares writing TPC-H lineitem through Arrow with the native Parquet
+// writer.
+
+namespace {
+constexpr int32_t kNumBatches = 10;
+constexpr int32_t kOrdersPerBatch = 10'000;
+
+class ParquetWriterBenchmark {
+ public:
+  ParquetWriterBenchmark() {
+    rootPool_ =
+        memory::defaultMemoryManager().addRootPool("ParquetWriterBenchmark");
+    leafPool_ = rootPool_->addLeafChild("ParquetWriterBenchmark");
+    for (auto i = 0; i < kNumBatches; ++i) {
+      batches_.push_back(tpch::genTpchLineItem(
+          leafPool_.get(), kOrdersPerBatch, i * kOrdersPerBatch));
+    }
+  }
+
+  // Writes the lineitem batches and returns the size of the file.
+  uint64_t write(bool nativeWriter, bool enableDictionary) {
+    auto sink = std::make_unique<MemorySink>(
+        200 << 20, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    WriterOptions options;
+    options.nativeWriter = nativeWriter;
+    options.enableDictionary = enableDictionary;
+    options.memoryPool = rootPool_.get();
+    auto writer = std::make_unique<Writer>(std::move(sink), options);
+    for (const auto& batch : batches_) {
+      writer->write(batch);
+    }
+    writer->close();
+    return sinkPtr->size();
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> leafPool_;
+  std::vector<RowVectorPtr> batches_;
+};
+
+std::unique_ptr<ParquetWriterBenchmark> benchmark;
+
+void run(uint32_t, bool nativeWriter, bool enableDictionary) {
+  folly::doNotOptimizeAway(benchmark->write(nativeWriter, enableDictionary));
+}
+} // namespace
+
+BENCHMARK_NAMED_PARAM(run, lineitem_arrow_dict, false, true);
+BENCHMARK_RELATIVE_NAMED_PARAM(run, lineitem_native_dict, true, true);
+BENCHMARK_NAMED_PARAM(run, lineitem_arrow_plain, false, false);
+BENCHMARK_RELATIVE_NAMED_PARAM(run, lineitem_native_plain, true, false);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<ParquetWriterBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
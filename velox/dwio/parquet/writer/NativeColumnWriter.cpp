@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeColumnWriter.h"
+
+#include <arrow/c/bridge.h>
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+using arrow::LogicalType;
+
+// Writes a column of Velox type 'T' as Parquet physical type 'ParquetType'.
+template <typename T, typename ParquetType>
+class PrimitiveColumnWriter : public NativeColumnWriter {
+ public:
+  using ParquetValue = typename ParquetType::c_type;
+
+  explicit PrimitiveColumnWriter(
+      std::shared_ptr<const LogicalType> logicalType)
+      : logicalType_(std::move(logicalType)) {}
+
+  arrow::schema::NodePtr schemaNode(const std::string& name) const override {
+    return arrow::schema::PrimitiveNode::Make(
+        name,
+        arrow::Repetition::OPTIONAL,
+        logicalType_,
+        ParquetType::type_num);
+  }
+
+  void write(
+      const BaseVector& vector,
+      vector_size_t offset,
+      vector_size_t size,
+      arrow::ColumnWriter& writer) override {
+    auto& typedWriter =
+        static_cast<arrow::TypedColumnWriter<ParquetType>&>(writer);
+    decoded_.decode(vector);
+    defLevels_.resize(size);
+    if constexpr (std::is_same_v<T, ParquetValue> && !std::is_same_v<T, bool>) {
+      if (decoded_.isIdentityMapping() && !decoded_.mayHaveNulls()) {
+        std::fill(defLevels_.begin(), defLevels_.end(), 1);
+        typedWriter.WriteBatch(
+            size, defLevels_.data(), nullptr, decoded_.data<T>() + offset);
+        return;
+      }
+    }
+    values_.resize(size);
+    vector_size_t numValues = 0;
+    for (auto i = 0; i < size; ++i) {
+      const auto row = offset + i;
+      if (decoded_.isNullAt(row)) {
+        defLevels_[i] = 0;
+        continue;
+      }
+      defLevels_[i] = 1;
+      values_[numValues++] = toParquet(decoded_.valueAt<T>(row));
+    }
+    typedWriter.WriteBatch(size, defLevels_.data(), nullptr, values_.data());
+  }
+
+ protected:
+  bool writeDictionaryEncoded(
+      const std::vector<VectorSlice>& slices,
+      arrow::ColumnWriter& writer) override {
+    // The column writer takes dictionaries of binary values only.
+    if constexpr (!std::is_same_v<T, StringView>) {
+      return false;
+    } else {
+      const BaseVector* dictionary = nullptr;
+      vector_size_t numRows = 0;
+      for (const auto& slice : slices) {
+        if (slice.vector->encoding() != VectorEncoding::Simple::DICTIONARY ||
+            (dictionary && slice.vector->valueVector().get() != dictionary)) {
+          return false;
+        }
+        dictionary = slice.vector->valueVector().get();
+        numRows += slice.size;
+      }
+      // A dictionary larger than the chunk would be mostly unused entries.
+      if (!dictionary ||
+          dictionary->encoding() != VectorEncoding::Simple::FLAT ||
+          dictionary->mayHaveNulls() || dictionary->size() > numRows) {
+        return false;
+      }
+      for (const auto& slice : slices) {
+        auto rows = slice.vector->slice(slice.offset, slice.size);
+        defLevels_.resize(slice.size);
+        for (auto i = 0; i < slice.size; ++i) {
+          defLevels_[i] = rows->isNullAt(i) ? 0 : 1;
+        }
+        ArrowArray arrowArray;
+        ArrowSchema arrowSchema;
+        exportToArrow(rows, arrowArray, rows->pool());
+        exportToArrow(rows, arrowSchema);
+        PARQUET_ASSIGN_OR_THROW(
+            auto array, ::arrow::ImportArray(&arrowArray, &arrowSchema));
+        arrow::ArrowWriteContext context(
+            ::arrow::default_memory_pool(), arrowProperties_.get());
+        PARQUET_THROW_NOT_OK(writer.WriteArrow(
+            defLevels_.data(),
+            nullptr,
+            slice.size,
+            *array,
+            &context,
+            /*leaf_field_nullable=*/true));
+      }
+      return true;
+    }
+  }
+
+ private:
+  static ParquetValue toParquet(T value) {
+    if constexpr (std::is_same_v<T, StringView>) {
+      // The bytes stay in the vector, which is live until the write returns.
+      return arrow::ByteArray(
+          value.size(), reinterpret_cast<const uint8_t*>(value.data()));
+    } else {
+      return static_cast<ParquetValue>(value);
+    }
+  }
+
+  const std::shared_ptr<const LogicalType> logicalType_;
+  const std::shared_ptr<arrow::ArrowWriterProperties> arrowProperties_{
+      arrow::ArrowWriterProperties::Builder().build()};
+  DecodedVector decoded_;
+  std::vector<int16_t> defLevels_;
+  // The non-null values of the rows being written.
+  raw_vector<ParquetValue> values_;
+};
+
+template <typename T, typename ParquetType>
+std::unique_ptr<NativeColumnWriter> makeWriter(
+    std::shared_ptr<const LogicalType> logicalType = LogicalType::None()) {
+  return std::make_unique<PrimitiveColumnWriter<T, ParquetType>>(
+      std::move(logicalType));
+}
+} // namespace
+
+void NativeColumnWriter::writeColumnChunk(
+    const std::vector<VectorSlice>& slices,
+    arrow::ColumnWriter& writer) {
+  if (writeDictionaryEncoded(slices, writer)) {
+    return;
+  }
+  for (const auto& slice : slices) {
+    write(*slice.vector, slice.offset, slice.size, writer);
+  }
+}
+
+// static
+std::unique_ptr<NativeColumnWriter> NativeColumnWriter::create(
+    const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return makeWriter<bool, arrow::BooleanType>();
+    case TypeKind::TINYINT:
+      return makeWriter<int8_t, arrow::Int32Type>(LogicalType::Int(8, true));
+    case TypeKind::SMALLINT:
+      return makeWriter<int16_t, arrow::Int32Type>(LogicalType::Int(16, true));
+    case TypeKind::INTEGER:
+      if (type->isDate()) {
+        return makeWriter<int32_t, arrow::Int32Type>(LogicalType::Date());
+      }
+      if (type->isIntervalYearMonth()) {
+        return nullptr;
+      }
+      return makeWriter<int32_t, arrow::Int32Type>();
+    case TypeKind::BIGINT:
+      if (type->isDecimal() || type->isIntervalDayTime()) {
+        return nullptr;
+      }
+      return makeWriter<int64_t, arrow::Int64Type>();
+    case TypeKind::REAL:
+      return makeWriter<float, arrow::FloatType>();
+    case TypeKind::DOUBLE:
+      return makeWriter<double, arrow::DoubleType>();
+    case TypeKind::VARCHAR:
+      return makeWriter<StringView, arrow::ByteArrayType>(
+          LogicalType::String());
+    case TypeKind::VARBINARY:
+      return makeWriter<StringView, arrow::ByteArrayType>();
+    default:
+      return nullptr;
+  }
+}
+
+std::shared_ptr<arrow::schema::GroupNode> makeNativeSchema(
+    const RowType& type,
+    std::vector<std::unique_ptr<NativeColumnWriter>>& columnWriters) {
+  std::vector<std::unique_ptr<NativeColumnWriter>> writers;
+  arrow::schema::NodeVector fields;
+  for (auto i = 0; i < type.size(); ++i) {
+    auto writer = NativeColumnWriter::create(type.childAt(i));
+    if (writer == nullptr) {
+      return nullptr;
+    }
+    fields.push_back(writer->schemaNode(type.nameOf(i)));
+    writers.push_back(std::move(writer));
+  }
+  columnWriters = std::move(writers);
+  return std::static_pointer_cast<arrow::schema::GroupNode>(
+      arrow::schema::GroupNode::Make(
+          "schema", arrow::Repetition::REQUIRED, fields));
+}
+
+} // namespace facebook::velox::parquet
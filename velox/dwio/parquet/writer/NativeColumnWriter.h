@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/writer/arrow/ColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/Schema.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Rows [offset, offset + size) of a vector.
+struct VectorSlice {
+  const BaseVector* vector;
+  vector_size_t offset;
+  vector_size_t size;
+};
+
+/// Writes a top level column of Velox vectors to the column chunks of a
+/// Parquet file without converting the vectors to Arrow. Values are read
+/// through DecodedVector, so that dictionary and constant vectors are not
+/// flattened. Flat vectors without nulls whose values have the layout of the
+/// Parquet physical type are passed to the column writer without a copy.
+class NativeColumnWriter {
+ public:
+  virtual ~NativeColumnWriter() = default;
+
+  /// Writes 'slices', the rows of the column in a row group, to 'writer'.
+  /// String slices that are all dictionary encoded over the same values
+  /// without nulls are written as that dictionary and their indices, so
+  /// that the column chunk uses the dictionary page of the input without
+  /// hashing the rows. The chunk is written plain instead if dictionary
+  /// encoding is disabled in the writer properties. Other slices are written
+  /// with write().
+  void writeColumnChunk(
+      const std::vector<VectorSlice>& slices,
+      arrow::ColumnWriter& writer);
+
+  /// Returns a writer for a column of 'type' or nullptr if 'type' is not
+  /// supported. Supported are the primitive types that map to a Parquet
+  /// physical type without conversion of the values other than widening.
+  static std::unique_ptr<NativeColumnWriter> create(const TypePtr& type);
+
+  /// Returns the Parquet schema node of a column named 'name'. The column is
+  /// OPTIONAL like the columns written through Arrow.
+  virtual arrow::schema::NodePtr schemaNode(const std::string& name) const = 0;
+
+  /// Writes the rows [offset, offset + size) of 'vector' to 'writer', which
+  /// is the column writer of the column in the current row group.
+  virtual void write(
+      const BaseVector& vector,
+      vector_size_t offset,
+      vector_size_t size,
+      arrow::ColumnWriter& writer) = 0;
+
+ protected:
+  // Writes 'slices' as described in writeColumnChunk() and returns true if
+  // they are dictionary encoded over the same values. Returns false without
+  // writing anything otherwise.
+  virtual bool writeDictionaryEncoded(
+      const std::vector<VectorSlice>& /*slices*/,
+      arrow::ColumnWriter& /*writer*/) {
+    return false;
+  }
+};
+
+/// Returns the Parquet schema of 'type' or nullptr if a column of 'type' is
+/// not supported by NativeColumnWriter. Fills 'columnWriters' with a writer
+/// per column otherwise.
+std::shared_ptr<arrow::schema::GroupNode> makeNativeSchema(
+    const RowType& type,
+    std::vector<std::unique_ptr<NativeColumnWriter>>& columnWriters);
+
+} // namespace facebook::velox::parquet
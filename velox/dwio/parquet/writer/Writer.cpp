@@ -19,15 +19,28 @@
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
 #include <arrow/table.h>
+#include <arrow/util/key_value_metadata.h>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include "velox/common/hyperloglog/HllUtils.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/TypeWithId.h"
 
 #include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/dwio/parquet/writer/NativeColumnWriter.h"
+#include "velox/dwio/parquet/writer/arrow/FileWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::parquet {
 
 using facebook::velox::parquet::arrow::ArrowWriterProperties;
 using facebook::velox::parquet::arrow::Compression;
+using facebook::velox::parquet::arrow::Encoding;
+using facebook::velox::parquet::arrow::ParquetFileWriter;
 using facebook::velox::parquet::arrow::WriterProperties;
 using facebook::velox::parquet::arrow::arrow::FileWriter;
 
@@ -105,6 +118,17 @@ struct ArrowContext {
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
 };
 
+// State of a writer that writes the Velox vectors without converting them to
+// Arrow. Uses the properties in ArrowContext.
+struct NativeContext {
+  std::unique_ptr<ParquetFileWriter> writer;
+  std::shared_ptr<arrow::schema::GroupNode> schema;
+  std::vector<std::unique_ptr<NativeColumnWriter>> columnWriters;
+  uint64_t stagingRows = 0;
+  int64_t stagingBytes = 0;
+  std::vector<RowVectorPtr> stagingBatches;
+};
+
 Compression::type getArrowParquetCompression(
     common::CompressionKind compression) {
   if (compression == common::CompressionKind_SNAPPY) {
@@ -130,9 +154,16 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   if (!options.enableDictionary) {
     properties = properties->disable_dictionary();
   }
+  if (options.encoding != ValueEncoding::kPlain) {
+    properties = properties->encoding(
+        static_cast<Encoding::type>(options.encoding));
+  }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   return properties->build();
@@ -148,6 +179,7 @@ Writer::Writer(
           std::move(sink),
           *generalPool_,
           options.bufferGrowRatio)),
+      nativeWriter_(options.nativeWriter),
       arrowContext_(std::make_shared<ArrowContext>()) {
   if (options.flushPolicyFactory) {
     flushPolicy_ = options.flushPolicyFactory();
@@ -156,6 +188,10 @@ Writer::Writer(
   }
   arrowContext_->properties =
       getArrowParquetWriterOptions(options, flushPolicy_);
+  if (options.distinctCountStats) {
+    distinctCountAllocator_ =
+        std::make_unique<HashStringAllocator>(generalPool_.get());
+  }
 }
 
 Writer::Writer(
@@ -169,6 +205,10 @@ Writer::Writer(
               folly::to<std::string>(folly::Random::rand64())))} {}
 
 void Writer::flush() {
+  if (nativeContext_) {
+    flushNative();
+    return;
+  }
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
       auto arrowProperties = ArrowWriterProperties::Builder().build();
@@ -223,6 +263,13 @@ dwio::common::StripeProgress getStripeProgress(
  * This method assumes each input `ColumnarBatch` have same schema.
  */
 void Writer::write(const VectorPtr& data) {
+  if (distinctCountAllocator_) {
+    addDistinctValues(data);
+  }
+  if (useNativeWriter(data)) {
+    writeNative(data);
+    return;
+  }
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get());
@@ -253,18 +300,216 @@ void Writer::write(const VectorPtr& data) {
   arrowContext_->stagingBytes += bytes;
 }
 
+bool Writer::useNativeWriter(const VectorPtr& data) {
+  if (nativeContext_) {
+    return true;
+  }
+  if (!nativeWriter_ || arrowContext_->schema ||
+      data->encoding() != VectorEncoding::Simple::ROW) {
+    return false;
+  }
+  auto context = std::make_shared<NativeContext>();
+  context->schema =
+      makeNativeSchema(data->type()->asRow(), context->columnWriters);
+  if (!context->schema) {
+    return false;
+  }
+  nativeContext_ = std::move(context);
+  return true;
+}
+
+void Writer::writeNative(const VectorPtr& data) {
+  auto rowVector = std::dynamic_pointer_cast<RowVector>(data);
+  VELOX_CHECK_NOT_NULL(rowVector, "Native Parquet writer expects a RowVector");
+  VELOX_CHECK_EQ(
+      rowVector->childrenSize(), nativeContext_->columnWriters.size());
+  if (flushPolicy_->shouldFlush(getStripeProgress(
+          nativeContext_->stagingRows, nativeContext_->stagingBytes))) {
+    flush();
+  }
+  nativeContext_->stagingRows += rowVector->size();
+  nativeContext_->stagingBytes += rowVector->estimateFlatSize();
+  nativeContext_->stagingBatches.push_back(std::move(rowVector));
+}
+
+void Writer::flushNative() {
+  auto& context = *nativeContext_;
+  if (context.stagingRows == 0) {
+    return;
+  }
+  if (!context.writer) {
+    context.writer = ParquetFileWriter::Open(
+        stream_, context.schema, arrowContext_->properties);
+  }
+
+  struct Slice {
+    const RowVector* batch;
+    vector_size_t offset;
+    vector_size_t size;
+  };
+  // Splits the staged rows into row groups of at most 'rowsInRowGroup' rows
+  // like FileWriter::WriteTable().
+  const auto rowsInRowGroup = flushPolicy_->rowsInRowGroup();
+  std::vector<Slice> slices;
+  auto batchIt = context.stagingBatches.begin();
+  vector_size_t offset = 0;
+  uint64_t rowsLeft = context.stagingRows;
+  while (rowsLeft > 0) {
+    const auto numRows = std::min(rowsLeft, rowsInRowGroup);
+    slices.clear();
+    for (uint64_t rows = 0; rows < numRows;) {
+      const auto& batch = *batchIt;
+      const vector_size_t size =
+          std::min<uint64_t>(batch->size() - offset, numRows - rows);
+      if (size > 0) {
+        slices.push_back({batch.get(), offset, size});
+      }
+      rows += size;
+      offset += size;
+      if (offset == batch->size()) {
+        ++batchIt;
+        offset = 0;
+      }
+    }
+    auto* rowGroup = context.writer->AppendRowGroup();
+    std::vector<VectorSlice> columnSlices(slices.size());
+    for (auto column = 0; column < context.columnWriters.size(); ++column) {
+      for (auto i = 0; i < slices.size(); ++i) {
+        columnSlices[i] = {
+            slices[i].batch->childAt(column).get(),
+            slices[i].offset,
+            slices[i].size};
+      }
+      context.columnWriters[column]->writeColumnChunk(
+          columnSlices, *rowGroup->NextColumn());
+    }
+    rowGroup->Close();
+    rowsLeft -= numRows;
+  }
+  PARQUET_THROW_NOT_OK(stream_->Flush());
+  context.stagingBatches.clear();
+  context.stagingRows = 0;
+  context.stagingBytes = 0;
+}
+
+namespace {
+
+bool hasDistinctCountSketch(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Hashes the values like approx_distinct: fixed width values by their native
+// type, strings by their bytes.
+template <TypeKind kind>
+void appendDistinctValues(
+    const DecodedVector& decoded,
+    common::hll::HllAccumulator& sketch) {
+  using T = typename TypeTraits<kind>::NativeType;
+  for (vector_size_t i = 0; i < decoded.size(); ++i) {
+    if (decoded.isNullAt(i)) {
+      continue;
+    }
+    const auto value = decoded.valueAt<T>(i);
+    if constexpr (std::is_same_v<T, StringView>) {
+      sketch.append(XXH64(value.data(), value.size(), 0));
+    } else {
+      sketch.append(XXH64(&value, sizeof(T), 0));
+    }
+  }
+}
+
+} // namespace
+
+void Writer::addDistinctValues(const VectorPtr& data) {
+  auto* rowVector = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(rowVector, "Distinct count stats expect a RowVector");
+  if (distinctCountType_ == nullptr) {
+    distinctCountType_ = asRowType(data->type());
+    distinctCountSketches_.resize(distinctCountType_->size());
+    for (auto i = 0; i < distinctCountType_->size(); ++i) {
+      if (!hasDistinctCountSketch(*distinctCountType_->childAt(i))) {
+        continue;
+      }
+      auto& sketch = distinctCountSketches_[i];
+      sketch = std::make_unique<common::hll::HllAccumulator>(
+          distinctCountAllocator_.get());
+      sketch->setIndexBitLength(
+          common::hll::toIndexBitLength(common::hll::kDefaultStandardError));
+    }
+  }
+  DecodedVector decoded;
+  for (auto i = 0; i < distinctCountSketches_.size(); ++i) {
+    if (auto& sketch = distinctCountSketches_[i]) {
+      decoded.decode(*rowVector->childAt(i));
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          appendDistinctValues,
+          distinctCountType_->childAt(i)->kind(),
+          decoded,
+          *sketch);
+    }
+  }
+}
+
+void Writer::writeDistinctCounts() {
+  auto metadata = std::make_shared<::arrow::KeyValueMetadata>();
+  // The keys use the node ids of the columns like the DWRF writer.
+  const auto typeWithId =
+      distinctCountType_ ? dwio::common::TypeWithId::create(distinctCountType_) : nullptr;
+  for (auto i = 0; i < distinctCountSketches_.size(); ++i) {
+    auto& sketch = distinctCountSketches_[i];
+    if (sketch == nullptr) {
+      continue;
+    }
+    std::string serialized(sketch->serializedSize(), '\0');
+    sketch->serialize(serialized.data());
+    metadata->Append(
+        dwio::common::distinctCountKey(typeWithId->childAt(i)->id()),
+        std::move(serialized));
+  }
+  if (metadata->size() == 0) {
+    return;
+  }
+  if (nativeContext_ && nativeContext_->writer) {
+    nativeContext_->writer->AddKeyValueMetadata(metadata);
+  } else if (arrowContext_->writer) {
+    PARQUET_THROW_NOT_OK(arrowContext_->writer->AddKeyValueMetadata(metadata));
+  }
+}
+
 bool Writer::isCodecAvailable(common::CompressionKind compression) {
   return arrow::util::Codec::IsAvailable(
       getArrowParquetCompression(compression));
 }
 
 void Writer::newRowGroup(int32_t numRows) {
+  if (nativeContext_) {
+    // Each flush ends a row group.
+    flush();
+    return;
+  }
   PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(numRows));
 }
 
 void Writer::close() {
   flush();
+  writeDistinctCounts();
 
+  if (nativeContext_ && nativeContext_->writer) {
+    nativeContext_->writer->Close();
+    nativeContext_->writer.reset();
+  }
   if (arrowContext_->writer) {
     PARQUET_THROW_NOT_OK(arrowContext_->writer->Close());
     arrowContext_->writer.reset();
@@ -277,6 +522,8 @@ void Writer::close() {
 void Writer::abort() {
   stream_->abort();
   arrowContext_.reset();
+  nativeContext_.reset();
+  distinctCountSketches_.clear();
 }
 
 parquet::WriterOptions getParquetOptions(
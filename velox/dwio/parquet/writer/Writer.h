@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/common/compression/Compression.h"
+#include "velox/common/hyperloglog/HllAccumulator.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/FlushPolicy.h"
@@ -31,6 +32,8 @@ class ArrowDataBufferSink;
 
 struct ArrowContext;
 
+struct NativeContext;
+
 class DefaultFlushPolicy : public dwio::common::FlushPolicy {
  public:
   DefaultFlushPolicy()
@@ -81,6 +84,19 @@ class LambdaFlushPolicy : public DefaultFlushPolicy {
   std::function<bool()> lambda_;
 };
 
+// Encoding of the values that are not dictionary encoded. The values are the
+// ones of the Parquet format.
+enum class ValueEncoding {
+  kPlain = 0,
+  kDeltaBinaryPacked = 5,
+  kDeltaLengthByteArray = 6,
+  kDeltaByteArray = 7,
+  // The writer emits this for FLOAT and DOUBLE columns only and fails on
+  // other types. The reader also decodes INT32 and INT64 pages of other
+  // writers.
+  kByteStreamSplit = 9,
+};
+
 struct WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
@@ -90,6 +106,21 @@ struct WriterOptions {
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
   common::CompressionKind compression = common::CompressionKind_NONE;
+  // Must be valid for the types of all the columns, e.g. kDeltaBinaryPacked
+  // only applies to integers.
+  ValueEncoding encoding = ValueEncoding::kPlain;
+  // Writes the column and offset indexes that let readers skip pages.
+  bool enablePageIndex = false;
+  // Writes the columns from the Velox vectors without converting them to
+  // Arrow first. Used only if all the top level columns are supported by
+  // NativeColumnWriter, the Arrow writer is used otherwise.
+  bool nativeWriter = false;
+  // Keeps a HyperLogLog sketch of the distinct values of each top level
+  // integer, floating point and string column and writes it to the key-value
+  // metadata of the file. The sketches use the Presto SparseV2/DenseV2 format
+  // and hash the values like approx_distinct, so they can be merged with its
+  // results.
+  bool distinctCountStats = false;
   velox::memory::MemoryPool* memoryPool;
   // The default factory allows the writer to construct the default flush
   // policy with the configs in its ctor.
@@ -132,6 +163,22 @@ class Writer : public dwio::common::Writer {
   void abort() override;
 
  private:
+  // Returns true if 'data' is written by 'nativeContext_'. Decides at the
+  // first write.
+  bool useNativeWriter(const VectorPtr& data);
+
+  void writeNative(const VectorPtr& data);
+
+  void flushNative();
+
+  // Adds the values of the top level columns of 'data' to
+  // 'distinctCountSketches_'.
+  void addDistinctValues(const VectorPtr& data);
+
+  // Adds the serialized 'distinctCountSketches_' to the key-value metadata of
+  // the file.
+  void writeDistinctCounts();
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
@@ -139,9 +186,25 @@ class Writer : public dwio::common::Writer {
   // Temporary Arrow stream for capturing the output.
   std::shared_ptr<ArrowDataBufferSink> stream_;
 
+  const bool nativeWriter_;
+
   std::shared_ptr<ArrowContext> arrowContext_;
 
+  std::shared_ptr<NativeContext> nativeContext_;
+
   std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
+
+  // Set if WriterOptions::distinctCountStats is set.
+  std::unique_ptr<HashStringAllocator> distinctCountAllocator_;
+
+  // Type of the written rows. Set at the first write if
+  // 'distinctCountAllocator_' is set.
+  RowTypePtr distinctCountType_;
+
+  // Sketch of the distinct values of each top level column. nullptr for the
+  // columns of other types.
+  std::vector<std::unique_ptr<common::hll::HllAccumulator>>
+      distinctCountSketches_;
 };
 
 class ParquetWriterFactory : public dwio::common::WriterFactory {
@@ -344,6 +344,15 @@ class FileWriterImpl : public FileWriter {
     return Status::OK();
   }
 
+  Status AddKeyValueMetadata(const std::shared_ptr<const KeyValueMetadata>&
+                                 key_value_metadata) override {
+    if (closed_) {
+      return Status::Invalid("AddKeyValueMetadata called on closed file");
+    }
+    PARQUET_CATCH_NOT_OK(writer_->AddKeyValueMetadata(key_value_metadata));
+    return Status::OK();
+  }
+
   Status Close() override {
     if (!closed_) {
       // Make idempotent
@@ -28,6 +28,7 @@ namespace arrow {
 
 class Array;
 class ChunkedArray;
+class KeyValueMetadata;
 class RecordBatch;
 class Schema;
 class Table;
@@ -152,6 +153,14 @@ class PARQUET_EXPORT FileWriter {
   virtual ::arrow::Status WriteRecordBatch(
       const ::arrow::RecordBatch& batch) = 0;
 
+  /// \brief Add key-value metadata to the file.
+  /// \param[in] key_value_metadata the metadata to add.
+  /// \note This will overwrite any existing metadata with the same key.
+  /// \return Error if Close() has been called.
+  virtual ::arrow::Status AddKeyValueMetadata(
+      const std::shared_ptr<const ::arrow::KeyValueMetadata>&
+          key_value_metadata) = 0;
+
   /// \brief Write the footer and close the file.
   virtual ::arrow::Status Close() = 0;
   virtual ~FileWriter();
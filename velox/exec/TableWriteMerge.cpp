@@ -33,16 +33,15 @@ bool isSameCommitContext(
              second[TableWriteTraits::kCommitStrategyContextKey]);
 }
 
-bool containsNonNullRows(const VectorPtr& vector) {
+vector_size_t countNonNullRows(const VectorPtr& vector) {
   if (!vector->mayHaveNulls()) {
-    return true;
+    return vector->size();
   }
+  vector_size_t numNonNullRows = 0;
   for (int i = 0; i < vector->size(); ++i) {
-    if (!vector->isNullAt(i)) {
-      return true;
-    }
+    numNonNullRows += !vector->isNullAt(i);
   }
-  return false;
+  return numNonNullRows;
 }
 } // namespace
 
@@ -74,8 +73,11 @@ void TableWriteMerge::addInput(RowVectorPtr input) {
     return;
   }
 
-  // Increments row count.
+  // Increments row count. Each table writer reports its row count once, so
+  // the non-null row counts are the number of merged writers.
   numRows_ += TableWriteTraits::getRowCount(input);
+  numWriters_ +=
+      countNonNullRows(input->childAt(TableWriteTraits::kRowCountChannel));
 
   // Makes sure the lifespan is the same.
   auto commitContext = TableWriteTraits::getTableCommitContext(input);
@@ -91,13 +93,17 @@ void TableWriteMerge::addInput(RowVectorPtr input) {
   // Adds fragments to the buffer. Fragments will be emitted as soon as possible
   // to avoid using extra memory.
   auto fragmentVector = input->childAt(TableWriteTraits::kFragmentChannel);
-  if (containsNonNullRows(fragmentVector)) {
+  const auto numFragments = countNonNullRows(fragmentVector);
+  if (numFragments != 0) {
+    numFragments_ += numFragments;
     fragmentVectors_.push(fragmentVector);
   }
 }
 
 void TableWriteMerge::noMoreInput() {
   Operator::noMoreInput();
+  addRuntimeStat("numWriters", RuntimeCounter(numWriters_));
+  addRuntimeStat("numFragments", RuntimeCounter(numFragments_));
   if (aggregation_ != nullptr) {
     aggregation_->noMoreInput();
   }
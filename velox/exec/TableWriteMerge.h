@@ -67,6 +67,10 @@ class TableWriteMerge : public Operator {
   bool finished_{false};
   // The sum of written rows.
   int64_t numRows_{0};
+  // The number of table writers whose outputs were merged.
+  int64_t numWriters_{0};
+  // The number of fragments passed through, e.g. one per file for Hive.
+  int64_t numFragments_{0};
   std::queue<VectorPtr> fragmentVectors_;
   folly::dynamic lastCommitContext_;
 };
@@ -107,6 +107,7 @@ std::vector<std::string> TableWriter::closeDataSink() {
   VELOX_CHECK(!closed_);
   VELOX_CHECK_NOT_NULL(dataSink_);
   closed_ = true;
+  NonReclaimableSection guard(this);
   return dataSink_->close(true);
 }
 
@@ -129,7 +130,12 @@ void TableWriter::addInput(RowVectorPtr input) {
       mappedChildren,
       input->getNullCount());
 
-  dataSink_->appendData(mappedInput);
+  {
+    // The data sink can't be flushed for memory arbitration triggered by its
+    // own allocations.
+    NonReclaimableSection guard(this);
+    dataSink_->appendData(mappedInput);
+  }
   numWrittenRows_ += input->size();
   updateWrittenBytes();
 
@@ -253,6 +259,38 @@ void TableWriter::close() {
   }
 }
 
+bool TableWriter::canReclaim() const {
+  return Operator::canReclaim() ||
+      (dataSink_ != nullptr && dataSink_->canReclaim());
+}
+
+bool TableWriter::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim()) {
+    return false;
+  }
+  // The file writers allocate from the connector pool.
+  reclaimableBytes = pool()->reservedBytes() + connectorPool_->reservedBytes();
+  return true;
+}
+
+void TableWriter::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+  if (dataSink_ == nullptr || !dataSink_->canReclaim()) {
+    return;
+  }
+  // NOTE: the data sink is not reclaimable after close or while it is under
+  // non-reclaimable execution section.
+  if (closed_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from table writer operator, closed_["
+                 << closed_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+  const auto numFlushedWriters = dataSink_->reclaim(targetBytes);
+  addRuntimeStat("forcedWriterFlushes", RuntimeCounter(numFlushedWriters));
+}
+
 void TableWriter::setConnectorOrWriterMemoryReclaimer(
     memory::MemoryPool* pool) {
   VELOX_CHECK_NOT_NULL(pool);
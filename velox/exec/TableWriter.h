@@ -127,6 +127,16 @@ class TableWriter : public Operator {
     return finished_;
   }
 
+  /// Returns true if the data sink can free memory by writing out the data
+  /// buffered by its file writers.
+  bool canReclaim() const override;
+
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  /// Flushes the file writers of the data sink to free memory. The number of
+  /// flushed writers is recorded in the 'forcedWriterFlushes' runtime stat.
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   // The memory reclaimer customized for connector and file writer memory pools.
   //
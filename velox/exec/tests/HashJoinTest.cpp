@@ -19,6 +19,7 @@
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
@@ -4890,6 +4891,65 @@ TEST_F(HashJoinTest, dynamicFilterOnPartitionKey) {
       .run();
 }
 
+TEST_F(HashJoinTest, dynamicFilterWithParallelDecoding) {
+  // The stripes of the probe split are decoded in parallel. The dynamic
+  // filter arrives after the first stripes are decoded and replaces the
+  // join, so the scan must apply it to the rows it has buffered.
+  resetHiveConnector(std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kDecodingThreads, "4"}}));
+  const int32_t numStripes = 20;
+  const int32_t rowsPerStripe = 1'000;
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < numStripes; ++i) {
+    probeVectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            rowsPerStripe, [&](auto row) { return i * rowsPerStripe + row; }),
+        makeFlatVector<int64_t>(rowsPerStripe, [](auto row) { return row; }),
+    }));
+  }
+  auto filePaths = makeFilePaths(1);
+  // Writes each vector as its own stripe.
+  auto config = std::make_shared<dwrf::Config>();
+  config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1);
+  writeToFile(filePaths[0]->path, probeVectors, config);
+  std::vector<RowVectorPtr> buildVectors{makeRowVector({makeFlatVector<int32_t>(
+      100, [](auto row) { return row * 197 + 5; })})};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  core::PlanNodeId probeScanId;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(asRowType(probeVectors[0]->type()))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      PlanBuilder(planNodeIdGenerator, pool_.get())
+                          .values(buildVectors)
+                          .project({"c0 AS u_c0"})
+                          .planNode(),
+                      "",
+                      {"c0", "c1"},
+                      core::JoinType::kInner)
+                  .planNode();
+  for (const auto* parallelism : {"1", "4"}) {
+    SCOPED_TRACE(fmt::format("parallelism: {}", parallelism));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .split(probeScanId, exec::Split(makeHiveConnectorSplit(
+                                    filePaths[0]->path)))
+            .connectorConfig(
+                kHiveConnectorId,
+                connector::hive::HiveConfig::kSplitDecodingParallelism,
+                parallelism)
+            .assertResults("SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0");
+    ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+    ASSERT_GT(getReplacedWithFilterRows(task, 1).sum, 0);
+  }
+}
+
 DEBUG_ONLY_TEST_F(HashJoinTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   VectorFuzzer fuzzer({.vectorSize = 1000}, pool());
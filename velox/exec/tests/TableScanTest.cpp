@@ -2634,6 +2634,120 @@ TEST_F(TableScanTest, bitwiseAggregationPushdown) {
       "SELECT c5, bit_or(c0), bit_or(c1), bit_or(c2), bit_or(c6) FROM tmp group by c5");
 }
 
+TEST_F(TableScanTest, statsAggregates) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  using Kind = connector::hive::HiveStatsAggregate::Kind;
+  auto makePlan = [&](const RowTypePtr& outputType,
+                      std::vector<connector::hive::HiveStatsAggregate>
+                          aggregates,
+                      const std::vector<std::string>& finalAggregates) {
+    auto tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        SubfieldFilters{},
+        nullptr,
+        rowType_,
+        std::unordered_map<std::string, std::string>{},
+        std::move(aggregates));
+    return PlanBuilder()
+        .tableScan(outputType, tableHandle, {})
+        .finalAggregation({}, finalAggregates, outputType->children())
+        .planNode();
+  };
+  auto getStat = [&](const std::shared_ptr<Task>& task,
+                     const std::string& name) {
+    auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find(name);
+    return it != stats.end() ? it->second.sum : 0;
+  };
+
+  // The integer aggregates come from the file statistics.
+  auto plan = makePlan(
+      ROW({"a0", "a1", "a2", "a3"}, {BIGINT(), BIGINT(), BIGINT(), INTEGER()}),
+      {{Kind::kCount, ""},
+       {Kind::kCount, "c1"},
+       {Kind::kMin, "c0"},
+       {Kind::kMax, "c1"}},
+      {"count(a0)", "count(a1)", "min(a2)", "max(a3)"});
+  auto task = assertQuery(
+      plan,
+      {filePath},
+      "SELECT count(*), count(c1), min(c0), max(c1) FROM tmp");
+  EXPECT_EQ(1, getStat(task, "statsAggregatedRowGroups"));
+  EXPECT_EQ(0, getStat(task, "statsAggregateReadRowGroups"));
+
+  // String statistics may be truncated, so the rows are read.
+  plan = makePlan(
+      ROW({"a0", "a1"}, {BIGINT(), VARCHAR()}),
+      {{Kind::kCount, ""}, {Kind::kMax, "c5"}},
+      {"count(a0)", "max(a1)"});
+  task = assertQuery(plan, {filePath}, "SELECT count(*), max(c5) FROM tmp");
+  EXPECT_EQ(0, getStat(task, "statsAggregatedRowGroups"));
+  EXPECT_EQ(1, getStat(task, "statsAggregateReadRowGroups"));
+}
+
+TEST_F(TableScanTest, statsAggregatesPartialSplits) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  // Writes each vector as its own stripe.
+  auto config = std::make_shared<dwrf::Config>();
+  config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1);
+  writeToFile(filePath->path, vectors, config);
+
+  using Kind = connector::hive::HiveStatsAggregate::Kind;
+  auto outputType =
+      ROW({"a0", "a1", "a2", "a3"}, {BIGINT(), BIGINT(), BIGINT(), INTEGER()});
+  auto tableHandle = std::make_shared<connector::hive::HiveTableHandle>(
+      kHiveConnectorId,
+      "hive_table",
+      true,
+      SubfieldFilters{},
+      nullptr,
+      rowType_,
+      std::unordered_map<std::string, std::string>{},
+      std::vector<connector::hive::HiveStatsAggregate>{
+          {Kind::kCount, ""},
+          {Kind::kCount, "c1"},
+          {Kind::kMin, "c0"},
+          {Kind::kMax, "c1"}});
+  auto statsPlan =
+      PlanBuilder()
+          .tableScan(outputType, tableHandle, {})
+          .finalAggregation(
+              {},
+              {"count(a0)", "count(a1)", "min(a2)", "max(a3)"},
+              outputType->children())
+          .planNode();
+  auto scanPlan =
+      PlanBuilder()
+          .tableScan(rowType_)
+          .singleAggregation(
+              {}, {"count(1)", "count(c1)", "min(c0)", "max(c1)"})
+          .planNode();
+
+  // DWRF has only file statistics. Each split covers some of the stripes, so
+  // all stripes are read.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (auto& split : makeHiveConnectorSplits(
+           filePath->path, 4, dwio::common::FileFormat::DWRF)) {
+    splits.push_back(split);
+  }
+  auto expected =
+      AssertQueryBuilder(scanPlan).splits(splits).copyResults(pool());
+  // The splits cover all rows.
+  EXPECT_EQ(10'000, expected->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
+  auto task =
+      AssertQueryBuilder(statsPlan).splits(splits).assertResults(expected);
+  auto stats = getTableScanRuntimeStats(task);
+  EXPECT_EQ(0, stats["statsAggregatedRowGroups"].sum);
+  EXPECT_EQ(10, stats["statsAggregateReadRowGroups"].sum);
+}
+
 TEST_F(TableScanTest, structLazy) {
   vector_size_t size = 1'000;
   auto rowVector = makeRowVector(
@@ -21,6 +21,7 @@
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/TableWriter.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -997,6 +998,90 @@ TEST_F(BasicTableWriteTest, roundTrip) {
   assertEqualResults({data}, {copy});
 }
 
+TEST_F(BasicTableWriteTest, parallelWrite) {
+  const int32_t numWriters = 4;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 2 * numWriters; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+        makeFlatVector<int32_t>(
+            100, [](auto row) { return -row; }, nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const auto targetDirectoryPath = TempDirectoryPath::create();
+  core::PlanNodeId mergeNodeId;
+  CursorParameters params;
+  params.maxDrivers = numWriters;
+  params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{QueryConfig::kTaskWriterCount, std::to_string(numWriters)}});
+  params.planNode =
+      PlanBuilder()
+          .values(vectors)
+          .parallelTableWrite(
+              targetDirectoryPath->path,
+              FileFormat::DWRF,
+              {"min(c0)", "max(c1)"})
+          .capturePlanNodeId(mergeNodeId)
+          .planNode();
+  const auto [cursor, results] = readCursor(params, [](Task*) {});
+
+  // The values are read by a single driver and each batch goes to the next
+  // writer, so that each writer writes one file.
+  int64_t numRows{0};
+  int32_t numFragments{0};
+  int32_t numStats{0};
+  for (const auto& result : results) {
+    const auto* rowCount = result->childAt(TableWriteTraits::kRowCountChannel)
+                               ->as<SimpleVector<int64_t>>();
+    const auto* fragment = result->childAt(TableWriteTraits::kFragmentChannel)
+                               ->as<SimpleVector<StringView>>();
+    const auto* minC0 = result->childAt(TableWriteTraits::kStatsChannel)
+                            ->as<SimpleVector<int64_t>>();
+    const auto* maxC1 = result->childAt(TableWriteTraits::kStatsChannel + 1)
+                            ->as<SimpleVector<int32_t>>();
+    for (vector_size_t row = 0; row < result->size(); ++row) {
+      if (!rowCount->isNullAt(row)) {
+        numRows += rowCount->valueAt(row);
+      }
+      if (!fragment->isNullAt(row)) {
+        ++numFragments;
+        ASSERT_EQ(
+            folly::parseJson(fragment->valueAt(row))["rowCount"].asInt(),
+            200);
+      }
+      if (!minC0->isNullAt(row)) {
+        ++numStats;
+        ASSERT_EQ(minC0->valueAt(row), 0);
+        ASSERT_EQ(maxC1->valueAt(row), -1);
+      }
+    }
+  }
+  ASSERT_EQ(numRows, 2 * numWriters * 100);
+  ASSERT_EQ(numFragments, numWriters);
+  ASSERT_EQ(numStats, 1);
+
+  const auto stats =
+      toPlanStats(cursor->task()->taskStats()).at(mergeNodeId).customStats;
+  ASSERT_EQ(stats.at("numWriters").sum, numWriters);
+  ASSERT_EQ(stats.at("numFragments").sum, numWriters);
+
+  std::vector<std::shared_ptr<ConnectorSplit>> splits;
+  for (auto& path :
+       fs::recursive_directory_iterator(targetDirectoryPath->path)) {
+    if (path.is_regular_file()) {
+      splits.push_back(makeHiveConnectorSplit(path.path().string()));
+    }
+  }
+  ASSERT_EQ(splits.size(), numWriters);
+  HiveConnectorTestBase::assertQuery(
+      PlanBuilder().tableScan(asRowType(vectors[0]->type())).planNode(),
+      splits,
+      "SELECT * FROM tmp");
+}
+
 class PartitionedTableWriterTest
     : public TableWriteTest,
       public testing::WithParamInterface<uint64_t> {
@@ -2809,6 +2894,70 @@ DEBUG_ONLY_TEST_P(
       "Aborted for external error");
 }
 
+DEBUG_ONLY_TEST_P(UnpartitionedTableWriterTest, reclaimFlushesWriters) {
+  VectorFuzzer::Options options;
+  options.vectorSize = 1000;
+  VectorFuzzer fuzzer(options, pool());
+  const int numBatches = 10;
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(fuzzer.fuzzRow(rowType_));
+  }
+  createDuckDbTable(vectors);
+
+  // Reclaims from a table writer once it has written a few batches, before
+  // it gets the next one.
+  std::atomic<int> writeInputs{0};
+  std::atomic<bool> reclaimed{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (op->operatorType() != "TableWrite" || ++writeInputs < 3 ||
+            reclaimed.exchange(true)) {
+          return;
+        }
+        ASSERT_TRUE(op->canReclaim());
+        uint64_t reclaimableBytes{0};
+        ASSERT_TRUE(op->reclaimableBytes(reclaimableBytes));
+        ASSERT_GT(reclaimableBytes, 0);
+        op->reclaim(0);
+      }));
+
+  auto outputDirectory = TempDirectoryPath::create();
+  auto plan = createInsertPlan(
+      PlanBuilder().values(vectors),
+      rowType_,
+      outputDirectory->path,
+      partitionedBy_,
+      bucketProperty_,
+      compressionKind_,
+      getNumWriters(),
+      connector::hive::LocationHandle::TableType::kNew,
+      commitStrategy_);
+  auto task = assertQuery(plan, "SELECT count(*) FROM tmp");
+  ASSERT_TRUE(reclaimed);
+
+  // The unpartitioned sink has one file writer, which is flushed once.
+  int64_t numFlushes{0};
+  const auto operatorStats =
+      task->taskStats().pipelineStats.at(0).operatorStats;
+  for (const auto& stats : operatorStats) {
+    if (stats.operatorType != "TableWrite") {
+      continue;
+    }
+    const auto it = stats.runtimeStats.find("forcedWriterFlushes");
+    ASSERT_NE(it, stats.runtimeStats.end());
+    ASSERT_EQ(it->second.count, 1);
+    numFlushes += it->second.sum;
+  }
+  ASSERT_EQ(numFlushes, 1);
+
+  assertQuery(
+      PlanBuilder().tableScan(rowType_).planNode(),
+      makeHiveConnectorSplits(outputDirectory),
+      "SELECT * FROM tmp");
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     TableWriterTest,
     UnpartitionedTableWriterTest,
@@ -549,6 +549,52 @@ core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
       planNode_);
 }
 
+PlanBuilder& PlanBuilder::parallelTableWrite(
+    const std::string& outputDirectoryPath,
+    const dwio::common::FileFormat fileFormat,
+    const std::vector<std::string>& aggregates) {
+  localPartitionRoundRobin();
+  tableWrite(outputDirectoryPath, fileFormat, aggregates);
+  const auto partialAggNode =
+      std::dynamic_pointer_cast<const core::TableWriteNode>(planNode_)
+          ->aggregationNode();
+  localPartition(std::vector<std::string>{});
+  if (partialAggNode == nullptr) {
+    return tableWriteMerge();
+  }
+
+  // Merges the partial column statistics of the table writers, which are the
+  // columns of the table writer output named after the aggregates.
+  std::vector<core::AggregationNode::Aggregate> mergeAggregates;
+  for (size_t i = 0; i < partialAggNode->aggregates().size(); ++i) {
+    const auto& call = partialAggNode->aggregates()[i].call;
+    std::vector<TypePtr> rawInputTypes;
+    for (const auto& rawInput : call->inputs()) {
+      rawInputTypes.push_back(rawInput->type());
+    }
+    core::AggregationNode::Aggregate aggregate;
+    aggregate.call = std::make_shared<core::CallTypedExpr>(
+        resolveAggregateType(
+            call->name(),
+            core::AggregationNode::Step::kIntermediate,
+            rawInputTypes,
+            false),
+        std::vector<core::TypedExprPtr>{
+            field(partialAggNode->aggregateNames()[i])},
+        call->name());
+    mergeAggregates.push_back(std::move(aggregate));
+  }
+  return tableWriteMerge(std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kIntermediate,
+      partialAggNode->groupingKeys(),
+      partialAggNode->preGroupedKeys(),
+      partialAggNode->aggregateNames(),
+      mergeAggregates,
+      partialAggNode->ignoreNullKeys(),
+      planNode_));
+}
+
 namespace {
 /// Checks that specified plan node is a partial or intermediate aggregation or
 /// local exchange over the same. Returns a pointer to core::AggregationNode.
@@ -266,6 +266,19 @@ class PlanBuilder {
           dwio::common::FileFormat::DWRF,
       const std::vector<std::string>& aggregates = {});
 
+  /// Similar to tableWrite() except that the input is written by as many
+  /// drivers as the task_writer_count query config, each into its own files.
+  /// Adds a LocalPartitionNode that distributes the input batches round-robin
+  /// to the TableWriteNode drivers, then a LocalPartitionNode that gathers
+  /// their outputs and a TableWriteMergeNode that merges their fragments, row
+  /// counts and column statistics. An unpartitioned write then scales across
+  /// cores even if the input is produced by a single driver.
+  PlanBuilder& parallelTableWrite(
+      const std::string& outputDirectoryPath,
+      const dwio::common::FileFormat fileFormat =
+          dwio::common::FileFormat::DWRF,
+      const std::vector<std::string>& aggregates = {});
+
   /// Add a TableWriteMergeNode.
   PlanBuilder& tableWriteMerge(
       const std::shared_ptr<core::AggregationNode>& aggregationNode = nullptr);
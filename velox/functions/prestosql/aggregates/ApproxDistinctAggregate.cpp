@@ -16,9 +16,8 @@
 #define XXH_INLINE_ALL
 #include <xxhash.h>
 
-#include "velox/common/hyperloglog/DenseHll.h"
+#include "velox/common/hyperloglog/HllAccumulator.h"
 #include "velox/common/hyperloglog/HllUtils.h"
-#include "velox/common/hyperloglog/SparseHll.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/FunctionSignature.h"
@@ -27,88 +26,12 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 
-using facebook::velox::common::hll::DenseHll;
-using facebook::velox::common::hll::SparseHll;
+using facebook::velox::common::hll::HllAccumulator;
 
 namespace facebook::velox::aggregate::prestosql {
 
 namespace {
 
-struct HllAccumulator {
-  explicit HllAccumulator(HashStringAllocator* allocator)
-      : sparseHll_{allocator}, denseHll_{allocator} {}
-
-  void setIndexBitLength(int8_t indexBitLength) {
-    indexBitLength_ = indexBitLength;
-    sparseHll_.setSoftMemoryLimit(
-        DenseHll::estimateInMemorySize(indexBitLength_));
-  }
-
-  void append(uint64_t hash) {
-    if (isSparse_) {
-      if (sparseHll_.insertHash(hash)) {
-        toDense();
-      }
-    } else {
-      denseHll_.insertHash(hash);
-    }
-  }
-
-  int64_t cardinality() const {
-    return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
-  }
-
-  void mergeWith(StringView serialized, HashStringAllocator* allocator) {
-    auto input = serialized.data();
-    if (SparseHll::canDeserialize(input)) {
-      if (isSparse_) {
-        sparseHll_.mergeWith(input);
-        if (indexBitLength_ < 0) {
-          setIndexBitLength(DenseHll::deserializeIndexBitLength(input));
-        }
-        if (sparseHll_.overLimit()) {
-          toDense();
-        }
-      } else {
-        SparseHll other{input, allocator};
-        other.toDense(denseHll_);
-      }
-    } else if (DenseHll::canDeserialize(input)) {
-      if (isSparse_) {
-        if (indexBitLength_ < 0) {
-          setIndexBitLength(DenseHll::deserializeIndexBitLength(input));
-        }
-        toDense();
-      }
-      denseHll_.mergeWith(input);
-    } else {
-      VELOX_USER_FAIL("Unexpected type of HLL");
-    }
-  }
-
-  int32_t serializedSize() {
-    return isSparse_ ? sparseHll_.serializedSize() : denseHll_.serializedSize();
-  }
-
-  void serialize(char* outputBuffer) {
-    return isSparse_ ? sparseHll_.serialize(indexBitLength_, outputBuffer)
-                     : denseHll_.serialize(outputBuffer);
-  }
-
- private:
-  void toDense() {
-    isSparse_ = false;
-    denseHll_.initialize(indexBitLength_);
-    sparseHll_.toDense(denseHll_);
-    sparseHll_.reset();
-  }
-
-  bool isSparse_{true};
-  int8_t indexBitLength_{-1};
-  SparseHll sparseHll_;
-  DenseHll denseHll_;
-};
-
 template <typename T>
 inline uint64_t hashOne(T value) {
   return XXH64(&value, sizeof(T), 0);